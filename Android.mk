@@ -6,6 +6,8 @@ include $(CLEAR_VARS)
 LOCAL_CPP_EXTENSION := .cc
 
 LOCAL_SRC_FILES := \
+    source/autotune.cc          \
+    source/batch.cc             \
     source/compare.cc           \
     source/compare_common.cc    \
     source/compare_neon64.cc    \
@@ -14,16 +16,21 @@ LOCAL_SRC_FILES := \
     source/convert_argb.cc      \
     source/convert_from.cc      \
     source/convert_from_argb.cc \
+    source/convert_frame.cc     \
     source/convert_to_argb.cc   \
     source/convert_to_i420.cc   \
     source/cpu_id.cc            \
+    source/dispatch.cc          \
+    source/frame_buffer_pool.cc \
     source/planar_functions.cc  \
+    source/profile.cc           \
     source/rotate.cc            \
     source/rotate_argb.cc       \
     source/rotate_mips.cc       \
     source/rotate_neon64.cc     \
     source/row_any.cc           \
     source/row_common.cc        \
+    source/row_functions.cc     \
     source/row_mips.cc          \
     source/row_neon64.cc        \
     source/row_gcc.cc	        \
@@ -34,6 +41,7 @@ LOCAL_SRC_FILES := \
     source/scale_mips.cc        \
     source/scale_neon64.cc      \
     source/scale_gcc.cc         \
+    source/scratch.cc           \
     source/video_common.cc
 
 # TODO(fbarchard): Enable mjpeg encoder.
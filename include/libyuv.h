@@ -11,21 +11,28 @@
 #ifndef INCLUDE_LIBYUV_H_  // NOLINT
 #define INCLUDE_LIBYUV_H_
 
+#include "libyuv/autotune.h"
 #include "libyuv/basic_types.h"
+#include "libyuv/batch.h"
 #include "libyuv/compare.h"
 #include "libyuv/convert.h"
 #include "libyuv/convert_argb.h"
 #include "libyuv/convert_from.h"
 #include "libyuv/convert_from_argb.h"
+#include "libyuv/convert_frame.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/dispatch.h"
+#include "libyuv/frame_buffer_pool.h"
 #include "libyuv/mjpeg_decoder.h"
 #include "libyuv/planar_functions.h"
+#include "libyuv/profile.h"
 #include "libyuv/rotate.h"
 #include "libyuv/rotate_argb.h"
 #include "libyuv/row.h"
 #include "libyuv/scale.h"
 #include "libyuv/scale_argb.h"
 #include "libyuv/scale_row.h"
+#include "libyuv/scratch.h"
 #include "libyuv/version.h"
 #include "libyuv/video_common.h"
 
@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_AUTOTUNE_H_  // NOLINT
+#define INCLUDE_LIBYUV_AUTOTUNE_H_
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Row functions picked by timing when autotuning is enabled, instead of by
+// the fixed preference for cpu features.  Each is tuned on first use for each
+// width bucket, and the fastest is used for later calls in that bucket.
+enum AutotuneKernel {
+  kAutotuneCopyRow = 0,  // CopyPlane.  0 = SSE2, 1 = AVX, 2 = ERMS.
+  kAutotuneSetRow,  // SetPlane.  0 = X86, 1 = ERMS.
+  kAutotuneTransposeWx8,  // TransposePlane.  0 = SSSE3, 1 = FAST_SSSE3.
+  kAutotuneI422ToARGBRow,  // I420ToARGB.  0 = SSSE3, 1 = AVX2.
+  kAutotuneKernelCount  // Number of kernels.  Not a kernel.
+};
+
+// Turn autotuning on or off.  When off, row functions are picked by cpu
+// features as usual and the table is kept.
+// Widths up to 320, 1280, 3840 and larger are tuned separately.
+LIBYUV_API
+void SetAutotuneEnabled(LIBYUV_BOOL enable);
+
+// Returns the candidate picked for a kernel at a width, or -1 if that width
+// bucket has not been tuned.
+LIBYUV_API
+int GetAutotuneChoice(enum AutotuneKernel kernel, int width);
+
+// Forget the tuned choices.
+LIBYUV_API
+void ResetAutotuneTable(void);
+
+// Write the tuned choices to a text file.  Returns 0 on success.
+LIBYUV_API
+int SaveAutotuneTable(const char* filename);
+
+// Read choices written by SaveAutotuneTable, so that a process can skip
+// tuning on restart.  Fails and keeps the current table if the file was
+// written on a cpu with different features.  Returns 0 on success.
+LIBYUV_API
+int LoadAutotuneTable(const char* filename);
+
+// Internal function and flag used by the tuned functions.
+// "available" has bit n set if candidate n can run on this cpu and width.
+// "run" runs candidate n on a row of "width" pixels, with buffers of
+// width * 32 bytes.  Returns the candidate to use, or -1 to use the usual
+// choice.
+LIBYUV_API extern int autotune_enabled_;
+typedef void (*AutotuneRunFunction)(int candidate, const uint8* src,
+                                    uint8* dst, int width);
+int AutotuneSelect(enum AutotuneKernel kernel, int width, int available,
+                   AutotuneRunFunction run);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_AUTOTUNE_H_  NOLINT
@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_BATCH_H_  // NOLINT
+#define INCLUDE_LIBYUV_BATCH_H_
+
+#include "libyuv/basic_types.h"
+#include "libyuv/scale.h"  // For FilterMode.
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Batch functions convert many small frames in one call, so the cost of
+// picking row functions and allocating temporary rows is paid once per batch
+// instead of once per frame.
+//
+// To spread a batch over threads, call the batch function from each thread
+// with the same frames and the same "next_frame" counter, set to 0 before
+// the first call.  Each call takes the next frame no call has taken yet
+// until none are left, so threads that finish early take more frames.
+// Pass NULL for "next_frame" to convert every frame on the calling thread.
+//
+// Each frame's "result" is set to what the single frame function returns.
+// Returns 0 if all frames converted by this call succeeded, or -1.
+
+// An I420 to ARGB conversion in a batch.  See I420ToARGB.
+struct I420ToARGBFrame {
+  const uint8* src_y;
+  int src_stride_y;
+  const uint8* src_u;
+  int src_stride_u;
+  const uint8* src_v;
+  int src_stride_v;
+  uint8* dst_argb;
+  int dst_stride_argb;
+  int width;
+  int height;
+  int result;
+};
+
+LIBYUV_API
+int I420ToARGBBatch(struct I420ToARGBFrame* frames, int count,
+                    int* next_frame);
+
+// An ARGB scale in a batch.  See ARGBScale.
+struct ARGBScaleFrame {
+  const uint8* src_argb;
+  int src_stride_argb;
+  int src_width;
+  int src_height;
+  uint8* dst_argb;
+  int dst_stride_argb;
+  int dst_width;
+  int dst_height;
+  int result;
+};
+
+// Temporary rows come from one scratch arena for the whole batch, unless
+// the calling thread already has one set with SetScratchArena.
+LIBYUV_API
+int ARGBScaleBatch(struct ARGBScaleFrame* frames, int count,
+                   enum FilterMode filtering, int* next_frame);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_BATCH_H_  NOLINT
@@ -16,6 +16,7 @@
 #include "libyuv/convert_from.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/rotate.h"
+#include "libyuv/scale.h"  // For FilterMode.
 
 // TODO(fbarchard): This set of functions should exactly match convert.h
 // TODO(fbarchard): Add tests. Create random content of right size and convert
@@ -44,6 +45,18 @@ int I420ToARGB(const uint8* src_y, int src_stride_y,
                uint8* dst_argb, int dst_stride_argb,
                int width, int height);
 
+// Convert I420 to ARGB with filtered chroma.  I420ToARGB uses each chroma
+// sample for 2x2 pixels, which looks blocky on sharp colored edges such as
+// text.  kFilterLinear interpolates chroma across, and kFilterBilinear and
+// kFilterBox interpolate across and down, with chroma sited between pixels.
+// kFilterNone is the same as I420ToARGB.
+LIBYUV_API
+int I420ToARGBFilter(const uint8* src_y, int src_stride_y,
+                     const uint8* src_u, int src_stride_u,
+                     const uint8* src_v, int src_stride_v,
+                     uint8* dst_argb, int dst_stride_argb,
+                     int width, int height, enum FilterMode filtering);
+
 // Convert I422 to ARGB.
 LIBYUV_API
 int I422ToARGB(const uint8* src_y, int src_stride_y,
@@ -90,6 +103,13 @@ int NV12ToARGB(const uint8* src_y, int src_stride_y,
                uint8* dst_argb, int dst_stride_argb,
                int width, int height);
 
+// Convert NV12 to ARGB with filtered chroma.  See I420ToARGBFilter.
+LIBYUV_API
+int NV12ToARGBFilter(const uint8* src_y, int src_stride_y,
+                     const uint8* src_uv, int src_stride_uv,
+                     uint8* dst_argb, int dst_stride_argb,
+                     int width, int height, enum FilterMode filtering);
+
 // Convert NV21 to ARGB.
 LIBYUV_API
 int NV21ToARGB(const uint8* src_y, int src_stride_y,
@@ -0,0 +1,114 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_CONVERT_FRAME_H_  // NOLINT
+#define INCLUDE_LIBYUV_CONVERT_FRAME_H_
+
+#include "libyuv/basic_types.h"
+#include "libyuv/rotate.h"  // For enum RotationMode.
+#include "libyuv/scale.h"  // For enum FilterMode.
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Passes over the frame that a plan is built from.  Each is an existing
+// libyuv function: ConvertToI420, I420Scale, I420Rotate, ConvertFromI420.
+enum FrameConvertStep {
+  kFrameStepToI420 = 0,
+  kFrameStepScale = 1,
+  kFrameStepRotate = 2,
+  kFrameStepFromI420 = 3,
+};
+
+// A conversion from one fourcc to another with cropping, scaling and
+// rotation, planned once and run on many frames.
+// The plan chains the fewest passes needed, going through I420 when there
+// is no direct path.  Intermediate I420 images are kept in 2 buffers owned
+// by the plan, so frames are converted without allocating.  When there is
+// no scaling or rotation the passes run in stripes of rows sized to stay in
+// the L2 cache instead of making a full frame temporary image.
+// Fields are filled in by FrameConvertPlanInit and should be treated as
+// read only.
+struct FrameConvertPlan {
+  uint32 src_fourcc;
+  int src_width;
+  int src_height;
+  int crop_x;
+  int crop_y;
+  int crop_width;
+  int crop_height;
+  uint32 dst_fourcc;
+  int dst_width;
+  int dst_height;
+  enum RotationMode rotation;
+  enum FilterMode filtering;
+  int num_steps;
+  enum FrameConvertStep steps[4];  // The first num_steps are used.
+  int stripe_height;  // Rows per stripe, or 0 for whole frames.
+  uint8* buffer_mem;
+  uint8* buffer[2];
+};
+
+// Build a plan to convert frames of src_fourcc to dst_fourcc.
+// "src_width" / "src_height" is size of the source frame in pixels.
+//   "src_height" can be negative indicating a vertically flipped image source.
+// "crop_x" / "crop_y" / "crop_width" / "crop_height" select the source
+//   rectangle, as in ConvertToI420.  Cropping parameters are pre-rotation.
+// "dst_width" / "dst_height" is the size of the destination, post-rotation.
+//   The cropped source is scaled to fit with "filtering".
+// "rotation" can be 0, 90, 180 or 270.
+// Returns 0 for successful; -1 for invalid parameter or unsupported fourcc.
+// Returns 1 if the temporary buffers could not be allocated.
+LIBYUV_API
+int FrameConvertPlanInit(struct FrameConvertPlan* plan,
+                         uint32 src_fourcc,
+                         int src_width, int src_height,
+                         int crop_x, int crop_y,
+                         int crop_width, int crop_height,
+                         uint32 dst_fourcc,
+                         int dst_width, int dst_height,
+                         enum RotationMode rotation,
+                         enum FilterMode filtering);
+
+// Convert one frame with a plan.
+// "src_size" is needed to parse MJPG.
+// "dst_stride_frame" is bytes in a row for single plane destinations.
+//   Pass 0 if the buffer has contiguous rows.  Planar destinations are
+//   always contiguous, as in ConvertFromI420.
+LIBYUV_API
+int FrameConvertPlanRun(const struct FrameConvertPlan* plan,
+                        const uint8* src_frame, size_t src_size,
+                        uint8* dst_frame, int dst_stride_frame);
+
+// Release the buffers of a plan.
+LIBYUV_API
+void FrameConvertPlanFree(struct FrameConvertPlan* plan);
+
+// Convert a single frame.  Same as planning, running and freeing a plan.
+LIBYUV_API
+int ConvertFrame(const uint8* src_frame, size_t src_size,
+                 uint32 src_fourcc,
+                 int src_width, int src_height,
+                 int crop_x, int crop_y,
+                 int crop_width, int crop_height,
+                 uint8* dst_frame, int dst_stride_frame,
+                 uint32 dst_fourcc,
+                 int dst_width, int dst_height,
+                 enum RotationMode rotation,
+                 enum FilterMode filtering);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_CONVERT_FRAME_H_  NOLINT
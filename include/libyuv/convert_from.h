@@ -88,6 +88,20 @@ int I420ToUYVY(const uint8* src_y, int src_stride_y,
                uint8* dst_frame, int dst_stride_frame,
                int width, int height);
 
+// Convert NV12 to YUY2.
+LIBYUV_API
+int NV12ToYUY2(const uint8* src_y, int src_stride_y,
+               const uint8* src_uv, int src_stride_uv,
+               uint8* dst_yuy2, int dst_stride_yuy2,
+               int width, int height);
+
+// Convert NV12 to UYVY.
+LIBYUV_API
+int NV12ToUYVY(const uint8* src_y, int src_stride_y,
+               const uint8* src_uv, int src_stride_uv,
+               uint8* dst_uyvy, int dst_stride_uyvy,
+               int width, int height);
+
 LIBYUV_API
 int I420ToARGB(const uint8* src_y, int src_stride_y,
                const uint8* src_u, int src_stride_u,
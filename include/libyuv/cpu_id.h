@@ -44,6 +44,25 @@ static const int kCpuHasMIPS = 0x10000;
 static const int kCpuHasMIPS_DSP = 0x20000;
 static const int kCpuHasMIPS_DSPR2 = 0x40000;
 
+// Building with one of the LIBYUV_TARGET_ macros defined, such as by
+// cmake -DLIBYUV_TARGET=avx2 or gyp -Dlibyuv_target=avx2, fixes the cpu
+// flags at compile time for a known cpu.  TestCpuFlag is then a constant, so
+// the compiler removes detection and the row functions for other cpus, and
+// ROW_FUNCTION picks between constant kernels.  MaskCpuFlags has no effect.
+#if defined(LIBYUV_TARGET_C)
+#define LIBYUV_TARGET_FLAGS 0
+#elif defined(LIBYUV_TARGET_SSE2)
+#define LIBYUV_TARGET_FLAGS (kCpuHasX86 | kCpuHasSSE2)
+#elif defined(LIBYUV_TARGET_SSSE3)
+#define LIBYUV_TARGET_FLAGS (kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3)
+#elif defined(LIBYUV_TARGET_AVX2)
+#define LIBYUV_TARGET_FLAGS (kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3 |        \
+                             kCpuHasSSE41 | kCpuHasSSE42 | kCpuHasAVX |       \
+                             kCpuHasAVX2 | kCpuHasFMA3)
+#elif defined(LIBYUV_TARGET_NEON)
+#define LIBYUV_TARGET_FLAGS (kCpuHasARM | kCpuHasNEON)
+#endif
+
 // Internal function used to auto-init.
 LIBYUV_API
 int InitCpuFlags(void);
@@ -55,10 +74,16 @@ int ArmCpuCaps(const char* cpuinfo_name);
 // Detect CPU has SSE2 etc.
 // Test_flag parameter should be one of kCpuHas constants above.
 // returns non-zero if instruction set is detected
+#if defined(LIBYUV_TARGET_FLAGS)
+static __inline int TestCpuFlag(int test_flag) {
+  return (LIBYUV_TARGET_FLAGS) & test_flag;
+}
+#else
 static __inline int TestCpuFlag(int test_flag) {
   LIBYUV_API extern int cpu_info_;
   return (cpu_info_ == kCpuInit ? InitCpuFlags() : cpu_info_) & test_flag;
 }
+#endif
 
 // For testing, allow CPU flags to be disabled.
 // ie MaskCpuFlags(~kCpuHasSSSE3) to disable SSSE3.
@@ -73,6 +98,33 @@ void MaskCpuFlags(int enable_flags);
 LIBYUV_API
 void CpuId(uint32 eax, uint32 ecx, uint32* cpu_info);
 
+// Cache sizes and core counts of the CPU.
+struct CpuCacheInfo {
+  int l1d_size;  // Bytes of L1 data cache, per core.
+  int l2_size;  // Bytes of L2 cache.
+  int l3_size;  // Bytes of L3 cache, or 0 if there is none.
+  int line_size;  // Bytes in a cache line.
+  int num_cores;  // Physical cores.
+  int num_threads;  // Logical processors.
+};
+
+// Get the cache topology of the CPU, detected on first use from cpuid leaf 4
+// or 0x8000001D on x86, /sys/devices/system/cpu on Linux and sysctl on Mac.
+// Values that can not be detected are 32 KB L1, 256 KB L2, no L3,
+// 64 byte lines and 1 core.
+LIBYUV_API
+void GetCpuCacheInfo(struct CpuCacheInfo* info);
+
+// For testing, replace the detected cache topology.
+// SetCpuCacheInfo(NULL) to detect it again.
+LIBYUV_API
+void SetCpuCacheInfo(const struct CpuCacheInfo* info);
+
+// Internal function for parsing /sys/devices/system/cpu.
+// Sets the fields found in "cpu_dir" and returns non-zero if any were found.
+LIBYUV_API
+int LinuxCpuCacheInfo(const char* cpu_dir, struct CpuCacheInfo* info);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -0,0 +1,59 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_DISPATCH_H_  // NOLINT
+#define INCLUDE_LIBYUV_DISPATCH_H_
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Called each time a function picks its row functions, with the name of the
+// function, such as "I420ToARGB", the name of the row function, such as
+// "I422ToARGBRow_Any_AVX2", and the width it was picked for.
+// "any" is non-zero for an _Any_ row function, which means the width (or
+// alignment) missed the faster full SIMD row function.
+// Reported by I420ToARGB, NV12ToARGB, ARGBToI420, I420ToNV12 and CopyPlane.
+typedef void (*KernelDispatchCallback)(const char* function,
+                                       const char* kernel,
+                                       LIBYUV_BOOL any,
+                                       int width);
+
+// Set the callback, or NULL to stop reporting.  Not thread safe; set it
+// before calling libyuv from other threads.  The callback may be called
+// from any thread.
+LIBYUV_API
+void SetKernelDispatchCallback(KernelDispatchCallback callback);
+
+// Returns the name of a row function, such as "CopyRow_SSE2", or NULL if it
+// is not one of the reported row functions.
+LIBYUV_API
+const char* GetKernelName(const void* kernel);
+
+// Internal function and macro used by the reporting functions.
+// Costs a test of a global when no callback is set.
+LIBYUV_API extern KernelDispatchCallback kernel_dispatch_callback_;
+void ReportKernelDispatch(const char* function, const void* kernel, int width);
+#define DISPATCH_KERNEL(function, kernel, width) \
+    do { \
+      if (kernel_dispatch_callback_) { \
+        ReportKernelDispatch(function, (const void*)(kernel), width); \
+      } \
+    } while (0)
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_DISPATCH_H_  NOLINT
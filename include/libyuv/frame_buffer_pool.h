@@ -0,0 +1,91 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_FRAME_BUFFER_POOL_H_  // NOLINT
+#define INCLUDE_LIBYUV_FRAME_BUFFER_POOL_H_
+
+#include <stddef.h>  // For size_t.
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Alignment of planes and strides in a FrameBuffer.
+static const int kFrameBufferAlignment = 64;
+
+// Flags for FrameBufferPoolInit.
+enum FrameBufferPoolFlags {
+  // Back frames of 2 MB or more with huge pages where the OS supports it,
+  // to reduce TLB misses on large frames.  Ignored elsewhere.
+  kFrameBufferPoolHugePages = 1,
+};
+
+// A frame with each plane and stride aligned to kFrameBufferAlignment, so
+// row functions take their aligned paths.
+// Planes are Y, U, V for planar formats, Y, UV (or VU) for NV12 and NV21,
+// and a single plane for packed formats.  Unused planes are NULL.
+struct FrameBuffer {
+  uint32 fourcc;  // Canonical fourcc.
+  int width;
+  int height;
+  int num_planes;
+  uint8* plane[3];
+  int stride[3];
+  // Internal.
+  uint8* mem;
+  size_t mem_size;
+  int mapped;
+  struct FrameBuffer* next;
+};
+
+// A pool of FrameBuffers that recycles frames by fourcc and size.
+// Released frames are kept for reuse, most recently released first, up to
+// "max_free" of them.  A pool is not thread safe.
+struct FrameBufferPool {
+  int flags;
+  int max_free;
+  int num_free;
+  struct FrameBuffer* free_list;
+};
+
+// Initialize an empty pool.
+// "flags" is a combination of FrameBufferPoolFlags.
+// "max_free" is the most released frames kept for reuse.
+LIBYUV_API
+void FrameBufferPoolInit(struct FrameBufferPool* pool,
+                         int flags, int max_free);
+
+// Get a frame of "fourcc" with "width" x "height" pixels, reusing a released
+// frame of the same geometry if there is one.  Contents are not cleared.
+// Returns NULL for invalid parameter, unsupported fourcc or out of memory.
+LIBYUV_API
+struct FrameBuffer* FrameBufferPoolAcquire(struct FrameBufferPool* pool,
+                                           uint32 fourcc,
+                                           int width, int height);
+
+// Return a frame to the pool.
+LIBYUV_API
+void FrameBufferPoolRelease(struct FrameBufferPool* pool,
+                            struct FrameBuffer* buffer);
+
+// Release the frames kept by the pool.  Acquired frames must be released
+// to the pool first.
+LIBYUV_API
+void FrameBufferPoolFree(struct FrameBufferPool* pool);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_FRAME_BUFFER_POOL_H_  NOLINT
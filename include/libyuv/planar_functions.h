@@ -22,6 +22,35 @@ namespace libyuv {
 extern "C" {
 #endif
 
+// Default output size in bytes above which non-temporal stores are used.
+static const int64 kStreamingStoreThreshold = 8 * 1024 * 1024;
+
+// Set the output size in bytes above which CopyPlane, I420ToARGB and
+// bilinear ScalePlane downscaling write with non-temporal stores that bypass
+// the cache, where the CPU supports them.  A large frame that is not read
+// again soon, such as one handed to an encoder, then does not evict the
+// working set.
+// 0 streams all output; -1 never streams.  The default is the smaller of
+// kStreamingStoreThreshold and the L3 size from GetCpuCacheInfo.
+LIBYUV_API
+void SetStreamingStoreThreshold(int64 bytes);
+
+// Precision of conversions.  kPrecisionExact gives the same results as the
+// C functions on every cpu.  kPrecisionFast allows results up to 1 off the
+// exact ones, for previews and analysis, so that cheaper row functions can
+// be used.  It currently speeds up I420ToARGB and I420ToARGBBatch on x86.
+enum Precision {
+  kPrecisionExact = 0,
+  kPrecisionFast = 1,
+};
+
+// Set the precision of conversions.  The default is kPrecisionExact.
+LIBYUV_API
+void SetPrecision(enum Precision precision);
+
+LIBYUV_API
+enum Precision GetPrecision(void);
+
 // Copy a plane of data.
 LIBYUV_API
 void CopyPlane(const uint8* src_y, int src_stride_y,
@@ -108,6 +137,15 @@ int I420Mirror(const uint8* src_y, int src_stride_y,
                uint8* dst_v, int dst_stride_v,
                int width, int height);
 
+// NV12 mirror.  UV is mirrored as pairs, so the result is also NV12.
+// Pass negative height to achieve 180 degree rotation.
+LIBYUV_API
+int NV12Mirror(const uint8* src_y, int src_stride_y,
+               const uint8* src_uv, int src_stride_uv,
+               uint8* dst_y, int dst_stride_y,
+               uint8* dst_uv, int dst_stride_uv,
+               int width, int height);
+
 // Alias
 #define I400ToI400Mirror I400Mirror
 
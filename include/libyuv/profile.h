@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_PROFILE_H_  // NOLINT
+#define INCLUDE_LIBYUV_PROFILE_H_
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Functions that count calls, pixels, bytes and time.
+// Counting is compiled in when libyuv is built with LIBYUV_PROFILE defined
+// and is off until SetProfileEnabled(1).  Without LIBYUV_PROFILE the
+// counters stay zero and cost nothing.
+// Times are inclusive, so ConvertToI420 includes the I420Rotate it calls.
+// I420Rotate and ARGBRotate count rotations; kRotate0 is counted as the
+// CopyPlane calls of the copy.  ConvertFromI420 counts only source bytes.
+enum ProfileFunction {
+  kProfileI420ToARGB = 0,
+  kProfileNV12ToARGB,
+  kProfileARGBToI420,
+  kProfileI420ToNV12,
+  kProfileCopyPlane,
+  kProfileI420Scale,
+  kProfileARGBScale,
+  kProfileI420Rotate,
+  kProfileARGBRotate,
+  kProfileConvertToI420,
+  kProfileConvertFromI420,
+  kProfileFunctionCount  // Number of functions.  Not a function.
+};
+
+struct ProfileCounters {
+  uint64 calls;
+  uint64 pixels;  // Destination pixels.
+  uint64 bytes;  // Source and destination bytes.
+  uint64 nanoseconds;
+};
+
+// Start or stop counting on all threads.
+LIBYUV_API
+void SetProfileEnabled(LIBYUV_BOOL enable);
+
+// Returns the name of a function, such as "I420ToARGB".
+LIBYUV_API
+const char* GetProfileFunctionName(enum ProfileFunction function);
+
+// Snapshot the counters since the last reset, summed over all threads, into
+// an array of kProfileFunctionCount counters indexed by ProfileFunction.
+// Each thread counts without locks, so calls still running on other threads
+// may not be included.
+LIBYUV_API
+void GetProfileCounters(struct ProfileCounters* counters);
+
+// Start counting from zero.  Call from the same thread as GetProfileCounters.
+LIBYUV_API
+void ResetProfileCounters(void);
+
+// Print the counters of functions that were called into "buffer", one line
+// per function, or as a JSON object keyed by function name if "json" is
+// non-zero.  Returns the length of the text, which is truncated to fit
+// "size" bytes including the terminating 0, like snprintf.
+LIBYUV_API
+int FormatProfileCounters(char* buffer, int size, LIBYUV_BOOL json);
+
+// Internal function for monotonic time in nanoseconds.
+uint64 ProfileNanoseconds(void);
+
+// Internal functions and macros used by the counted functions.
+// PROFILE_BEGIN goes after parameter checks, before width and height are
+// changed to coalesce rows, and PROFILE_END before the successful return.
+#ifdef LIBYUV_PROFILE
+uint64 ProfileBegin(void);
+void ProfileEnd(enum ProfileFunction function, uint64 start,
+                int64 pixels, int64 bytes);
+#define PROFILE_BEGIN(pixels, bytes) \
+    const int64 profile_pixels = (pixels); \
+    const int64 profile_bytes = (bytes); \
+    const uint64 profile_start = ProfileBegin()
+#define PROFILE_END(function) \
+    ProfileEnd(function, profile_start, profile_pixels, profile_bytes)
+#else
+#define PROFILE_BEGIN(pixels, bytes)
+#define PROFILE_END(function)
+#endif
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_PROFILE_H_  NOLINT
@@ -50,6 +50,14 @@ int NV12ToI420Rotate(const uint8* src_y, int src_stride_y,
                      uint8* dst_v, int dst_stride_v,
                      int src_width, int src_height, enum RotationMode mode);
 
+// Rotate NV12 frame.  UV is rotated as pairs, so the result is also NV12.
+LIBYUV_API
+int NV12Rotate(const uint8* src_y, int src_stride_y,
+               const uint8* src_uv, int src_stride_uv,
+               uint8* dst_y, int dst_stride_y,
+               uint8* dst_uv, int dst_stride_uv,
+               int src_width, int src_height, enum RotationMode mode);
+
 // Rotate a plane by 0, 90, 180, or 270.
 LIBYUV_API
 int RotatePlane(const uint8* src, int src_stride,
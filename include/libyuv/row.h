@@ -14,6 +14,7 @@
 #include <stdlib.h>  // For malloc.
 
 #include "libyuv/basic_types.h"
+#include "libyuv/cpu_id.h"  // For TestCpuFlag and LIBYUV_TARGET_FLAGS.
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -22,19 +23,54 @@ extern "C" {
 
 #define IS_ALIGNED(p, a) (!((uintptr_t)(p) & ((a) - 1)))
 
+#if defined(_MSC_VER)
+#define LIBYUV_THREAD_LOCAL __declspec(thread)
+#else
+#define LIBYUV_THREAD_LOCAL __thread
+#endif
+
+// Temporary buffers come from the scratch arena of the calling thread when
+// one is set with SetScratchArena, otherwise from malloc.
+// Exported because align_buffer_64 uses them in tests and tools too.
+LIBYUV_API
+void* ScratchAlloc(size_t size);
+LIBYUV_API
+void ScratchFree(void* ptr);
+// Returns true if the calling thread has a scratch arena.
+LIBYUV_BOOL HasScratchArena(void);
+
+// Returns true if output of "size" bytes to "dst" should be written with
+// non-temporal stores.  See SetStreamingStoreThreshold.
+LIBYUV_BOOL UseStreamingStores(const uint8* dst, int dst_stride, int64 size);
+
 #ifdef __cplusplus
 #define align_buffer_64(var, size)                                             \
-  uint8* var##_mem = reinterpret_cast<uint8*>(malloc((size) + 63));            \
+  uint8* var##_mem = reinterpret_cast<uint8*>(ScratchAlloc((size) + 63));      \
   uint8* var = reinterpret_cast<uint8*>                                        \
       ((reinterpret_cast<intptr_t>(var##_mem) + 63) & ~63)
 #else
 #define align_buffer_64(var, size)                                             \
-  uint8* var##_mem = (uint8*)(malloc((size) + 63));               /* NOLINT */ \
+  uint8* var##_mem = (uint8*)(ScratchAlloc((size) + 63));         /* NOLINT */ \
   uint8* var = (uint8*)(((intptr_t)(var##_mem) + 63) & ~63)       /* NOLINT */
 #endif
 
+// As align_buffer_64, but allocates nothing and sets var to NULL unless
+// cond is true.  free_aligned_buffer_64 accepts either.
+#ifdef __cplusplus
+#define align_buffer_64_if(var, cond, size)                                    \
+  uint8* var##_mem = (cond) ?                                                  \
+      reinterpret_cast<uint8*>(ScratchAlloc((size) + 63)) : NULL;              \
+  uint8* var = var##_mem ? reinterpret_cast<uint8*>                            \
+      ((reinterpret_cast<intptr_t>(var##_mem) + 63) & ~63) : NULL
+#else
+#define align_buffer_64_if(var, cond, size)                                    \
+  uint8* var##_mem = (cond) ? (uint8*)(ScratchAlloc((size) + 63)) : NULL;      \
+  uint8* var = var##_mem ?                                                     \
+      (uint8*)(((intptr_t)(var##_mem) + 63) & ~63) : NULL         /* NOLINT */
+#endif
+
 #define free_aligned_buffer_64(var) \
-  free(var##_mem);  \
+  ScratchFree(var##_mem);  \
   var = 0
 
 #if defined(__pnacl__) || defined(__CLR_VER) || defined(COVERAGE_ENABLED) || \
@@ -82,6 +118,7 @@ extern "C" {
 #define HAS_BGRATOUVROW_SSSE3
 #define HAS_BGRATOYROW_SSSE3
 #define HAS_COPYROW_ERMS
+#define HAS_COPYROW_NT_SSE2
 #define HAS_COPYROW_SSE2
 #define HAS_I400TOARGBROW_SSE2
 #define HAS_I411TOARGBROW_SSSE3
@@ -158,6 +195,24 @@ extern "C" {
 #define HAS_SOBELYROW_SSE2
 #endif
 
+// The following are available on x86 GCC and clang:
+#if !defined(LIBYUV_DISABLE_X86) && (defined(__x86_64__) || defined(__i386__))
+#define HAS_I422TOARGBFASTROW_SSSE3
+#define HAS_INTERPOLATEROW_16_SSE2
+#define HAS_MIRRORNVUVROW_SSE2
+#define HAS_NV12TOYUY2ROW_SSE2
+#define HAS_YUY2TONVUVROW_SSE2
+#endif
+
+// The following are available on x64 GCC and clang.
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__)
+#define HAS_ABGRTOI420ROW_SSSE3
+#define HAS_ARGBTOI420ROW_SSSE3
+#define HAS_ARGBTOJ420ROW_SSSE3
+#define HAS_BGRATOI420ROW_SSSE3
+#define HAS_RGBATOI420ROW_SSSE3
+#endif
+
 // The following are available on x64 Visual C and clangcl.
 #if !defined(LIBYUV_DISABLE_X86) && defined (_M_X64) && \
     (!defined(__clang__) || defined(__SSSE3__))
@@ -249,6 +304,40 @@ extern "C" {
 #define HAS_ARGBUNATTENUATEROW_AVX2
 #endif
 
+// The following require gcc 4.7 or clang 3.4.
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+#define HAS_ABGRTOUVROW_AVX2
+#define HAS_ABGRTOYROW_AVX2
+#define HAS_ARGB1555TOARGBROW_AVX2
+#define HAS_ARGB4444TOARGBROW_AVX2
+#define HAS_ARGBTOUVJROW_AVX2
+#define HAS_BGRATOUVROW_AVX2
+#define HAS_BGRATOYROW_AVX2
+#define HAS_I422TOARGBFASTROW_AVX2
+#define HAS_INTERPOLATEROW_16_AVX2
+#define HAS_MIRRORNVUVROW_AVX2
+#define HAS_NV12TOYUY2ROW_AVX2
+#define HAS_RAWTOUVROW_AVX2
+#define HAS_RAWTOYROW_AVX2
+#define HAS_RGB24TOUVROW_AVX2
+#define HAS_RGB24TOYROW_AVX2
+#define HAS_RGB565TOARGBROW_AVX2
+#define HAS_RGBATOUVROW_AVX2
+#define HAS_RGBATOYROW_AVX2
+#define HAS_YUY2TONVUVROW_AVX2
+#endif
+
+// The following require gcc 4.7 or clang 3.4 on x64.
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+#define HAS_ABGRTOI420ROW_AVX2
+#define HAS_ARGBTOI420ROW_AVX2
+#define HAS_ARGBTOJ420ROW_AVX2
+#define HAS_BGRATOI420ROW_AVX2
+#define HAS_RGBATOI420ROW_AVX2
+#endif
+
 // The following are disabled when SSSE3 is available:
 #if !defined(LIBYUV_DISABLE_X86) && \
     (defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)) && \
@@ -583,6 +672,16 @@ void ARGBToYRow_SSSE3(const uint8* src_argb, uint8* dst_y, int pix);
 void ARGBToYJRow_AVX2(const uint8* src_argb, uint8* dst_y, int pix);
 void ARGBToYJRow_Any_AVX2(const uint8* src_argb, uint8* dst_y, int pix);
 void ARGBToYJRow_SSSE3(const uint8* src_argb, uint8* dst_y, int pix);
+void BGRAToYRow_AVX2(const uint8* src_bgra, uint8* dst_y, int pix);
+void ABGRToYRow_AVX2(const uint8* src_abgr, uint8* dst_y, int pix);
+void RGBAToYRow_AVX2(const uint8* src_rgba, uint8* dst_y, int pix);
+void RGB24ToYRow_AVX2(const uint8* src_rgb24, uint8* dst_y, int pix);
+void RAWToYRow_AVX2(const uint8* src_raw, uint8* dst_y, int pix);
+void BGRAToYRow_Any_AVX2(const uint8* src_bgra, uint8* dst_y, int pix);
+void ABGRToYRow_Any_AVX2(const uint8* src_abgr, uint8* dst_y, int pix);
+void RGBAToYRow_Any_AVX2(const uint8* src_rgba, uint8* dst_y, int pix);
+void RGB24ToYRow_Any_AVX2(const uint8* src_rgb24, uint8* dst_y, int pix);
+void RAWToYRow_Any_AVX2(const uint8* src_raw, uint8* dst_y, int pix);
 void BGRAToYRow_SSSE3(const uint8* src_bgra, uint8* dst_y, int pix);
 void ABGRToYRow_SSSE3(const uint8* src_abgr, uint8* dst_y, int pix);
 void RGBAToYRow_SSSE3(const uint8* src_rgba, uint8* dst_y, int pix);
@@ -656,6 +755,30 @@ void ARGBToUVRow_AVX2(const uint8* src_argb, int src_stride_argb,
                       uint8* dst_u, uint8* dst_v, int width);
 void ARGBToUVRow_Any_AVX2(const uint8* src_argb, int src_stride_argb,
                           uint8* dst_u, uint8* dst_v, int width);
+void ARGBToUVJRow_AVX2(const uint8* src_argb, int src_stride_argb,
+                       uint8* dst_u, uint8* dst_v, int width);
+void BGRAToUVRow_AVX2(const uint8* src_bgra, int src_stride_bgra,
+                      uint8* dst_u, uint8* dst_v, int width);
+void ABGRToUVRow_AVX2(const uint8* src_abgr, int src_stride_abgr,
+                      uint8* dst_u, uint8* dst_v, int width);
+void RGBAToUVRow_AVX2(const uint8* src_rgba, int src_stride_rgba,
+                      uint8* dst_u, uint8* dst_v, int width);
+void RGB24ToUVRow_AVX2(const uint8* src_rgb24, int src_stride_rgb24,
+                       uint8* dst_u, uint8* dst_v, int width);
+void RAWToUVRow_AVX2(const uint8* src_raw, int src_stride_raw,
+                     uint8* dst_u, uint8* dst_v, int width);
+void ARGBToUVJRow_Any_AVX2(const uint8* src_argb, int src_stride_argb,
+                           uint8* dst_u, uint8* dst_v, int width);
+void BGRAToUVRow_Any_AVX2(const uint8* src_bgra, int src_stride_bgra,
+                          uint8* dst_u, uint8* dst_v, int width);
+void ABGRToUVRow_Any_AVX2(const uint8* src_abgr, int src_stride_abgr,
+                          uint8* dst_u, uint8* dst_v, int width);
+void RGBAToUVRow_Any_AVX2(const uint8* src_rgba, int src_stride_rgba,
+                          uint8* dst_u, uint8* dst_v, int width);
+void RGB24ToUVRow_Any_AVX2(const uint8* src_rgb24, int src_stride_rgb24,
+                           uint8* dst_u, uint8* dst_v, int width);
+void RAWToUVRow_Any_AVX2(const uint8* src_raw, int src_stride_raw,
+                         uint8* dst_u, uint8* dst_v, int width);
 void ARGBToUVRow_SSSE3(const uint8* src_argb, int src_stride_argb,
                        uint8* dst_u, uint8* dst_v, int width);
 void ARGBToUVJRow_SSSE3(const uint8* src_argb, int src_stride_argb,
@@ -725,6 +848,83 @@ void ARGB1555ToUVRow_C(const uint8* src_argb1555, int src_stride_argb1555,
 void ARGB4444ToUVRow_C(const uint8* src_argb4444, int src_stride_argb4444,
                        uint8* dst_u, uint8* dst_v, int width);
 
+// Convert 2 rows to 2 rows of Y and 1 row of U and V.
+void ARGBToI420Row_SSSE3(const uint8* src_argb, int src_stride_argb,
+                         uint8* dst_y, int dst_stride_y,
+                         uint8* dst_u, uint8* dst_v, int width);
+void ARGBToJ420Row_SSSE3(const uint8* src_argb, int src_stride_argb,
+                         uint8* dst_y, int dst_stride_y,
+                         uint8* dst_u, uint8* dst_v, int width);
+void BGRAToI420Row_SSSE3(const uint8* src_bgra, int src_stride_bgra,
+                         uint8* dst_y, int dst_stride_y,
+                         uint8* dst_u, uint8* dst_v, int width);
+void ABGRToI420Row_SSSE3(const uint8* src_abgr, int src_stride_abgr,
+                         uint8* dst_y, int dst_stride_y,
+                         uint8* dst_u, uint8* dst_v, int width);
+void RGBAToI420Row_SSSE3(const uint8* src_rgba, int src_stride_rgba,
+                         uint8* dst_y, int dst_stride_y,
+                         uint8* dst_u, uint8* dst_v, int width);
+void ARGBToI420Row_AVX2(const uint8* src_argb, int src_stride_argb,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width);
+void ARGBToJ420Row_AVX2(const uint8* src_argb, int src_stride_argb,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width);
+void BGRAToI420Row_AVX2(const uint8* src_bgra, int src_stride_bgra,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width);
+void ABGRToI420Row_AVX2(const uint8* src_abgr, int src_stride_abgr,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width);
+void RGBAToI420Row_AVX2(const uint8* src_rgba, int src_stride_rgba,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width);
+void ARGBToI420Row_Any_SSSE3(const uint8* src_argb, int src_stride_argb,
+                             uint8* dst_y, int dst_stride_y,
+                             uint8* dst_u, uint8* dst_v, int width);
+void ARGBToJ420Row_Any_SSSE3(const uint8* src_argb, int src_stride_argb,
+                             uint8* dst_y, int dst_stride_y,
+                             uint8* dst_u, uint8* dst_v, int width);
+void BGRAToI420Row_Any_SSSE3(const uint8* src_bgra, int src_stride_bgra,
+                             uint8* dst_y, int dst_stride_y,
+                             uint8* dst_u, uint8* dst_v, int width);
+void ABGRToI420Row_Any_SSSE3(const uint8* src_abgr, int src_stride_abgr,
+                             uint8* dst_y, int dst_stride_y,
+                             uint8* dst_u, uint8* dst_v, int width);
+void RGBAToI420Row_Any_SSSE3(const uint8* src_rgba, int src_stride_rgba,
+                             uint8* dst_y, int dst_stride_y,
+                             uint8* dst_u, uint8* dst_v, int width);
+void ARGBToI420Row_Any_AVX2(const uint8* src_argb, int src_stride_argb,
+                            uint8* dst_y, int dst_stride_y,
+                            uint8* dst_u, uint8* dst_v, int width);
+void ARGBToJ420Row_Any_AVX2(const uint8* src_argb, int src_stride_argb,
+                            uint8* dst_y, int dst_stride_y,
+                            uint8* dst_u, uint8* dst_v, int width);
+void BGRAToI420Row_Any_AVX2(const uint8* src_bgra, int src_stride_bgra,
+                            uint8* dst_y, int dst_stride_y,
+                            uint8* dst_u, uint8* dst_v, int width);
+void ABGRToI420Row_Any_AVX2(const uint8* src_abgr, int src_stride_abgr,
+                            uint8* dst_y, int dst_stride_y,
+                            uint8* dst_u, uint8* dst_v, int width);
+void RGBAToI420Row_Any_AVX2(const uint8* src_rgba, int src_stride_rgba,
+                            uint8* dst_y, int dst_stride_y,
+                            uint8* dst_u, uint8* dst_v, int width);
+void ARGBToI420Row_C(const uint8* src_argb, int src_stride_argb,
+                     uint8* dst_y, int dst_stride_y,
+                     uint8* dst_u, uint8* dst_v, int width);
+void ARGBToJ420Row_C(const uint8* src_argb, int src_stride_argb,
+                     uint8* dst_y, int dst_stride_y,
+                     uint8* dst_u, uint8* dst_v, int width);
+void BGRAToI420Row_C(const uint8* src_bgra, int src_stride_bgra,
+                     uint8* dst_y, int dst_stride_y,
+                     uint8* dst_u, uint8* dst_v, int width);
+void ABGRToI420Row_C(const uint8* src_abgr, int src_stride_abgr,
+                     uint8* dst_y, int dst_stride_y,
+                     uint8* dst_u, uint8* dst_v, int width);
+void RGBAToI420Row_C(const uint8* src_rgba, int src_stride_rgba,
+                     uint8* dst_y, int dst_stride_y,
+                     uint8* dst_u, uint8* dst_v, int width);
+
 void ARGBToUV444Row_SSSE3(const uint8* src_argb,
                           uint8* dst_u, uint8* dst_v, int width);
 void ARGBToUV444Row_Any_SSSE3(const uint8* src_argb,
@@ -764,6 +964,13 @@ void MirrorUVRow_MIPS_DSPR2(const uint8* src_uv, uint8* dst_u, uint8* dst_v,
 void MirrorUVRow_C(const uint8* src_uv, uint8* dst_u, uint8* dst_v,
                    int width);
 
+// Mirror interleaved UV as pairs, keeping U before V.
+void MirrorNVUVRow_C(const uint8* src_uv, uint8* dst_uv, int width);
+void MirrorNVUVRow_SSE2(const uint8* src_uv, uint8* dst_uv, int width);
+void MirrorNVUVRow_AVX2(const uint8* src_uv, uint8* dst_uv, int width);
+void MirrorNVUVRow_Any_SSE2(const uint8* src_uv, uint8* dst_uv, int width);
+void MirrorNVUVRow_Any_AVX2(const uint8* src_uv, uint8* dst_uv, int width);
+
 void ARGBMirrorRow_AVX2(const uint8* src, uint8* dst, int width);
 void ARGBMirrorRow_SSE2(const uint8* src, uint8* dst, int width);
 void ARGBMirrorRow_NEON(const uint8* src, uint8* dst, int width);
@@ -805,10 +1012,12 @@ void MergeUVRow_Any_NEON(const uint8* src_u, const uint8* src_v, uint8* dst_uv,
 void CopyRow_SSE2(const uint8* src, uint8* dst, int count);
 void CopyRow_AVX(const uint8* src, uint8* dst, int count);
 void CopyRow_ERMS(const uint8* src, uint8* dst, int count);
+void CopyRow_NT_SSE2(const uint8* src, uint8* dst, int count);
 void CopyRow_NEON(const uint8* src, uint8* dst, int count);
 void CopyRow_MIPS(const uint8* src, uint8* dst, int count);
 void CopyRow_C(const uint8* src, uint8* dst, int count);
 void CopyRow_Any_SSE2(const uint8* src, uint8* dst, int count);
+void CopyRow_NT_Any_SSE2(const uint8* src, uint8* dst, int count);
 void CopyRow_Any_AVX(const uint8* src, uint8* dst, int count);
 void CopyRow_Any_NEON(const uint8* src, uint8* dst, int count);
 
@@ -1061,6 +1270,27 @@ void I422ToARGBRow_SSSE3(const uint8* src_y,
                          const uint8* src_v,
                          uint8* dst_argb,
                          int width);
+// Fast precision.  Results may be 1 off I422ToARGBRow_C.
+void I422ToARGBFastRow_SSSE3(const uint8* src_y,
+                             const uint8* src_u,
+                             const uint8* src_v,
+                             uint8* dst_argb,
+                             int width);
+void I422ToARGBFastRow_AVX2(const uint8* src_y,
+                            const uint8* src_u,
+                            const uint8* src_v,
+                            uint8* dst_argb,
+                            int width);
+void I422ToARGBFastRow_Any_SSSE3(const uint8* src_y,
+                                 const uint8* src_u,
+                                 const uint8* src_v,
+                                 uint8* dst_argb,
+                                 int width);
+void I422ToARGBFastRow_Any_AVX2(const uint8* src_y,
+                                const uint8* src_u,
+                                const uint8* src_v,
+                                uint8* dst_argb,
+                                int width);
 void I411ToARGBRow_SSSE3(const uint8* src_y,
                          const uint8* src_u,
                          const uint8* src_v,
@@ -1631,6 +1861,27 @@ void UYVYToUVRow_Any_NEON(const uint8* src_uyvy, int stride_uyvy,
 void UYVYToUV422Row_Any_NEON(const uint8* src_uyvy,
                              uint8* dst_u, uint8* dst_v, int pix);
 
+void YUY2ToNVUVRow_C(const uint8* src_yuy2, int stride_yuy2,
+                     uint8* dst_uv, int pix);
+void UYVYToNVUVRow_C(const uint8* src_uyvy, int stride_uyvy,
+                     uint8* dst_uv, int pix);
+void YUY2ToNVUVRow_SSE2(const uint8* src_yuy2, int stride_yuy2,
+                        uint8* dst_uv, int pix);
+void UYVYToNVUVRow_SSE2(const uint8* src_uyvy, int stride_uyvy,
+                        uint8* dst_uv, int pix);
+void YUY2ToNVUVRow_AVX2(const uint8* src_yuy2, int stride_yuy2,
+                        uint8* dst_uv, int pix);
+void UYVYToNVUVRow_AVX2(const uint8* src_uyvy, int stride_uyvy,
+                        uint8* dst_uv, int pix);
+void YUY2ToNVUVRow_Any_SSE2(const uint8* src_yuy2, int stride_yuy2,
+                            uint8* dst_uv, int pix);
+void UYVYToNVUVRow_Any_SSE2(const uint8* src_uyvy, int stride_uyvy,
+                            uint8* dst_uv, int pix);
+void YUY2ToNVUVRow_Any_AVX2(const uint8* src_yuy2, int stride_yuy2,
+                            uint8* dst_uv, int pix);
+void UYVYToNVUVRow_Any_AVX2(const uint8* src_uyvy, int stride_uyvy,
+                            uint8* dst_uv, int pix);
+
 void I422ToYUY2Row_C(const uint8* src_y,
                      const uint8* src_u,
                      const uint8* src_v,
@@ -1672,6 +1923,37 @@ void I422ToUYVYRow_Any_NEON(const uint8* src_y,
                             const uint8* src_v,
                             uint8* dst_uyvy, int width);
 
+void NV12ToYUY2Row_C(const uint8* src_y,
+                     const uint8* src_uv,
+                     uint8* dst_yuy2, int width);
+void NV12ToUYVYRow_C(const uint8* src_y,
+                     const uint8* src_uv,
+                     uint8* dst_uyvy, int width);
+void NV12ToYUY2Row_SSE2(const uint8* src_y,
+                        const uint8* src_uv,
+                        uint8* dst_yuy2, int width);
+void NV12ToUYVYRow_SSE2(const uint8* src_y,
+                        const uint8* src_uv,
+                        uint8* dst_uyvy, int width);
+void NV12ToYUY2Row_AVX2(const uint8* src_y,
+                        const uint8* src_uv,
+                        uint8* dst_yuy2, int width);
+void NV12ToUYVYRow_AVX2(const uint8* src_y,
+                        const uint8* src_uv,
+                        uint8* dst_uyvy, int width);
+void NV12ToYUY2Row_Any_SSE2(const uint8* src_y,
+                            const uint8* src_uv,
+                            uint8* dst_yuy2, int width);
+void NV12ToUYVYRow_Any_SSE2(const uint8* src_y,
+                            const uint8* src_uv,
+                            uint8* dst_uyvy, int width);
+void NV12ToYUY2Row_Any_AVX2(const uint8* src_y,
+                            const uint8* src_uv,
+                            uint8* dst_yuy2, int width);
+void NV12ToUYVYRow_Any_AVX2(const uint8* src_y,
+                            const uint8* src_uv,
+                            uint8* dst_uyvy, int width);
+
 // Effects related row functions.
 void ARGBAttenuateRow_C(const uint8* src_argb, uint8* dst_argb, int width);
 void ARGBAttenuateRow_SSE2(const uint8* src_argb, uint8* dst_argb, int width);
@@ -1788,6 +2070,18 @@ void InterpolateRow_Any_MIPS_DSPR2(uint8* dst_ptr, const uint8* src_ptr,
 void InterpolateRow_16_C(uint16* dst_ptr, const uint16* src_ptr,
                          ptrdiff_t src_stride_ptr,
                          int width, int source_y_fraction);
+void InterpolateRow_16_SSE2(uint16* dst_ptr, const uint16* src_ptr,
+                            ptrdiff_t src_stride_ptr, int width,
+                            int source_y_fraction);
+void InterpolateRow_16_AVX2(uint16* dst_ptr, const uint16* src_ptr,
+                            ptrdiff_t src_stride_ptr, int width,
+                            int source_y_fraction);
+void InterpolateRow_Any_16_SSE2(uint16* dst_ptr, const uint16* src_ptr,
+                                ptrdiff_t src_stride_ptr, int width,
+                                int source_y_fraction);
+void InterpolateRow_Any_16_AVX2(uint16* dst_ptr, const uint16* src_ptr,
+                                ptrdiff_t src_stride_ptr, int width,
+                                int source_y_fraction);
 
 // Sobel images.
 void SobelXRow_C(const uint8* src_y0, const uint8* src_y1, const uint8* src_y2,
@@ -1849,6 +2143,285 @@ void ARGBLumaColorTableRow_SSSE3(const uint8* src_argb, uint8* dst_argb,
                                  int width,
                                  const uint8* luma, uint32 lumacoeff);
 
+// Row functions picked once for the cpu flags, so that small images do not
+// pay for picking them on every call.  Each kernel has a function for any
+// width and one for widths that are a multiple of its alignment.
+struct RowFunctions {
+  int cpu_info;  // Cpu flags the table was built for.
+  int fast;  // Nonzero if built for kPrecisionFast.
+  void (*CopyRow)(const uint8* src, uint8* dst, int count);
+  void (*CopyRow_Any)(const uint8* src, uint8* dst, int count);
+  int CopyRow_align;
+  void (*SetRow)(uint8* dst, uint8 v8, int count);
+  void (*SetRow_Any)(uint8* dst, uint8 v8, int count);
+  int SetRow_align;
+  void (*MergeUVRow)(const uint8* src_u, const uint8* src_v, uint8* dst_uv,
+                     int width);
+  void (*MergeUVRow_Any)(const uint8* src_u, const uint8* src_v,
+                         uint8* dst_uv, int width);
+  int MergeUVRow_align;
+  void (*I422ToARGBRow)(const uint8* src_y, const uint8* src_u,
+                        const uint8* src_v, uint8* dst_argb, int width);
+  void (*I422ToARGBRow_Any)(const uint8* src_y, const uint8* src_u,
+                            const uint8* src_v, uint8* dst_argb, int width);
+  int I422ToARGBRow_align;
+  void (*NV12ToARGBRow)(const uint8* src_y, const uint8* src_uv,
+                        uint8* dst_argb, int width);
+  void (*NV12ToARGBRow_Any)(const uint8* src_y, const uint8* src_uv,
+                            uint8* dst_argb, int width);
+  int NV12ToARGBRow_align;
+  void (*ARGBToYRow)(const uint8* src_argb, uint8* dst_y, int pix);
+  void (*ARGBToYRow_Any)(const uint8* src_argb, uint8* dst_y, int pix);
+  int ARGBToYRow_align;
+  void (*ARGBToUVRow)(const uint8* src_argb, int src_stride_argb,
+                      uint8* dst_u, uint8* dst_v, int width);
+  void (*ARGBToUVRow_Any)(const uint8* src_argb, int src_stride_argb,
+                          uint8* dst_u, uint8* dst_v, int width);
+  int ARGBToUVRow_align;
+  // NULL if there is no fused row function for the cpu.
+  void (*ARGBToI420Row)(const uint8* src_argb, int src_stride_argb,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width);
+  void (*ARGBToI420Row_Any)(const uint8* src_argb, int src_stride_argb,
+                            uint8* dst_y, int dst_stride_y,
+                            uint8* dst_u, uint8* dst_v, int width);
+  int ARGBToI420Row_align;
+};
+
+// The complete table, or NULL if it is not built yet.
+LIBYUV_API extern const struct RowFunctions* volatile row_functions_;
+
+// Internal function to build and publish the table for the current cpu flags.
+const struct RowFunctions* InitRowFunctions(void);
+
+// The function from a table for a kernel at a width.
+#define ROW_TABLE_FUNCTION(table, name, width)                                 \
+    (IS_ALIGNED(width, (table)->name##_align) ? (table)->name :                \
+                                                (table)->name##_Any)
+
+// Sets a kernel in rows, the table being built.
+#define SET_ROW_FUNCTION(name, any, full, align)                               \
+    do {                                                                       \
+      rows->name##_Any = any;                                                  \
+      rows->name = full;                                                       \
+      rows->name##_align = align;                                              \
+    } while (0)
+
+// Sets the kernels of a table for the cpu flags, with the fast kernels if
+// fast is nonzero.  Same order of preference as the functions that picked
+// row functions on each call, so results do not change.  InitRowFunctions
+// builds the table with it, and in LIBYUV_TARGET builds, where TestCpuFlag
+// is a constant, ROW_FUNCTION runs it at compile time.
+static __inline void SetRowFunctions(struct RowFunctions* rows, int fast) {
+  rows->fast = fast;
+  SET_ROW_FUNCTION(CopyRow, CopyRow_C, CopyRow_C, 1);
+#if defined(HAS_COPYROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SET_ROW_FUNCTION(CopyRow, CopyRow_Any_SSE2, CopyRow_SSE2, 32);
+  }
+#endif
+#if defined(HAS_COPYROW_AVX)
+  if (TestCpuFlag(kCpuHasAVX)) {
+    SET_ROW_FUNCTION(CopyRow, CopyRow_Any_AVX, CopyRow_AVX, 64);
+  }
+#endif
+#if defined(HAS_COPYROW_ERMS)
+  if (TestCpuFlag(kCpuHasERMS)) {
+    SET_ROW_FUNCTION(CopyRow, CopyRow_ERMS, CopyRow_ERMS, 1);
+  }
+#endif
+#if defined(HAS_COPYROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SET_ROW_FUNCTION(CopyRow, CopyRow_Any_NEON, CopyRow_NEON, 32);
+  }
+#endif
+#if defined(HAS_COPYROW_MIPS)
+  if (TestCpuFlag(kCpuHasMIPS)) {
+    SET_ROW_FUNCTION(CopyRow, CopyRow_MIPS, CopyRow_MIPS, 1);
+  }
+#endif
+
+  SET_ROW_FUNCTION(SetRow, SetRow_C, SetRow_C, 1);
+#if defined(HAS_SETROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SET_ROW_FUNCTION(SetRow, SetRow_Any_NEON, SetRow_NEON, 16);
+  }
+#endif
+#if defined(HAS_SETROW_X86)
+  if (TestCpuFlag(kCpuHasX86)) {
+    SET_ROW_FUNCTION(SetRow, SetRow_Any_X86, SetRow_X86, 4);
+  }
+#endif
+#if defined(HAS_SETROW_ERMS)
+  if (TestCpuFlag(kCpuHasERMS)) {
+    SET_ROW_FUNCTION(SetRow, SetRow_ERMS, SetRow_ERMS, 1);
+  }
+#endif
+
+  SET_ROW_FUNCTION(MergeUVRow, MergeUVRow_C, MergeUVRow_C, 1);
+#if defined(HAS_MERGEUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SET_ROW_FUNCTION(MergeUVRow, MergeUVRow_Any_SSE2, MergeUVRow_SSE2, 16);
+  }
+#endif
+#if defined(HAS_MERGEUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SET_ROW_FUNCTION(MergeUVRow, MergeUVRow_Any_AVX2, MergeUVRow_AVX2, 32);
+  }
+#endif
+#if defined(HAS_MERGEUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SET_ROW_FUNCTION(MergeUVRow, MergeUVRow_Any_NEON, MergeUVRow_NEON, 16);
+  }
+#endif
+
+  SET_ROW_FUNCTION(I422ToARGBRow, I422ToARGBRow_C, I422ToARGBRow_C, 1);
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    SET_ROW_FUNCTION(I422ToARGBRow, I422ToARGBRow_Any_SSSE3,
+                     I422ToARGBRow_SSSE3, 8);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SET_ROW_FUNCTION(I422ToARGBRow, I422ToARGBRow_Any_AVX2,
+                     I422ToARGBRow_AVX2, 16);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SET_ROW_FUNCTION(I422ToARGBRow, I422ToARGBRow_Any_NEON,
+                     I422ToARGBRow_NEON, 8);
+  }
+#endif
+  if (fast) {
+#if defined(HAS_I422TOARGBFASTROW_SSSE3)
+    if (TestCpuFlag(kCpuHasSSSE3)) {
+      SET_ROW_FUNCTION(I422ToARGBRow, I422ToARGBFastRow_Any_SSSE3,
+                       I422ToARGBFastRow_SSSE3, 16);
+    }
+#endif
+#if defined(HAS_I422TOARGBFASTROW_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2)) {
+      SET_ROW_FUNCTION(I422ToARGBRow, I422ToARGBFastRow_Any_AVX2,
+                       I422ToARGBFastRow_AVX2, 32);
+    }
+#endif
+  }
+
+  SET_ROW_FUNCTION(NV12ToARGBRow, NV12ToARGBRow_C, NV12ToARGBRow_C, 1);
+#if defined(HAS_NV12TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    SET_ROW_FUNCTION(NV12ToARGBRow, NV12ToARGBRow_Any_SSSE3,
+                     NV12ToARGBRow_SSSE3, 8);
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SET_ROW_FUNCTION(NV12ToARGBRow, NV12ToARGBRow_Any_AVX2,
+                     NV12ToARGBRow_AVX2, 16);
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SET_ROW_FUNCTION(NV12ToARGBRow, NV12ToARGBRow_Any_NEON,
+                     NV12ToARGBRow_NEON, 8);
+  }
+#endif
+
+  SET_ROW_FUNCTION(ARGBToYRow, ARGBToYRow_C, ARGBToYRow_C, 1);
+  SET_ROW_FUNCTION(ARGBToUVRow, ARGBToUVRow_C, ARGBToUVRow_C, 1);
+#if defined(HAS_ARGBTOYROW_SSSE3) && defined(HAS_ARGBTOUVROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    SET_ROW_FUNCTION(ARGBToYRow, ARGBToYRow_Any_SSSE3, ARGBToYRow_SSSE3, 16);
+    SET_ROW_FUNCTION(ARGBToUVRow, ARGBToUVRow_Any_SSSE3, ARGBToUVRow_SSSE3,
+                     16);
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_AVX2) && defined(HAS_ARGBTOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SET_ROW_FUNCTION(ARGBToYRow, ARGBToYRow_Any_AVX2, ARGBToYRow_AVX2, 32);
+    SET_ROW_FUNCTION(ARGBToUVRow, ARGBToUVRow_Any_AVX2, ARGBToUVRow_AVX2, 32);
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SET_ROW_FUNCTION(ARGBToYRow, ARGBToYRow_Any_NEON, ARGBToYRow_NEON, 8);
+  }
+#endif
+#if defined(HAS_ARGBTOUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SET_ROW_FUNCTION(ARGBToUVRow, ARGBToUVRow_Any_NEON, ARGBToUVRow_NEON, 16);
+  }
+#endif
+
+  SET_ROW_FUNCTION(ARGBToI420Row, NULL, NULL, 1);
+#if defined(HAS_ARGBTOI420ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    SET_ROW_FUNCTION(ARGBToI420Row, ARGBToI420Row_Any_SSSE3,
+                     ARGBToI420Row_SSSE3, 16);
+  }
+#endif
+#if defined(HAS_ARGBTOI420ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SET_ROW_FUNCTION(ARGBToI420Row, ARGBToI420Row_Any_AVX2,
+                     ARGBToI420Row_AVX2, 32);
+  }
+#endif
+}
+
+#if !defined(LIBYUV_TARGET_FLAGS)
+// Returns the table, rebuilding it if the cpu flags changed since it was
+// built, such as by MaskCpuFlags.
+static __inline const struct RowFunctions* GetRowFunctions(void) {
+  LIBYUV_API extern int cpu_info_;
+  const struct RowFunctions* rows = row_functions_;
+  if (!rows || rows->cpu_info != cpu_info_) {
+    rows = InitRowFunctions();
+  }
+  return rows;
+}
+
+#define ROW_FUNCTION(table, name, width) ROW_TABLE_FUNCTION(table, name, width)
+#else
+// The cpu flags can not change, so the table is only rebuilt for precision.
+static __inline const struct RowFunctions* GetRowFunctions(void) {
+  const struct RowFunctions* rows = row_functions_;
+  if (!rows) {
+    rows = InitRowFunctions();
+  }
+  return rows;
+}
+
+// The kernels for the target cpu.  Only the precision is read from table,
+// which may be NULL for kernels that do not depend on it.  Everything else
+// is constant, so the compiler reduces ROW_FUNCTION to the choice between
+// the 2 kernels for the width.
+static __inline struct RowFunctions TargetRowFunctions(
+    const struct RowFunctions* table) {
+  struct RowFunctions rows;
+  rows.cpu_info = LIBYUV_TARGET_FLAGS;
+  SetRowFunctions(&rows, table ? table->fast : 0);
+  return rows;
+}
+
+#define ROW_FUNCTION(table, name, width)                                       \
+    (IS_ALIGNED(width, TargetRowFunctions(table).name##_align) ?               \
+         TargetRowFunctions(table).name :                                      \
+         TargetRowFunctions(table).name##_Any)
+#endif  // LIBYUV_TARGET_FLAGS
+
+// Returns the table for kernels that do not depend on the precision.  In
+// LIBYUV_TARGET builds those kernels are known at compile time, so this
+// returns NULL without building the table.
+static __inline const struct RowFunctions* GetCpuRowFunctions(void) {
+#if defined(LIBYUV_TARGET_FLAGS)
+  return NULL;
+#else
+  return GetRowFunctions();
+#endif
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
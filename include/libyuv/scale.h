@@ -73,6 +73,99 @@ int I420Scale_16(const uint16* src_y, int src_stride_y,
                  int dst_width, int dst_height,
                  enum FilterMode filtering);
 
+// Scales a YUV 4:2:2 image from the src width and height to the
+// dst width and height.  Chroma planes are half width, full height.
+LIBYUV_API
+int I422Scale(const uint8* src_y, int src_stride_y,
+              const uint8* src_u, int src_stride_u,
+              const uint8* src_v, int src_stride_v,
+              int src_width, int src_height,
+              uint8* dst_y, int dst_stride_y,
+              uint8* dst_u, int dst_stride_u,
+              uint8* dst_v, int dst_stride_v,
+              int dst_width, int dst_height,
+              enum FilterMode filtering);
+
+LIBYUV_API
+int I422Scale_16(const uint16* src_y, int src_stride_y,
+                 const uint16* src_u, int src_stride_u,
+                 const uint16* src_v, int src_stride_v,
+                 int src_width, int src_height,
+                 uint16* dst_y, int dst_stride_y,
+                 uint16* dst_u, int dst_stride_u,
+                 uint16* dst_v, int dst_stride_v,
+                 int dst_width, int dst_height,
+                 enum FilterMode filtering);
+
+// Scales a YUV 4:4:4 image from the src width and height to the
+// dst width and height.  Chroma planes are full size.
+LIBYUV_API
+int I444Scale(const uint8* src_y, int src_stride_y,
+              const uint8* src_u, int src_stride_u,
+              const uint8* src_v, int src_stride_v,
+              int src_width, int src_height,
+              uint8* dst_y, int dst_stride_y,
+              uint8* dst_u, int dst_stride_u,
+              uint8* dst_v, int dst_stride_v,
+              int dst_width, int dst_height,
+              enum FilterMode filtering);
+
+LIBYUV_API
+int I444Scale_16(const uint16* src_y, int src_stride_y,
+                 const uint16* src_u, int src_stride_u,
+                 const uint16* src_v, int src_stride_v,
+                 int src_width, int src_height,
+                 uint16* dst_y, int dst_stride_y,
+                 uint16* dst_u, int dst_stride_u,
+                 uint16* dst_v, int dst_stride_v,
+                 int dst_width, int dst_height,
+                 enum FilterMode filtering);
+
+// Scales a Y only (grey) image from the src width and height to the
+// dst width and height.
+LIBYUV_API
+int I400Scale(const uint8* src_y, int src_stride_y,
+              int src_width, int src_height,
+              uint8* dst_y, int dst_stride_y,
+              int dst_width, int dst_height,
+              enum FilterMode filtering);
+
+LIBYUV_API
+int I400Scale_16(const uint16* src_y, int src_stride_y,
+                 int src_width, int src_height,
+                 uint16* dst_y, int dst_stride_y,
+                 int dst_width, int dst_height,
+                 enum FilterMode filtering);
+
+// Scales a sub pixel rectangle of a plane to the dst width and height.
+// crop_x, crop_y, crop_width and crop_height are 16.16 fixed point source
+// coordinates. The rectangle must be at least 1 pixel and within the image.
+// Rectangles on whole pixels produce the same result as ScalePlane on that
+// part of the image. Otherwise kFilterBox is treated as kFilterBilinear.
+// Returns 0 if successful.
+LIBYUV_API
+int ScalePlaneCrop(const uint8* src, int src_stride,
+                   int src_width, int src_height,
+                   int crop_x, int crop_y, int crop_width, int crop_height,
+                   uint8* dst, int dst_stride,
+                   int dst_width, int dst_height,
+                   enum FilterMode filtering);
+
+// Scales a sub pixel rectangle of a YUV 4:2:0 image.
+// The crop rectangle is in luma 16.16 fixed point coordinates and must be at
+// least 2 pixels. Chroma uses half the rectangle without rounding to even.
+LIBYUV_API
+int I420ScaleCrop(const uint8* src_y, int src_stride_y,
+                  const uint8* src_u, int src_stride_u,
+                  const uint8* src_v, int src_stride_v,
+                  int src_width, int src_height,
+                  int crop_x, int crop_y, int crop_width, int crop_height,
+                  uint8* dst_y, int dst_stride_y,
+                  uint8* dst_u, int dst_stride_u,
+                  uint8* dst_v, int dst_stride_v,
+                  int dst_width, int dst_height,
+                  enum FilterMode filtering);
+
 #ifdef __cplusplus
 // Legacy API.  Deprecated.
 LIBYUV_API
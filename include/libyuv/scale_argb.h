@@ -26,6 +26,16 @@ int ARGBScale(const uint8* src_argb, int src_stride_argb,
               int dst_width, int dst_height,
               enum FilterMode filtering);
 
+// Scale in linear light.  Color channels are converted from sRGB to 16 bit
+// linear values before filtering and converted back afterwards, which
+// avoids darkening high contrast detail.  Alpha is filtered as is.
+LIBYUV_API
+int ARGBScaleLinearLight(const uint8* src_argb, int src_stride_argb,
+                         int src_width, int src_height,
+                         uint8* dst_argb, int dst_stride_argb,
+                         int dst_width, int dst_height,
+                         enum FilterMode filtering);
+
 // Clipped scale takes destination rectangle coordinates for clip values.
 LIBYUV_API
 int ARGBScaleClip(const uint8* src_argb, int src_stride_argb,
@@ -35,6 +45,17 @@ int ARGBScaleClip(const uint8* src_argb, int src_stride_argb,
                   int clip_x, int clip_y, int clip_width, int clip_height,
                   enum FilterMode filtering);
 
+// Scale a sub pixel source rectangle to the destination.
+// crop_x, crop_y, crop_width and crop_height are 16.16 fixed point source
+// coordinates. The rectangle must be at least 1 pixel and within the image.
+LIBYUV_API
+int ARGBScaleCrop(const uint8* src_argb, int src_stride_argb,
+                  int src_width, int src_height,
+                  int crop_x, int crop_y, int crop_width, int crop_height,
+                  uint8* dst_argb, int dst_stride_argb,
+                  int dst_width, int dst_height,
+                  enum FilterMode filtering);
+
 // TODO(fbarchard): Implement this.
 // Scale with YUV conversion to ARGB and clipping.
 LIBYUV_API
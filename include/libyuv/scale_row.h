@@ -12,6 +12,7 @@
 #define INCLUDE_LIBYUV_SCALE_ROW_H_
 
 #include "libyuv/basic_types.h"
+#include "libyuv/row.h"  // For GCC_HAS_AVX2 and CLANG_HAS_AVX2.
 #include "libyuv/scale.h"
 
 #ifdef __cplusplus
@@ -48,6 +49,28 @@ extern "C" {
 #define HAS_SCALEROWDOWN4_SSE2
 #endif
 
+// The following are available on x86 GCC and clang:
+#if !defined(LIBYUV_DISABLE_X86) && (defined(__x86_64__) || defined(__i386__))
+#define HAS_SCALEADDROW_16_SSE2
+#define HAS_SCALEARGBFILTERCOLS_16_SSE2
+#define HAS_SCALEARGBFILTERCOLSTABLE_SSSE3
+#define HAS_SCALECOLS_16_SSE2
+#define HAS_SCALEFILTERCOLSTABLE_SSSE3
+#define HAS_SCALEROWDOWN2_16_SSE2
+#define HAS_SCALEROWDOWN4_16_SSE2
+#define HAS_SCALEROWUP2_BILINEAR_SSE2
+#endif
+
+// The following are available on x86 GCC and clang with AVX2:
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+#define HAS_SCALEARGBFILTERCOLSTABLE_AVX2
+#define HAS_SCALEARGBROWFROMLINEAR_AVX2
+#define HAS_SCALEARGBROWTOLINEAR_AVX2
+#define HAS_SCALEROWUP2_BILINEAR_AVX2
+#endif
+
 // The following are available on VS2012:
 #if !defined(LIBYUV_DISABLE_X86) && defined(VISUALC_HAS_AVX2)
 #define HAS_SCALEADDROW_AVX2
@@ -122,6 +145,12 @@ void ScaleSlope(int src_width, int src_height,
                 int dst_width, int dst_height,
                 enum FilterMode filtering,
                 int* x, int* y, int* dx, int* dy);
+// Compute slope values for stepping over a source rectangle with 16.16 fixed
+// point position and size.
+void ScaleSlopeRect(int src_x, int src_y, int src_width, int src_height,
+                    int dst_width, int dst_height,
+                    enum FilterMode filtering,
+                    int* x, int* y, int* dx, int* dy);
 
 void ScaleRowDown2_C(const uint8* src_ptr, ptrdiff_t src_stride,
                      uint8* dst, int dst_width);
@@ -161,6 +190,12 @@ void ScaleCols_16_C(uint16* dst_ptr, const uint16* src_ptr,
                     int dst_width, int x, int dx);
 void ScaleColsUp2_C(uint8* dst_ptr, const uint8* src_ptr,
                     int dst_width, int, int);
+// Doubles the width of a row, filtering 3/4 of the nearer and 1/4 of the
+// farther pixel across and 3/4 of the row at src_ptr and 1/4 of the row at
+// src_ptr + src_stride down.  A src_stride of 0 filters across only.
+// dst_width is even.  Reads dst_width / 2 + 1 pixels of each row.
+void ScaleRowUp2_Bilinear_C(const uint8* src_ptr, ptrdiff_t src_stride,
+                            uint8* dst_ptr, int dst_width);
 void ScaleColsUp2_16_C(uint16* dst_ptr, const uint16* src_ptr,
                        int dst_width, int, int);
 void ScaleFilterCols_C(uint8* dst_ptr, const uint8* src_ptr,
@@ -212,6 +247,26 @@ void ScaleARGBFilterCols_C(uint8* dst_argb, const uint8* src_argb,
                            int dst_width, int x, int dx);
 void ScaleARGBFilterCols64_C(uint8* dst_argb, const uint8* src_argb,
                              int dst_width, int x, int dx);
+void ScaleARGBFilterCols_16_C(uint16* dst_argb, const uint16* src_argb,
+                              int dst_width, int x, int dx);
+
+// Column filtering with precomputed source offsets and weights.
+void ScaleFilterColsSetup_C(int* offsets, uint8* weights,
+                            int dst_width, int x, int dx);
+void ScaleFilterColsTable_C(uint8* dst_ptr, const uint8* src_ptr,
+                            int dst_width, const int* offsets,
+                            const uint8* weights);
+void ScaleARGBFilterColsTable_C(uint8* dst_argb, const uint8* src_argb,
+                                int dst_width, const int* offsets,
+                                const uint8* weights);
+
+// Linear light conversion used by ARGBScaleLinearLight.
+extern const uint32 kSRGBToLinear[256];
+void ScaleARGBRowToLinear_C(const uint8* src_argb, uint16* dst_argb,
+                            int width);
+void ScaleARGBRowFromLinear_C(const uint16* src_argb, uint8* dst_argb,
+                              const uint8* table, int width);
+void ScaleARGBLinearTable_C(uint8* table);
 
 // Specialized scalers for x86.
 void ScaleRowDown2_SSE2(const uint8* src_ptr, ptrdiff_t src_stride,
@@ -271,6 +326,26 @@ void ScaleRowDown4_Any_AVX2(const uint8* src_ptr, ptrdiff_t src_stride,
                             uint8* dst_ptr, int dst_width);
 void ScaleRowDown4Box_Any_AVX2(const uint8* src_ptr, ptrdiff_t src_stride,
                                uint8* dst_ptr, int dst_width);
+void ScaleRowUp2_Bilinear_SSE2(const uint8* src_ptr, ptrdiff_t src_stride,
+                               uint8* dst_ptr, int dst_width);
+void ScaleRowUp2_Bilinear_Any_SSE2(const uint8* src_ptr, ptrdiff_t src_stride,
+                                   uint8* dst_ptr, int dst_width);
+void ScaleRowUp2_Bilinear_AVX2(const uint8* src_ptr, ptrdiff_t src_stride,
+                               uint8* dst_ptr, int dst_width);
+void ScaleRowUp2_Bilinear_Any_AVX2(const uint8* src_ptr, ptrdiff_t src_stride,
+                                   uint8* dst_ptr, int dst_width);
+
+// The AVX2 versions gather blue, green and red from the tables.
+// ScaleARGBRowFromLinear_AVX2 reads 4 bytes at each entry it looks up, so its
+// table must be readable 3 bytes past the end.
+void ScaleARGBRowToLinear_AVX2(const uint8* src_argb, uint16* dst_argb,
+                               int width);
+void ScaleARGBRowToLinear_Any_AVX2(const uint8* src_argb, uint16* dst_argb,
+                                   int width);
+void ScaleARGBRowFromLinear_AVX2(const uint16* src_argb, uint8* dst_argb,
+                                 const uint8* table, int width);
+void ScaleARGBRowFromLinear_Any_AVX2(const uint16* src_argb, uint8* dst_argb,
+                                     const uint8* table, int width);
 
 void ScaleRowDown34_Any_SSSE3(const uint8* src_ptr, ptrdiff_t src_stride,
                               uint8* dst_ptr, int dst_width);
@@ -298,6 +373,41 @@ void ScaleFilterCols_SSSE3(uint8* dst_ptr, const uint8* src_ptr,
                            int dst_width, int x, int dx);
 void ScaleColsUp2_SSE2(uint8* dst_ptr, const uint8* src_ptr,
                        int dst_width, int x, int dx);
+void ScaleFilterColsTable_SSSE3(uint8* dst_ptr, const uint8* src_ptr,
+                                int dst_width, const int* offsets,
+                                const uint8* weights);
+void ScaleFilterColsTable_Any_SSSE3(uint8* dst_ptr, const uint8* src_ptr,
+                                    int dst_width, const int* offsets,
+                                    const uint8* weights);
+
+// 16 bit scalers for x86.
+void ScaleRowDown2_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                           uint16* dst_ptr, int dst_width);
+void ScaleRowDown2Linear_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                                 uint16* dst_ptr, int dst_width);
+void ScaleRowDown2Box_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                              uint16* dst_ptr, int dst_width);
+void ScaleRowDown4_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                           uint16* dst_ptr, int dst_width);
+void ScaleRowDown4Box_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                              uint16* dst_ptr, int dst_width);
+void ScaleRowDown2_Any_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                               uint16* dst_ptr, int dst_width);
+void ScaleRowDown2Linear_Any_16_SSE2(const uint16* src_ptr,
+                                     ptrdiff_t src_stride,
+                                     uint16* dst_ptr, int dst_width);
+void ScaleRowDown2Box_Any_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                                  uint16* dst_ptr, int dst_width);
+void ScaleRowDown4_Any_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                               uint16* dst_ptr, int dst_width);
+void ScaleRowDown4Box_Any_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                                  uint16* dst_ptr, int dst_width);
+void ScaleAddRow_16_SSE2(const uint16* src_ptr, uint32* dst_ptr,
+                         int src_width);
+void ScaleAddRow_Any_16_SSE2(const uint16* src_ptr, uint32* dst_ptr,
+                             int src_width);
+void ScaleColsUp2_16_SSE2(uint16* dst_ptr, const uint16* src_ptr,
+                          int dst_width, int x, int dx);
 
 
 // ARGB Column functions
@@ -305,8 +415,24 @@ void ScaleARGBCols_SSE2(uint8* dst_argb, const uint8* src_argb,
                         int dst_width, int x, int dx);
 void ScaleARGBFilterCols_SSSE3(uint8* dst_argb, const uint8* src_argb,
                                int dst_width, int x, int dx);
+void ScaleARGBFilterCols_16_SSE2(uint16* dst_argb, const uint16* src_argb,
+                                 int dst_width, int x, int dx);
 void ScaleARGBColsUp2_SSE2(uint8* dst_argb, const uint8* src_argb,
                            int dst_width, int x, int dx);
+void ScaleARGBFilterColsTable_SSSE3(uint8* dst_argb, const uint8* src_argb,
+                                    int dst_width, const int* offsets,
+                                    const uint8* weights);
+void ScaleARGBFilterColsTable_AVX2(uint8* dst_argb, const uint8* src_argb,
+                                   int dst_width, const int* offsets,
+                                   const uint8* weights);
+void ScaleARGBFilterColsTable_Any_SSSE3(uint8* dst_argb,
+                                        const uint8* src_argb,
+                                        int dst_width, const int* offsets,
+                                        const uint8* weights);
+void ScaleARGBFilterColsTable_Any_AVX2(uint8* dst_argb,
+                                       const uint8* src_argb,
+                                       int dst_width, const int* offsets,
+                                       const uint8* weights);
 void ScaleARGBFilterCols_NEON(uint8* dst_argb, const uint8* src_argb,
                               int dst_width, int x, int dx);
 void ScaleARGBCols_NEON(uint8* dst_argb, const uint8* src_argb,
@@ -0,0 +1,44 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_SCRATCH_H_  // NOLINT
+#define INCLUDE_LIBYUV_SCRATCH_H_
+
+#include <stddef.h>  // For size_t.
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Set the scratch arena for the calling thread.
+// Functions that need temporary rows, such as RGB565ToI420, I420Scale with
+// filtering and ARGBSobel, take them from "buffer" instead of calling
+// malloc, so converting frames in steady state does not use the heap.
+// Requests that do not fit fall back to malloc.
+// The arena is per thread and must stay valid until it is replaced or
+// cleared by passing NULL.  Do not change it while a conversion is running.
+LIBYUV_API
+void SetScratchArena(uint8* buffer, size_t size);
+
+// Returns the most scratch memory used at once on the calling thread since
+// the arena was set, including requests that fell back to malloc.
+// Convert a frame with a large arena and use this to size the arena.
+LIBYUV_API
+size_t GetScratchArenaPeak(void);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_SCRATCH_H_  NOLINT
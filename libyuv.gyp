@@ -23,6 +23,9 @@
     'chromium_code': 1,
     # Link-Time Optimizations.
     'use_lto%': 0,
+    # Cpu to build for without runtime cpu detection, such as 'avx2'.
+    # One of c, sse2, ssse3, avx2 or neon.  Empty detects the cpu at runtime.
+    'libyuv_target%': '',
     'build_neon': 0,
     'conditions': [
        ['(target_arch == "armv7" or target_arch == "armv7s" or \
@@ -138,6 +141,39 @@
             'LIBYUV_DISABLE_X86',
           ],
         }],
+        ['libyuv_target == "c"', {
+          'defines': [ 'LIBYUV_TARGET_C' ],
+          'direct_dependent_settings': {
+            'defines': [ 'LIBYUV_TARGET_C' ],
+          },
+        }],
+        ['libyuv_target == "sse2"', {
+          'defines': [ 'LIBYUV_TARGET_SSE2' ],
+          'cflags': [ '-msse2' ],
+          'direct_dependent_settings': {
+            'defines': [ 'LIBYUV_TARGET_SSE2' ],
+          },
+        }],
+        ['libyuv_target == "ssse3"', {
+          'defines': [ 'LIBYUV_TARGET_SSSE3' ],
+          'cflags': [ '-mssse3' ],
+          'direct_dependent_settings': {
+            'defines': [ 'LIBYUV_TARGET_SSSE3' ],
+          },
+        }],
+        ['libyuv_target == "avx2"', {
+          'defines': [ 'LIBYUV_TARGET_AVX2' ],
+          'cflags': [ '-mavx2' ],
+          'direct_dependent_settings': {
+            'defines': [ 'LIBYUV_TARGET_AVX2' ],
+          },
+        }],
+        ['libyuv_target == "neon"', {
+          'defines': [ 'LIBYUV_TARGET_NEON' ],
+          'direct_dependent_settings': {
+            'defines': [ 'LIBYUV_TARGET_NEON' ],
+          },
+        }],
       ], #conditions
       'defines': [
         # Enable the following 3 macros to turn off assembly for specified CPU.
@@ -146,6 +182,8 @@
         # 'LIBYUV_DISABLE_MIPS',
         # Enable the following macro to build libyuv as a shared library (dll).
         # 'LIBYUV_USING_SHARED_LIBRARY',
+        # Enable the following macro to count calls and time of hot functions.
+        # 'LIBYUV_PROFILE',
         # TODO(fbarchard): Make these into gyp defines.
       ],
       'include_dirs': [
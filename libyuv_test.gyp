@@ -34,18 +34,24 @@
         'unit_test/unit_test.h',
 
         # sources
+        'unit_test/autotune_test.cc',
         'unit_test/basictypes_test.cc',
+        'unit_test/batch_test.cc',
         'unit_test/compare_test.cc',
         'unit_test/color_test.cc',
         'unit_test/convert_test.cc',
         'unit_test/cpu_test.cc',
+        'unit_test/dispatch_test.cc',
+        'unit_test/frame_buffer_pool_test.cc',
         'unit_test/math_test.cc',
         'unit_test/planar_test.cc',
+        'unit_test/profile_test.cc',
         'unit_test/rotate_argb_test.cc',
         'unit_test/rotate_test.cc',
         'unit_test/scale_argb_test.cc',
         'unit_test/scale_color_test.cc',
         'unit_test/scale_test.cc',
+        'unit_test/scratch_test.cc',
         'unit_test/unit_test.cc',
         'unit_test/video_common_test.cc',
         'unit_test/version_test.cc',
@@ -126,6 +132,17 @@
         }],
       ], # conditions
     },
+    {
+      'target_name': 'yuvbench',
+      'type': 'executable',
+      'dependencies': [
+        'libyuv.gyp:libyuv',
+      ],
+      'sources': [
+        # sources
+        'util/yuvbench.cc',
+      ],
+    },
     # TODO(fbarchard): Enable SSE2 and OpenMP for better performance.
     {
       'target_name': 'psnr',
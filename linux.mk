@@ -6,6 +6,8 @@ CXXFLAGS?=-O2 -fomit-frame-pointer
 CXXFLAGS+=-Iinclude/
 
 LOCAL_OBJ_FILES := \
+    source/autotune.o          \
+    source/batch.o             \
     source/compare.o           \
     source/compare_common.o    \
     source/compare_gcc.o       \
@@ -13,15 +15,20 @@ LOCAL_OBJ_FILES := \
     source/convert_argb.o      \
     source/convert_from.o      \
     source/convert_from_argb.o \
+    source/convert_frame.o     \
     source/convert_to_argb.o   \
     source/convert_to_i420.o   \
     source/cpu_id.o            \
+    source/dispatch.o          \
+    source/frame_buffer_pool.o \
     source/planar_functions.o  \
+    source/profile.o           \
     source/rotate.o            \
     source/rotate_argb.o       \
     source/rotate_mips.o       \
     source/row_any.o           \
     source/row_common.o        \
+    source/row_functions.o     \
     source/row_mips.o          \
     source/row_gcc.o           \
     source/scale.o             \
@@ -30,12 +37,13 @@ LOCAL_OBJ_FILES := \
     source/scale_common.o      \
     source/scale_gcc.o         \
     source/scale_mips.o        \
+    source/scratch.o           \
     source/video_common.o
 
 .cc.o:
 	$(CXX) -c $(CXXFLAGS) $*.cc -o $*.o
 
-all: libyuv.a convert
+all: libyuv.a convert yuvbench
 
 libyuv.a: $(LOCAL_OBJ_FILES)
 	$(AR) $(ARFLAGS) $@ $(LOCAL_OBJ_FILES)
@@ -44,6 +52,10 @@ libyuv.a: $(LOCAL_OBJ_FILES)
 convert: util/convert.cc libyuv.a
 	$(CXX) $(CXXFLAGS) -Iutil/ -o $@ util/convert.cc libyuv.a
 
+# A benchmark of libyuv functions.
+yuvbench: util/yuvbench.cc libyuv.a
+	$(CXX) $(CXXFLAGS) -o $@ util/yuvbench.cc libyuv.a
+
 clean:
-	/bin/rm -f source/*.o *.ii *.s libyuv.a convert
+	/bin/rm -f source/*.o *.ii *.s libyuv.a convert yuvbench
 
@@ -0,0 +1,209 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/autotune.h"
+
+#include <stdio.h>  // For fopen.
+#include <stdlib.h>  // For malloc.
+#include <string.h>  // For memset.
+
+#include "libyuv/cpu_id.h"
+#include "libyuv/profile.h"  // For ProfileNanoseconds.
+#include "libyuv/row.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+#define kAutotuneBuckets 4
+// Widths above this are timed at this width.
+#define kAutotuneMaxWidth 4096
+// Each candidate is timed this many times, over about this many pixels, and
+// the fastest time counts.
+#define kAutotuneTrials 5
+#define kAutotunePixels (256 * 1024)
+
+static const char* const kAutotuneKernelNames[kAutotuneKernelCount] = {
+  "CopyRow",
+  "SetRow",
+  "TransposeWx8",
+  "I422ToARGBRow",
+};
+
+LIBYUV_API
+int autotune_enabled_ = 0;
+
+// Candidate for each kernel and width bucket, or -1 if not tuned.  Threads
+// that tune the same entry at once each store a good choice.
+static int autotune_table[kAutotuneKernelCount][kAutotuneBuckets] = {
+  { -1, -1, -1, -1 },
+  { -1, -1, -1, -1 },
+  { -1, -1, -1, -1 },
+  { -1, -1, -1, -1 },
+};
+
+static int AutotuneBucket(int width) {
+  if (width <= 320) {
+    return 0;
+  }
+  if (width <= 1280) {
+    return 1;
+  }
+  if (width <= 3840) {
+    return 2;
+  }
+  return 3;
+}
+
+// Cpu features the table was tuned for.
+static int AutotuneCpuFlags(void) {
+  return TestCpuFlag(-1) & ~kCpuInit;
+}
+
+LIBYUV_API
+void SetAutotuneEnabled(LIBYUV_BOOL enable) {
+  autotune_enabled_ = enable ? 1 : 0;
+}
+
+LIBYUV_API
+int GetAutotuneChoice(enum AutotuneKernel kernel, int width) {
+  if ((int)(kernel) < 0 || kernel >= kAutotuneKernelCount) {
+    return -1;
+  }
+  return autotune_table[kernel][AutotuneBucket(width)];
+}
+
+LIBYUV_API
+void ResetAutotuneTable(void) {
+  memset(autotune_table, -1, sizeof(autotune_table));
+}
+
+LIBYUV_API
+int SaveAutotuneTable(const char* filename) {
+  int kernel;
+  int bucket;
+  FILE* f = fopen(filename, "w");
+  if (!f) {
+    return -1;
+  }
+  fprintf(f, "libyuv autotune 1\ncpu %d\n", AutotuneCpuFlags());
+  for (kernel = 0; kernel < kAutotuneKernelCount; ++kernel) {
+    for (bucket = 0; bucket < kAutotuneBuckets; ++bucket) {
+      if (autotune_table[kernel][bucket] >= 0) {
+        fprintf(f, "%s %d %d\n", kAutotuneKernelNames[kernel], bucket,
+                autotune_table[kernel][bucket]);
+      }
+    }
+  }
+  return fclose(f) ? -1 : 0;
+}
+
+LIBYUV_API
+int LoadAutotuneTable(const char* filename) {
+  int table[kAutotuneKernelCount][kAutotuneBuckets];
+  char name[32];
+  int version = 0;
+  int cpu_flags = 0;
+  int bucket;
+  int choice;
+  int kernel;
+  FILE* f = fopen(filename, "r");
+  if (!f) {
+    return -1;
+  }
+  if (fscanf(f, "libyuv autotune %d cpu %d", &version, &cpu_flags) != 2 ||
+      version != 1 || cpu_flags != AutotuneCpuFlags()) {
+    fclose(f);
+    return -1;
+  }
+  memset(table, -1, sizeof(table));
+  while (fscanf(f, "%31s %d %d", name, &bucket, &choice) == 3) {
+    for (kernel = 0; kernel < kAutotuneKernelCount; ++kernel) {
+      if (!strcmp(name, kAutotuneKernelNames[kernel])) {
+        break;
+      }
+    }
+    if (kernel == kAutotuneKernelCount || bucket < 0 ||
+        bucket >= kAutotuneBuckets || choice < 0 || choice >= 31) {
+      fclose(f);
+      return -1;
+    }
+    table[kernel][bucket] = choice;
+  }
+  fclose(f);
+  memcpy(autotune_table, table, sizeof(table));
+  return 0;
+}
+
+// Returns the fastest time in nanoseconds to run a candidate over about
+// kAutotunePixels.
+static uint64 TimeCandidate(AutotuneRunFunction run, int candidate,
+                            const uint8* src, uint8* dst, int width) {
+  int repeat = kAutotunePixels / width + 1;
+  uint64 best = 0;
+  int trial;
+  int i;
+  run(candidate, src, dst, width);  // Warm up.
+  for (trial = 0; trial < kAutotuneTrials; ++trial) {
+    uint64 start = ProfileNanoseconds();
+    uint64 elapsed;
+    for (i = 0; i < repeat; ++i) {
+      run(candidate, src, dst, width);
+    }
+    elapsed = ProfileNanoseconds() - start;
+    if (trial == 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+int AutotuneSelect(enum AutotuneKernel kernel, int width, int available,
+                   AutotuneRunFunction run) {
+  int bucket = AutotuneBucket(width);
+  int choice = autotune_table[kernel][bucket];
+  uint64 best_time = 0;
+  int tune_width;
+  int candidate;
+  uint8* buffer;
+  if (choice >= 0) {
+    return (available & (1 << choice)) ? choice : -1;
+  }
+  if (!(available & (available - 1))) {
+    return -1;  // Nothing to choose between.
+  }
+  tune_width = width < kAutotuneMaxWidth ? width : kAutotuneMaxWidth;
+  buffer = (uint8*)(malloc(tune_width * 64 + 64));
+  if (!buffer) {
+    return -1;
+  }
+  memset(buffer, 128, tune_width * 64 + 64);
+  for (candidate = 0; candidate < 31; ++candidate) {
+    uint64 time;
+    if (!(available & (1 << candidate))) {
+      continue;
+    }
+    time = TimeCandidate(run, candidate, buffer, buffer + tune_width * 32 + 64,
+                         tune_width);
+    if (choice < 0 || time < best_time) {
+      choice = candidate;
+      best_time = time;
+    }
+  }
+  free(buffer);
+  autotune_table[kernel][bucket] = choice;
+  return choice;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
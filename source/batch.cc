@@ -0,0 +1,151 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/batch.h"
+
+#include <stdlib.h>  // For malloc.
+
+#if defined(_MSC_VER)
+#include <intrin.h>  // For _InterlockedExchangeAdd.
+#endif
+
+#include "libyuv/row.h"
+#include "libyuv/scale_argb.h"
+#include "libyuv/scratch.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Largest scratch arena a batch allocates.  Larger requests use malloc.
+#define kBatchMaxScratch (4 * 1024 * 1024)
+
+// Returns the index of the next frame for this call to convert, or count if
+// there are none left.
+static int NextBatchFrame(int* next_frame, int* index, int count) {
+  if (!next_frame) {
+    return (*index)++;
+  }
+  if (*index >= count) {
+    return count;
+  }
+#if defined(_MSC_VER)
+  *index = _InterlockedExchangeAdd((long volatile*)(next_frame), 1);
+#else
+  *index = __sync_fetch_and_add(next_frame, 1);
+#endif
+  return *index < count ? *index : count;
+}
+
+static int I420ToARGBBatchFrame(const struct RowFunctions* rows,
+                                const struct I420ToARGBFrame* frame) {
+  const uint8* src_y = frame->src_y;
+  const uint8* src_u = frame->src_u;
+  const uint8* src_v = frame->src_v;
+  uint8* dst_argb = frame->dst_argb;
+  int dst_stride_argb = frame->dst_stride_argb;
+  int width = frame->width;
+  int height = frame->height;
+  int y;
+  void (*I422ToARGBRow)(const uint8* y_buf,
+                        const uint8* u_buf,
+                        const uint8* v_buf,
+                        uint8* rgb_buf,
+                        int width);
+  if (!src_y || !src_u || !src_v || !dst_argb ||
+      width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_argb = dst_argb + (height - 1) * dst_stride_argb;
+    dst_stride_argb = -dst_stride_argb;
+  }
+  I422ToARGBRow = ROW_FUNCTION(rows, I422ToARGBRow, width);
+  for (y = 0; y < height; ++y) {
+    I422ToARGBRow(src_y, src_u, src_v, dst_argb, width);
+    dst_argb += dst_stride_argb;
+    src_y += frame->src_stride_y;
+    if (y & 1) {
+      src_u += frame->src_stride_u;
+      src_v += frame->src_stride_v;
+    }
+  }
+  return 0;
+}
+
+LIBYUV_API
+int I420ToARGBBatch(struct I420ToARGBFrame* frames, int count,
+                    int* next_frame) {
+  const struct RowFunctions* rows = GetRowFunctions();
+  int result = 0;
+  int index = 0;
+  int i;
+  if (!frames || count < 0) {
+    return -1;
+  }
+  while ((i = NextBatchFrame(next_frame, &index, count)) < count) {
+    frames[i].result = I420ToARGBBatchFrame(rows, &frames[i]);
+    result |= frames[i].result;
+  }
+  return result ? -1 : 0;
+}
+
+LIBYUV_API
+int ARGBScaleBatch(struct ARGBScaleFrame* frames, int count,
+                   enum FilterMode filtering, int* next_frame) {
+  uint8* arena = NULL;
+  int result = 0;
+  int index = 0;
+  int i;
+  if (!frames || count < 0) {
+    return -1;
+  }
+  if (!HasScratchArena()) {
+    // Filtering keeps a few rows of the wider of source and destination, so
+    // size the arena for the widest frame.
+    size_t size = 0;
+    for (i = 0; i < count; ++i) {
+      int width = frames[i].src_width > frames[i].dst_width ?
+          frames[i].src_width : frames[i].dst_width;
+      size_t frame_size = (size_t)(width < 0 ? -width : width) * 4 * 4 + 4096;
+      if (frame_size > size) {
+        size = frame_size;
+      }
+    }
+    if (size > kBatchMaxScratch) {
+      size = kBatchMaxScratch;
+    }
+    arena = (uint8*)(malloc(size));
+    if (arena) {
+      SetScratchArena(arena, size);
+    }
+  }
+  while ((i = NextBatchFrame(next_frame, &index, count)) < count) {
+    frames[i].result = ARGBScale(frames[i].src_argb, frames[i].src_stride_argb,
+                                 frames[i].src_width, frames[i].src_height,
+                                 frames[i].dst_argb, frames[i].dst_stride_argb,
+                                 frames[i].dst_width, frames[i].dst_height,
+                                 filtering);
+    result |= frames[i].result;
+  }
+  if (arena) {
+    SetScratchArena(NULL, 0);
+    free(arena);
+  }
+  return result ? -1 : 0;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
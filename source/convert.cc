@@ -12,7 +12,9 @@
 
 #include "libyuv/basic_types.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/dispatch.h"
 #include "libyuv/planar_functions.h"
+#include "libyuv/profile.h"
 #include "libyuv/rotate.h"
 #include "libyuv/scale.h"  // For ScalePlane()
 #include "libyuv/row.h"
@@ -511,70 +513,207 @@ int UYVYToI420(const uint8* src_uyvy, int src_stride_uyvy,
   return 0;
 }
 
-// Convert ARGB to I420.
+// Convert YUY2 to NV12.
 LIBYUV_API
-int ARGBToI420(const uint8* src_argb, int src_stride_argb,
+int YUY2ToNV12(const uint8* src_yuy2, int src_stride_yuy2,
                uint8* dst_y, int dst_stride_y,
-               uint8* dst_u, int dst_stride_u,
-               uint8* dst_v, int dst_stride_v,
+               uint8* dst_uv, int dst_stride_uv,
                int width, int height) {
   int y;
-  void (*ARGBToUVRow)(const uint8* src_argb0, int src_stride_argb,
-      uint8* dst_u, uint8* dst_v, int width) = ARGBToUVRow_C;
-  void (*ARGBToYRow)(const uint8* src_argb, uint8* dst_y, int pix) =
-      ARGBToYRow_C;
-  if (!src_argb ||
-      !dst_y || !dst_u || !dst_v ||
+  void (*YUY2ToNVUVRow)(const uint8* src_yuy2, int src_stride_yuy2,
+      uint8* dst_uv, int pix) = YUY2ToNVUVRow_C;
+  void (*YUY2ToYRow)(const uint8* src_yuy2,
+      uint8* dst_y, int pix) = YUY2ToYRow_C;
+  if (!src_yuy2 || !dst_y || !dst_uv ||
       width <= 0 || height == 0) {
     return -1;
   }
   // Negative height means invert the image.
   if (height < 0) {
     height = -height;
-    src_argb = src_argb + (height - 1) * src_stride_argb;
-    src_stride_argb = -src_stride_argb;
+    src_yuy2 = src_yuy2 + (height - 1) * src_stride_yuy2;
+    src_stride_yuy2 = -src_stride_yuy2;
   }
-#if defined(HAS_ARGBTOYROW_SSSE3) && defined(HAS_ARGBTOUVROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    ARGBToUVRow = ARGBToUVRow_Any_SSSE3;
-    ARGBToYRow = ARGBToYRow_Any_SSSE3;
+#if defined(HAS_YUY2TOYROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    YUY2ToYRow = YUY2ToYRow_Any_SSE2;
     if (IS_ALIGNED(width, 16)) {
-      ARGBToUVRow = ARGBToUVRow_SSSE3;
-      ARGBToYRow = ARGBToYRow_SSSE3;
+      YUY2ToYRow = YUY2ToYRow_SSE2;
     }
   }
 #endif
-#if defined(HAS_ARGBTOYROW_AVX2) && defined(HAS_ARGBTOUVROW_AVX2)
+#if defined(HAS_YUY2TOYROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
-    ARGBToUVRow = ARGBToUVRow_Any_AVX2;
-    ARGBToYRow = ARGBToYRow_Any_AVX2;
+    YUY2ToYRow = YUY2ToYRow_Any_AVX2;
     if (IS_ALIGNED(width, 32)) {
-      ARGBToUVRow = ARGBToUVRow_AVX2;
-      ARGBToYRow = ARGBToYRow_AVX2;
+      YUY2ToYRow = YUY2ToYRow_AVX2;
     }
   }
 #endif
-#if defined(HAS_ARGBTOYROW_NEON)
+#if defined(HAS_YUY2TOYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    ARGBToYRow = ARGBToYRow_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      ARGBToYRow = ARGBToYRow_NEON;
+    YUY2ToYRow = YUY2ToYRow_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      YUY2ToYRow = YUY2ToYRow_NEON;
     }
   }
 #endif
-#if defined(HAS_ARGBTOUVROW_NEON)
+#if defined(HAS_YUY2TONVUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    YUY2ToNVUVRow = YUY2ToNVUVRow_Any_SSE2;
+    if (IS_ALIGNED(width, 16)) {
+      YUY2ToNVUVRow = YUY2ToNVUVRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_YUY2TONVUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    YUY2ToNVUVRow = YUY2ToNVUVRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      YUY2ToNVUVRow = YUY2ToNVUVRow_AVX2;
+    }
+  }
+#endif
+
+  for (y = 0; y < height - 1; y += 2) {
+    YUY2ToNVUVRow(src_yuy2, src_stride_yuy2, dst_uv, width);
+    YUY2ToYRow(src_yuy2, dst_y, width);
+    YUY2ToYRow(src_yuy2 + src_stride_yuy2, dst_y + dst_stride_y, width);
+    src_yuy2 += src_stride_yuy2 * 2;
+    dst_y += dst_stride_y * 2;
+    dst_uv += dst_stride_uv;
+  }
+  if (height & 1) {
+    YUY2ToNVUVRow(src_yuy2, 0, dst_uv, width);
+    YUY2ToYRow(src_yuy2, dst_y, width);
+  }
+  return 0;
+}
+
+// Convert UYVY to NV12.
+LIBYUV_API
+int UYVYToNV12(const uint8* src_uyvy, int src_stride_uyvy,
+               uint8* dst_y, int dst_stride_y,
+               uint8* dst_uv, int dst_stride_uv,
+               int width, int height) {
+  int y;
+  void (*UYVYToNVUVRow)(const uint8* src_uyvy, int src_stride_uyvy,
+      uint8* dst_uv, int pix) = UYVYToNVUVRow_C;
+  void (*UYVYToYRow)(const uint8* src_uyvy,
+      uint8* dst_y, int pix) = UYVYToYRow_C;
+  if (!src_uyvy || !dst_y || !dst_uv ||
+      width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_uyvy = src_uyvy + (height - 1) * src_stride_uyvy;
+    src_stride_uyvy = -src_stride_uyvy;
+  }
+#if defined(HAS_UYVYTOYROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    UYVYToYRow = UYVYToYRow_Any_SSE2;
+    if (IS_ALIGNED(width, 16)) {
+      UYVYToYRow = UYVYToYRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_UYVYTOYROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    UYVYToYRow = UYVYToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      UYVYToYRow = UYVYToYRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_UYVYTOYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    ARGBToUVRow = ARGBToUVRow_Any_NEON;
+    UYVYToYRow = UYVYToYRow_Any_NEON;
     if (IS_ALIGNED(width, 16)) {
-      ARGBToUVRow = ARGBToUVRow_NEON;
+      UYVYToYRow = UYVYToYRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_YUY2TONVUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    UYVYToNVUVRow = UYVYToNVUVRow_Any_SSE2;
+    if (IS_ALIGNED(width, 16)) {
+      UYVYToNVUVRow = UYVYToNVUVRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_YUY2TONVUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    UYVYToNVUVRow = UYVYToNVUVRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      UYVYToNVUVRow = UYVYToNVUVRow_AVX2;
     }
   }
 #endif
 
   for (y = 0; y < height - 1; y += 2) {
-    ARGBToUVRow(src_argb, src_stride_argb, dst_u, dst_v, width);
-    ARGBToYRow(src_argb, dst_y, width);
-    ARGBToYRow(src_argb + src_stride_argb, dst_y + dst_stride_y, width);
+    UYVYToNVUVRow(src_uyvy, src_stride_uyvy, dst_uv, width);
+    UYVYToYRow(src_uyvy, dst_y, width);
+    UYVYToYRow(src_uyvy + src_stride_uyvy, dst_y + dst_stride_y, width);
+    src_uyvy += src_stride_uyvy * 2;
+    dst_y += dst_stride_y * 2;
+    dst_uv += dst_stride_uv;
+  }
+  if (height & 1) {
+    UYVYToNVUVRow(src_uyvy, 0, dst_uv, width);
+    UYVYToYRow(src_uyvy, dst_y, width);
+  }
+  return 0;
+}
+
+// Convert ARGB to I420.
+LIBYUV_API
+int ARGBToI420(const uint8* src_argb, int src_stride_argb,
+               uint8* dst_y, int dst_stride_y,
+               uint8* dst_u, int dst_stride_u,
+               uint8* dst_v, int dst_stride_v,
+               int width, int height) {
+  int y;
+  void (*ARGBToUVRow)(const uint8* src_argb0, int src_stride_argb,
+      uint8* dst_u, uint8* dst_v, int width);
+  void (*ARGBToYRow)(const uint8* src_argb, uint8* dst_y, int pix);
+  void (*ARGBToI420Row)(const uint8* src_argb, int src_stride_argb,
+      uint8* dst_y, int dst_stride_y,
+      uint8* dst_u, uint8* dst_v, int width);
+  const struct RowFunctions* rows = GetCpuRowFunctions();
+  if (!src_argb ||
+      !dst_y || !dst_u || !dst_v ||
+      width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_argb = src_argb + (height - 1) * src_stride_argb;
+    src_stride_argb = -src_stride_argb;
+  }
+  PROFILE_BEGIN((int64)(width) * height, (int64)(width) * height * 11 / 2);
+  ARGBToUVRow = ROW_FUNCTION(rows, ARGBToUVRow, width);
+  ARGBToYRow = ROW_FUNCTION(rows, ARGBToYRow, width);
+  ARGBToI420Row = ROW_FUNCTION(rows, ARGBToI420Row, width);
+  if (ARGBToI420Row && height > 1) {
+    DISPATCH_KERNEL("ARGBToI420", ARGBToI420Row, width);
+  }
+  if (!ARGBToI420Row || (height & 1)) {
+    DISPATCH_KERNEL("ARGBToI420", ARGBToYRow, width);
+    DISPATCH_KERNEL("ARGBToI420", ARGBToUVRow, width);
+  }
+
+  for (y = 0; y < height - 1; y += 2) {
+    if (ARGBToI420Row) {
+      ARGBToI420Row(src_argb, src_stride_argb, dst_y, dst_stride_y,
+                    dst_u, dst_v, width);
+    } else {
+      ARGBToUVRow(src_argb, src_stride_argb, dst_u, dst_v, width);
+      ARGBToYRow(src_argb, dst_y, width);
+      ARGBToYRow(src_argb + src_stride_argb, dst_y + dst_stride_y, width);
+    }
     src_argb += src_stride_argb * 2;
     dst_y += dst_stride_y * 2;
     dst_u += dst_stride_u;
@@ -584,6 +723,7 @@ int ARGBToI420(const uint8* src_argb, int src_stride_argb,
     ARGBToUVRow(src_argb, 0, dst_u, dst_v, width);
     ARGBToYRow(src_argb, dst_y, width);
   }
+  PROFILE_END(kProfileARGBToI420);
   return 0;
 }
 
@@ -599,6 +739,9 @@ int BGRAToI420(const uint8* src_bgra, int src_stride_bgra,
       uint8* dst_u, uint8* dst_v, int width) = BGRAToUVRow_C;
   void (*BGRAToYRow)(const uint8* src_bgra, uint8* dst_y, int pix) =
       BGRAToYRow_C;
+  void (*BGRAToI420Row)(const uint8* src_bgra, int src_stride_bgra,
+      uint8* dst_y, int dst_stride_y,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
   if (!src_bgra ||
       !dst_y || !dst_u || !dst_v ||
       width <= 0 || height == 0) {
@@ -620,6 +763,16 @@ int BGRAToI420(const uint8* src_bgra, int src_stride_bgra,
     }
   }
 #endif
+#if defined(HAS_BGRATOYROW_AVX2) && defined(HAS_BGRATOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    BGRAToUVRow = BGRAToUVRow_Any_AVX2;
+    BGRAToYRow = BGRAToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      BGRAToUVRow = BGRAToUVRow_AVX2;
+      BGRAToYRow = BGRAToYRow_AVX2;
+    }
+  }
+#endif
 #if defined(HAS_BGRATOYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     BGRAToYRow = BGRAToYRow_Any_NEON;
@@ -637,10 +790,32 @@ int BGRAToI420(const uint8* src_bgra, int src_stride_bgra,
     }
 #endif
 
+#if defined(HAS_BGRATOI420ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    BGRAToI420Row = BGRAToI420Row_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      BGRAToI420Row = BGRAToI420Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_BGRATOI420ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    BGRAToI420Row = BGRAToI420Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      BGRAToI420Row = BGRAToI420Row_AVX2;
+    }
+  }
+#endif
+
   for (y = 0; y < height - 1; y += 2) {
-    BGRAToUVRow(src_bgra, src_stride_bgra, dst_u, dst_v, width);
-    BGRAToYRow(src_bgra, dst_y, width);
-    BGRAToYRow(src_bgra + src_stride_bgra, dst_y + dst_stride_y, width);
+    if (BGRAToI420Row) {
+      BGRAToI420Row(src_bgra, src_stride_bgra, dst_y, dst_stride_y,
+                    dst_u, dst_v, width);
+    } else {
+      BGRAToUVRow(src_bgra, src_stride_bgra, dst_u, dst_v, width);
+      BGRAToYRow(src_bgra, dst_y, width);
+      BGRAToYRow(src_bgra + src_stride_bgra, dst_y + dst_stride_y, width);
+    }
     src_bgra += src_stride_bgra * 2;
     dst_y += dst_stride_y * 2;
     dst_u += dst_stride_u;
@@ -665,6 +840,9 @@ int ABGRToI420(const uint8* src_abgr, int src_stride_abgr,
       uint8* dst_u, uint8* dst_v, int width) = ABGRToUVRow_C;
   void (*ABGRToYRow)(const uint8* src_abgr, uint8* dst_y, int pix) =
       ABGRToYRow_C;
+  void (*ABGRToI420Row)(const uint8* src_abgr, int src_stride_abgr,
+      uint8* dst_y, int dst_stride_y,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
   if (!src_abgr ||
       !dst_y || !dst_u || !dst_v ||
       width <= 0 || height == 0) {
@@ -686,6 +864,16 @@ int ABGRToI420(const uint8* src_abgr, int src_stride_abgr,
     }
   }
 #endif
+#if defined(HAS_ABGRTOYROW_AVX2) && defined(HAS_ABGRTOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ABGRToUVRow = ABGRToUVRow_Any_AVX2;
+    ABGRToYRow = ABGRToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ABGRToUVRow = ABGRToUVRow_AVX2;
+      ABGRToYRow = ABGRToYRow_AVX2;
+    }
+  }
+#endif
 #if defined(HAS_ABGRTOYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     ABGRToYRow = ABGRToYRow_Any_NEON;
@@ -703,10 +891,32 @@ int ABGRToI420(const uint8* src_abgr, int src_stride_abgr,
   }
 #endif
 
+#if defined(HAS_ABGRTOI420ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ABGRToI420Row = ABGRToI420Row_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      ABGRToI420Row = ABGRToI420Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ABGRTOI420ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ABGRToI420Row = ABGRToI420Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ABGRToI420Row = ABGRToI420Row_AVX2;
+    }
+  }
+#endif
+
   for (y = 0; y < height - 1; y += 2) {
-    ABGRToUVRow(src_abgr, src_stride_abgr, dst_u, dst_v, width);
-    ABGRToYRow(src_abgr, dst_y, width);
-    ABGRToYRow(src_abgr + src_stride_abgr, dst_y + dst_stride_y, width);
+    if (ABGRToI420Row) {
+      ABGRToI420Row(src_abgr, src_stride_abgr, dst_y, dst_stride_y,
+                    dst_u, dst_v, width);
+    } else {
+      ABGRToUVRow(src_abgr, src_stride_abgr, dst_u, dst_v, width);
+      ABGRToYRow(src_abgr, dst_y, width);
+      ABGRToYRow(src_abgr + src_stride_abgr, dst_y + dst_stride_y, width);
+    }
     src_abgr += src_stride_abgr * 2;
     dst_y += dst_stride_y * 2;
     dst_u += dst_stride_u;
@@ -731,6 +941,9 @@ int RGBAToI420(const uint8* src_rgba, int src_stride_rgba,
       uint8* dst_u, uint8* dst_v, int width) = RGBAToUVRow_C;
   void (*RGBAToYRow)(const uint8* src_rgba, uint8* dst_y, int pix) =
       RGBAToYRow_C;
+  void (*RGBAToI420Row)(const uint8* src_rgba, int src_stride_rgba,
+      uint8* dst_y, int dst_stride_y,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
   if (!src_rgba ||
       !dst_y || !dst_u || !dst_v ||
       width <= 0 || height == 0) {
@@ -752,6 +965,16 @@ int RGBAToI420(const uint8* src_rgba, int src_stride_rgba,
     }
   }
 #endif
+#if defined(HAS_RGBATOYROW_AVX2) && defined(HAS_RGBATOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    RGBAToUVRow = RGBAToUVRow_Any_AVX2;
+    RGBAToYRow = RGBAToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      RGBAToUVRow = RGBAToUVRow_AVX2;
+      RGBAToYRow = RGBAToYRow_AVX2;
+    }
+  }
+#endif
 #if defined(HAS_RGBATOYROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     RGBAToYRow = RGBAToYRow_Any_NEON;
@@ -769,10 +992,32 @@ int RGBAToI420(const uint8* src_rgba, int src_stride_rgba,
   }
 #endif
 
+#if defined(HAS_RGBATOI420ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    RGBAToI420Row = RGBAToI420Row_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      RGBAToI420Row = RGBAToI420Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_RGBATOI420ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    RGBAToI420Row = RGBAToI420Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      RGBAToI420Row = RGBAToI420Row_AVX2;
+    }
+  }
+#endif
+
   for (y = 0; y < height - 1; y += 2) {
-    RGBAToUVRow(src_rgba, src_stride_rgba, dst_u, dst_v, width);
-    RGBAToYRow(src_rgba, dst_y, width);
-    RGBAToYRow(src_rgba + src_stride_rgba, dst_y + dst_stride_y, width);
+    if (RGBAToI420Row) {
+      RGBAToI420Row(src_rgba, src_stride_rgba, dst_y, dst_stride_y,
+                    dst_u, dst_v, width);
+    } else {
+      RGBAToUVRow(src_rgba, src_stride_rgba, dst_u, dst_v, width);
+      RGBAToYRow(src_rgba, dst_y, width);
+      RGBAToYRow(src_rgba + src_stride_rgba, dst_y + dst_stride_y, width);
+    }
     src_rgba += src_stride_rgba * 2;
     dst_y += dst_stride_y * 2;
     dst_u += dst_stride_u;
@@ -805,6 +1050,12 @@ int RGB24ToI420(const uint8* src_rgb24, int src_stride_rgb24,
       uint8* dst_u, uint8* dst_v, int width) = ARGBToUVRow_C;
   void (*ARGBToYRow)(const uint8* src_argb, uint8* dst_y, int pix) =
       ARGBToYRow_C;
+  void (*ARGBToI420Row)(const uint8* src_argb, int src_stride_argb,
+      uint8* dst_y, int dst_stride_y,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
+  void (*RGB24ToUVRow)(const uint8* src_rgb24, int src_stride_rgb24,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
+  void (*RGB24ToYRow)(const uint8* src_rgb24, uint8* dst_y, int pix) = NULL;
 #endif
   if (!src_rgb24 || !dst_y || !dst_u || !dst_v ||
       width <= 0 || height == 0) {
@@ -861,44 +1112,76 @@ int RGB24ToI420(const uint8* src_rgb24, int src_stride_rgb24,
     }
   }
 #endif
+#if defined(HAS_ARGBTOI420ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBToI420Row = ARGBToI420Row_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToI420Row = ARGBToI420Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOI420ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToI420Row = ARGBToI420Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToI420Row = ARGBToI420Row_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_RGB24TOYROW_AVX2) && defined(HAS_RGB24TOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    RGB24ToUVRow = RGB24ToUVRow_Any_AVX2;
+    RGB24ToYRow = RGB24ToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      RGB24ToUVRow = RGB24ToUVRow_AVX2;
+      RGB24ToYRow = RGB24ToYRow_AVX2;
+    }
+  }
+#endif
 #if !defined(HAS_RGB24TOYROW_NEON)
-  {
+  if (!RGB24ToYRow) {
     // Allocate 2 rows of ARGB.
     const int kRowSize = (width * 4 + 31) & ~31;
     align_buffer_64(row, kRowSize * 2);
-#endif
-
     for (y = 0; y < height - 1; y += 2) {
-#if defined(HAS_RGB24TOYROW_NEON)
-      RGB24ToUVRow(src_rgb24, src_stride_rgb24, dst_u, dst_v, width);
-      RGB24ToYRow(src_rgb24, dst_y, width);
-      RGB24ToYRow(src_rgb24 + src_stride_rgb24, dst_y + dst_stride_y, width);
-#else
       RGB24ToARGBRow(src_rgb24, row, width);
       RGB24ToARGBRow(src_rgb24 + src_stride_rgb24, row + kRowSize, width);
-      ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
-      ARGBToYRow(row, dst_y, width);
-      ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
-#endif
+      if (ARGBToI420Row) {
+        ARGBToI420Row(row, kRowSize, dst_y, dst_stride_y, dst_u, dst_v, width);
+      } else {
+        ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
+        ARGBToYRow(row, dst_y, width);
+        ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
+      }
       src_rgb24 += src_stride_rgb24 * 2;
       dst_y += dst_stride_y * 2;
       dst_u += dst_stride_u;
       dst_v += dst_stride_v;
     }
     if (height & 1) {
-#if defined(HAS_RGB24TOYROW_NEON)
-      RGB24ToUVRow(src_rgb24, 0, dst_u, dst_v, width);
-      RGB24ToYRow(src_rgb24, dst_y, width);
-#else
       RGB24ToARGBRow(src_rgb24, row, width);
       ARGBToUVRow(row, 0, dst_u, dst_v, width);
       ARGBToYRow(row, dst_y, width);
-#endif
     }
-#if !defined(HAS_RGB24TOYROW_NEON)
     free_aligned_buffer_64(row);
+    return 0;
   }
 #endif
+
+  // Convert directly without ARGB rows.
+  for (y = 0; y < height - 1; y += 2) {
+    RGB24ToUVRow(src_rgb24, src_stride_rgb24, dst_u, dst_v, width);
+    RGB24ToYRow(src_rgb24, dst_y, width);
+    RGB24ToYRow(src_rgb24 + src_stride_rgb24, dst_y + dst_stride_y, width);
+    src_rgb24 += src_stride_rgb24 * 2;
+    dst_y += dst_stride_y * 2;
+    dst_u += dst_stride_u;
+    dst_v += dst_stride_v;
+  }
+  if (height & 1) {
+    RGB24ToUVRow(src_rgb24, 0, dst_u, dst_v, width);
+    RGB24ToYRow(src_rgb24, dst_y, width);
+  }
   return 0;
 }
 
@@ -922,6 +1205,12 @@ int RAWToI420(const uint8* src_raw, int src_stride_raw,
       uint8* dst_u, uint8* dst_v, int width) = ARGBToUVRow_C;
   void (*ARGBToYRow)(const uint8* src_argb, uint8* dst_y, int pix) =
       ARGBToYRow_C;
+  void (*ARGBToI420Row)(const uint8* src_argb, int src_stride_argb,
+      uint8* dst_y, int dst_stride_y,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
+  void (*RAWToUVRow)(const uint8* src_raw, int src_stride_raw,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
+  void (*RAWToYRow)(const uint8* src_raw, uint8* dst_y, int pix) = NULL;
 #endif
   if (!src_raw || !dst_y || !dst_u || !dst_v ||
       width <= 0 || height == 0) {
@@ -978,44 +1267,76 @@ int RAWToI420(const uint8* src_raw, int src_stride_raw,
     }
   }
 #endif
+#if defined(HAS_ARGBTOI420ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBToI420Row = ARGBToI420Row_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToI420Row = ARGBToI420Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOI420ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToI420Row = ARGBToI420Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToI420Row = ARGBToI420Row_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_RAWTOYROW_AVX2) && defined(HAS_RAWTOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    RAWToUVRow = RAWToUVRow_Any_AVX2;
+    RAWToYRow = RAWToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      RAWToUVRow = RAWToUVRow_AVX2;
+      RAWToYRow = RAWToYRow_AVX2;
+    }
+  }
+#endif
 #if !defined(HAS_RAWTOYROW_NEON)
-  {
+  if (!RAWToYRow) {
     // Allocate 2 rows of ARGB.
     const int kRowSize = (width * 4 + 31) & ~31;
     align_buffer_64(row, kRowSize * 2);
-#endif
-
     for (y = 0; y < height - 1; y += 2) {
-#if defined(HAS_RAWTOYROW_NEON)
-      RAWToUVRow(src_raw, src_stride_raw, dst_u, dst_v, width);
-      RAWToYRow(src_raw, dst_y, width);
-      RAWToYRow(src_raw + src_stride_raw, dst_y + dst_stride_y, width);
-#else
       RAWToARGBRow(src_raw, row, width);
       RAWToARGBRow(src_raw + src_stride_raw, row + kRowSize, width);
-      ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
-      ARGBToYRow(row, dst_y, width);
-      ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
-#endif
+      if (ARGBToI420Row) {
+        ARGBToI420Row(row, kRowSize, dst_y, dst_stride_y, dst_u, dst_v, width);
+      } else {
+        ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
+        ARGBToYRow(row, dst_y, width);
+        ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
+      }
       src_raw += src_stride_raw * 2;
       dst_y += dst_stride_y * 2;
       dst_u += dst_stride_u;
       dst_v += dst_stride_v;
     }
     if (height & 1) {
-#if defined(HAS_RAWTOYROW_NEON)
-      RAWToUVRow(src_raw, 0, dst_u, dst_v, width);
-      RAWToYRow(src_raw, dst_y, width);
-#else
       RAWToARGBRow(src_raw, row, width);
       ARGBToUVRow(row, 0, dst_u, dst_v, width);
       ARGBToYRow(row, dst_y, width);
-#endif
     }
-#if !defined(HAS_RAWTOYROW_NEON)
     free_aligned_buffer_64(row);
+    return 0;
   }
 #endif
+
+  // Convert directly without ARGB rows.
+  for (y = 0; y < height - 1; y += 2) {
+    RAWToUVRow(src_raw, src_stride_raw, dst_u, dst_v, width);
+    RAWToYRow(src_raw, dst_y, width);
+    RAWToYRow(src_raw + src_stride_raw, dst_y + dst_stride_y, width);
+    src_raw += src_stride_raw * 2;
+    dst_y += dst_stride_y * 2;
+    dst_u += dst_stride_u;
+    dst_v += dst_stride_v;
+  }
+  if (height & 1) {
+    RAWToUVRow(src_raw, 0, dst_u, dst_v, width);
+    RAWToYRow(src_raw, dst_y, width);
+  }
   return 0;
 }
 
@@ -1039,6 +1360,9 @@ int RGB565ToI420(const uint8* src_rgb565, int src_stride_rgb565,
       uint8* dst_u, uint8* dst_v, int width) = ARGBToUVRow_C;
   void (*ARGBToYRow)(const uint8* src_argb, uint8* dst_y, int pix) =
       ARGBToYRow_C;
+  void (*ARGBToI420Row)(const uint8* src_argb, int src_stride_argb,
+      uint8* dst_y, int dst_stride_y,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
 #endif
   if (!src_rgb565 || !dst_y || !dst_u || !dst_v ||
       width <= 0 || height == 0) {
@@ -1099,6 +1423,22 @@ int RGB565ToI420(const uint8* src_rgb565, int src_stride_rgb565,
     }
   }
 #endif
+#if defined(HAS_ARGBTOI420ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBToI420Row = ARGBToI420Row_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToI420Row = ARGBToI420Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOI420ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToI420Row = ARGBToI420Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToI420Row = ARGBToI420Row_AVX2;
+    }
+  }
+#endif
 #if !defined(HAS_RGB565TOYROW_NEON)
   {
     // Allocate 2 rows of ARGB.
@@ -1114,9 +1454,13 @@ int RGB565ToI420(const uint8* src_rgb565, int src_stride_rgb565,
 #else
       RGB565ToARGBRow(src_rgb565, row, width);
       RGB565ToARGBRow(src_rgb565 + src_stride_rgb565, row + kRowSize, width);
-      ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
-      ARGBToYRow(row, dst_y, width);
-      ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
+      if (ARGBToI420Row) {
+        ARGBToI420Row(row, kRowSize, dst_y, dst_stride_y, dst_u, dst_v, width);
+      } else {
+        ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
+        ARGBToYRow(row, dst_y, width);
+        ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
+      }
 #endif
       src_rgb565 += src_stride_rgb565 * 2;
       dst_y += dst_stride_y * 2;
@@ -1160,6 +1504,9 @@ int ARGB1555ToI420(const uint8* src_argb1555, int src_stride_argb1555,
       uint8* dst_u, uint8* dst_v, int width) = ARGBToUVRow_C;
   void (*ARGBToYRow)(const uint8* src_argb, uint8* dst_y, int pix) =
       ARGBToYRow_C;
+  void (*ARGBToI420Row)(const uint8* src_argb, int src_stride_argb,
+      uint8* dst_y, int dst_stride_y,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
 #endif
   if (!src_argb1555 || !dst_y || !dst_u || !dst_v ||
       width <= 0 || height == 0) {
@@ -1221,6 +1568,22 @@ int ARGB1555ToI420(const uint8* src_argb1555, int src_stride_argb1555,
     }
   }
 #endif
+#if defined(HAS_ARGBTOI420ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBToI420Row = ARGBToI420Row_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToI420Row = ARGBToI420Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOI420ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToI420Row = ARGBToI420Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToI420Row = ARGBToI420Row_AVX2;
+    }
+  }
+#endif
 #if !defined(HAS_ARGB1555TOYROW_NEON)
   {
     // Allocate 2 rows of ARGB.
@@ -1237,9 +1600,13 @@ int ARGB1555ToI420(const uint8* src_argb1555, int src_stride_argb1555,
       ARGB1555ToARGBRow(src_argb1555, row, width);
       ARGB1555ToARGBRow(src_argb1555 + src_stride_argb1555, row + kRowSize,
                         width);
-      ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
-      ARGBToYRow(row, dst_y, width);
-      ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
+      if (ARGBToI420Row) {
+        ARGBToI420Row(row, kRowSize, dst_y, dst_stride_y, dst_u, dst_v, width);
+      } else {
+        ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
+        ARGBToYRow(row, dst_y, width);
+        ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
+      }
 #endif
       src_argb1555 += src_stride_argb1555 * 2;
       dst_y += dst_stride_y * 2;
@@ -1283,6 +1650,9 @@ int ARGB4444ToI420(const uint8* src_argb4444, int src_stride_argb4444,
       uint8* dst_u, uint8* dst_v, int width) = ARGBToUVRow_C;
   void (*ARGBToYRow)(const uint8* src_argb, uint8* dst_y, int pix) =
       ARGBToYRow_C;
+  void (*ARGBToI420Row)(const uint8* src_argb, int src_stride_argb,
+      uint8* dst_y, int dst_stride_y,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
 #endif
   if (!src_argb4444 || !dst_y || !dst_u || !dst_v ||
       width <= 0 || height == 0) {
@@ -1345,6 +1715,22 @@ int ARGB4444ToI420(const uint8* src_argb4444, int src_stride_argb4444,
   }
 #endif
 
+#if defined(HAS_ARGBTOI420ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBToI420Row = ARGBToI420Row_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToI420Row = ARGBToI420Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOI420ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToI420Row = ARGBToI420Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToI420Row = ARGBToI420Row_AVX2;
+    }
+  }
+#endif
 #if !defined(HAS_ARGB4444TOYROW_NEON)
   {
     // Allocate 2 rows of ARGB.
@@ -1362,9 +1748,13 @@ int ARGB4444ToI420(const uint8* src_argb4444, int src_stride_argb4444,
       ARGB4444ToARGBRow(src_argb4444, row, width);
       ARGB4444ToARGBRow(src_argb4444 + src_stride_argb4444, row + kRowSize,
                         width);
-      ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
-      ARGBToYRow(row, dst_y, width);
-      ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
+      if (ARGBToI420Row) {
+        ARGBToI420Row(row, kRowSize, dst_y, dst_stride_y, dst_u, dst_v, width);
+      } else {
+        ARGBToUVRow(row, kRowSize, dst_u, dst_v, width);
+        ARGBToYRow(row, dst_y, width);
+        ARGBToYRow(row + kRowSize, dst_y + dst_stride_y, width);
+      }
 #endif
       src_argb4444 += src_stride_argb4444 * 2;
       dst_y += dst_stride_y * 2;
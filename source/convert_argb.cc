@@ -11,11 +11,14 @@
 #include "libyuv/convert_argb.h"
 
 #include "libyuv/cpu_id.h"
+#include "libyuv/dispatch.h"
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
 #endif
+#include "libyuv/profile.h"
 #include "libyuv/rotate_argb.h"
 #include "libyuv/row.h"
+#include "libyuv/scale_row.h"  // For ScaleRowUp2_Bilinear.
 #include "libyuv/video_common.h"
 
 #ifdef __cplusplus
@@ -112,6 +115,143 @@ int I444ToARGB(const uint8* src_y, int src_stride_y,
   return 0;
 }
 
+typedef void (*ScaleRowUp2Function)(const uint8* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8* dst_ptr, int dst_width);
+
+static ScaleRowUp2Function GetScaleRowUp2(int width) {
+  ScaleRowUp2Function ScaleRowUp2 = ScaleRowUp2_Bilinear_C;
+#if defined(HAS_SCALEROWUP2_BILINEAR_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ScaleRowUp2 = ScaleRowUp2_Bilinear_Any_SSE2;
+    if (IS_ALIGNED((width - 1) & ~1, 16)) {
+      ScaleRowUp2 = ScaleRowUp2_Bilinear_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEROWUP2_BILINEAR_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ScaleRowUp2 = ScaleRowUp2_Bilinear_Any_AVX2;
+    if (IS_ALIGNED((width - 1) & ~1, 32)) {
+      ScaleRowUp2 = ScaleRowUp2_Bilinear_AVX2;
+    }
+  }
+#endif
+  return ScaleRowUp2;
+}
+
+// Upsamples a row of chroma to "width" pixels with 3/4 of the row at src_ptr
+// and 1/4 of the row at src_ptr + src_stride.  Chroma is sited between
+// pixels, so the first pixel, and the last if width is even, have no
+// neighbour across and are only filtered down.
+static void ChromaRowUp2(ScaleRowUp2Function ScaleRowUp2,
+                         const uint8* src_ptr, ptrdiff_t src_stride,
+                         uint8* dst_ptr, int width) {
+  int work_width = (width - 1) & ~1;
+  dst_ptr[0] = (src_ptr[0] * 3 + src_ptr[src_stride] + 2) >> 2;
+  if (work_width > 0) {
+    ScaleRowUp2(src_ptr, src_stride, dst_ptr + 1, work_width);
+  }
+  if (!(width & 1)) {
+    int x = (width - 1) >> 1;
+    dst_ptr[width - 1] = (src_ptr[x] * 3 + src_ptr[x + src_stride] + 2) >> 2;
+  }
+}
+
+// Returns which chroma row, relative to row y / 2, is filtered with it for
+// luma row y: the next row for odd rows and the previous row for even rows,
+// or none at the top and bottom edges and for kFilterLinear.
+static int ChromaRowNeighbour(int y, int halfheight,
+                              enum FilterMode filtering) {
+  if (filtering == kFilterLinear) {
+    return 0;
+  }
+  if (y & 1) {
+    return ((y >> 1) + 1 < halfheight) ? 1 : 0;
+  }
+  return y > 0 ? -1 : 0;
+}
+
+// Convert I420 to ARGB with filtered chroma.  Chroma is upsampled a row at a
+// time into a buffer that stays in cache, then converted as I444.
+LIBYUV_API
+int I420ToARGBFilter(const uint8* src_y, int src_stride_y,
+                     const uint8* src_u, int src_stride_u,
+                     const uint8* src_v, int src_stride_v,
+                     uint8* dst_argb, int dst_stride_argb,
+                     int width, int height, enum FilterMode filtering) {
+  int y;
+  int halfheight;
+  ScaleRowUp2Function ScaleRowUp2;
+  void (*I444ToARGBRow)(const uint8* y_buf,
+                        const uint8* u_buf,
+                        const uint8* v_buf,
+                        uint8* rgb_buf,
+                        int width) = I444ToARGBRow_C;
+  if (filtering == kFilterNone) {
+    return I420ToARGB(src_y, src_stride_y, src_u, src_stride_u,
+                      src_v, src_stride_v, dst_argb, dst_stride_argb,
+                      width, height);
+  }
+  if (!src_y || !src_u || !src_v || !dst_argb ||
+      width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_argb = dst_argb + (height - 1) * dst_stride_argb;
+    dst_stride_argb = -dst_stride_argb;
+  }
+  halfheight = (height + 1) >> 1;
+  ScaleRowUp2 = GetScaleRowUp2(width);
+#if defined(HAS_I444TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    I444ToARGBRow = I444ToARGBRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 8)) {
+      I444ToARGBRow = I444ToARGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_I444TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    I444ToARGBRow = I444ToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      I444ToARGBRow = I444ToARGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_I444TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    I444ToARGBRow = I444ToARGBRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      I444ToARGBRow = I444ToARGBRow_NEON;
+    }
+  }
+#endif
+
+  {
+    // Row of upsampled U and V.
+    const int kRowSize = (width + 63) & ~63;
+    align_buffer_64(row, kRowSize * 2);
+    uint8* row_u = row;
+    uint8* row_v = row + kRowSize;
+
+    for (y = 0; y < height; ++y) {
+      int neighbour = ChromaRowNeighbour(y, halfheight, filtering);
+      ChromaRowUp2(ScaleRowUp2, src_u + (y >> 1) * src_stride_u,
+                   neighbour * src_stride_u, row_u, width);
+      ChromaRowUp2(ScaleRowUp2, src_v + (y >> 1) * src_stride_v,
+                   neighbour * src_stride_v, row_v, width);
+      I444ToARGBRow(src_y, row_u, row_v, dst_argb, width);
+      src_y += src_stride_y;
+      dst_argb += dst_stride_argb;
+    }
+    free_aligned_buffer_64(row);
+  }
+  return 0;
+}
+
 // Convert I422 to ARGB.
 LIBYUV_API
 int I422ToARGB(const uint8* src_y, int src_stride_y,
@@ -727,7 +867,8 @@ int NV12ToARGB(const uint8* src_y, int src_stride_y,
   void (*NV12ToARGBRow)(const uint8* y_buf,
                         const uint8* uv_buf,
                         uint8* rgb_buf,
-                        int width) = NV12ToARGBRow_C;
+                        int width);
+  const struct RowFunctions* rows = GetCpuRowFunctions();
   if (!src_y || !src_uv || !dst_argb ||
       width <= 0 || height == 0) {
     return -1;
@@ -738,38 +879,132 @@ int NV12ToARGB(const uint8* src_y, int src_stride_y,
     dst_argb = dst_argb + (height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
-#if defined(HAS_NV12TOARGBROW_SSSE3)
+  PROFILE_BEGIN((int64)(width) * height, (int64)(width) * height * 11 / 2);
+  NV12ToARGBRow = ROW_FUNCTION(rows, NV12ToARGBRow, width);
+  DISPATCH_KERNEL("NV12ToARGB", NV12ToARGBRow, width);
+
+  for (y = 0; y < height; ++y) {
+    NV12ToARGBRow(src_y, src_uv, dst_argb, width);
+    dst_argb += dst_stride_argb;
+    src_y += src_stride_y;
+    if (y & 1) {
+      src_uv += src_stride_uv;
+    }
+  }
+  PROFILE_END(kProfileNV12ToARGB);
+  return 0;
+}
+
+// Convert NV12 to ARGB with filtered chroma.  Each chroma row is split into
+// U and V before upsampling as in I420ToARGBFilter.
+LIBYUV_API
+int NV12ToARGBFilter(const uint8* src_y, int src_stride_y,
+                     const uint8* src_uv, int src_stride_uv,
+                     uint8* dst_argb, int dst_stride_argb,
+                     int width, int height, enum FilterMode filtering) {
+  int y;
+  int halfwidth = (width + 1) >> 1;
+  int halfheight;
+  ScaleRowUp2Function ScaleRowUp2;
+  void (*SplitUVRow)(const uint8* src_uv, uint8* dst_u, uint8* dst_v,
+                     int pix) = SplitUVRow_C;
+  void (*I444ToARGBRow)(const uint8* y_buf,
+                        const uint8* u_buf,
+                        const uint8* v_buf,
+                        uint8* rgb_buf,
+                        int width) = I444ToARGBRow_C;
+  if (filtering == kFilterNone) {
+    return NV12ToARGB(src_y, src_stride_y, src_uv, src_stride_uv,
+                      dst_argb, dst_stride_argb, width, height);
+  }
+  if (!src_y || !src_uv || !dst_argb ||
+      width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_argb = dst_argb + (height - 1) * dst_stride_argb;
+    dst_stride_argb = -dst_stride_argb;
+  }
+  halfheight = (height + 1) >> 1;
+  ScaleRowUp2 = GetScaleRowUp2(width);
+#if defined(HAS_SPLITUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SplitUVRow = SplitUVRow_Any_SSE2;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      SplitUVRow = SplitUVRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SPLITUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SplitUVRow = SplitUVRow_Any_AVX2;
+    if (IS_ALIGNED(halfwidth, 32)) {
+      SplitUVRow = SplitUVRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SPLITUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SplitUVRow = SplitUVRow_Any_NEON;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      SplitUVRow = SplitUVRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_I444TOARGBROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
-    NV12ToARGBRow = NV12ToARGBRow_Any_SSSE3;
+    I444ToARGBRow = I444ToARGBRow_Any_SSSE3;
     if (IS_ALIGNED(width, 8)) {
-      NV12ToARGBRow = NV12ToARGBRow_SSSE3;
+      I444ToARGBRow = I444ToARGBRow_SSSE3;
     }
   }
 #endif
-#if defined(HAS_NV12TOARGBROW_AVX2)
+#if defined(HAS_I444TOARGBROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
-    NV12ToARGBRow = NV12ToARGBRow_Any_AVX2;
+    I444ToARGBRow = I444ToARGBRow_Any_AVX2;
     if (IS_ALIGNED(width, 16)) {
-      NV12ToARGBRow = NV12ToARGBRow_AVX2;
+      I444ToARGBRow = I444ToARGBRow_AVX2;
     }
   }
 #endif
-#if defined(HAS_NV12TOARGBROW_NEON)
+#if defined(HAS_I444TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    NV12ToARGBRow = NV12ToARGBRow_Any_NEON;
+    I444ToARGBRow = I444ToARGBRow_Any_NEON;
     if (IS_ALIGNED(width, 8)) {
-      NV12ToARGBRow = NV12ToARGBRow_NEON;
+      I444ToARGBRow = I444ToARGBRow_NEON;
     }
   }
 #endif
 
-  for (y = 0; y < height; ++y) {
-    NV12ToARGBRow(src_y, src_uv, dst_argb, width);
-    dst_argb += dst_stride_argb;
-    src_y += src_stride_y;
-    if (y & 1) {
-      src_uv += src_stride_uv;
+  {
+    // Row of upsampled U and V, then 2 rows of split U and V that are
+    // kRowSize apart.
+    const int kRowSize = (width + 63) & ~63;
+    align_buffer_64(row, kRowSize * 4);
+    uint8* row_u = row;
+    uint8* row_v = row + kRowSize;
+    uint8* split_u = row + kRowSize * 2;
+    uint8* split_v = split_u + kRowSize / 2;
+
+    for (y = 0; y < height; ++y) {
+      int neighbour = ChromaRowNeighbour(y, halfheight, filtering);
+      const uint8* uv = src_uv + (y >> 1) * src_stride_uv;
+      SplitUVRow(uv, split_u, split_v, halfwidth);
+      if (neighbour) {
+        SplitUVRow(uv + neighbour * src_stride_uv, split_u + kRowSize,
+                   split_v + kRowSize, halfwidth);
+      }
+      ChromaRowUp2(ScaleRowUp2, split_u, neighbour ? kRowSize : 0,
+                   row_u, width);
+      ChromaRowUp2(ScaleRowUp2, split_v, neighbour ? kRowSize : 0,
+                   row_v, width);
+      I444ToARGBRow(src_y, row_u, row_v, dst_argb, width);
+      src_y += src_stride_y;
+      dst_argb += dst_stride_argb;
     }
+    free_aligned_buffer_64(row);
   }
   return 0;
 }
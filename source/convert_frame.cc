@@ -0,0 +1,484 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/convert_frame.h"
+
+#include <stdlib.h>
+#include <string.h>  // For memset.
+
+#include "libyuv/convert.h"
+#include "libyuv/convert_from.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/rotate.h"
+#include "libyuv/scale.h"
+#include "libyuv/video_common.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+static int I420Size(int width, int height) {
+  return width * height + ((width + 1) / 2) * ((height + 1) / 2) * 2;
+}
+
+static LIBYUV_BOOL IsI420Format(uint32 format) {
+  return format == FOURCC_I420 || format == FOURCC_YU12 ||
+      format == FOURCC_YV12;
+}
+
+// Formats ConvertToI420 accepts.
+static LIBYUV_BOOL CanConvertToI420(uint32 format) {
+  switch (format) {
+    case FOURCC_YUY2:
+    case FOURCC_UYVY:
+    case FOURCC_RGBP:
+    case FOURCC_RGBO:
+    case FOURCC_R444:
+    case FOURCC_24BG:
+    case FOURCC_RAW:
+    case FOURCC_ARGB:
+    case FOURCC_BGRA:
+    case FOURCC_ABGR:
+    case FOURCC_RGBA:
+    case FOURCC_I400:
+    case FOURCC_NV12:
+    case FOURCC_NV21:
+    case FOURCC_M420:
+    case FOURCC_I420:
+    case FOURCC_YU12:
+    case FOURCC_YV12:
+    case FOURCC_I422:
+    case FOURCC_YV16:
+    case FOURCC_I444:
+    case FOURCC_YV24:
+    case FOURCC_I411:
+#ifdef HAVE_JPEG
+    case FOURCC_MJPG:
+#endif
+      return LIBYUV_TRUE;
+    default:
+      return LIBYUV_FALSE;
+  }
+}
+
+// Bytes per pixel of the single plane formats ConvertFromI420 writes.
+// Returns 0 for formats that are not a single plane.
+static int SinglePlaneBpp(uint32 format) {
+  switch (format) {
+    case FOURCC_I400:
+      return 1;
+    case FOURCC_YUY2:
+    case FOURCC_UYVY:
+    case FOURCC_RGBP:
+    case FOURCC_RGBO:
+    case FOURCC_R444:
+      return 2;
+    case FOURCC_24BG:
+    case FOURCC_RAW:
+      return 3;
+    case FOURCC_ARGB:
+    case FOURCC_BGRA:
+    case FOURCC_ABGR:
+    case FOURCC_RGBA:
+      return 4;
+    default:
+      return 0;
+  }
+}
+
+// Formats ConvertFromI420 accepts.
+static LIBYUV_BOOL CanConvertFromI420(uint32 format) {
+  switch (format) {
+    case FOURCC_NV12:
+    case FOURCC_NV21:
+    case FOURCC_I420:
+    case FOURCC_YU12:
+    case FOURCC_YV12:
+    case FOURCC_I422:
+    case FOURCC_YV16:
+    case FOURCC_I444:
+    case FOURCC_YV24:
+    case FOURCC_I411:
+      return LIBYUV_TRUE;
+    default:
+      return SinglePlaneBpp(format) != 0;
+  }
+}
+
+// Locate the planes of a contiguous I420 or YV12 frame, offset to x, y.
+static void I420FramePlanes(const uint8* frame, int width, int height,
+                            int x, int y, uint32 format,
+                            uint8** dst_y, uint8** dst_u, uint8** dst_v) {
+  int halfwidth = (width + 1) / 2;
+  int halfheight = (height + 1) / 2;
+  uint8* u = (uint8*)(frame) + width * height;
+  uint8* v = u + halfwidth * halfheight;
+  if (format == FOURCC_YV12) {
+    uint8* t = u;
+    u = v;
+    v = t;
+  }
+  *dst_y = (uint8*)(frame) + width * y + x;
+  *dst_u = u + halfwidth * (y / 2) + x / 2;
+  *dst_v = v + halfwidth * (y / 2) + x / 2;
+}
+
+LIBYUV_API
+int FrameConvertPlanInit(struct FrameConvertPlan* plan,
+                         uint32 src_fourcc,
+                         int src_width, int src_height,
+                         int crop_x, int crop_y,
+                         int crop_width, int crop_height,
+                         uint32 dst_fourcc,
+                         int dst_width, int dst_height,
+                         enum RotationMode rotation,
+                         enum FilterMode filtering) {
+  uint32 src_format = CanonicalFourCC(src_fourcc);
+  uint32 dst_format = CanonicalFourCC(dst_fourcc);
+  int abs_crop_height = (crop_height < 0) ? -crop_height : crop_height;
+  LIBYUV_BOOL transpose = rotation == kRotate90 || rotation == kRotate270;
+  // Size of the scaled image before rotation.
+  int scale_width = transpose ? dst_height : dst_width;
+  int scale_height = transpose ? dst_width : dst_height;
+  LIBYUV_BOOL need_scale = scale_width != crop_width ||
+      scale_height != abs_crop_height;
+  // I420 sources are read in place unless they need flipping, and the last
+  // I420 pass writes straight into I420 destinations.
+  LIBYUV_BOOL src_direct = IsI420Format(src_format) && src_height > 0;
+  LIBYUV_BOOL dst_direct = IsI420Format(dst_format);
+  // ConvertToI420 rotates biplanar sources in the same pass.
+  LIBYUV_BOOL rotate_in_convert = src_format == FOURCC_NV12 ||
+      src_format == FOURCC_NV21;
+  int buffer_size = 0;
+  int num_buffers = 0;
+  int i;
+  if (!plan) {
+    return -1;
+  }
+  memset(plan, 0, sizeof(*plan));
+  if (src_width <= 0 || src_height == 0 ||
+      crop_width <= 0 || crop_height == 0 ||
+      dst_width <= 0 || dst_height <= 0 ||
+      (rotation != kRotate0 && rotation != kRotate90 &&
+       rotation != kRotate180 && rotation != kRotate270) ||
+      !CanConvertToI420(src_format) || !CanConvertFromI420(dst_format)) {
+    return -1;
+  }
+  plan->src_fourcc = src_format;
+  plan->src_width = src_width;
+  plan->src_height = src_height;
+  plan->crop_x = crop_x;
+  plan->crop_y = crop_y;
+  plan->crop_width = crop_width;
+  plan->crop_height = crop_height;
+  plan->dst_fourcc = dst_format;
+  plan->dst_width = dst_width;
+  plan->dst_height = dst_height;
+  plan->rotation = rotation;
+  plan->filtering = filtering;
+
+  if (!src_direct) {
+    plan->steps[plan->num_steps++] = kFrameStepToI420;
+  }
+  // Rotate whichever of the cropped and scaled images is smaller.
+  if (rotation && need_scale &&
+      scale_width * scale_height < crop_width * abs_crop_height) {
+    plan->steps[plan->num_steps++] = kFrameStepScale;
+    plan->steps[plan->num_steps++] = kFrameStepRotate;
+  } else {
+    if (rotation && (src_direct || !rotate_in_convert)) {
+      plan->steps[plan->num_steps++] = kFrameStepRotate;
+    }
+    if (need_scale) {
+      plan->steps[plan->num_steps++] = kFrameStepScale;
+    }
+  }
+  if (!dst_direct || plan->num_steps == 0) {
+    plan->steps[plan->num_steps++] = kFrameStepFromI420;
+  }
+
+  // Count the I420 images that are not the destination.
+  for (i = 0; i < plan->num_steps; ++i) {
+    if (plan->steps[i] != kFrameStepFromI420) {
+      ++num_buffers;
+    }
+  }
+  if (dst_direct && plan->steps[plan->num_steps - 1] != kFrameStepFromI420) {
+    --num_buffers;
+  }
+  if (num_buffers > 2) {
+    num_buffers = 2;
+  }
+
+  // Convert and pack in stripes when nothing needs the whole frame.
+  if (plan->num_steps == 2 && plan->steps[0] == kFrameStepToI420 &&
+      plan->steps[1] == kFrameStepFromI420 && !rotation &&
+      src_height > 0 && src_format != FOURCC_MJPG &&
+      SinglePlaneBpp(dst_format)) {
+    struct CpuCacheInfo cache_info;
+    int stripe_height;
+    GetCpuCacheInfo(&cache_info);
+    // The I420 stripe is a quarter of L2 so the source and destination rows
+    // fit too.
+    stripe_height = (cache_info.l2_size / 4 / (crop_width * 2)) & ~1;
+    if (stripe_height < 2) {
+      stripe_height = 2;
+    }
+    if (stripe_height < abs_crop_height) {
+      plan->stripe_height = stripe_height;
+      buffer_size = I420Size(crop_width, stripe_height);
+    }
+  }
+  if (num_buffers && !buffer_size) {
+    buffer_size = I420Size(crop_width, abs_crop_height);
+    if (need_scale && I420Size(scale_width, scale_height) > buffer_size) {
+      buffer_size = I420Size(scale_width, scale_height);
+    }
+  }
+  if (num_buffers) {
+    buffer_size = (buffer_size + 63) & ~63;
+    plan->buffer_mem = (uint8*)malloc(buffer_size * num_buffers + 63);
+    if (!plan->buffer_mem) {
+      return 1;  // Out of memory runtime error.
+    }
+    plan->buffer[0] = (uint8*)(((intptr_t)(plan->buffer_mem) + 63) & ~63);
+    plan->buffer[1] = plan->buffer[0] + (num_buffers > 1 ? buffer_size : 0);
+  }
+  return 0;
+}
+
+// Run a plan that converts in stripes of rows through a small I420 buffer.
+static int FrameConvertPlanRunStripes(const struct FrameConvertPlan* plan,
+                                      const uint8* src_frame, size_t src_size,
+                                      uint8* dst_frame, int dst_stride_frame) {
+  int width = plan->crop_width;
+  int height = (plan->crop_height < 0) ? -plan->crop_height :
+      plan->crop_height;
+  int halfwidth = (width + 1) / 2;
+  uint8* tmp_y = plan->buffer[0];
+  uint8* tmp_u = tmp_y + width * plan->stripe_height;
+  uint8* tmp_v = tmp_u + halfwidth * (plan->stripe_height / 2);
+  int y;
+  if (!dst_stride_frame) {
+    dst_stride_frame = width * SinglePlaneBpp(plan->dst_fourcc);
+  }
+  for (y = 0; y < height; y += plan->stripe_height) {
+    int rows = (height - y < plan->stripe_height) ? height - y :
+        plan->stripe_height;
+    int r = ConvertToI420(src_frame, src_size,
+                          tmp_y, width,
+                          tmp_u, halfwidth,
+                          tmp_v, halfwidth,
+                          plan->crop_x, plan->crop_y + y,
+                          plan->src_width, plan->src_height,
+                          width, rows,
+                          kRotate0, plan->src_fourcc);
+    if (!r) {
+      r = ConvertFromI420(tmp_y, width,
+                          tmp_u, halfwidth,
+                          tmp_v, halfwidth,
+                          dst_frame + y * dst_stride_frame, dst_stride_frame,
+                          width, rows, plan->dst_fourcc);
+    }
+    if (r) {
+      return r;
+    }
+  }
+  return 0;
+}
+
+LIBYUV_API
+int FrameConvertPlanRun(const struct FrameConvertPlan* plan,
+                        const uint8* src_frame, size_t src_size,
+                        uint8* dst_frame, int dst_stride_frame) {
+  // The current I420 image.
+  const uint8* y = NULL;
+  const uint8* u = NULL;
+  const uint8* v = NULL;
+  int y_stride = 0;
+  int uv_stride = 0;
+  int width = 0;
+  int height = 0;
+  LIBYUV_BOOL transpose = LIBYUV_FALSE;
+  LIBYUV_BOOL rotate_pending = LIBYUV_FALSE;
+  int next_buffer = 0;
+  int i;
+  if (!plan || !src_frame || !dst_frame || plan->num_steps == 0) {
+    return -1;
+  }
+  if (plan->stripe_height) {
+    return FrameConvertPlanRunStripes(plan, src_frame, src_size,
+                                      dst_frame, dst_stride_frame);
+  }
+  transpose = plan->rotation == kRotate90 || plan->rotation == kRotate270;
+  for (i = 0; i < plan->num_steps; ++i) {
+    if (plan->steps[i] == kFrameStepRotate) {
+      rotate_pending = LIBYUV_TRUE;
+    }
+  }
+  if (plan->steps[0] != kFrameStepToI420) {
+    uint8* src_y;
+    uint8* src_u;
+    uint8* src_v;
+    I420FramePlanes(src_frame, plan->src_width, plan->src_height,
+                    plan->crop_x, plan->crop_y, plan->src_fourcc,
+                    &src_y, &src_u, &src_v);
+    y = src_y;
+    u = src_u;
+    v = src_v;
+    y_stride = plan->src_width;
+    uv_stride = (plan->src_width + 1) / 2;
+    width = plan->crop_width;
+    height = (plan->crop_height < 0) ? -plan->crop_height : plan->crop_height;
+  }
+
+  for (i = 0; i < plan->num_steps; ++i) {
+    enum FrameConvertStep step = plan->steps[i];
+    int dst_w = width;
+    int dst_h = height;
+    uint8* dst_y;
+    uint8* dst_u;
+    uint8* dst_v;
+    int dst_y_stride;
+    int dst_uv_stride;
+    int r;
+    if (step == kFrameStepFromI420) {
+      r = ConvertFromI420(y, y_stride,
+                          u, uv_stride,
+                          v, uv_stride,
+                          dst_frame, dst_stride_frame,
+                          width, height, plan->dst_fourcc);
+      if (r) {
+        return r;
+      }
+      continue;
+    }
+
+    // Size of the I420 image this step makes.
+    if (step == kFrameStepToI420) {
+      dst_w = plan->crop_width;
+      dst_h = (plan->crop_height < 0) ? -plan->crop_height :
+          plan->crop_height;
+      if (transpose && !rotate_pending) {
+        dst_w = dst_h;
+        dst_h = plan->crop_width;
+      }
+    } else if (step == kFrameStepRotate) {
+      rotate_pending = LIBYUV_FALSE;
+      if (transpose) {
+        dst_w = height;
+        dst_h = width;
+      }
+    } else {
+      dst_w = transpose && rotate_pending ? plan->dst_height : plan->dst_width;
+      dst_h = transpose && rotate_pending ? plan->dst_width : plan->dst_height;
+    }
+
+    if (i == plan->num_steps - 1) {
+      // Last step writes into the I420 destination.
+      I420FramePlanes(dst_frame, plan->dst_width, plan->dst_height, 0, 0,
+                      plan->dst_fourcc, &dst_y, &dst_u, &dst_v);
+      dst_y_stride = plan->dst_width;
+      dst_uv_stride = (plan->dst_width + 1) / 2;
+    } else {
+      dst_y = plan->buffer[next_buffer];
+      dst_u = dst_y + dst_w * dst_h;
+      dst_v = dst_u + ((dst_w + 1) / 2) * ((dst_h + 1) / 2);
+      dst_y_stride = dst_w;
+      dst_uv_stride = (dst_w + 1) / 2;
+      next_buffer ^= 1;
+    }
+
+    switch (step) {
+      case kFrameStepToI420:
+        r = ConvertToI420(src_frame, src_size,
+                          dst_y, dst_y_stride,
+                          dst_u, dst_uv_stride,
+                          dst_v, dst_uv_stride,
+                          plan->crop_x, plan->crop_y,
+                          plan->src_width, plan->src_height,
+                          plan->crop_width, plan->crop_height,
+                          rotate_pending ? kRotate0 : plan->rotation,
+                          plan->src_fourcc);
+        break;
+      case kFrameStepScale:
+        r = I420Scale(y, y_stride,
+                      u, uv_stride,
+                      v, uv_stride,
+                      width, height,
+                      dst_y, dst_y_stride,
+                      dst_u, dst_uv_stride,
+                      dst_v, dst_uv_stride,
+                      dst_w, dst_h,
+                      plan->filtering);
+        break;
+      default:
+        r = I420Rotate(y, y_stride,
+                       u, uv_stride,
+                       v, uv_stride,
+                       dst_y, dst_y_stride,
+                       dst_u, dst_uv_stride,
+                       dst_v, dst_uv_stride,
+                       width, height, plan->rotation);
+        break;
+    }
+    if (r) {
+      return r;
+    }
+    y = dst_y;
+    u = dst_u;
+    v = dst_v;
+    y_stride = dst_y_stride;
+    uv_stride = dst_uv_stride;
+    width = dst_w;
+    height = dst_h;
+  }
+  return 0;
+}
+
+LIBYUV_API
+void FrameConvertPlanFree(struct FrameConvertPlan* plan) {
+  if (plan) {
+    free(plan->buffer_mem);
+    plan->buffer_mem = NULL;
+    plan->buffer[0] = NULL;
+    plan->buffer[1] = NULL;
+  }
+}
+
+LIBYUV_API
+int ConvertFrame(const uint8* src_frame, size_t src_size,
+                 uint32 src_fourcc,
+                 int src_width, int src_height,
+                 int crop_x, int crop_y,
+                 int crop_width, int crop_height,
+                 uint8* dst_frame, int dst_stride_frame,
+                 uint32 dst_fourcc,
+                 int dst_width, int dst_height,
+                 enum RotationMode rotation,
+                 enum FilterMode filtering) {
+  struct FrameConvertPlan plan;
+  int r = FrameConvertPlanInit(&plan, src_fourcc, src_width, src_height,
+                               crop_x, crop_y, crop_width, crop_height,
+                               dst_fourcc, dst_width, dst_height,
+                               rotation, filtering);
+  if (!r) {
+    r = FrameConvertPlanRun(&plan, src_frame, src_size,
+                            dst_frame, dst_stride_frame);
+  }
+  FrameConvertPlanFree(&plan);
+  return r;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
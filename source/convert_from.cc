@@ -10,10 +10,13 @@
 
 #include "libyuv/convert_from.h"
 
+#include "libyuv/autotune.h"
 #include "libyuv/basic_types.h"
 #include "libyuv/convert.h"  // For I420Copy
 #include "libyuv/cpu_id.h"
+#include "libyuv/dispatch.h"
 #include "libyuv/planar_functions.h"
+#include "libyuv/profile.h"
 #include "libyuv/rotate.h"
 #include "libyuv/scale.h"  // For ScalePlane()
 #include "libyuv/video_common.h"
@@ -251,6 +254,106 @@ int I420ToYUY2(const uint8* src_y, int src_stride_y,
   return 0;
 }
 
+// Convert NV12 to YUY2.
+LIBYUV_API
+int NV12ToYUY2(const uint8* src_y, int src_stride_y,
+               const uint8* src_uv, int src_stride_uv,
+               uint8* dst_yuy2, int dst_stride_yuy2,
+               int width, int height) {
+  int y;
+  void (*NV12ToYUY2Row)(const uint8* src_y, const uint8* src_uv,
+                        uint8* dst_yuy2, int width) = NV12ToYUY2Row_C;
+  if (!src_y || !src_uv || !dst_yuy2 ||
+      width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_yuy2 = dst_yuy2 + (height - 1) * dst_stride_yuy2;
+    dst_stride_yuy2 = -dst_stride_yuy2;
+  }
+#if defined(HAS_NV12TOYUY2ROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    NV12ToYUY2Row = NV12ToYUY2Row_Any_SSE2;
+    if (IS_ALIGNED(width, 16)) {
+      NV12ToYUY2Row = NV12ToYUY2Row_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOYUY2ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    NV12ToYUY2Row = NV12ToYUY2Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      NV12ToYUY2Row = NV12ToYUY2Row_AVX2;
+    }
+  }
+#endif
+
+  for (y = 0; y < height - 1; y += 2) {
+    NV12ToYUY2Row(src_y, src_uv, dst_yuy2, width);
+    NV12ToYUY2Row(src_y + src_stride_y, src_uv,
+                  dst_yuy2 + dst_stride_yuy2, width);
+    src_y += src_stride_y * 2;
+    src_uv += src_stride_uv;
+    dst_yuy2 += dst_stride_yuy2 * 2;
+  }
+  if (height & 1) {
+    NV12ToYUY2Row(src_y, src_uv, dst_yuy2, width);
+  }
+  return 0;
+}
+
+// Convert NV12 to UYVY.
+LIBYUV_API
+int NV12ToUYVY(const uint8* src_y, int src_stride_y,
+               const uint8* src_uv, int src_stride_uv,
+               uint8* dst_uyvy, int dst_stride_uyvy,
+               int width, int height) {
+  int y;
+  void (*NV12ToUYVYRow)(const uint8* src_y, const uint8* src_uv,
+                        uint8* dst_uyvy, int width) = NV12ToUYVYRow_C;
+  if (!src_y || !src_uv || !dst_uyvy ||
+      width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_uyvy = dst_uyvy + (height - 1) * dst_stride_uyvy;
+    dst_stride_uyvy = -dst_stride_uyvy;
+  }
+#if defined(HAS_NV12TOYUY2ROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    NV12ToUYVYRow = NV12ToUYVYRow_Any_SSE2;
+    if (IS_ALIGNED(width, 16)) {
+      NV12ToUYVYRow = NV12ToUYVYRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOYUY2ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    NV12ToUYVYRow = NV12ToUYVYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      NV12ToUYVYRow = NV12ToUYVYRow_AVX2;
+    }
+  }
+#endif
+
+  for (y = 0; y < height - 1; y += 2) {
+    NV12ToUYVYRow(src_y, src_uv, dst_uyvy, width);
+    NV12ToUYVYRow(src_y + src_stride_y, src_uv,
+                  dst_uyvy + dst_stride_uyvy, width);
+    src_y += src_stride_y * 2;
+    src_uv += src_stride_uv;
+    dst_uyvy += dst_stride_uyvy * 2;
+  }
+  if (height & 1) {
+    NV12ToUYVYRow(src_y, src_uv, dst_uyvy, width);
+  }
+  return 0;
+}
+
 LIBYUV_API
 int I422ToUYVY(const uint8* src_y, int src_stride_y,
                const uint8* src_u, int src_stride_u,
@@ -368,7 +471,8 @@ int I420ToNV12(const uint8* src_y, int src_stride_y,
                int width, int height) {
   int y;
   void (*MergeUVRow_)(const uint8* src_u, const uint8* src_v, uint8* dst_uv,
-      int width) = MergeUVRow_C;
+      int width);
+  const struct RowFunctions* rows = GetCpuRowFunctions();
   // Coalesce rows.
   int halfwidth = (width + 1) >> 1;
   int halfheight = (height + 1) >> 1;
@@ -385,6 +489,7 @@ int I420ToNV12(const uint8* src_y, int src_stride_y,
     dst_stride_y = -dst_stride_y;
     dst_stride_uv = -dst_stride_uv;
   }
+  PROFILE_BEGIN((int64)(width) * height, (int64)(width) * height * 3);
   if (src_stride_y == width &&
       dst_stride_y == width) {
     width *= height;
@@ -399,30 +504,8 @@ int I420ToNV12(const uint8* src_y, int src_stride_y,
     halfheight = 1;
     src_stride_u = src_stride_v = dst_stride_uv = 0;
   }
-#if defined(HAS_MERGEUVROW_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2)) {
-    MergeUVRow_ = MergeUVRow_Any_SSE2;
-    if (IS_ALIGNED(halfwidth, 16)) {
-      MergeUVRow_ = MergeUVRow_SSE2;
-    }
-  }
-#endif
-#if defined(HAS_MERGEUVROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    MergeUVRow_ = MergeUVRow_Any_AVX2;
-    if (IS_ALIGNED(halfwidth, 32)) {
-      MergeUVRow_ = MergeUVRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_MERGEUVROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    MergeUVRow_ = MergeUVRow_Any_NEON;
-    if (IS_ALIGNED(halfwidth, 16)) {
-      MergeUVRow_ = MergeUVRow_NEON;
-    }
-  }
-#endif
+  MergeUVRow_ = ROW_FUNCTION(rows, MergeUVRow, halfwidth);
+  DISPATCH_KERNEL("I420ToNV12", MergeUVRow_, halfwidth);
 
   CopyPlane(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
   for (y = 0; y < halfheight; ++y) {
@@ -432,6 +515,7 @@ int I420ToNV12(const uint8* src_y, int src_stride_y,
     src_v += src_stride_v;
     dst_uv += dst_stride_uv;
   }
+  PROFILE_END(kProfileI420ToNV12);
   return 0;
 }
 
@@ -450,6 +534,33 @@ int I420ToNV21(const uint8* src_y, int src_stride_y,
                     width, height);
 }
 
+#if defined(HAS_I422TOARGBROW_SSSE3) && defined(HAS_I422TOARGBROW_AVX2)
+#define HAS_I422TOARGBROW_AUTOTUNE
+typedef void (*I422ToARGBRowFunction)(const uint8* y_buf,
+                                      const uint8* u_buf,
+                                      const uint8* v_buf,
+                                      uint8* rgb_buf,
+                                      int width);
+
+// I422ToARGBRow candidates for autotuning, in the order of
+// kAutotuneI422ToARGBRow.  AVX2 is not always faster on cpus that lower
+// their clock for it.
+static I422ToARGBRowFunction I422ToARGBRowCandidate(int candidate,
+                                                    int width) {
+  if (candidate == 0) {
+    return IS_ALIGNED(width, 8) ? I422ToARGBRow_SSSE3 :
+        I422ToARGBRow_Any_SSSE3;
+  }
+  return IS_ALIGNED(width, 16) ? I422ToARGBRow_AVX2 : I422ToARGBRow_Any_AVX2;
+}
+
+static void RunI422ToARGBRowCandidate(int candidate, const uint8* src,
+                                      uint8* dst, int width) {
+  I422ToARGBRowCandidate(candidate, width)(src, src + width,
+                                           src + width * 2, dst, width);
+}
+#endif
+
 // Convert I420 to ARGB.
 LIBYUV_API
 int I420ToARGB(const uint8* src_y, int src_stride_y,
@@ -462,7 +573,9 @@ int I420ToARGB(const uint8* src_y, int src_stride_y,
                         const uint8* u_buf,
                         const uint8* v_buf,
                         uint8* rgb_buf,
-                        int width) = I422ToARGBRow_C;
+                        int width);
+  void (*CopyRow_NT)(const uint8* src, uint8* dst, int width) = NULL;
+  const struct RowFunctions* rows = GetRowFunctions();
   if (!src_y || !src_u || !src_v || !dst_argb ||
       width <= 0 || height == 0) {
     return -1;
@@ -473,31 +586,10 @@ int I420ToARGB(const uint8* src_y, int src_stride_y,
     dst_argb = dst_argb + (height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
-#if defined(HAS_I422TOARGBROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    I422ToARGBRow = I422ToARGBRow_Any_SSSE3;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    I422ToARGBRow = I422ToARGBRow_Any_AVX2;
-    if (IS_ALIGNED(width, 16)) {
-      I422ToARGBRow = I422ToARGBRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    I422ToARGBRow = I422ToARGBRow_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_NEON;
-    }
-  }
-#endif
+  PROFILE_BEGIN((int64)(width) * height, (int64)(width) * height * 11 / 2);
+  I422ToARGBRow = ROW_FUNCTION(rows, I422ToARGBRow, width);
 #if defined(HAS_I422TOARGBROW_MIPS_DSPR2)
+  // Needs aligned pointers, so is not in the table.
   if (TestCpuFlag(kCpuHasMIPS_DSPR2) && IS_ALIGNED(width, 4) &&
       IS_ALIGNED(src_y, 4) && IS_ALIGNED(src_stride_y, 4) &&
       IS_ALIGNED(src_u, 2) && IS_ALIGNED(src_stride_u, 2) &&
@@ -506,6 +598,44 @@ int I420ToARGB(const uint8* src_y, int src_stride_y,
     I422ToARGBRow = I422ToARGBRow_MIPS_DSPR2;
   }
 #endif
+#if defined(HAS_I422TOARGBROW_AUTOTUNE)
+  // Candidates are exact, so are not used for fast precision.
+  if (autotune_enabled_ && GetPrecision() == kPrecisionExact) {
+    int choice = AutotuneSelect(kAutotuneI422ToARGBRow, width,
+                                (TestCpuFlag(kCpuHasSSSE3) ? 1 : 0) |
+                                (TestCpuFlag(kCpuHasAVX2) ? 2 : 0),
+                                RunI422ToARGBRowCandidate);
+    if (choice >= 0) {
+      I422ToARGBRow = I422ToARGBRowCandidate(choice, width);
+    }
+  }
+#endif
+#if defined(HAS_COPYROW_NT_SSE2)
+  if (UseStreamingStores(dst_argb, dst_stride_argb,
+                         (int64)(width) * 4 * height)) {
+    CopyRow_NT = IS_ALIGNED(width, 16) ? CopyRow_NT_SSE2 : CopyRow_NT_Any_SSE2;
+  }
+#endif
+  DISPATCH_KERNEL("I420ToARGB", I422ToARGBRow, width);
+
+  if (CopyRow_NT) {
+    DISPATCH_KERNEL("I420ToARGB", CopyRow_NT, width * 4);
+    // Convert each row in cache then stream it out.
+    align_buffer_64(row, width * 4);
+    for (y = 0; y < height; ++y) {
+      I422ToARGBRow(src_y, src_u, src_v, row, width);
+      CopyRow_NT(row, dst_argb, width * 4);
+      dst_argb += dst_stride_argb;
+      src_y += src_stride_y;
+      if (y & 1) {
+        src_u += src_stride_u;
+        src_v += src_stride_v;
+      }
+    }
+    free_aligned_buffer_64(row);
+    PROFILE_END(kProfileI420ToARGB);
+    return 0;
+  }
 
   for (y = 0; y < height; ++y) {
     I422ToARGBRow(src_y, src_u, src_v, dst_argb, width);
@@ -516,6 +646,7 @@ int I420ToARGB(const uint8* src_y, int src_stride_y,
       src_v += src_stride_v;
     }
   }
+  PROFILE_END(kProfileI420ToARGB);
   return 0;
 }
 
@@ -1134,6 +1265,8 @@ int ConvertFromI420(const uint8* y, int y_stride,
       width <= 0 || height == 0) {
     return -1;
   }
+  PROFILE_BEGIN((int64)(width) * Abs(height),
+                (int64)(width) * Abs(height) * 3 / 2);
   switch (format) {
     // Single plane formats
     case FOURCC_YUY2:
@@ -1339,6 +1472,9 @@ int ConvertFromI420(const uint8* y, int y_stride,
     default:
       return -1;  // unknown fourcc - return failure code.
   }
+  if (!r) {
+    PROFILE_END(kProfileConvertFromI420);
+  }
   return r;
 }
 
@@ -1095,6 +1095,9 @@ int ARGBToJ420(const uint8* src_argb, int src_stride_argb,
                        uint8* dst_u, uint8* dst_v, int width) = ARGBToUVJRow_C;
   void (*ARGBToYJRow)(const uint8* src_argb, uint8* dst_yj, int pix) =
       ARGBToYJRow_C;
+  void (*ARGBToJ420Row)(const uint8* src_argb, int src_stride_argb,
+      uint8* dst_y, int dst_stride_y,
+      uint8* dst_u, uint8* dst_v, int width) = NULL;
   if (!src_argb ||
       !dst_yj || !dst_u || !dst_v ||
       width <= 0 || height == 0) {
@@ -1124,6 +1127,14 @@ int ARGBToJ420(const uint8* src_argb, int src_stride_argb,
     }
   }
 #endif
+#if defined(HAS_ARGBTOUVJROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToUVJRow = ARGBToUVJRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVJRow = ARGBToUVJRow_AVX2;
+    }
+  }
+#endif
 #if defined(HAS_ARGBTOYJROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     ARGBToYJRow = ARGBToYJRow_Any_NEON;
@@ -1141,10 +1152,32 @@ int ARGBToJ420(const uint8* src_argb, int src_stride_argb,
   }
 #endif
 
+#if defined(HAS_ARGBTOJ420ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBToJ420Row = ARGBToJ420Row_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToJ420Row = ARGBToJ420Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOJ420ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToJ420Row = ARGBToJ420Row_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToJ420Row = ARGBToJ420Row_AVX2;
+    }
+  }
+#endif
+
   for (y = 0; y < height - 1; y += 2) {
-    ARGBToUVJRow(src_argb, src_stride_argb, dst_u, dst_v, width);
-    ARGBToYJRow(src_argb, dst_yj, width);
-    ARGBToYJRow(src_argb + src_stride_argb, dst_yj + dst_stride_yj, width);
+    if (ARGBToJ420Row) {
+      ARGBToJ420Row(src_argb, src_stride_argb, dst_yj, dst_stride_yj,
+                    dst_u, dst_v, width);
+    } else {
+      ARGBToUVJRow(src_argb, src_stride_argb, dst_u, dst_v, width);
+      ARGBToYJRow(src_argb, dst_yj, width);
+      ARGBToYJRow(src_argb + src_stride_argb, dst_yj + dst_stride_yj, width);
+    }
     src_argb += src_stride_argb * 2;
     dst_yj += dst_stride_yj * 2;
     dst_u += dst_stride_u;
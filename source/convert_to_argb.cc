@@ -67,7 +67,7 @@ int ConvertToARGB(const uint8* sample, size_t sample_size,
 
   if (need_buf) {
     int argb_size = crop_width * abs_crop_height * 4;
-    rotate_buffer = (uint8*)malloc(argb_size);
+    rotate_buffer = (uint8*)ScratchAlloc(argb_size);
     if (!rotate_buffer) {
       return 1;  // Out of memory runtime error.
     }
@@ -294,7 +294,7 @@ int ConvertToARGB(const uint8* sample, size_t sample_size,
                      tmp_argb, tmp_argb_stride,
                      crop_width, abs_crop_height, rotation);
     }
-    free(rotate_buffer);
+    ScratchFree(rotate_buffer);
   }
 
   return r;
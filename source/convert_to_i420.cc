@@ -12,6 +12,8 @@
 
 #include "libyuv/convert.h"
 
+#include "libyuv/profile.h"
+#include "libyuv/row.h"
 #include "libyuv/video_common.h"
 
 #ifdef __cplusplus
@@ -62,6 +64,9 @@ int ConvertToI420(const uint8* sample,
   if (src_height < 0) {
     inv_crop_height = -inv_crop_height;
   }
+  PROFILE_BEGIN((int64)(crop_width) * abs_crop_height,
+                (int64)(sample_size) +
+                (int64)(crop_width) * abs_crop_height * 3 / 2);
 
   // One pass rotation is available for some formats. For the rest, convert
   // to I420 (with optional vertical flipping) into a temporary I420 buffer,
@@ -71,7 +76,7 @@ int ConvertToI420(const uint8* sample,
   if (need_buf) {
     int y_size = crop_width * abs_crop_height;
     int uv_size = ((crop_width + 1) / 2) * ((abs_crop_height + 1) / 2);
-    rotate_buffer = (uint8*)malloc(y_size + uv_size * 2);
+    rotate_buffer = (uint8*)ScratchAlloc(y_size + uv_size * 2);
     if (!rotate_buffer) {
       return 1;  // Out of memory runtime error.
     }
@@ -327,9 +332,12 @@ int ConvertToI420(const uint8* sample,
                      tmp_v, tmp_v_stride,
                      crop_width, abs_crop_height, rotation);
     }
-    free(rotate_buffer);
+    ScratchFree(rotate_buffer);
   }
 
+  if (!r) {
+    PROFILE_END(kProfileConvertToI420);
+  }
   return r;
 }
 
@@ -22,6 +22,15 @@
 #if !defined(__native_client__)
 #include <stdlib.h>  // For getenv()
 #endif
+#if defined(_WIN32) && !defined(__CLR_VER)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>  // For GetSystemInfo()
+#endif
+#if defined(__APPLE__)
+#include <sys/sysctl.h>  // For sysctlbyname()
+#endif
 
 // For ArmCpuCaps() but unittested on all platforms
 #include <stdio.h>
@@ -173,9 +182,15 @@ static int MipsCpuCaps(const char* search_string) {
 #endif
 
 // CPU detect function for SIMD instruction sets.
+#if defined(LIBYUV_TARGET_FLAGS)
+LIBYUV_API
+int cpu_info_ = LIBYUV_TARGET_FLAGS;  // Fixed at compile time.
+#else
 LIBYUV_API
 int cpu_info_ = kCpuInit;  // cpu_info is not initialized yet.
+#endif
 
+#if !defined(LIBYUV_TARGET_FLAGS)
 // Test environment variable for disabling CPU features. Any non-zero value
 // to disable. Zero ignored to make it easy to set the variable on/off.
 #if !defined(__native_client__) && !defined(_M_ARM)
@@ -194,9 +209,13 @@ static LIBYUV_BOOL TestEnv(const char*) {
   return LIBYUV_FALSE;
 }
 #endif
+#endif  // LIBYUV_TARGET_FLAGS
 
 LIBYUV_API SAFEBUFFERS
 int InitCpuFlags(void) {
+#if defined(LIBYUV_TARGET_FLAGS)
+  return cpu_info_;
+#else
 #if !defined(__pnacl__) && !defined(__CLR_VER) && defined(CPU_X86)
 
   uint32 cpu_info0[4] = { 0, 0, 0, 0 };
@@ -294,11 +313,267 @@ int InitCpuFlags(void) {
     cpu_info_ = 0;
   }
   return cpu_info_;
+#endif  // LIBYUV_TARGET_FLAGS
 }
 
 LIBYUV_API
 void MaskCpuFlags(int enable_flags) {
+#if !defined(LIBYUV_TARGET_FLAGS)
   cpu_info_ = InitCpuFlags() & enable_flags;
+#endif
+}
+
+// Cache topology, detected on first use.
+static struct CpuCacheInfo cpu_cache_info_;
+static int cpu_cache_info_init_ = 0;
+
+#if !defined(__pnacl__) && !defined(__CLR_VER) && defined(CPU_X86)
+// Read deterministic cache parameters from cpuid leaf 4 on Intel or
+// 0x8000001D on AMD.  Each subleaf describes one cache.
+static void CpuIdCacheInfo(uint32 leaf, struct CpuCacheInfo* info) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+    uint32 cache_info[4] = { 0, 0, 0, 0 };
+    int type, level, line_size, size;
+    CpuId(leaf, i, cache_info);
+    type = cache_info[0] & 0x1f;  // 1 data, 2 instruction, 3 unified.
+    if (type == 0) {
+      break;
+    }
+    if (type == 2) {
+      continue;
+    }
+    level = (cache_info[0] >> 5) & 7;
+    line_size = (cache_info[1] & 0xfff) + 1;
+    size = ((cache_info[1] >> 22) + 1) *  // ways
+           (((cache_info[1] >> 12) & 0x3ff) + 1) *  // partitions
+           line_size * (cache_info[2] + 1);  // sets
+    if (level == 1) {
+      info->l1d_size = size;
+      info->line_size = line_size;
+    } else if (level == 2) {
+      info->l2_size = size;
+    } else if (level == 3) {
+      info->l3_size = size;
+    }
+  }
+}
+
+static void X86CacheInfo(struct CpuCacheInfo* info) {
+  uint32 cpu_info0[4] = { 0, 0, 0, 0 };
+  uint32 cpu_info80[4] = { 0, 0, 0, 0 };
+  uint32 cpu_info81[4] = { 0, 0, 0, 0 };
+  LIBYUV_BOOL is_amd;
+  CpuId(0, 0, cpu_info0);
+  CpuId(0x80000000, 0, cpu_info80);
+  if (cpu_info80[0] >= 0x80000001) {
+    CpuId(0x80000001, 0, cpu_info81);
+  }
+  // "AuthenticAMD" in ebx, edx, ecx.
+  is_amd = cpu_info0[1] == 0x68747541 && cpu_info0[3] == 0x69746e65 &&
+           cpu_info0[2] == 0x444d4163;
+  if (!is_amd) {
+    if (cpu_info0[0] >= 4) {
+      CpuIdCacheInfo(4, info);
+    }
+  } else if (cpu_info80[0] >= 0x8000001d &&
+             (cpu_info81[2] & 0x00400000)) {  // Topology extensions.
+    CpuIdCacheInfo(0x8000001d, info);
+  } else {
+    uint32 cpu_info85[4] = { 0, 0, 0, 0 };
+    uint32 cpu_info86[4] = { 0, 0, 0, 0 };
+    if (cpu_info80[0] >= 0x80000006) {
+      CpuId(0x80000005, 0, cpu_info85);
+      CpuId(0x80000006, 0, cpu_info86);
+    }
+    info->l1d_size = (cpu_info85[2] >> 24) * 1024;
+    info->line_size = cpu_info85[2] & 0xff;
+    info->l2_size = (cpu_info86[2] >> 16) * 1024;
+    info->l3_size = (cpu_info86[3] >> 18) * 512 * 1024;
+  }
+}
+#endif
+
+#if defined(_MSC_VER) && (_MSC_VER < 1900)
+#define snprintf _snprintf
+#endif
+
+// Read the first number in a file, scaled by a K or M suffix.
+// Returns -1 if the file can not be opened.
+static int ReadSysfsInt(const char* name) {
+  char line[64];
+  int value = 0;
+  FILE* f = fopen(name, "r");
+  if (!f) {
+    return -1;
+  }
+  if (fgets(line, sizeof(line) - 1, f)) {
+    const char* p = line;
+    while (*p >= '0' && *p <= '9') {
+      value = value * 10 + (*p - '0');
+      ++p;
+    }
+    if (*p == 'K') {
+      value *= 1024;
+    } else if (*p == 'M') {
+      value *= 1024 * 1024;
+    }
+  }
+  fclose(f);
+  return value;
+}
+
+// Caches of cpu0 are in cpu0/cache/index*.  Each cpu is a new core if it is
+// the first of its thread siblings.
+LIBYUV_API SAFEBUFFERS
+int LinuxCpuCacheInfo(const char* cpu_dir, struct CpuCacheInfo* info) {
+  char name[512];
+  int found = 0;
+  int num_cores = 0;
+  int i;
+  for (i = 0; i < 16; ++i) {
+    char type[64] = { 0 };
+    int level, size;
+    FILE* f;
+    snprintf(name, sizeof(name), "%s/cpu0/cache/index%d/type", cpu_dir, i);
+    f = fopen(name, "r");
+    if (!f) {
+      break;
+    }
+    if (!fgets(type, sizeof(type) - 1, f)) {
+      type[0] = 0;
+    }
+    fclose(f);
+    if (memcmp(type, "Instruction", 11) == 0) {
+      continue;
+    }
+    snprintf(name, sizeof(name), "%s/cpu0/cache/index%d/level", cpu_dir, i);
+    level = ReadSysfsInt(name);
+    snprintf(name, sizeof(name), "%s/cpu0/cache/index%d/size", cpu_dir, i);
+    size = ReadSysfsInt(name);
+    if (size <= 0) {
+      continue;
+    }
+    if (level == 1) {
+      snprintf(name, sizeof(name),
+               "%s/cpu0/cache/index%d/coherency_line_size", cpu_dir, i);
+      info->l1d_size = size;
+      info->line_size = ReadSysfsInt(name);
+    } else if (level == 2) {
+      info->l2_size = size;
+    } else if (level == 3) {
+      info->l3_size = size;
+    }
+    found = 1;
+  }
+  for (i = 0; i < 4096; ++i) {
+    int first_sibling;
+    snprintf(name, sizeof(name), "%s/cpu%d/topology/thread_siblings_list",
+             cpu_dir, i);
+    first_sibling = ReadSysfsInt(name);
+    if (first_sibling < 0) {
+      break;
+    }
+    if (first_sibling == i) {
+      ++num_cores;
+    }
+  }
+  if (i > 0) {
+    info->num_cores = num_cores;
+    info->num_threads = i;
+    found = 1;
+  }
+  return found;
+}
+
+#if defined(__APPLE__)
+static int SysctlInt(const char* name) {
+  int64 value = 0;
+  size_t size = sizeof(value);
+  if (sysctlbyname(name, &value, &size, NULL, 0) != 0) {
+    return 0;
+  }
+  return size == sizeof(int) ? *(int*)(&value) : (int)(value);
+}
+#endif
+
+static void InitCpuCacheInfo(struct CpuCacheInfo* info) {
+  memset(info, 0, sizeof(*info));
+#if !defined(__pnacl__) && !defined(__CLR_VER) && defined(CPU_X86)
+  X86CacheInfo(info);
+#endif
+#if defined(__linux__) && !defined(__native_client__)
+  {
+    struct CpuCacheInfo sysfs_info;
+    memset(&sysfs_info, 0, sizeof(sysfs_info));
+    if (LinuxCpuCacheInfo("/sys/devices/system/cpu", &sysfs_info)) {
+      if (!info->l1d_size) {
+        info->l1d_size = sysfs_info.l1d_size;
+        info->line_size = sysfs_info.line_size;
+      }
+      if (!info->l2_size) {
+        info->l2_size = sysfs_info.l2_size;
+      }
+      if (!info->l3_size) {
+        info->l3_size = sysfs_info.l3_size;
+      }
+      info->num_cores = sysfs_info.num_cores;
+      info->num_threads = sysfs_info.num_threads;
+    }
+  }
+#elif defined(__APPLE__)
+  if (!info->l1d_size) {
+    info->l1d_size = SysctlInt("hw.l1dcachesize");
+    info->line_size = SysctlInt("hw.cachelinesize");
+    info->l2_size = SysctlInt("hw.l2cachesize");
+    info->l3_size = SysctlInt("hw.l3cachesize");
+  }
+  info->num_cores = SysctlInt("hw.physicalcpu");
+  info->num_threads = SysctlInt("hw.logicalcpu");
+#elif defined(_WIN32) && !defined(__CLR_VER)
+  {
+    SYSTEM_INFO system_info;
+    GetSystemInfo(&system_info);
+    info->num_threads = (int)(system_info.dwNumberOfProcessors);
+  }
+#endif
+  if (info->l1d_size <= 0) {
+    info->l1d_size = 32 * 1024;
+  }
+  if (info->l2_size <= 0) {
+    info->l2_size = 256 * 1024;
+  }
+  if (info->l3_size < 0) {
+    info->l3_size = 0;
+  }
+  if (info->line_size <= 0) {
+    info->line_size = 64;
+  }
+  if (info->num_threads <= 0) {
+    info->num_threads = 1;
+  }
+  if (info->num_cores <= 0 || info->num_cores > info->num_threads) {
+    info->num_cores = info->num_threads;
+  }
+}
+
+LIBYUV_API
+void GetCpuCacheInfo(struct CpuCacheInfo* info) {
+  if (!cpu_cache_info_init_) {
+    InitCpuCacheInfo(&cpu_cache_info_);
+    cpu_cache_info_init_ = 1;
+  }
+  *info = cpu_cache_info_;
+}
+
+LIBYUV_API
+void SetCpuCacheInfo(const struct CpuCacheInfo* info) {
+  if (info) {
+    cpu_cache_info_ = *info;
+    cpu_cache_info_init_ = 1;
+  } else {
+    cpu_cache_info_init_ = 0;
+  }
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/dispatch.h"
+
+#include <string.h>  // For strstr.
+
+#include "libyuv/row.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+LIBYUV_API
+KernelDispatchCallback kernel_dispatch_callback_ = NULL;
+
+struct KernelName {
+  const void* kernel;
+  const char* name;
+};
+
+#define KERNEL(name) { (const void*)(name), #name }
+
+// Row functions that can be picked by the reporting functions.
+static const struct KernelName kKernelNames[] = {
+  KERNEL(I422ToARGBRow_C),
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  KERNEL(I422ToARGBRow_SSSE3),
+  KERNEL(I422ToARGBRow_Any_SSSE3),
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+  KERNEL(I422ToARGBRow_AVX2),
+  KERNEL(I422ToARGBRow_Any_AVX2),
+#endif
+#if defined(HAS_I422TOARGBROW_NEON)
+  KERNEL(I422ToARGBRow_NEON),
+  KERNEL(I422ToARGBRow_Any_NEON),
+#endif
+#if defined(HAS_I422TOARGBROW_MIPS_DSPR2)
+  KERNEL(I422ToARGBRow_MIPS_DSPR2),
+#endif
+#if defined(HAS_I422TOARGBFASTROW_SSSE3)
+  KERNEL(I422ToARGBFastRow_SSSE3),
+  KERNEL(I422ToARGBFastRow_Any_SSSE3),
+#endif
+#if defined(HAS_I422TOARGBFASTROW_AVX2)
+  KERNEL(I422ToARGBFastRow_AVX2),
+  KERNEL(I422ToARGBFastRow_Any_AVX2),
+#endif
+  KERNEL(NV12ToARGBRow_C),
+#if defined(HAS_NV12TOARGBROW_SSSE3)
+  KERNEL(NV12ToARGBRow_SSSE3),
+  KERNEL(NV12ToARGBRow_Any_SSSE3),
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX2)
+  KERNEL(NV12ToARGBRow_AVX2),
+  KERNEL(NV12ToARGBRow_Any_AVX2),
+#endif
+#if defined(HAS_NV12TOARGBROW_NEON)
+  KERNEL(NV12ToARGBRow_NEON),
+  KERNEL(NV12ToARGBRow_Any_NEON),
+#endif
+  KERNEL(ARGBToYRow_C),
+#if defined(HAS_ARGBTOYROW_SSSE3)
+  KERNEL(ARGBToYRow_SSSE3),
+  KERNEL(ARGBToYRow_Any_SSSE3),
+#endif
+#if defined(HAS_ARGBTOYROW_AVX2)
+  KERNEL(ARGBToYRow_AVX2),
+  KERNEL(ARGBToYRow_Any_AVX2),
+#endif
+#if defined(HAS_ARGBTOYROW_NEON)
+  KERNEL(ARGBToYRow_NEON),
+  KERNEL(ARGBToYRow_Any_NEON),
+#endif
+  KERNEL(ARGBToUVRow_C),
+#if defined(HAS_ARGBTOUVROW_SSSE3)
+  KERNEL(ARGBToUVRow_SSSE3),
+  KERNEL(ARGBToUVRow_Any_SSSE3),
+#endif
+#if defined(HAS_ARGBTOUVROW_AVX2)
+  KERNEL(ARGBToUVRow_AVX2),
+  KERNEL(ARGBToUVRow_Any_AVX2),
+#endif
+#if defined(HAS_ARGBTOUVROW_NEON)
+  KERNEL(ARGBToUVRow_NEON),
+  KERNEL(ARGBToUVRow_Any_NEON),
+#endif
+#if defined(HAS_ARGBTOI420ROW_SSSE3)
+  KERNEL(ARGBToI420Row_SSSE3),
+  KERNEL(ARGBToI420Row_Any_SSSE3),
+#endif
+#if defined(HAS_ARGBTOI420ROW_AVX2)
+  KERNEL(ARGBToI420Row_AVX2),
+  KERNEL(ARGBToI420Row_Any_AVX2),
+#endif
+  KERNEL(MergeUVRow_C),
+#if defined(HAS_MERGEUVROW_SSE2)
+  KERNEL(MergeUVRow_SSE2),
+  KERNEL(MergeUVRow_Any_SSE2),
+#endif
+#if defined(HAS_MERGEUVROW_AVX2)
+  KERNEL(MergeUVRow_AVX2),
+  KERNEL(MergeUVRow_Any_AVX2),
+#endif
+#if defined(HAS_MERGEUVROW_NEON)
+  KERNEL(MergeUVRow_NEON),
+  KERNEL(MergeUVRow_Any_NEON),
+#endif
+  KERNEL(CopyRow_C),
+#if defined(HAS_COPYROW_SSE2)
+  KERNEL(CopyRow_SSE2),
+  KERNEL(CopyRow_Any_SSE2),
+#endif
+#if defined(HAS_COPYROW_AVX)
+  KERNEL(CopyRow_AVX),
+  KERNEL(CopyRow_Any_AVX),
+#endif
+#if defined(HAS_COPYROW_ERMS)
+  KERNEL(CopyRow_ERMS),
+#endif
+#if defined(HAS_COPYROW_NEON)
+  KERNEL(CopyRow_NEON),
+  KERNEL(CopyRow_Any_NEON),
+#endif
+#if defined(HAS_COPYROW_MIPS)
+  KERNEL(CopyRow_MIPS),
+#endif
+#if defined(HAS_COPYROW_NT_SSE2)
+  KERNEL(CopyRow_NT_SSE2),
+  KERNEL(CopyRow_NT_Any_SSE2),
+#endif
+};
+
+#undef KERNEL
+
+LIBYUV_API
+void SetKernelDispatchCallback(KernelDispatchCallback callback) {
+  kernel_dispatch_callback_ = callback;
+}
+
+LIBYUV_API
+const char* GetKernelName(const void* kernel) {
+  int i;
+  for (i = 0; i < (int)(sizeof(kKernelNames) / sizeof(kKernelNames[0]));
+       ++i) {
+    if (kKernelNames[i].kernel == kernel) {
+      return kKernelNames[i].name;
+    }
+  }
+  return NULL;
+}
+
+void ReportKernelDispatch(const char* function, const void* kernel,
+                          int width) {
+  KernelDispatchCallback callback = kernel_dispatch_callback_;
+  const char* name = GetKernelName(kernel);
+  if (!callback) {
+    return;
+  }
+  if (!name) {
+    name = "unknown";
+  }
+  callback(function, name, strstr(name, "_Any_") != NULL, width);
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
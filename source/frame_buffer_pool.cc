@@ -0,0 +1,268 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/frame_buffer_pool.h"
+
+#include <stdlib.h>  // For malloc.
+#include <string.h>  // For memset.
+
+#if defined(__linux__)
+#include <sys/mman.h>  // For mmap.
+#define HAS_FRAMEBUFFER_MMAP
+#endif
+
+#include "libyuv/video_common.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+static const size_t kHugePageSize = 2 * 1024 * 1024;
+
+#define ALIGNUP(v) (((v) + kFrameBufferAlignment - 1) & \
+    ~(kFrameBufferAlignment - 1))
+
+// Bytes per row and rows of each plane of a fourcc.  Returns the number of
+// planes, or 0 if the fourcc is not a raw format.
+static int FramePlaneSizes(uint32 fourcc, int width, int height,
+                           int* row_bytes, int* rows) {
+  int halfwidth = (width + 1) / 2;
+  int halfheight = (height + 1) / 2;
+  switch (fourcc) {
+    case FOURCC_I420:
+    case FOURCC_YV12:
+    case FOURCC_J420:
+      row_bytes[1] = row_bytes[2] = halfwidth;
+      rows[1] = rows[2] = halfheight;
+      break;
+    case FOURCC_I422:
+    case FOURCC_YV16:
+      row_bytes[1] = row_bytes[2] = halfwidth;
+      rows[1] = rows[2] = height;
+      break;
+    case FOURCC_I444:
+    case FOURCC_YV24:
+      row_bytes[1] = row_bytes[2] = width;
+      rows[1] = rows[2] = height;
+      break;
+    case FOURCC_I411:
+      row_bytes[1] = row_bytes[2] = (width + 3) / 4;
+      rows[1] = rows[2] = height;
+      break;
+    case FOURCC_NV12:
+    case FOURCC_NV21:
+      row_bytes[0] = width;
+      rows[0] = height;
+      row_bytes[1] = halfwidth * 2;
+      rows[1] = halfheight;
+      return 2;
+    case FOURCC_I400:
+    case FOURCC_J400:
+    case FOURCC_RGGB:
+    case FOURCC_BGGR:
+    case FOURCC_GRBG:
+    case FOURCC_GBRG:
+      row_bytes[0] = width;
+      rows[0] = height;
+      return 1;
+    case FOURCC_YUY2:
+    case FOURCC_UYVY:
+      row_bytes[0] = halfwidth * 4;
+      rows[0] = height;
+      return 1;
+    case FOURCC_RGBP:
+    case FOURCC_RGBO:
+    case FOURCC_R444:
+      row_bytes[0] = width * 2;
+      rows[0] = height;
+      return 1;
+    case FOURCC_24BG:
+    case FOURCC_RAW:
+      row_bytes[0] = width * 3;
+      rows[0] = height;
+      return 1;
+    case FOURCC_ARGB:
+    case FOURCC_BGRA:
+    case FOURCC_ABGR:
+    case FOURCC_RGBA:
+      row_bytes[0] = width * 4;
+      rows[0] = height;
+      return 1;
+    default:
+      return 0;
+  }
+  row_bytes[0] = width;
+  rows[0] = height;
+  return 3;
+}
+
+// Allocate aligned memory for a frame, from huge pages if requested.
+static LIBYUV_BOOL FrameBufferAlloc(struct FrameBuffer* buffer, size_t size,
+                                    int flags) {
+#ifdef HAS_FRAMEBUFFER_MMAP
+  if ((flags & kFrameBufferPoolHugePages) && size >= kHugePageSize) {
+    size_t mapped_size = (size + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    void* mem = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    // Reserved huge pages, if the system has any.
+    mem = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (mem == MAP_FAILED) {
+      mem = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+#ifdef MADV_HUGEPAGE
+      // Ask for transparent huge pages instead.
+      if (mem != MAP_FAILED) {
+        madvise(mem, mapped_size, MADV_HUGEPAGE);
+      }
+#endif
+    }
+    if (mem != MAP_FAILED) {
+      buffer->mem = (uint8*)(mem);
+      buffer->mem_size = mapped_size;
+      buffer->mapped = 1;
+      buffer->plane[0] = buffer->mem;
+      return LIBYUV_TRUE;
+    }
+  }
+#endif
+  buffer->mem = (uint8*)(malloc(size + kFrameBufferAlignment - 1));
+  if (!buffer->mem) {
+    return LIBYUV_FALSE;
+  }
+  buffer->mem_size = size;
+  buffer->mapped = 0;
+  buffer->plane[0] = (uint8*)(ALIGNUP((intptr_t)(buffer->mem)));
+  return LIBYUV_TRUE;
+}
+
+static void FrameBufferDelete(struct FrameBuffer* buffer) {
+#ifdef HAS_FRAMEBUFFER_MMAP
+  if (buffer->mapped) {
+    munmap(buffer->mem, buffer->mem_size);
+  } else
+#endif
+  {
+    free(buffer->mem);
+  }
+  free(buffer);
+}
+
+LIBYUV_API
+void FrameBufferPoolInit(struct FrameBufferPool* pool,
+                         int flags, int max_free) {
+  pool->flags = flags;
+  pool->max_free = max_free;
+  pool->num_free = 0;
+  pool->free_list = NULL;
+}
+
+LIBYUV_API
+struct FrameBuffer* FrameBufferPoolAcquire(struct FrameBufferPool* pool,
+                                           uint32 fourcc,
+                                           int width, int height) {
+  int row_bytes[3];
+  int rows[3];
+  int num_planes;
+  int i;
+  size_t size = 0;
+  struct FrameBuffer** link;
+  struct FrameBuffer* buffer;
+  if (!pool || width <= 0 || height <= 0) {
+    return NULL;
+  }
+  fourcc = CanonicalFourCC(fourcc);
+  num_planes = FramePlaneSizes(fourcc, width, height, row_bytes, rows);
+  if (num_planes == 0) {
+    return NULL;
+  }
+
+  // Reuse a released frame of the same geometry.
+  for (link = &pool->free_list; *link; link = &(*link)->next) {
+    buffer = *link;
+    if (buffer->fourcc == fourcc && buffer->width == width &&
+        buffer->height == height) {
+      *link = buffer->next;
+      buffer->next = NULL;
+      --pool->num_free;
+      return buffer;
+    }
+  }
+
+  buffer = (struct FrameBuffer*)(malloc(sizeof(struct FrameBuffer)));
+  if (!buffer) {
+    return NULL;
+  }
+  memset(buffer, 0, sizeof(*buffer));
+  for (i = 0; i < num_planes; ++i) {
+    buffer->stride[i] = ALIGNUP(row_bytes[i]);
+    size += (size_t)(buffer->stride[i]) * rows[i];
+  }
+  if (!FrameBufferAlloc(buffer, size, pool->flags)) {
+    free(buffer);
+    return NULL;
+  }
+  for (i = 1; i < num_planes; ++i) {
+    buffer->plane[i] = buffer->plane[i - 1] +
+        (size_t)(buffer->stride[i - 1]) * rows[i - 1];
+  }
+  buffer->fourcc = fourcc;
+  buffer->width = width;
+  buffer->height = height;
+  buffer->num_planes = num_planes;
+  return buffer;
+}
+
+LIBYUV_API
+void FrameBufferPoolRelease(struct FrameBufferPool* pool,
+                            struct FrameBuffer* buffer) {
+  struct FrameBuffer* last;
+  if (!pool || !buffer) {
+    return;
+  }
+  if (pool->max_free <= 0) {
+    FrameBufferDelete(buffer);
+    return;
+  }
+  // Drop the least recently released frame when the pool is full.
+  if (pool->num_free == pool->max_free) {
+    struct FrameBuffer** link = &pool->free_list;
+    while ((*link)->next) {
+      link = &(*link)->next;
+    }
+    last = *link;
+    *link = NULL;
+    FrameBufferDelete(last);
+    --pool->num_free;
+  }
+  buffer->next = pool->free_list;
+  pool->free_list = buffer;
+  ++pool->num_free;
+}
+
+LIBYUV_API
+void FrameBufferPoolFree(struct FrameBufferPool* pool) {
+  if (!pool) {
+    return;
+  }
+  while (pool->free_list) {
+    struct FrameBuffer* buffer = pool->free_list;
+    pool->free_list = buffer->next;
+    FrameBufferDelete(buffer);
+  }
+  pool->num_free = 0;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -12,10 +12,13 @@
 
 #include <string.h>  // for memset()
 
+#include "libyuv/autotune.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/dispatch.h"
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
 #endif
+#include "libyuv/profile.h"
 #include "libyuv/row.h"
 
 #ifdef __cplusplus
@@ -23,13 +26,66 @@ namespace libyuv {
 extern "C" {
 #endif
 
+static int64 streaming_store_threshold = kStreamingStoreThreshold;
+static LIBYUV_BOOL streaming_store_threshold_set = LIBYUV_FALSE;
+
+LIBYUV_API
+void SetStreamingStoreThreshold(int64 bytes) {
+  streaming_store_threshold = bytes;
+  streaming_store_threshold_set = LIBYUV_TRUE;
+}
+
+// Streaming stores need 16 byte aligned rows.
+LIBYUV_BOOL UseStreamingStores(const uint8* dst, int dst_stride, int64 size) {
+#if defined(HAS_COPYROW_NT_SSE2)
+  int64 threshold = streaming_store_threshold;
+  if (!streaming_store_threshold_set) {
+    // Output that does not fit in L3 would evict it anyway.
+    struct CpuCacheInfo cache_info;
+    GetCpuCacheInfo(&cache_info);
+    if (cache_info.l3_size && cache_info.l3_size < threshold) {
+      threshold = cache_info.l3_size;
+    }
+  }
+  return threshold >= 0 && size > threshold &&
+      TestCpuFlag(kCpuHasSSE2) &&
+      IS_ALIGNED(dst, 16) && IS_ALIGNED(dst_stride, 16);
+#else
+  return LIBYUV_FALSE;
+#endif
+}
+
+#if defined(HAS_COPYROW_SSE2) && defined(HAS_COPYROW_AVX) && \
+    defined(HAS_COPYROW_ERMS)
+#define HAS_COPYROW_AUTOTUNE
+typedef void (*CopyRowFunction)(const uint8* src, uint8* dst, int count);
+
+// CopyRow candidates for autotuning, in the order of kAutotuneCopyRow.
+static CopyRowFunction CopyRowCandidate(int candidate, int width) {
+  switch (candidate) {
+    case 0:
+      return IS_ALIGNED(width, 32) ? CopyRow_SSE2 : CopyRow_Any_SSE2;
+    case 1:
+      return IS_ALIGNED(width, 64) ? CopyRow_AVX : CopyRow_Any_AVX;
+    default:
+      return CopyRow_ERMS;
+  }
+}
+
+static void RunCopyRowCandidate(int candidate, const uint8* src, uint8* dst,
+                                int width) {
+  CopyRowCandidate(candidate, width)(src, dst, width);
+}
+#endif
+
 // Copy a plane of data
 LIBYUV_API
 void CopyPlane(const uint8* src_y, int src_stride_y,
                uint8* dst_y, int dst_stride_y,
                int width, int height) {
   int y;
-  void (*CopyRow)(const uint8* src, uint8* dst, int width) = CopyRow_C;
+  void (*CopyRow)(const uint8* src, uint8* dst, int width);
+  const struct RowFunctions* rows = GetCpuRowFunctions();
   // Coalesce rows.
   if (src_stride_y == width &&
       dst_stride_y == width) {
@@ -41,31 +97,26 @@ void CopyPlane(const uint8* src_y, int src_stride_y,
   if (src_y == dst_y && src_stride_y == dst_stride_y) {
     return;
   }
-#if defined(HAS_COPYROW_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2)) {
-    CopyRow = IS_ALIGNED(width, 32) ? CopyRow_SSE2 : CopyRow_Any_SSE2;
-  }
-#endif
-#if defined(HAS_COPYROW_AVX)
-  if (TestCpuFlag(kCpuHasAVX)) {
-    CopyRow = IS_ALIGNED(width, 64) ? CopyRow_AVX : CopyRow_Any_AVX;
-  }
-#endif
-#if defined(HAS_COPYROW_ERMS)
-  if (TestCpuFlag(kCpuHasERMS)) {
-    CopyRow = CopyRow_ERMS;
-  }
-#endif
-#if defined(HAS_COPYROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    CopyRow = IS_ALIGNED(width, 32) ? CopyRow_NEON : CopyRow_Any_NEON;
+  PROFILE_BEGIN((int64)(width) * height, (int64)(width) * height * 2);
+  CopyRow = ROW_FUNCTION(rows, CopyRow, width);
+#if defined(HAS_COPYROW_AUTOTUNE)
+  if (autotune_enabled_) {
+    int choice = AutotuneSelect(kAutotuneCopyRow, width,
+                                (TestCpuFlag(kCpuHasSSE2) ? 1 : 0) |
+                                (TestCpuFlag(kCpuHasAVX) ? 2 : 0) |
+                                (TestCpuFlag(kCpuHasERMS) ? 4 : 0),
+                                RunCopyRowCandidate);
+    if (choice >= 0) {
+      CopyRow = CopyRowCandidate(choice, width);
+    }
   }
 #endif
-#if defined(HAS_COPYROW_MIPS)
-  if (TestCpuFlag(kCpuHasMIPS)) {
-    CopyRow = CopyRow_MIPS;
+#if defined(HAS_COPYROW_NT_SSE2)
+  if (UseStreamingStores(dst_y, dst_stride_y, (int64)(width) * height)) {
+    CopyRow = IS_ALIGNED(width, 64) ? CopyRow_NT_SSE2 : CopyRow_NT_Any_SSE2;
   }
 #endif
+  DISPATCH_KERNEL("CopyPlane", CopyRow, width);
 
   // Copy plane
   for (y = 0; y < height; ++y) {
@@ -73,6 +124,7 @@ void CopyPlane(const uint8* src_y, int src_stride_y,
     src_y += src_stride_y;
     dst_y += dst_stride_y;
   }
+  PROFILE_END(kProfileCopyPlane);
 }
 
 LIBYUV_API
@@ -477,6 +529,57 @@ int I420Mirror(const uint8* src_y, int src_stride_y,
   return 0;
 }
 
+// NV12 mirror.
+LIBYUV_API
+int NV12Mirror(const uint8* src_y, int src_stride_y,
+               const uint8* src_uv, int src_stride_uv,
+               uint8* dst_y, int dst_stride_y,
+               uint8* dst_uv, int dst_stride_uv,
+               int width, int height) {
+  int halfwidth = (width + 1) >> 1;
+  int halfheight = (height + 1) >> 1;
+  int y;
+  void (*MirrorNVUVRow)(const uint8* src_uv, uint8* dst_uv, int width) =
+      MirrorNVUVRow_C;
+  if (!src_y || !src_uv || !dst_y || !dst_uv ||
+      width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    halfheight = (height + 1) >> 1;
+    src_y = src_y + (height - 1) * src_stride_y;
+    src_uv = src_uv + (halfheight - 1) * src_stride_uv;
+    src_stride_y = -src_stride_y;
+    src_stride_uv = -src_stride_uv;
+  }
+#if defined(HAS_MIRRORNVUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    MirrorNVUVRow = MirrorNVUVRow_Any_SSE2;
+    if (IS_ALIGNED(halfwidth, 8)) {
+      MirrorNVUVRow = MirrorNVUVRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_MIRRORNVUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    MirrorNVUVRow = MirrorNVUVRow_Any_AVX2;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      MirrorNVUVRow = MirrorNVUVRow_AVX2;
+    }
+  }
+#endif
+
+  MirrorPlane(src_y, src_stride_y, dst_y, dst_stride_y, width, height);
+  for (y = 0; y < halfheight; ++y) {
+    MirrorNVUVRow(src_uv, dst_uv, halfwidth);
+    src_uv += src_stride_uv;
+    dst_uv += dst_stride_uv;
+  }
+  return 0;
+}
+
 // ARGB mirror.
 LIBYUV_API
 int ARGBMirror(const uint8* src_argb, int src_stride_argb,
@@ -1105,12 +1208,31 @@ int NV21ToRGB565(const uint8* src_y, int src_stride_y,
   return 0;
 }
 
+#if defined(HAS_SETROW_X86) && defined(HAS_SETROW_ERMS)
+#define HAS_SETROW_AUTOTUNE
+typedef void (*SetRowFunction)(uint8* dst, uint8 v8, int count);
+
+// SetRow candidates for autotuning, in the order of kAutotuneSetRow.
+static SetRowFunction SetRowCandidate(int candidate, int width) {
+  if (candidate == 0) {
+    return IS_ALIGNED(width, 4) ? SetRow_X86 : SetRow_Any_X86;
+  }
+  return SetRow_ERMS;
+}
+
+static void RunSetRowCandidate(int candidate, const uint8* src, uint8* dst,
+                               int width) {
+  SetRowCandidate(candidate, width)(dst, src[0], width);
+}
+#endif
+
 LIBYUV_API
 void SetPlane(uint8* dst_y, int dst_stride_y,
               int width, int height,
               uint32 value) {
   int y;
-  void (*SetRow)(uint8* dst, uint8 value, int pix) = SetRow_C;
+  void (*SetRow)(uint8* dst, uint8 value, int pix);
+  const struct RowFunctions* rows = GetCpuRowFunctions();
   if (height < 0) {
     height = -height;
     dst_y = dst_y + (height - 1) * dst_stride_y;
@@ -1122,27 +1244,18 @@ void SetPlane(uint8* dst_y, int dst_stride_y,
     height = 1;
     dst_stride_y = 0;
   }
-#if defined(HAS_SETROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    SetRow = SetRow_Any_NEON;
-    if (IS_ALIGNED(width, 16)) {
-      SetRow = SetRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_SETROW_X86)
-  if (TestCpuFlag(kCpuHasX86)) {
-    SetRow = SetRow_Any_X86;
-    if (IS_ALIGNED(width, 4)) {
-      SetRow = SetRow_X86;
+  SetRow = ROW_FUNCTION(rows, SetRow, width);
+#if defined(HAS_SETROW_AUTOTUNE)
+  if (autotune_enabled_) {
+    int choice = AutotuneSelect(kAutotuneSetRow, width,
+                                (TestCpuFlag(kCpuHasX86) ? 1 : 0) |
+                                (TestCpuFlag(kCpuHasERMS) ? 2 : 0),
+                                RunSetRowCandidate);
+    if (choice >= 0) {
+      SetRow = SetRowCandidate(choice, width);
     }
   }
 #endif
-#if defined(HAS_SETROW_ERMS)
-  if (TestCpuFlag(kCpuHasERMS)) {
-    SetRow = SetRow_ERMS;
-  }
-#endif
 
   // Set plane
   for (y = 0; y < height; ++y) {
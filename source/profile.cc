@@ -0,0 +1,313 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/profile.h"
+
+#include <stdio.h>  // For snprintf.
+#include <stdlib.h>  // For calloc.
+#include <string.h>  // For memset.
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>  // For QueryPerformanceCounter and FlsAlloc.
+#else
+#include <pthread.h>  // For pthread_key_create.
+#if defined(__APPLE__)
+#include <mach/mach_time.h>  // For mach_absolute_time.
+#else
+#include <time.h>  // For clock_gettime.
+#endif
+#endif
+
+#include "libyuv/row.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+#if defined(_MSC_VER) && (_MSC_VER < 1900)
+#define snprintf _snprintf
+#endif
+
+static const char* const kProfileFunctionNames[kProfileFunctionCount] = {
+  "I420ToARGB",
+  "NV12ToARGB",
+  "ARGBToI420",
+  "I420ToNV12",
+  "CopyPlane",
+  "I420Scale",
+  "ARGBScale",
+  "I420Rotate",
+  "ARGBRotate",
+  "ConvertToI420",
+  "ConvertFromI420",
+};
+
+// Each thread adds to its own counters, which are on a list that only grows,
+// so counting needs no locks.  A reset saves the totals as a base that later
+// snapshots subtract, so counters are only written by their thread.
+// When a thread exits its record is released, and the next new thread
+// takes it over and keeps adding to its counters, so the list only grows
+// to the number of threads counting at once.
+struct ProfileThread {
+  struct ProfileCounters counters[kProfileFunctionCount];
+  struct ProfileThread* next;
+  volatile long in_use;  // 1 while a thread owns the record.
+};
+
+static volatile int profile_enabled = 0;
+static struct ProfileThread* volatile profile_threads = NULL;
+static LIBYUV_THREAD_LOCAL struct ProfileThread* profile_thread = NULL;
+static struct ProfileCounters profile_base[kProfileFunctionCount];
+
+#if defined(_MSC_VER)
+#define PROFILE_CAS(ptr, old_value, new_value) \
+    (InterlockedCompareExchangePointer((PVOID volatile*)(ptr), \
+        new_value, old_value) == (old_value))
+#define PROFILE_CAS_LONG(ptr, old_value, new_value) \
+    (InterlockedCompareExchange(ptr, new_value, old_value) == (old_value))
+#else
+#define PROFILE_CAS(ptr, old_value, new_value) \
+    __sync_bool_compare_and_swap(ptr, old_value, new_value)
+#define PROFILE_CAS_LONG(ptr, old_value, new_value) \
+    __sync_bool_compare_and_swap(ptr, old_value, new_value)
+#endif
+
+uint64 ProfileNanoseconds(void) {
+#if defined(_WIN32)
+  static LARGE_INTEGER frequency = { 0 };
+  LARGE_INTEGER count;
+  if (!frequency.QuadPart) {
+    QueryPerformanceFrequency(&frequency);
+  }
+  QueryPerformanceCounter(&count);
+  return (uint64)(count.QuadPart / frequency.QuadPart) * 1000000000u +
+      (uint64)(count.QuadPart % frequency.QuadPart) * 1000000000u /
+      frequency.QuadPart;
+#elif defined(__APPLE__)
+  static mach_timebase_info_data_t timebase = { 0, 0 };
+  if (!timebase.denom) {
+    mach_timebase_info(&timebase);
+  }
+  return mach_absolute_time() * timebase.numer / timebase.denom;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64)(ts.tv_sec) * 1000000000u + ts.tv_nsec;
+#endif
+}
+
+// Called on thread exit.  The counters stay on the list.
+static void ReleaseProfileThread(void* thread) {
+  if (thread) {
+    PROFILE_CAS_LONG(&((struct ProfileThread*)(thread))->in_use, 1, 0);
+  }
+}
+
+// Arrange for ReleaseProfileThread to be called when this thread exits.
+#if defined(_WIN32)
+static INIT_ONCE profile_key_once = INIT_ONCE_STATIC_INIT;
+static DWORD profile_key = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI ReleaseProfileThreadFls(PVOID thread) {
+  ReleaseProfileThread(thread);
+}
+
+static BOOL CALLBACK CreateProfileKey(PINIT_ONCE once, PVOID param,
+                                      PVOID* context) {
+  (void)once;
+  (void)param;
+  (void)context;
+  profile_key = FlsAlloc(ReleaseProfileThreadFls);
+  return TRUE;
+}
+
+static void RegisterProfileThread(struct ProfileThread* thread) {
+  InitOnceExecuteOnce(&profile_key_once, CreateProfileKey, NULL, NULL);
+  if (profile_key != FLS_OUT_OF_INDEXES) {
+    FlsSetValue(profile_key, thread);
+  }
+}
+#else
+static pthread_once_t profile_key_once = PTHREAD_ONCE_INIT;
+static pthread_key_t profile_key;
+static int profile_key_created = 0;
+
+static void CreateProfileKey(void) {
+  profile_key_created =
+      pthread_key_create(&profile_key, ReleaseProfileThread) == 0;
+}
+
+static void RegisterProfileThread(struct ProfileThread* thread) {
+  pthread_once(&profile_key_once, CreateProfileKey);
+  if (profile_key_created) {
+    pthread_setspecific(profile_key, thread);
+  }
+}
+#endif
+
+static struct ProfileThread* GetProfileThread(void) {
+  struct ProfileThread* thread = profile_thread;
+  if (!thread) {
+    // Take over the record of a thread that has exited.
+    for (thread = profile_threads; thread; thread = thread->next) {
+      if (!thread->in_use && PROFILE_CAS_LONG(&thread->in_use, 0, 1)) {
+        break;
+      }
+    }
+    if (!thread) {
+      struct ProfileThread* head;
+      thread = (struct ProfileThread*)(calloc(1, sizeof(*thread)));
+      if (!thread) {
+        return NULL;
+      }
+      thread->in_use = 1;
+      do {
+        head = profile_threads;
+        thread->next = head;
+      } while (!PROFILE_CAS(&profile_threads, head, thread));
+    }
+    RegisterProfileThread(thread);
+    profile_thread = thread;
+  }
+  return thread;
+}
+
+uint64 ProfileBegin(void) {
+  return profile_enabled ? ProfileNanoseconds() : 0;
+}
+
+void ProfileEnd(enum ProfileFunction function, uint64 start,
+                int64 pixels, int64 bytes) {
+  struct ProfileThread* thread;
+  struct ProfileCounters* counters;
+  if (!start) {
+    return;
+  }
+  thread = GetProfileThread();
+  if (!thread) {
+    return;
+  }
+  counters = &thread->counters[function];
+  counters->nanoseconds += ProfileNanoseconds() - start;
+  counters->calls += 1;
+  counters->pixels += pixels;
+  counters->bytes += bytes;
+}
+
+LIBYUV_API
+void SetProfileEnabled(LIBYUV_BOOL enable) {
+  profile_enabled = enable ? 1 : 0;
+}
+
+LIBYUV_API
+const char* GetProfileFunctionName(enum ProfileFunction function) {
+  if ((int)(function) < 0 || function >= kProfileFunctionCount) {
+    return "";
+  }
+  return kProfileFunctionNames[function];
+}
+
+// Sum of the counters of all threads.
+static void SumProfileCounters(struct ProfileCounters* counters) {
+  struct ProfileThread* thread;
+  int i;
+  memset(counters, 0, sizeof(struct ProfileCounters) * kProfileFunctionCount);
+  for (thread = profile_threads; thread; thread = thread->next) {
+    for (i = 0; i < kProfileFunctionCount; ++i) {
+      counters[i].calls += thread->counters[i].calls;
+      counters[i].pixels += thread->counters[i].pixels;
+      counters[i].bytes += thread->counters[i].bytes;
+      counters[i].nanoseconds += thread->counters[i].nanoseconds;
+    }
+  }
+}
+
+LIBYUV_API
+void GetProfileCounters(struct ProfileCounters* counters) {
+  int i;
+  SumProfileCounters(counters);
+  for (i = 0; i < kProfileFunctionCount; ++i) {
+    counters[i].calls -= profile_base[i].calls;
+    counters[i].pixels -= profile_base[i].pixels;
+    counters[i].bytes -= profile_base[i].bytes;
+    counters[i].nanoseconds -= profile_base[i].nanoseconds;
+  }
+}
+
+LIBYUV_API
+void ResetProfileCounters(void) {
+  SumProfileCounters(profile_base);
+}
+
+LIBYUV_API
+int FormatProfileCounters(char* buffer, int size, LIBYUV_BOOL json) {
+  struct ProfileCounters counters[kProfileFunctionCount];
+  int length = 0;
+  int num_printed = 0;
+  int i;
+  GetProfileCounters(counters);
+  if (size > 0) {
+    buffer[0] = 0;
+  }
+  for (i = 0; i <= kProfileFunctionCount; ++i) {
+    char line[256];
+    int n;
+    if (i == kProfileFunctionCount) {
+      if (!json) {
+        break;
+      }
+      n = snprintf(line, sizeof(line), "%s", num_printed ? "\n}\n" : "{}\n");
+    } else if (!counters[i].calls) {
+      continue;
+    } else if (json) {
+      n = snprintf(line, sizeof(line),
+                   "%s\n  \"%s\": {\"calls\": %llu, \"pixels\": %llu, "
+                   "\"bytes\": %llu, \"nanoseconds\": %llu}",
+                   num_printed ? "," : "{", kProfileFunctionNames[i],
+                   (unsigned long long)(counters[i].calls),  // NOLINT
+                   (unsigned long long)(counters[i].pixels),  // NOLINT
+                   (unsigned long long)(counters[i].bytes),  // NOLINT
+                   (unsigned long long)(counters[i].nanoseconds));  // NOLINT
+      ++num_printed;
+    } else {
+      n = snprintf(line, sizeof(line),
+                   "%-16s calls %10llu pixels %14llu bytes %14llu ns %14llu\n",
+                   kProfileFunctionNames[i],
+                   (unsigned long long)(counters[i].calls),  // NOLINT
+                   (unsigned long long)(counters[i].pixels),  // NOLINT
+                   (unsigned long long)(counters[i].bytes),  // NOLINT
+                   (unsigned long long)(counters[i].nanoseconds));  // NOLINT
+      ++num_printed;
+    }
+    if (n < 0) {
+      continue;
+    }
+    if (n >= (int)(sizeof(line))) {
+      n = (int)(sizeof(line)) - 1;
+    }
+    if (length + n < size) {
+      memcpy(buffer + length, line, n + 1);
+    } else if (length < size) {
+      memcpy(buffer + length, line, size - length - 1);
+      buffer[size - 1] = 0;
+    }
+    length += n;
+  }
+  return length;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -10,9 +10,11 @@
 
 #include "libyuv/rotate.h"
 
+#include "libyuv/autotune.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/convert.h"
 #include "libyuv/planar_functions.h"
+#include "libyuv/profile.h"
 #include "libyuv/row.h"
 
 #ifdef __cplusplus
@@ -763,6 +765,95 @@ static void TransposeUVWx8_SSE2(const uint8* src, int src_stride,
     "xmm8", "xmm9"
 );
 }
+
+// Transposes 8 rows of UV pairs, treating each pair as one 16 bit pixel.
+#define HAS_TRANSPOSE_NVUVWX8_SSE2
+static void TransposeNVUVWx8_SSE2(const uint8* src, int src_stride,
+                                  uint8* dst, int dst_stride,
+                                  int w) {
+  asm volatile (
+  // Read in the data from the source pointer.
+  // First round of pair swap.
+  ".p2align  2                                 \n"
+"1:                                            \n"
+  "movdqu     (%0),%%xmm0                      \n"
+  "movdqu     (%0,%3),%%xmm1                   \n"
+  "lea        (%0,%3,2),%0                     \n"
+  "movdqu     (%0),%%xmm2                      \n"
+  "movdqu     (%0,%3),%%xmm3                   \n"
+  "lea        (%0,%3,2),%0                     \n"
+  "movdqu     (%0),%%xmm4                      \n"
+  "movdqu     (%0,%3),%%xmm5                   \n"
+  "lea        (%0,%3,2),%0                     \n"
+  "movdqu     (%0),%%xmm6                      \n"
+  "movdqu     (%0,%3),%%xmm7                   \n"
+  "lea        (%0,%3,2),%0                     \n"
+  "neg        %3                               \n"
+  "lea        0x10(%0,%3,8),%0                 \n"
+  "neg        %3                               \n"
+  "movdqa     %%xmm0,%%xmm8                    \n"
+  "punpcklwd  %%xmm1,%%xmm0                    \n"
+  "punpckhwd  %%xmm1,%%xmm8                    \n"
+  "movdqa     %%xmm2,%%xmm9                    \n"
+  "punpcklwd  %%xmm3,%%xmm2                    \n"
+  "punpckhwd  %%xmm3,%%xmm9                    \n"
+  "movdqa     %%xmm4,%%xmm10                   \n"
+  "punpcklwd  %%xmm5,%%xmm4                    \n"
+  "punpckhwd  %%xmm5,%%xmm10                   \n"
+  "movdqa     %%xmm6,%%xmm11                   \n"
+  "punpcklwd  %%xmm7,%%xmm6                    \n"
+  "punpckhwd  %%xmm7,%%xmm11                   \n"
+  // Second round of pair swap.
+  "movdqa     %%xmm0,%%xmm1                    \n"
+  "punpckldq  %%xmm2,%%xmm0                    \n"
+  "punpckhdq  %%xmm2,%%xmm1                    \n"
+  "movdqa     %%xmm8,%%xmm3                    \n"
+  "punpckldq  %%xmm9,%%xmm8                    \n"
+  "punpckhdq  %%xmm9,%%xmm3                    \n"
+  "movdqa     %%xmm4,%%xmm5                    \n"
+  "punpckldq  %%xmm6,%%xmm4                    \n"
+  "punpckhdq  %%xmm6,%%xmm5                    \n"
+  "movdqa     %%xmm10,%%xmm7                   \n"
+  "punpckldq  %%xmm11,%%xmm10                  \n"
+  "punpckhdq  %%xmm11,%%xmm7                   \n"
+  // Third round of pair swap.
+  // Write to the destination pointer.
+  "movdqa     %%xmm0,%%xmm2                    \n"
+  "punpcklqdq %%xmm4,%%xmm0                    \n"
+  "punpckhqdq %%xmm4,%%xmm2                    \n"
+  "movdqu     %%xmm0,(%1)                      \n"
+  "movdqu     %%xmm2,(%1,%4)                   \n"
+  "lea        (%1,%4,2),%1                     \n"
+  "movdqa     %%xmm1,%%xmm6                    \n"
+  "punpcklqdq %%xmm5,%%xmm1                    \n"
+  "punpckhqdq %%xmm5,%%xmm6                    \n"
+  "movdqu     %%xmm1,(%1)                      \n"
+  "movdqu     %%xmm6,(%1,%4)                   \n"
+  "lea        (%1,%4,2),%1                     \n"
+  "movdqa     %%xmm8,%%xmm9                    \n"
+  "punpcklqdq %%xmm10,%%xmm8                   \n"
+  "punpckhqdq %%xmm10,%%xmm9                   \n"
+  "movdqu     %%xmm8,(%1)                      \n"
+  "movdqu     %%xmm9,(%1,%4)                   \n"
+  "lea        (%1,%4,2),%1                     \n"
+  "movdqa     %%xmm3,%%xmm11                   \n"
+  "punpcklqdq %%xmm7,%%xmm3                    \n"
+  "punpckhqdq %%xmm7,%%xmm11                   \n"
+  "sub        $0x8,%2                          \n"
+  "movdqu     %%xmm3,(%1)                      \n"
+  "movdqu     %%xmm11,(%1,%4)                  \n"
+  "lea        (%1,%4,2),%1                     \n"
+  "jg         1b                               \n"
+  : "+r"(src),    // %0
+    "+r"(dst),    // %1
+    "+r"(w)       // %2
+  : "r"((intptr_t)(src_stride)),  // %3
+    "r"((intptr_t)(dst_stride))   // %4
+  : "memory", "cc",
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7",
+    "xmm8", "xmm9", "xmm10", "xmm11"
+);
+}
 #endif
 #endif
 
@@ -796,6 +887,20 @@ static void TransposeWxH_C(const uint8* src, int src_stride,
   }
 }
 
+#if defined(HAS_TRANSPOSE_WX8_SSSE3) && defined(HAS_TRANSPOSE_WX8_FAST_SSSE3)
+#define HAS_TRANSPOSE_WX8_AUTOTUNE
+// TransposeWx8 candidates for autotuning, in the order of
+// kAutotuneTransposeWx8.
+static void RunTransposeWx8Candidate(int candidate, const uint8* src,
+                                     uint8* dst, int width) {
+  if (candidate == 0) {
+    TransposeWx8_SSSE3(src, width, dst, 8, width);
+  } else {
+    TransposeWx8_FAST_SSSE3(src, width, dst, 8, width);
+  }
+}
+#endif
+
 LIBYUV_API
 void TransposePlane(const uint8* src, int src_stride,
                     uint8* dst, int dst_stride,
@@ -804,6 +909,9 @@ void TransposePlane(const uint8* src, int src_stride,
   void (*TransposeWx8)(const uint8* src, int src_stride,
                        uint8* dst, int dst_stride,
                        int width) = TransposeWx8_C;
+  struct CpuCacheInfo cache_info;
+  int band_height;
+  int tile_width;
 #if defined(HAS_TRANSPOSE_WX8_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     TransposeWx8 = TransposeWx8_NEON;
@@ -819,6 +927,17 @@ void TransposePlane(const uint8* src, int src_stride,
     TransposeWx8 = TransposeWx8_FAST_SSSE3;
   }
 #endif
+#if defined(HAS_TRANSPOSE_WX8_AUTOTUNE)
+  if (autotune_enabled_ && TestCpuFlag(kCpuHasSSSE3) &&
+      IS_ALIGNED(width, 8)) {
+    int choice = AutotuneSelect(kAutotuneTransposeWx8, width,
+                                IS_ALIGNED(width, 16) ? 3 : 1,
+                                RunTransposeWx8Candidate);
+    if (choice >= 0) {
+      TransposeWx8 = choice ? TransposeWx8_FAST_SSSE3 : TransposeWx8_SSSE3;
+    }
+  }
+#endif
 #if defined(HAS_TRANSPOSE_WX8_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2)) {
     if (IS_ALIGNED(width, 4) &&
@@ -830,12 +949,39 @@ void TransposePlane(const uint8* src, int src_stride,
   }
 #endif
 
+  // Each 8 rows of source fill 8 bytes of "width" destination rows.  Work in
+  // bands of enough rows to fill a destination cache line, across tiles
+  // narrow enough that the destination lines and source band take half of
+  // L2.  Each destination row is usually on its own page, so tiles are also
+  // limited to what the TLB covers.
+  GetCpuCacheInfo(&cache_info);
+  band_height = cache_info.line_size & ~7;
+  if (band_height < 8) {
+    band_height = 8;
+  }
+  tile_width = (cache_info.l2_size / 4 / cache_info.line_size) & ~15;
+  if (tile_width < 64) {
+    tile_width = 64;
+  }
+  if (tile_width > 2048) {
+    tile_width = 2048;
+  }
+
   // Work across the source in 8x8 tiles
   while (i >= 8) {
-    TransposeWx8(src, src_stride, dst, dst_stride, width);
-    src += 8 * src_stride;    // Go down 8 rows.
-    dst += 8;                 // Move over 8 columns.
-    i -= 8;
+    int tile_height = i < band_height ? (i & ~7) : band_height;
+    int x;
+    for (x = 0; x < width; x += tile_width) {
+      int w = width - x < tile_width ? width - x : tile_width;
+      int j;
+      for (j = 0; j < tile_height; j += 8) {
+        TransposeWx8(src + j * src_stride + x, src_stride,
+                     dst + x * dst_stride + j, dst_stride, w);
+      }
+    }
+    src += tile_height * src_stride;  // Go down tile_height rows.
+    dst += tile_height;               // Move over tile_height columns.
+    i -= tile_height;
   }
 
   TransposeWxH_C(src, src_stride, dst, dst_stride, width, i);
@@ -1110,6 +1256,108 @@ void RotateUV180(const uint8* src, int src_stride,
   }
 }
 
+static void TransposeNVUVWx8_C(const uint8* src, int src_stride,
+                               uint8* dst, int dst_stride,
+                               int width) {
+  int i;
+  for (i = 0; i < width; ++i) {
+    int j;
+    for (j = 0; j < 8; ++j) {
+      dst[j * 2 + 0] = src[j * src_stride + 0];
+      dst[j * 2 + 1] = src[j * src_stride + 1];
+    }
+    src += 2;
+    dst += dst_stride;
+  }
+}
+
+static void TransposeNVUVWxH_C(const uint8* src, int src_stride,
+                               uint8* dst, int dst_stride,
+                               int width, int height) {
+  int i;
+  for (i = 0; i < width; ++i) {
+    int j;
+    for (j = 0; j < height; ++j) {
+      dst[i * dst_stride + j * 2 + 0] = src[j * src_stride + i * 2 + 0];
+      dst[i * dst_stride + j * 2 + 1] = src[j * src_stride + i * 2 + 1];
+    }
+  }
+}
+
+// Transpose interleaved UV into interleaved UV.  "width" is in UV pairs.
+static void TransposeNVUV(const uint8* src, int src_stride,
+                          uint8* dst, int dst_stride,
+                          int width, int height) {
+  int i = height;
+  void (*TransposeNVUVWx8)(const uint8* src, int src_stride,
+                           uint8* dst, int dst_stride,
+                           int width) = TransposeNVUVWx8_C;
+#if defined(HAS_TRANSPOSE_NVUVWX8_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(width, 8)) {
+    TransposeNVUVWx8 = TransposeNVUVWx8_SSE2;
+  }
+#endif
+
+  // Work through the source in 8x8 tiles.
+  while (i >= 8) {
+    TransposeNVUVWx8(src, src_stride, dst, dst_stride, width);
+    src += 8 * src_stride;    // Go down 8 rows.
+    dst += 8 * 2;             // Move over 8 columns.
+    i -= 8;
+  }
+
+  TransposeNVUVWxH_C(src, src_stride, dst, dst_stride, width, i);
+}
+
+static void RotateNVUV90(const uint8* src, int src_stride,
+                         uint8* dst, int dst_stride,
+                         int width, int height) {
+  src += src_stride * (height - 1);
+  src_stride = -src_stride;
+  TransposeNVUV(src, src_stride, dst, dst_stride, width, height);
+}
+
+static void RotateNVUV270(const uint8* src, int src_stride,
+                          uint8* dst, int dst_stride,
+                          int width, int height) {
+  dst += dst_stride * (width - 1);
+  dst_stride = -dst_stride;
+  TransposeNVUV(src, src_stride, dst, dst_stride, width, height);
+}
+
+// Rotate 180 is a horizontal and vertical flip.
+static void RotateNVUV180(const uint8* src, int src_stride,
+                          uint8* dst, int dst_stride,
+                          int width, int height) {
+  int i;
+  void (*MirrorNVUVRow)(const uint8* src_uv, uint8* dst_uv, int width) =
+      MirrorNVUVRow_C;
+#if defined(HAS_MIRRORNVUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    MirrorNVUVRow = MirrorNVUVRow_Any_SSE2;
+    if (IS_ALIGNED(width, 8)) {
+      MirrorNVUVRow = MirrorNVUVRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_MIRRORNVUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    MirrorNVUVRow = MirrorNVUVRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      MirrorNVUVRow = MirrorNVUVRow_AVX2;
+    }
+  }
+#endif
+
+  dst += dst_stride * (height - 1);
+
+  for (i = 0; i < height; ++i) {
+    MirrorNVUVRow(src, dst, width);
+    src += src_stride;
+    dst -= dst_stride;
+  }
+}
+
 LIBYUV_API
 int RotatePlane(const uint8* src, int src_stride,
                 uint8* dst, int dst_stride,
@@ -1181,6 +1429,7 @@ int I420Rotate(const uint8* src_y, int src_stride_y,
     src_stride_u = -src_stride_u;
     src_stride_v = -src_stride_v;
   }
+  PROFILE_BEGIN((int64)(width) * height, (int64)(width) * height * 3);
 
   switch (mode) {
     case kRotate0:
@@ -1202,6 +1451,7 @@ int I420Rotate(const uint8* src_y, int src_stride_y,
       RotatePlane90(src_v, src_stride_v,
                     dst_v, dst_stride_v,
                     halfwidth, halfheight);
+      PROFILE_END(kProfileI420Rotate);
       return 0;
     case kRotate270:
       RotatePlane270(src_y, src_stride_y,
@@ -1213,6 +1463,7 @@ int I420Rotate(const uint8* src_y, int src_stride_y,
       RotatePlane270(src_v, src_stride_v,
                      dst_v, dst_stride_v,
                      halfwidth, halfheight);
+      PROFILE_END(kProfileI420Rotate);
       return 0;
     case kRotate180:
       RotatePlane180(src_y, src_stride_y,
@@ -1224,6 +1475,7 @@ int I420Rotate(const uint8* src_y, int src_stride_y,
       RotatePlane180(src_v, src_stride_v,
                      dst_v, dst_stride_v,
                      halfwidth, halfheight);
+      PROFILE_END(kProfileI420Rotate);
       return 0;
     default:
       break;
@@ -1298,6 +1550,70 @@ int NV12ToI420Rotate(const uint8* src_y, int src_stride_y,
   return -1;
 }
 
+LIBYUV_API
+int NV12Rotate(const uint8* src_y, int src_stride_y,
+               const uint8* src_uv, int src_stride_uv,
+               uint8* dst_y, int dst_stride_y,
+               uint8* dst_uv, int dst_stride_uv,
+               int width, int height,
+               enum RotationMode mode) {
+  int halfwidth = (width + 1) >> 1;
+  int halfheight = (height + 1) >> 1;
+  if (!src_y || !src_uv || width <= 0 || height == 0 ||
+      !dst_y || !dst_uv) {
+    return -1;
+  }
+
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    halfheight = (height + 1) >> 1;
+    src_y = src_y + (height - 1) * src_stride_y;
+    src_uv = src_uv + (halfheight - 1) * src_stride_uv;
+    src_stride_y = -src_stride_y;
+    src_stride_uv = -src_stride_uv;
+  }
+
+  switch (mode) {
+    case kRotate0:
+      // copy frame
+      CopyPlane(src_y, src_stride_y,
+                dst_y, dst_stride_y,
+                width, height);
+      CopyPlane(src_uv, src_stride_uv,
+                dst_uv, dst_stride_uv,
+                halfwidth * 2, halfheight);
+      return 0;
+    case kRotate90:
+      RotatePlane90(src_y, src_stride_y,
+                    dst_y, dst_stride_y,
+                    width, height);
+      RotateNVUV90(src_uv, src_stride_uv,
+                   dst_uv, dst_stride_uv,
+                   halfwidth, halfheight);
+      return 0;
+    case kRotate270:
+      RotatePlane270(src_y, src_stride_y,
+                     dst_y, dst_stride_y,
+                     width, height);
+      RotateNVUV270(src_uv, src_stride_uv,
+                    dst_uv, dst_stride_uv,
+                    halfwidth, halfheight);
+      return 0;
+    case kRotate180:
+      RotatePlane180(src_y, src_stride_y,
+                     dst_y, dst_stride_y,
+                     width, height);
+      RotateNVUV180(src_uv, src_stride_uv,
+                    dst_uv, dst_stride_uv,
+                    halfwidth, halfheight);
+      return 0;
+    default:
+      break;
+  }
+  return -1;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
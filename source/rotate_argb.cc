@@ -13,6 +13,7 @@
 #include "libyuv/cpu_id.h"
 #include "libyuv/convert.h"
 #include "libyuv/planar_functions.h"
+#include "libyuv/profile.h"
 #include "libyuv/row.h"
 
 #ifdef __cplusplus
@@ -179,6 +180,7 @@ int ARGBRotate(const uint8* src_argb, int src_stride_argb,
     src_argb = src_argb + (height - 1) * src_stride_argb;
     src_stride_argb = -src_stride_argb;
   }
+  PROFILE_BEGIN((int64)(width) * height, (int64)(width) * height * 8);
 
   switch (mode) {
     case kRotate0:
@@ -190,16 +192,19 @@ int ARGBRotate(const uint8* src_argb, int src_stride_argb,
       ARGBRotate90(src_argb, src_stride_argb,
                    dst_argb, dst_stride_argb,
                    width, height);
+      PROFILE_END(kProfileARGBRotate);
       return 0;
     case kRotate270:
       ARGBRotate270(src_argb, src_stride_argb,
                     dst_argb, dst_stride_argb,
                     width, height);
+      PROFILE_END(kProfileARGBRotate);
       return 0;
     case kRotate180:
       ARGBRotate180(src_argb, src_stride_argb,
                     dst_argb, dst_stride_argb,
                     width, height);
+      PROFILE_END(kProfileARGBRotate);
       return 0;
     default:
       break;
@@ -17,18 +17,30 @@ namespace libyuv {
 extern "C" {
 #endif
 
-// YUV to RGB does multiple of 8 with SIMD and remainder with C.
+// YUV to RGB does multiple of 8 with SIMD.  The remainder is done by running
+// SIMD again on the last MASK + 1 pixels (last16 method), starting at a whole
+// chroma sample, which redoes some pixels already written with the same
+// values.  Any pixel left after that, and rows narrower than MASK + 1, are
+// done with C.
 #define YANY(NAMEANY, I420TORGB_SIMD, I420TORGB_C, UV_SHIFT, BPP, MASK)        \
     void NAMEANY(const uint8* y_buf, const uint8* u_buf, const uint8* v_buf,   \
                  uint8* rgb_buf, int width) {                                  \
       int n = width & ~MASK;                                                   \
       if (n > 0) {                                                             \
         I420TORGB_SIMD(y_buf, u_buf, v_buf, rgb_buf, n);                       \
+        if (n < width) {                                                       \
+          n = (width - MASK - 1) & ~((1 << UV_SHIFT) - 1);                     \
+          I420TORGB_SIMD(y_buf + n,                                            \
+                         u_buf + (n >> UV_SHIFT),                              \
+                         v_buf + (n >> UV_SHIFT),                              \
+                         rgb_buf + n * BPP, MASK + 1);                         \
+          n += MASK + 1;                                                       \
+        }                                                                      \
       }                                                                        \
       I420TORGB_C(y_buf + n,                                                   \
                   u_buf + (n >> UV_SHIFT),                                     \
                   v_buf + (n >> UV_SHIFT),                                     \
-                  rgb_buf + n * BPP, width & MASK);                            \
+                  rgb_buf + n * BPP, width - n);                               \
     }
 
 #ifdef HAS_I422TOARGBROW_SSSE3
@@ -72,6 +84,14 @@ YANY(J422ToARGBRow_Any_AVX2, J422ToARGBRow_AVX2, J422ToARGBRow_C, 1, 4, 15)
 #ifdef HAS_I422TOARGBROW_AVX2
 YANY(I422ToARGBRow_Any_AVX2, I422ToARGBRow_AVX2, I422ToARGBRow_C, 1, 4, 15)
 #endif
+#ifdef HAS_I422TOARGBFASTROW_SSSE3
+YANY(I422ToARGBFastRow_Any_SSSE3, I422ToARGBFastRow_SSSE3, I422ToARGBRow_C,
+     1, 4, 15)
+#endif
+#ifdef HAS_I422TOARGBFASTROW_AVX2
+YANY(I422ToARGBFastRow_Any_AVX2, I422ToARGBFastRow_AVX2, I422ToARGBRow_C,
+     1, 4, 31)
+#endif
 #ifdef HAS_I422TOBGRAROW_AVX2
 YANY(I422ToBGRARow_Any_AVX2, I422ToBGRARow_AVX2, I422ToBGRARow_C, 1, 4, 15)
 #endif
@@ -123,16 +143,24 @@ YANY(I422ToUYVYRow_Any_NEON, I422ToUYVYRow_NEON, I422ToUYVYRow_C, 1, 2, 15)
 #undef YANY
 
 // Wrappers to handle odd width
+// Same as YUV to RGB, with the last16 method at an even pixel.
 #define NV2NY(NAMEANY, NV12TORGB_SIMD, NV12TORGB_C, UV_SHIFT, BPP, MASK)       \
     void NAMEANY(const uint8* y_buf, const uint8* uv_buf,                      \
                  uint8* rgb_buf, int width) {                                  \
       int n = width & ~MASK;                                                   \
       if (n > 0) {                                                             \
         NV12TORGB_SIMD(y_buf, uv_buf, rgb_buf, n);                             \
+        if (n < width) {                                                       \
+          n = (width - MASK - 1) & ~1;                                         \
+          NV12TORGB_SIMD(y_buf + n,                                            \
+                         uv_buf + (n >> UV_SHIFT),                             \
+                         rgb_buf + n * BPP, MASK + 1);                         \
+          n += MASK + 1;                                                       \
+        }                                                                      \
       }                                                                        \
       NV12TORGB_C(y_buf + n,                                                   \
                   uv_buf + (n >> UV_SHIFT),                                    \
-                  rgb_buf + n * BPP, width & MASK);                            \
+                  rgb_buf + n * BPP, width - n);                               \
     }
 
 #ifdef HAS_NV12TOARGBROW_SSSE3
@@ -165,15 +193,30 @@ NV2NY(NV12ToRGB565Row_Any_NEON, NV12ToRGB565Row_NEON, NV12ToRGB565Row_C,
 NV2NY(NV21ToRGB565Row_Any_NEON, NV21ToRGB565Row_NEON, NV21ToRGB565Row_C,
       0, 2, 7)
 #endif
-#undef NVANY
+#ifdef HAS_NV12TOYUY2ROW_SSE2
+NV2NY(NV12ToYUY2Row_Any_SSE2, NV12ToYUY2Row_SSE2, NV12ToYUY2Row_C, 0, 2, 15)
+NV2NY(NV12ToUYVYRow_Any_SSE2, NV12ToUYVYRow_SSE2, NV12ToUYVYRow_C, 0, 2, 15)
+#endif
+#ifdef HAS_NV12TOYUY2ROW_AVX2
+NV2NY(NV12ToYUY2Row_Any_AVX2, NV12ToYUY2Row_AVX2, NV12ToYUY2Row_C, 0, 2, 31)
+NV2NY(NV12ToUYVYRow_Any_AVX2, NV12ToUYVYRow_AVX2, NV12ToUYVYRow_C, 0, 2, 31)
+#endif
+#undef NV2NY
 
+// Converts between formats of different sizes, so never in place and the
+// last16 method can be used.  It starts at an even pixel for YUY2 and UYVY.
 #define RGBANY(NAMEANY, ARGBTORGB_SIMD, ARGBTORGB_C, SBPP, BPP, MASK)          \
     void NAMEANY(const uint8* src, uint8* dst, int width) {                    \
       int n = width & ~MASK;                                                   \
       if (n > 0) {                                                             \
         ARGBTORGB_SIMD(src, dst, n);                                           \
+        if (n < width) {                                                       \
+          n = (width - MASK - 1) & ~1;                                         \
+          ARGBTORGB_SIMD(src + n * SBPP, dst + n * BPP, MASK + 1);             \
+          n += MASK + 1;                                                       \
+        }                                                                      \
       }                                                                        \
-      ARGBTORGB_C(src + n * SBPP, dst + n * BPP, width & MASK);                \
+      ARGBTORGB_C(src + n * SBPP, dst + n * BPP, width - n);                   \
     }
 
 #if defined(HAS_ARGBTORGB24ROW_SSSE3)
@@ -278,14 +321,21 @@ RGBDANY(ARGBToRGB565DitherRow_Any_NEON, ARGBToRGB565DitherRow_NEON,
 #endif
 #undef RGBDANY
 
+// The last16 method is used when source and destination differ in size.
+// Functions with the same size, such as attenuate, may work in place.
 #define YANY(NAMEANY, ARGBTOY_SIMD, ARGBTOY_C, SBPP, BPP, MASK)                \
     void NAMEANY(const uint8* src_argb, uint8* dst_y, int width) {             \
       int n = width & ~MASK;                                                   \
       if (n > 0) {                                                             \
         ARGBTOY_SIMD(src_argb, dst_y, n);                                      \
+        if (SBPP != BPP && n < width) {                                        \
+          n = (width - MASK - 1) & ~1;                                         \
+          ARGBTOY_SIMD(src_argb + n * SBPP, dst_y + n * BPP, MASK + 1);        \
+          n += MASK + 1;                                                       \
+        }                                                                      \
       }                                                                        \
       ARGBTOY_C(src_argb + n * SBPP,                                           \
-                dst_y  + n * BPP, width & MASK);                               \
+                dst_y  + n * BPP, width - n);                                  \
     }
 #ifdef HAS_ARGBTOYROW_AVX2
 YANY(ARGBToYRow_Any_AVX2, ARGBToYRow_AVX2, ARGBToYRow_C, 4, 1, 31)
@@ -293,6 +343,21 @@ YANY(ARGBToYRow_Any_AVX2, ARGBToYRow_AVX2, ARGBToYRow_C, 4, 1, 31)
 #ifdef HAS_ARGBTOYJROW_AVX2
 YANY(ARGBToYJRow_Any_AVX2, ARGBToYJRow_AVX2, ARGBToYJRow_C, 4, 1, 31)
 #endif
+#ifdef HAS_BGRATOYROW_AVX2
+YANY(BGRAToYRow_Any_AVX2, BGRAToYRow_AVX2, BGRAToYRow_C, 4, 1, 31)
+#endif
+#ifdef HAS_ABGRTOYROW_AVX2
+YANY(ABGRToYRow_Any_AVX2, ABGRToYRow_AVX2, ABGRToYRow_C, 4, 1, 31)
+#endif
+#ifdef HAS_RGBATOYROW_AVX2
+YANY(RGBAToYRow_Any_AVX2, RGBAToYRow_AVX2, RGBAToYRow_C, 4, 1, 31)
+#endif
+#ifdef HAS_RGB24TOYROW_AVX2
+YANY(RGB24ToYRow_Any_AVX2, RGB24ToYRow_AVX2, RGB24ToYRow_C, 3, 1, 31)
+#endif
+#ifdef HAS_RAWTOYROW_AVX2
+YANY(RAWToYRow_Any_AVX2, RAWToYRow_AVX2, RAWToYRow_C, 3, 1, 31)
+#endif
 #ifdef HAS_UYVYTOYROW_AVX2
 YANY(UYVYToYRow_Any_AVX2, UYVYToYRow_AVX2, UYVYToYRow_C, 2, 1, 31)
 #endif
@@ -391,23 +456,48 @@ YANY(ARGBAttenuateRow_Any_NEON, ARGBAttenuateRow_NEON, ARGBAttenuateRow_C,
 #endif
 #undef YANY
 
-// RGB/YUV to UV does multiple of 16 with SIMD and remainder with C.
+// RGB/YUV to UV does multiple of 16 with SIMD and remainder with the last16
+// method at an even pixel.
 #define UVANY(NAMEANY, ANYTOUV_SIMD, ANYTOUV_C, BPP, MASK)                     \
     void NAMEANY(const uint8* src_argb, int src_stride_argb,                   \
                  uint8* dst_u, uint8* dst_v, int width) {                      \
       int n = width & ~MASK;                                                   \
       if (n > 0) {                                                             \
         ANYTOUV_SIMD(src_argb, src_stride_argb, dst_u, dst_v, n);              \
+        if (n < width) {                                                       \
+          n = (width - MASK - 1) & ~1;                                         \
+          ANYTOUV_SIMD(src_argb + n * BPP, src_stride_argb,                    \
+                       dst_u + (n >> 1), dst_v + (n >> 1), MASK + 1);          \
+          n += MASK + 1;                                                       \
+        }                                                                      \
       }                                                                        \
       ANYTOUV_C(src_argb  + n * BPP, src_stride_argb,                          \
                 dst_u + (n >> 1),                                              \
                 dst_v + (n >> 1),                                              \
-                width & MASK);                                                 \
+                width - n);                                                    \
     }
 
 #ifdef HAS_ARGBTOUVROW_AVX2
 UVANY(ARGBToUVRow_Any_AVX2, ARGBToUVRow_AVX2, ARGBToUVRow_C, 4, 31)
 #endif
+#ifdef HAS_ARGBTOUVJROW_AVX2
+UVANY(ARGBToUVJRow_Any_AVX2, ARGBToUVJRow_AVX2, ARGBToUVJRow_C, 4, 31)
+#endif
+#ifdef HAS_BGRATOUVROW_AVX2
+UVANY(BGRAToUVRow_Any_AVX2, BGRAToUVRow_AVX2, BGRAToUVRow_C, 4, 31)
+#endif
+#ifdef HAS_ABGRTOUVROW_AVX2
+UVANY(ABGRToUVRow_Any_AVX2, ABGRToUVRow_AVX2, ABGRToUVRow_C, 4, 31)
+#endif
+#ifdef HAS_RGBATOUVROW_AVX2
+UVANY(RGBAToUVRow_Any_AVX2, RGBAToUVRow_AVX2, RGBAToUVRow_C, 4, 31)
+#endif
+#ifdef HAS_RGB24TOUVROW_AVX2
+UVANY(RGB24ToUVRow_Any_AVX2, RGB24ToUVRow_AVX2, RGB24ToUVRow_C, 3, 31)
+#endif
+#ifdef HAS_RAWTOUVROW_AVX2
+UVANY(RAWToUVRow_Any_AVX2, RAWToUVRow_AVX2, RAWToUVRow_C, 3, 31)
+#endif
 #ifdef HAS_ARGBTOUVROW_SSSE3
 UVANY(ARGBToUVRow_Any_SSSE3, ARGBToUVRow_SSSE3, ARGBToUVRow_C, 4, 15)
 UVANY(ARGBToUVJRow_Any_SSSE3, ARGBToUVJRow_SSSE3, ARGBToUVJRow_C, 4, 15)
@@ -461,6 +551,73 @@ UVANY(UYVYToUVRow_Any_NEON, UYVYToUVRow_NEON, UYVYToUVRow_C, 2, 15)
 #endif
 #undef UVANY
 
+// Same as UVANY, with U and V interleaved.
+#define NVUVANY(NAMEANY, ANYTOUV_SIMD, ANYTOUV_C, BPP, MASK)                   \
+    void NAMEANY(const uint8* src_argb, int src_stride_argb,                   \
+                 uint8* dst_uv, int width) {                                   \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        ANYTOUV_SIMD(src_argb, src_stride_argb, dst_uv, n);                    \
+        if (n < width) {                                                       \
+          n = (width - MASK - 1) & ~1;                                         \
+          ANYTOUV_SIMD(src_argb + n * BPP, src_stride_argb, dst_uv + n,        \
+                       MASK + 1);                                              \
+          n += MASK + 1;                                                       \
+        }                                                                      \
+      }                                                                        \
+      ANYTOUV_C(src_argb + n * BPP, src_stride_argb, dst_uv + n, width - n);   \
+    }
+
+#ifdef HAS_YUY2TONVUVROW_AVX2
+NVUVANY(YUY2ToNVUVRow_Any_AVX2, YUY2ToNVUVRow_AVX2, YUY2ToNVUVRow_C, 2, 31)
+NVUVANY(UYVYToNVUVRow_Any_AVX2, UYVYToNVUVRow_AVX2, UYVYToNVUVRow_C, 2, 31)
+#endif
+#ifdef HAS_YUY2TONVUVROW_SSE2
+NVUVANY(YUY2ToNVUVRow_Any_SSE2, YUY2ToNVUVRow_SSE2, YUY2ToNVUVRow_C, 2, 15)
+NVUVANY(UYVYToNVUVRow_Any_SSE2, UYVYToNVUVRow_SSE2, UYVYToNVUVRow_C, 2, 15)
+#endif
+#undef NVUVANY
+
+// Pair of RGB rows to 2 rows of Y and 1 row of UV.
+#define I420ANY(NAMEANY, ANYTOI420_SIMD, ANYTOI420_C, BPP, MASK)               \
+    void NAMEANY(const uint8* src_argb, int src_stride_argb,                   \
+                 uint8* dst_y, int dst_stride_y,                               \
+                 uint8* dst_u, uint8* dst_v, int width) {                      \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        ANYTOI420_SIMD(src_argb, src_stride_argb, dst_y, dst_stride_y,         \
+                       dst_u, dst_v, n);                                       \
+        if (n < width) {                                                       \
+          n = (width - MASK - 1) & ~1;                                         \
+          ANYTOI420_SIMD(src_argb + n * BPP, src_stride_argb,                  \
+                         dst_y + n, dst_stride_y,                              \
+                         dst_u + (n >> 1), dst_v + (n >> 1), MASK + 1);        \
+          n += MASK + 1;                                                       \
+        }                                                                      \
+      }                                                                        \
+      ANYTOI420_C(src_argb  + n * BPP, src_stride_argb,                        \
+                  dst_y + n, dst_stride_y,                                     \
+                  dst_u + (n >> 1),                                            \
+                  dst_v + (n >> 1),                                            \
+                  width - n);                                                  \
+    }
+
+#ifdef HAS_ARGBTOI420ROW_AVX2
+I420ANY(ARGBToI420Row_Any_AVX2, ARGBToI420Row_AVX2, ARGBToI420Row_C, 4, 31)
+I420ANY(ARGBToJ420Row_Any_AVX2, ARGBToJ420Row_AVX2, ARGBToJ420Row_C, 4, 31)
+I420ANY(BGRAToI420Row_Any_AVX2, BGRAToI420Row_AVX2, BGRAToI420Row_C, 4, 31)
+I420ANY(ABGRToI420Row_Any_AVX2, ABGRToI420Row_AVX2, ABGRToI420Row_C, 4, 31)
+I420ANY(RGBAToI420Row_Any_AVX2, RGBAToI420Row_AVX2, RGBAToI420Row_C, 4, 31)
+#endif
+#ifdef HAS_ARGBTOI420ROW_SSSE3
+I420ANY(ARGBToI420Row_Any_SSSE3, ARGBToI420Row_SSSE3, ARGBToI420Row_C, 4, 15)
+I420ANY(ARGBToJ420Row_Any_SSSE3, ARGBToJ420Row_SSSE3, ARGBToJ420Row_C, 4, 15)
+I420ANY(BGRAToI420Row_Any_SSSE3, BGRAToI420Row_SSSE3, BGRAToI420Row_C, 4, 15)
+I420ANY(ABGRToI420Row_Any_SSSE3, ABGRToI420Row_SSSE3, ABGRToI420Row_C, 4, 15)
+I420ANY(RGBAToI420Row_Any_SSSE3, RGBAToI420Row_SSSE3, RGBAToI420Row_C, 4, 15)
+#endif
+#undef I420ANY
+
 #define UV422ANY(NAMEANY, ANYTOUV_SIMD, ANYTOUV_C, BPP, SHIFT, MASK)           \
     void NAMEANY(const uint8* src_uv, uint8* dst_u, uint8* dst_v, int width) { \
       int n = width & ~MASK;                                                   \
@@ -512,11 +669,16 @@ UV422ANY(UYVYToUV422Row_Any_NEON, UYVYToUV422Row_NEON,
       int n = width & ~MASK;                                                   \
       if (n > 0) {                                                             \
         ANYTOUV_SIMD(src_uv, dst_u, dst_v, n);                                 \
+        if (n < width) {                                                       \
+          n = width - MASK - 1;                                                \
+          ANYTOUV_SIMD(src_uv + n * 2, dst_u + n, dst_v + n, MASK + 1);        \
+          n = width;                                                           \
+        }                                                                      \
       }                                                                        \
       ANYTOUV_C(src_uv + n * 2,                                                \
                 dst_u + n,                                                     \
                 dst_v + n,                                                     \
-                width & MASK);                                                 \
+                width - n);                                                    \
     }
 
 #ifdef HAS_SPLITUVROW_SSE2
@@ -540,11 +702,16 @@ SPLITUVROWANY(SplitUVRow_Any_MIPS_DSPR2, SplitUVRow_MIPS_DSPR2,
       int n = width & ~MASK;                                                   \
       if (n > 0) {                                                             \
         ANYTOUV_SIMD(src_u, src_v, dst_uv, n);                                 \
+        if (n < width) {                                                       \
+          n = width - MASK - 1;                                                \
+          ANYTOUV_SIMD(src_u + n, src_v + n, dst_uv + n * 2, MASK + 1);        \
+          n = width;                                                           \
+        }                                                                      \
       }                                                                        \
       ANYTOUV_C(src_u + n,                                                     \
                 src_v + n,                                                     \
                 dst_uv + n * 2,                                                \
-                width & MASK);                                                 \
+                width - n);                                                    \
     }
 
 #ifdef HAS_MERGEUVROW_SSE2
@@ -688,6 +855,29 @@ NANY(InterpolateRow_Any_MIPS_DSPR2, InterpolateRow_MIPS_DSPR2, InterpolateRow_C,
 #endif
 #undef NANY
 
+// Interpolate for 16 bit samples.  Stride is in shorts.
+#define NANY16(NAMEANY, TERP_SIMD, TERP_C, MASK)                               \
+    void NAMEANY(uint16* dst_ptr, const uint16* src_ptr,                       \
+                 ptrdiff_t src_stride_ptr, int width,                          \
+                 int source_y_fraction) {                                      \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        TERP_SIMD(dst_ptr, src_ptr, src_stride_ptr, n, source_y_fraction);     \
+      }                                                                        \
+      TERP_C(dst_ptr + n, src_ptr + n, src_stride_ptr,                         \
+             width & MASK, source_y_fraction);                                 \
+    }
+
+#ifdef HAS_INTERPOLATEROW_16_AVX2
+NANY16(InterpolateRow_Any_16_AVX2, InterpolateRow_16_AVX2, InterpolateRow_16_C,
+       15)
+#endif
+#ifdef HAS_INTERPOLATEROW_16_SSE2
+NANY16(InterpolateRow_Any_16_SSE2, InterpolateRow_16_SSE2, InterpolateRow_16_C,
+       7)
+#endif
+#undef NANY16
+
 #define MANY(NAMEANY, MIRROR_SIMD, MIRROR_C, BPP, MASK)                        \
     void NAMEANY(const uint8* src_y, uint8* dst_y, int width) {                \
       int n = width & ~MASK;                                                   \
@@ -710,6 +900,12 @@ MANY(MirrorRow_Any_SSE2, MirrorRow_SSE2, MirrorRow_C, 1, 15)
 #ifdef HAS_MIRRORROW_NEON
 MANY(MirrorRow_Any_NEON, MirrorRow_NEON, MirrorRow_C, 1, 15)
 #endif
+#ifdef HAS_MIRRORNVUVROW_AVX2
+MANY(MirrorNVUVRow_Any_AVX2, MirrorNVUVRow_AVX2, MirrorNVUVRow_C, 2, 15)
+#endif
+#ifdef HAS_MIRRORNVUVROW_SSE2
+MANY(MirrorNVUVRow_Any_SSE2, MirrorNVUVRow_SSE2, MirrorNVUVRow_C, 2, 7)
+#endif
 #ifdef HAS_ARGBMIRRORROW_AVX2
 MANY(ARGBMirrorRow_Any_AVX2, ARGBMirrorRow_AVX2, ARGBMirrorRow_C, 4, 7)
 #endif
@@ -737,6 +933,9 @@ MANY(CopyRow_Any_AVX, CopyRow_AVX, CopyRow_C, 1, 63)
 #ifdef HAS_COPYROW_SSE2
 MANY(CopyRow_Any_SSE2, CopyRow_SSE2, CopyRow_C, 1, 31)
 #endif
+#ifdef HAS_COPYROW_NT_SSE2
+MANY(CopyRow_NT_Any_SSE2, CopyRow_NT_SSE2, CopyRow_C, 1, 63)
+#endif
 #ifdef HAS_COPYROW_NEON
 MANY(CopyRow_Any_NEON, CopyRow_NEON, CopyRow_C, 1, 31)
 #endif
@@ -419,6 +419,23 @@ void NAME ## ToUVJRow_C(const uint8* src_rgb0, int src_stride_rgb,             \
 MAKEROWYJ(ARGB, 2, 1, 0, 4)
 #undef MAKEROWYJ
 
+// Convert a pair of rows to 2 rows of Y and 1 row of U and V.
+#define MAKEROWI420(NAME, TOYROW, TOUVROW) \
+void NAME(const uint8* src_rgb0, int src_stride_rgb,                           \
+          uint8* dst_y, int dst_stride_y,                                      \
+          uint8* dst_u, uint8* dst_v, int width) {                             \
+  TOUVROW(src_rgb0, src_stride_rgb, dst_u, dst_v, width);                      \
+  TOYROW(src_rgb0, dst_y, width);                                              \
+  TOYROW(src_rgb0 + src_stride_rgb, dst_y + dst_stride_y, width);              \
+}
+
+MAKEROWI420(ARGBToI420Row_C, ARGBToYRow_C, ARGBToUVRow_C)
+MAKEROWI420(ARGBToJ420Row_C, ARGBToYJRow_C, ARGBToUVJRow_C)
+MAKEROWI420(BGRAToI420Row_C, BGRAToYRow_C, BGRAToUVRow_C)
+MAKEROWI420(ABGRToI420Row_C, ABGRToYRow_C, ABGRToUVRow_C)
+MAKEROWI420(RGBAToI420Row_C, RGBAToYRow_C, RGBAToUVRow_C)
+#undef MAKEROWI420
+
 void ARGBToUVJ422Row_C(const uint8* src_argb,
                        uint8* dst_u, uint8* dst_v, int width) {
   int x;
@@ -1657,6 +1674,17 @@ void MirrorUVRow_C(const uint8* src_uv, uint8* dst_u, uint8* dst_v, int width) {
   }
 }
 
+void MirrorNVUVRow_C(const uint8* src_uv, uint8* dst_uv, int width) {
+  int x;
+  src_uv += (width - 1) << 1;
+  for (x = 0; x < width; ++x) {
+    dst_uv[0] = src_uv[0];
+    dst_uv[1] = src_uv[1];
+    src_uv -= 2;
+    dst_uv += 2;
+  }
+}
+
 void ARGBMirrorRow_C(const uint8* src, uint8* dst, int width) {
   int x;
   const uint32* src32 = (const uint32*)(src);
@@ -1793,6 +1821,30 @@ void UYVYToUV422Row_C(const uint8* src_uyvy,
   }
 }
 
+// Filter 2 rows of YUY2 UV's (422) into interleaved UV (NV12).
+void YUY2ToNVUVRow_C(const uint8* src_yuy2, int src_stride_yuy2,
+                     uint8* dst_uv, int width) {
+  int x;
+  for (x = 0; x < width; x += 2) {
+    dst_uv[0] = (src_yuy2[1] + src_yuy2[src_stride_yuy2 + 1] + 1) >> 1;
+    dst_uv[1] = (src_yuy2[3] + src_yuy2[src_stride_yuy2 + 3] + 1) >> 1;
+    src_yuy2 += 4;
+    dst_uv += 2;
+  }
+}
+
+// Filter 2 rows of UYVY UV's (422) into interleaved UV (NV12).
+void UYVYToNVUVRow_C(const uint8* src_uyvy, int src_stride_uyvy,
+                     uint8* dst_uv, int width) {
+  int x;
+  for (x = 0; x < width; x += 2) {
+    dst_uv[0] = (src_uyvy[0] + src_uyvy[src_stride_uyvy + 0] + 1) >> 1;
+    dst_uv[1] = (src_uyvy[2] + src_uyvy[src_stride_uyvy + 2] + 1) >> 1;
+    src_uyvy += 4;
+    dst_uv += 2;
+  }
+}
+
 // Copy row of UYVY Y's (422) into Y (420/422).
 void UYVYToYRow_C(const uint8* src_uyvy, uint8* dst_y, int width) {
   // Output a row of Y values.
@@ -2133,6 +2185,48 @@ void I422ToYUY2Row_C(const uint8* src_y,
   }
 }
 
+void NV12ToYUY2Row_C(const uint8* src_y,
+                     const uint8* src_uv,
+                     uint8* dst_frame, int width) {
+  int x;
+  for (x = 0; x < width - 1; x += 2) {
+    dst_frame[0] = src_y[0];
+    dst_frame[1] = src_uv[0];
+    dst_frame[2] = src_y[1];
+    dst_frame[3] = src_uv[1];
+    dst_frame += 4;
+    src_y += 2;
+    src_uv += 2;
+  }
+  if (width & 1) {
+    dst_frame[0] = src_y[0];
+    dst_frame[1] = src_uv[0];
+    dst_frame[2] = src_y[0];  // duplicate last y
+    dst_frame[3] = src_uv[1];
+  }
+}
+
+void NV12ToUYVYRow_C(const uint8* src_y,
+                     const uint8* src_uv,
+                     uint8* dst_frame, int width) {
+  int x;
+  for (x = 0; x < width - 1; x += 2) {
+    dst_frame[0] = src_uv[0];
+    dst_frame[1] = src_y[0];
+    dst_frame[2] = src_uv[1];
+    dst_frame[3] = src_y[1];
+    dst_frame += 4;
+    src_y += 2;
+    src_uv += 2;
+  }
+  if (width & 1) {
+    dst_frame[0] = src_uv[0];
+    dst_frame[1] = src_y[0];
+    dst_frame[2] = src_uv[1];
+    dst_frame[3] = src_y[0];  // duplicate last y
+  }
+}
+
 void I422ToUYVYRow_C(const uint8* src_y,
                      const uint8* src_u,
                      const uint8* src_v,
@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/row.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>  // For _InterlockedExchange.
+#endif
+
+#include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// The table is built into the one of two tables that was not built last,
+// then published through row_functions_ once it is complete, so a reader
+// never sees a kernel from one build with the alignment from another.
+// SetPrecision unpublishes the table, but readers may still hold it, so the
+// next build must not pick its target from the published pointer.  Builds
+// are serialized by a lock.  A caller holds a table only for one
+// conversion, so the two tables are enough unless the table is rebuilt
+// twice during it.
+static struct RowFunctions row_tables_[2];
+static int row_table_built_ = -1;  // Index of the table built last.
+static volatile int row_functions_lock_ = 0;
+
+LIBYUV_API
+const struct RowFunctions* volatile row_functions_ = NULL;
+
+static enum Precision precision_ = kPrecisionExact;
+
+#if defined(_MSC_VER)
+#define LOCK_ROW_FUNCTIONS()                                                   \
+    while (_InterlockedExchange((long volatile*)(&row_functions_lock_), 1)) {}
+#define UNLOCK_ROW_FUNCTIONS()                                                 \
+    _InterlockedExchange((long volatile*)(&row_functions_lock_), 0)
+#define PUBLISH_ROW_FUNCTIONS(table)                                           \
+    _InterlockedExchangePointer((void* volatile*)(&row_functions_),            \
+                                (void*)(table))
+#else
+#define LOCK_ROW_FUNCTIONS()                                                   \
+    while (__sync_lock_test_and_set(&row_functions_lock_, 1)) {}
+#define UNLOCK_ROW_FUNCTIONS() __sync_lock_release(&row_functions_lock_)
+#define PUBLISH_ROW_FUNCTIONS(table)                                           \
+    do {                                                                       \
+      __sync_synchronize();                                                    \
+      row_functions_ = (table);                                                \
+    } while (0)
+#endif
+
+LIBYUV_API
+void SetPrecision(enum Precision precision) {
+  LOCK_ROW_FUNCTIONS();
+  precision_ = precision;
+  // Rebuild the table on next use.
+  PUBLISH_ROW_FUNCTIONS(NULL);
+  UNLOCK_ROW_FUNCTIONS();
+}
+
+LIBYUV_API
+enum Precision GetPrecision(void) {
+  return precision_;
+}
+
+const struct RowFunctions* InitRowFunctions(void) {
+  struct RowFunctions* rows;
+  const struct RowFunctions* published;
+  // TestCpuFlag sets cpu_info_ if it is not yet detected.
+  int cpu_info = TestCpuFlag(-1);
+
+  LOCK_ROW_FUNCTIONS();
+  published = row_functions_;
+  // Another thread may have built it while this one waited for the lock.
+  if (published && published->cpu_info == cpu_info) {
+    UNLOCK_ROW_FUNCTIONS();
+    return published;
+  }
+  row_table_built_ = row_table_built_ == 0 ? 1 : 0;
+  rows = &row_tables_[row_table_built_];
+
+  SetRowFunctions(rows, precision_ == kPrecisionFast);
+  rows->cpu_info = cpu_info;
+  PUBLISH_ROW_FUNCTIONS(rows);
+  UNLOCK_ROW_FUNCTIONS();
+  return rows;
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -108,6 +108,101 @@ static uvec16 kAddUVJ128 = {
 };
 #endif  // defined(HAS_ARGBTOYROW_SSSE3) || defined(HAS_I422TOARGBROW_SSSE3)
 
+#if defined(HAS_ARGBTOI420ROW_SSSE3) || defined(HAS_BGRATOYROW_AVX2)
+
+struct RGBToYUVConstants {
+  lvec8 kRGBToY;    // 0
+  lvec8 kRGBToU;    // 32
+  lvec8 kRGBToV;    // 64
+  lvec16 kAddY;     // 96
+  ulvec16 kAddUV;   // 128
+  ulvec8 kShuffleToARGB;  // 160 RGB24 and RAW only.
+};
+
+// Y bias is added before the shift: 16 << 7 for BT.601 or 0.5 for JPeg.
+// UV bias of 0x8000 is 128 after the shift, which packsswb turns into the
+// same result as adding 128 afterward.  JPeg adds 0x80 for rounding.
+#define RGBX8(a, b, c, d)                                                      \
+  { a, b, c, d, a, b, c, d, a, b, c, d, a, b, c, d,                            \
+    a, b, c, d, a, b, c, d, a, b, c, d, a, b, c, d }
+#define WX16(a)                                                                \
+  { a, a, a, a, a, a, a, a, a, a, a, a, a, a, a, a }
+
+static RGBToYUVConstants SIMD_ALIGNED(kARGBToYUVConstants) = {
+  RGBX8(13, 65, 33, 0),
+  RGBX8(112, -74, -38, 0),
+  RGBX8(-18, -94, 112, 0),
+  WX16(16 << 7),
+  WX16(0x8000u),
+  { 0u }  // No shuffle.
+};
+
+static RGBToYUVConstants SIMD_ALIGNED(kARGBToYUVJConstants) = {
+  RGBX8(15, 75, 38, 0),
+  RGBX8(127, -84, -43, 0),
+  RGBX8(-20, -107, 127, 0),
+  WX16(64),
+  WX16(0x8080u),
+  { 0u }  // No shuffle.
+};
+
+static RGBToYUVConstants SIMD_ALIGNED(kBGRAToYUVConstants) = {
+  RGBX8(0, 33, 65, 13),
+  RGBX8(0, -38, -74, 112),
+  RGBX8(0, 112, -94, -18),
+  WX16(16 << 7),
+  WX16(0x8000u),
+  { 0u }  // No shuffle.
+};
+
+static RGBToYUVConstants SIMD_ALIGNED(kABGRToYUVConstants) = {
+  RGBX8(33, 65, 13, 0),
+  RGBX8(-38, -74, 112, 0),
+  RGBX8(112, -94, -18, 0),
+  WX16(16 << 7),
+  WX16(0x8000u),
+  { 0u }  // No shuffle.
+};
+
+static RGBToYUVConstants SIMD_ALIGNED(kRGBAToYUVConstants) = {
+  RGBX8(0, 13, 65, 33),
+  RGBX8(0, 112, -74, -38),
+  RGBX8(0, -18, -94, 112),
+  WX16(16 << 7),
+  WX16(0x8000u),
+  { 0u }  // No shuffle.
+};
+
+#ifdef HAS_RGB24TOYROW_AVX2
+// The upper lane is loaded 8 bytes further in so 32 pixels read exactly
+// 96 bytes.  Alpha is shuffled in as 0.
+static RGBToYUVConstants SIMD_ALIGNED(kRGB24ToYUVConstants) = {
+  RGBX8(13, 65, 33, 0),
+  RGBX8(112, -74, -38, 0),
+  RGBX8(-18, -94, 112, 0),
+  WX16(16 << 7),
+  WX16(0x8000u),
+  { 0u, 1u, 2u, 128u, 3u, 4u, 5u, 128u, 6u, 7u, 8u, 128u, 9u, 10u, 11u, 128u,
+    4u, 5u, 6u, 128u, 7u, 8u, 9u, 128u, 10u, 11u, 12u, 128u, 13u, 14u, 15u,
+    128u }
+};
+
+static RGBToYUVConstants SIMD_ALIGNED(kRAWToYUVConstants) = {
+  RGBX8(13, 65, 33, 0),
+  RGBX8(112, -74, -38, 0),
+  RGBX8(-18, -94, 112, 0),
+  WX16(16 << 7),
+  WX16(0x8000u),
+  { 2u, 1u, 0u, 128u, 5u, 4u, 3u, 128u, 8u, 7u, 6u, 128u, 11u, 10u, 9u, 128u,
+    6u, 5u, 4u, 128u, 9u, 8u, 7u, 128u, 12u, 11u, 10u, 128u, 15u, 14u, 13u,
+    128u }
+};
+#endif  // HAS_RGB24TOYROW_AVX2
+
+#undef RGBX8
+#undef WX16
+#endif  // HAS_ARGBTOI420ROW_SSSE3 || HAS_BGRATOYROW_AVX2
+
 #ifdef HAS_RGB24TOARGBROW_SSSE3
 
 // Shuffle table for converting RGB24 to ARGB.
@@ -478,6 +573,145 @@ void ARGB4444ToARGBRow_SSE2(const uint8* src, uint8* dst, int pix) {
   );
 }
 
+#ifdef HAS_RGB565TOARGBROW_AVX2
+void RGB565ToARGBRow_AVX2(const uint8* src, uint8* dst, int pix) {
+  asm volatile (
+    "mov       $0x1080108,%%eax                \n"
+    "vmovd     %%eax,%%xmm5                    \n"
+    "vbroadcastss %%xmm5,%%ymm5                \n"
+    "mov       $0x20802080,%%eax               \n"
+    "vmovd     %%eax,%%xmm6                    \n"
+    "vbroadcastss %%xmm6,%%ymm6                \n"
+    "vpcmpeqb  %%ymm3,%%ymm3,%%ymm3            \n"
+    "vpsllw    $0xb,%%ymm3,%%ymm3              \n"
+    "vpcmpeqb  %%ymm4,%%ymm4,%%ymm4            \n"
+    "vpsllw    $0xa,%%ymm4,%%ymm4              \n"
+    "vpsrlw    $0x5,%%ymm4,%%ymm4              \n"
+    "vpcmpeqb  %%ymm7,%%ymm7,%%ymm7            \n"
+    "vpsllw    $0x8,%%ymm7,%%ymm7              \n"
+    "sub       %0,%1                           \n"
+    "sub       %0,%1                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vpand     %%ymm3,%%ymm0,%%ymm1            \n"
+    "vpsllw    $0xb,%%ymm0,%%ymm2              \n"
+    "vpmulhuw  %%ymm5,%%ymm1,%%ymm1            \n"
+    "vpmulhuw  %%ymm5,%%ymm2,%%ymm2            \n"
+    "vpsllw    $0x8,%%ymm1,%%ymm1              \n"
+    "vpor      %%ymm2,%%ymm1,%%ymm1            \n"
+    "vpand     %%ymm4,%%ymm0,%%ymm0            \n"
+    "vpmulhuw  %%ymm6,%%ymm0,%%ymm0            \n"
+    "vpor      %%ymm7,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vpermq    $0xd8,%%ymm1,%%ymm1             \n"
+    "vpunpckhbw %%ymm0,%%ymm1,%%ymm2           \n"
+    "vpunpcklbw %%ymm0,%%ymm1,%%ymm1           \n"
+    MEMOPMEM(vmovdqu,ymm1,0x00,1,0,2)          //  vmovdqu %%ymm1,(%1,%0,2)
+    MEMOPMEM(vmovdqu,ymm2,0x20,1,0,2)          //  vmovdqu %%ymm2,0x20(%1,%0,2)
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src),  // %0
+    "+r"(dst),  // %1
+    "+r"(pix)   // %2
+  :
+  : "memory", "cc", "eax", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_RGB565TOARGBROW_AVX2
+
+#ifdef HAS_ARGB1555TOARGBROW_AVX2
+void ARGB1555ToARGBRow_AVX2(const uint8* src, uint8* dst, int pix) {
+  asm volatile (
+    "mov       $0x1080108,%%eax                \n"
+    "vmovd     %%eax,%%xmm5                    \n"
+    "vbroadcastss %%xmm5,%%ymm5                \n"
+    "mov       $0x42004200,%%eax               \n"
+    "vmovd     %%eax,%%xmm6                    \n"
+    "vbroadcastss %%xmm6,%%ymm6                \n"
+    "vpcmpeqb  %%ymm3,%%ymm3,%%ymm3            \n"
+    "vpsllw    $0xb,%%ymm3,%%ymm3              \n"
+    "vpsrlw    $0x6,%%ymm3,%%ymm4              \n"
+    "vpcmpeqb  %%ymm7,%%ymm7,%%ymm7            \n"
+    "vpsllw    $0x8,%%ymm7,%%ymm7              \n"
+    "sub       %0,%1                           \n"
+    "sub       %0,%1                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vpsllw    $0x1,%%ymm0,%%ymm1              \n"
+    "vpsllw    $0xb,%%ymm0,%%ymm2              \n"
+    "vpand     %%ymm3,%%ymm1,%%ymm1            \n"
+    "vpmulhuw  %%ymm5,%%ymm2,%%ymm2            \n"
+    "vpmulhuw  %%ymm5,%%ymm1,%%ymm1            \n"
+    "vpsllw    $0x8,%%ymm1,%%ymm1              \n"
+    "vpor      %%ymm2,%%ymm1,%%ymm1            \n"
+    "vpsraw    $0x8,%%ymm0,%%ymm2              \n"
+    "vpand     %%ymm4,%%ymm0,%%ymm0            \n"
+    "vpmulhuw  %%ymm6,%%ymm0,%%ymm0            \n"
+    "vpand     %%ymm7,%%ymm2,%%ymm2            \n"
+    "vpor      %%ymm2,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vpermq    $0xd8,%%ymm1,%%ymm1             \n"
+    "vpunpckhbw %%ymm0,%%ymm1,%%ymm2           \n"
+    "vpunpcklbw %%ymm0,%%ymm1,%%ymm1           \n"
+    MEMOPMEM(vmovdqu,ymm1,0x00,1,0,2)          //  vmovdqu %%ymm1,(%1,%0,2)
+    MEMOPMEM(vmovdqu,ymm2,0x20,1,0,2)          //  vmovdqu %%ymm2,0x20(%1,%0,2)
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src),  // %0
+    "+r"(dst),  // %1
+    "+r"(pix)   // %2
+  :
+  : "memory", "cc", "eax", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_ARGB1555TOARGBROW_AVX2
+
+#ifdef HAS_ARGB4444TOARGBROW_AVX2
+void ARGB4444ToARGBRow_AVX2(const uint8* src, uint8* dst, int pix) {
+  asm volatile (
+    "mov       $0xf0f0f0f,%%eax                \n"
+    "vmovd     %%eax,%%xmm4                    \n"
+    "vbroadcastss %%xmm4,%%ymm4                \n"
+    "vpslld    $0x4,%%ymm4,%%ymm5              \n"
+    "sub       %0,%1                           \n"
+    "sub       %0,%1                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vpand     %%ymm5,%%ymm0,%%ymm2            \n"
+    "vpand     %%ymm4,%%ymm0,%%ymm0            \n"
+    "vpsrlw    $0x4,%%ymm2,%%ymm3              \n"
+    "vpsllw    $0x4,%%ymm0,%%ymm1              \n"
+    "vpor      %%ymm3,%%ymm2,%%ymm2            \n"
+    "vpor      %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vpermq    $0xd8,%%ymm2,%%ymm2             \n"
+    "vpunpckhbw %%ymm2,%%ymm0,%%ymm1           \n"
+    "vpunpcklbw %%ymm2,%%ymm0,%%ymm0           \n"
+    MEMOPMEM(vmovdqu,ymm0,0x00,1,0,2)          //  vmovdqu %%ymm0,(%1,%0,2)
+    MEMOPMEM(vmovdqu,ymm1,0x20,1,0,2)          //  vmovdqu %%ymm1,0x20(%1,%0,2)
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src),  // %0
+    "+r"(dst),  // %1
+    "+r"(pix)   // %2
+  :
+  : "memory", "cc", "eax", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+}
+#endif  // HAS_ARGB4444TOARGBROW_AVX2
+
 void ARGBToRGB24Row_SSSE3(const uint8* src, uint8* dst, int pix) {
   asm volatile (
     "movdqa    %3,%%xmm6                       \n"
@@ -952,6 +1186,257 @@ void ARGBToUVRow_AVX2(const uint8* src_argb0, int src_stride_argb,
 }
 #endif  // HAS_ARGBTOUVROW_AVX2
 
+#ifdef HAS_BGRATOYROW_AVX2
+// Load 32 RGB24 pixels (96 bytes) into ymm0-3 in ARGB order.
+#define READRGB24_AVX2                                                         \
+    "vmovdqu    " MEMACCESS([src_rgb]) ",%%xmm0                   \n"          \
+    "vinserti128 $0x1," MEMACCESS2(0x08,[src_rgb]) ",%%ymm0,%%ymm0 \n"         \
+    "vmovdqu    " MEMACCESS2(0x18,[src_rgb]) ",%%xmm1             \n"          \
+    "vinserti128 $0x1," MEMACCESS2(0x20,[src_rgb]) ",%%ymm1,%%ymm1 \n"         \
+    "vmovdqu    " MEMACCESS2(0x30,[src_rgb]) ",%%xmm2             \n"          \
+    "vinserti128 $0x1," MEMACCESS2(0x38,[src_rgb]) ",%%ymm2,%%ymm2 \n"         \
+    "vmovdqu    " MEMACCESS2(0x48,[src_rgb]) ",%%xmm3             \n"          \
+    "vinserti128 $0x1," MEMACCESS2(0x50,[src_rgb]) ",%%ymm3,%%ymm3 \n"
+
+// Average in the next row of 32 RGB24 pixels.  Uses ymm4 and ymm7.
+#define AVGRGB24_AVX2(OFFSET, REG)                                             \
+    MEMOPREG(vmovdqu, OFFSET, [src_rgb], [src_stride_rgb], 1, xmm4)           \
+    MEMOPREG(vmovdqu, OFFSET + 8, [src_rgb], [src_stride_rgb], 1, xmm7)       \
+    "vinserti128 $0x1,%%xmm7,%%ymm4,%%ymm4                         \n"         \
+    "vpavgb     %%ymm4,%%" #REG ",%%" #REG "                       \n"
+
+// Convert 32 pixels in ymm0-3 to 32 Y values in ymm0.
+#define RGBTOY_AVX2(YuvConstants)                                              \
+    "vpmaddubsw " MEMACCESS([YuvConstants]) ",%%ymm0,%%ymm0         \n"        \
+    "vpmaddubsw " MEMACCESS([YuvConstants]) ",%%ymm1,%%ymm1         \n"        \
+    "vpmaddubsw " MEMACCESS([YuvConstants]) ",%%ymm2,%%ymm2         \n"        \
+    "vpmaddubsw " MEMACCESS([YuvConstants]) ",%%ymm3,%%ymm3         \n"        \
+    "vphaddw    %%ymm1,%%ymm0,%%ymm0                                \n"        \
+    "vphaddw    %%ymm3,%%ymm2,%%ymm2                                \n"        \
+    "vpaddw     " MEMACCESS2(0x60,[YuvConstants]) ",%%ymm0,%%ymm0   \n"        \
+    "vpaddw     " MEMACCESS2(0x60,[YuvConstants]) ",%%ymm2,%%ymm2   \n"        \
+    "vpsrlw     $0x7,%%ymm0,%%ymm0                                  \n"        \
+    "vpsrlw     $0x7,%%ymm2,%%ymm2                                  \n"        \
+    "vpackuswb  %%ymm2,%%ymm0,%%ymm0                                \n"        \
+    "vpermd     %%ymm0,%%ymm6,%%ymm0                                \n"
+
+// Convert 32 averaged pixels in ymm0-3 to 16 U and 16 V in ymm0.
+#define RGBTOUV_AVX2(YuvConstants)                                             \
+    "vshufps    $0x88,%%ymm1,%%ymm0,%%ymm4                          \n"        \
+    "vshufps    $0xdd,%%ymm1,%%ymm0,%%ymm0                          \n"        \
+    "vpavgb     %%ymm4,%%ymm0,%%ymm0                                \n"        \
+    "vshufps    $0x88,%%ymm3,%%ymm2,%%ymm4                          \n"        \
+    "vshufps    $0xdd,%%ymm3,%%ymm2,%%ymm2                          \n"        \
+    "vpavgb     %%ymm4,%%ymm2,%%ymm2                                \n"        \
+    "vpmaddubsw " MEMACCESS2(0x20,[YuvConstants]) ",%%ymm0,%%ymm1   \n"        \
+    "vpmaddubsw " MEMACCESS2(0x20,[YuvConstants]) ",%%ymm2,%%ymm3   \n"        \
+    "vpmaddubsw " MEMACCESS2(0x40,[YuvConstants]) ",%%ymm0,%%ymm0   \n"        \
+    "vpmaddubsw " MEMACCESS2(0x40,[YuvConstants]) ",%%ymm2,%%ymm2   \n"        \
+    "vphaddw    %%ymm3,%%ymm1,%%ymm1                                \n"        \
+    "vphaddw    %%ymm2,%%ymm0,%%ymm0                                \n"        \
+    "vpaddw     " MEMACCESS2(0x80,[YuvConstants]) ",%%ymm1,%%ymm1   \n"        \
+    "vpaddw     " MEMACCESS2(0x80,[YuvConstants]) ",%%ymm0,%%ymm0   \n"        \
+    "vpsraw     $0x8,%%ymm1,%%ymm1                                  \n"        \
+    "vpsraw     $0x8,%%ymm0,%%ymm0                                  \n"        \
+    "vpacksswb  %%ymm0,%%ymm1,%%ymm0                                \n"        \
+    "vpermq     $0xd8,%%ymm0,%%ymm0                                 \n"        \
+    "vpshufb    %[kShufARGBToUV_AVX],%%ymm0,%%ymm0                  \n"
+
+// Store 16 U and 16 V.  dst_v is relative to dst_u.
+#define STOREUV_AVX2                                                           \
+    "vextractf128 $0x0,%%ymm0," MEMACCESS([dst_u]) "                \n"        \
+    VEXTOPMEM(vextractf128,1,ymm0,0x0,[dst_u],[dst_v],1)                       \
+    "lea        " MEMLEA(0x10,[dst_u]) ",%[dst_u]                   \n"
+
+// Convert 32 pixels of 4 bytes to 32 Y values.
+static void RGBToYRow_AVX2(const uint8* src_rgb, uint8* dst_y, int pix,
+                           const RGBToYUVConstants* yuvconstants) {
+  asm volatile (
+    "vmovdqu    %[kPermdARGBToY_AVX],%%ymm6    \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu    " MEMACCESS([src_rgb]) ",%%ymm0        \n"
+    "vmovdqu    " MEMACCESS2(0x20,[src_rgb]) ",%%ymm1  \n"
+    "vmovdqu    " MEMACCESS2(0x40,[src_rgb]) ",%%ymm2  \n"
+    "vmovdqu    " MEMACCESS2(0x60,[src_rgb]) ",%%ymm3  \n"
+    "lea        " MEMLEA(0x80,[src_rgb]) ",%[src_rgb]  \n"
+    RGBTOY_AVX2(yuvconstants)
+    "vmovdqu    %%ymm0," MEMACCESS([dst_y]) "          \n"
+    "lea        " MEMLEA(0x20,[dst_y]) ",%[dst_y]      \n"
+    "sub        $0x20,%[pix]                           \n"
+    "jg         1b                                     \n"
+    "vzeroupper                                        \n"
+  : [src_rgb]"+r"(src_rgb),  // %[src_rgb]
+    [dst_y]"+r"(dst_y),      // %[dst_y]
+    [pix]"+r"(pix)           // %[pix]
+  : [yuvconstants]"r"(yuvconstants),  // %[yuvconstants]
+    [kPermdARGBToY_AVX]"m"(kPermdARGBToY_AVX)
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm6"
+  );
+}
+
+// Convert 32 pixels of RGB24 or RAW to 32 Y values.
+static void RGBToYRow24_AVX2(const uint8* src_rgb, uint8* dst_y, int pix,
+                             const RGBToYUVConstants* yuvconstants) {
+  asm volatile (
+    "vmovdqu    " MEMACCESS2(0xa0,[yuvconstants]) ",%%ymm5 \n"
+    "vmovdqu    %[kPermdARGBToY_AVX],%%ymm6    \n"
+    LABELALIGN
+  "1:                                          \n"
+    READRGB24_AVX2
+    "lea        " MEMLEA(0x60,[src_rgb]) ",%[src_rgb]  \n"
+    "vpshufb    %%ymm5,%%ymm0,%%ymm0                   \n"
+    "vpshufb    %%ymm5,%%ymm1,%%ymm1                   \n"
+    "vpshufb    %%ymm5,%%ymm2,%%ymm2                   \n"
+    "vpshufb    %%ymm5,%%ymm3,%%ymm3                   \n"
+    RGBTOY_AVX2(yuvconstants)
+    "vmovdqu    %%ymm0," MEMACCESS([dst_y]) "          \n"
+    "lea        " MEMLEA(0x20,[dst_y]) ",%[dst_y]      \n"
+    "sub        $0x20,%[pix]                           \n"
+    "jg         1b                                     \n"
+    "vzeroupper                                        \n"
+  : [src_rgb]"+r"(src_rgb),  // %[src_rgb]
+    [dst_y]"+r"(dst_y),      // %[dst_y]
+    [pix]"+r"(pix)           // %[pix]
+  : [yuvconstants]"r"(yuvconstants),  // %[yuvconstants]
+    [kPermdARGBToY_AVX]"m"(kPermdARGBToY_AVX)
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5", "xmm6"
+  );
+}
+
+// Convert 2 rows of 32 pixels of 4 bytes to 16 U and 16 V values.
+static void RGBToUVRow_AVX2(const uint8* src_rgb, int src_stride_rgb,
+                            uint8* dst_u, uint8* dst_v, int width,
+                            const RGBToYUVConstants* yuvconstants) {
+  asm volatile (
+    "sub        %[dst_u],%[dst_v]              \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu    " MEMACCESS([src_rgb]) ",%%ymm0        \n"
+    "vmovdqu    " MEMACCESS2(0x20,[src_rgb]) ",%%ymm1  \n"
+    "vmovdqu    " MEMACCESS2(0x40,[src_rgb]) ",%%ymm2  \n"
+    "vmovdqu    " MEMACCESS2(0x60,[src_rgb]) ",%%ymm3  \n"
+    VMEMOPREG(vpavgb,0x00,[src_rgb],[src_stride_rgb],1,ymm0,ymm0)
+    VMEMOPREG(vpavgb,0x20,[src_rgb],[src_stride_rgb],1,ymm1,ymm1)
+    VMEMOPREG(vpavgb,0x40,[src_rgb],[src_stride_rgb],1,ymm2,ymm2)
+    VMEMOPREG(vpavgb,0x60,[src_rgb],[src_stride_rgb],1,ymm3,ymm3)
+    "lea        " MEMLEA(0x80,[src_rgb]) ",%[src_rgb]  \n"
+    RGBTOUV_AVX2(yuvconstants)
+    STOREUV_AVX2
+    "sub        $0x20,%[width]                         \n"
+    "jg         1b                                     \n"
+    "vzeroupper                                        \n"
+  : [src_rgb]"+r"(src_rgb),  // %[src_rgb]
+    [dst_u]"+r"(dst_u),      // %[dst_u]
+    [dst_v]"+r"(dst_v),      // %[dst_v]
+    [width]"+rm"(width)      // %[width]
+  : [src_stride_rgb]"r"((intptr_t)(src_stride_rgb)),
+    [yuvconstants]"r"(yuvconstants),  // %[yuvconstants]
+    [kShufARGBToUV_AVX]"m"(kShufARGBToUV_AVX)
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4"
+  );
+}
+
+// Convert 2 rows of 32 pixels of RGB24 or RAW to 16 U and 16 V values.
+static void RGBToUVRow24_AVX2(const uint8* src_rgb, int src_stride_rgb,
+                              uint8* dst_u, uint8* dst_v, int width,
+                              const RGBToYUVConstants* yuvconstants) {
+  asm volatile (
+    "vmovdqu    " MEMACCESS2(0xa0,[yuvconstants]) ",%%ymm6 \n"
+    "sub        %[dst_u],%[dst_v]              \n"
+    LABELALIGN
+  "1:                                          \n"
+    READRGB24_AVX2
+    AVGRGB24_AVX2(0x00, ymm0)
+    AVGRGB24_AVX2(0x18, ymm1)
+    AVGRGB24_AVX2(0x30, ymm2)
+    AVGRGB24_AVX2(0x48, ymm3)
+    "lea        " MEMLEA(0x60,[src_rgb]) ",%[src_rgb]  \n"
+    "vpshufb    %%ymm6,%%ymm0,%%ymm0                   \n"
+    "vpshufb    %%ymm6,%%ymm1,%%ymm1                   \n"
+    "vpshufb    %%ymm6,%%ymm2,%%ymm2                   \n"
+    "vpshufb    %%ymm6,%%ymm3,%%ymm3                   \n"
+    RGBTOUV_AVX2(yuvconstants)
+    STOREUV_AVX2
+    "sub        $0x20,%[width]                         \n"
+    "jg         1b                                     \n"
+    "vzeroupper                                        \n"
+  : [src_rgb]"+r"(src_rgb),  // %[src_rgb]
+    [dst_u]"+r"(dst_u),      // %[dst_u]
+    [dst_v]"+r"(dst_v),      // %[dst_v]
+    [width]"+rm"(width)      // %[width]
+  : [src_stride_rgb]"r"((intptr_t)(src_stride_rgb)),
+    [yuvconstants]"r"(yuvconstants),  // %[yuvconstants]
+    [kShufARGBToUV_AVX]"m"(kShufARGBToUV_AVX)
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm6", "xmm7"
+  );
+}
+
+#undef READRGB24_AVX2
+#undef AVGRGB24_AVX2
+#undef RGBTOY_AVX2
+#undef RGBTOUV_AVX2
+#undef STOREUV_AVX2
+
+void BGRAToYRow_AVX2(const uint8* src_bgra, uint8* dst_y, int pix) {
+  RGBToYRow_AVX2(src_bgra, dst_y, pix, &kBGRAToYUVConstants);
+}
+
+void ABGRToYRow_AVX2(const uint8* src_abgr, uint8* dst_y, int pix) {
+  RGBToYRow_AVX2(src_abgr, dst_y, pix, &kABGRToYUVConstants);
+}
+
+void RGBAToYRow_AVX2(const uint8* src_rgba, uint8* dst_y, int pix) {
+  RGBToYRow_AVX2(src_rgba, dst_y, pix, &kRGBAToYUVConstants);
+}
+
+void RGB24ToYRow_AVX2(const uint8* src_rgb24, uint8* dst_y, int pix) {
+  RGBToYRow24_AVX2(src_rgb24, dst_y, pix, &kRGB24ToYUVConstants);
+}
+
+void RAWToYRow_AVX2(const uint8* src_raw, uint8* dst_y, int pix) {
+  RGBToYRow24_AVX2(src_raw, dst_y, pix, &kRAWToYUVConstants);
+}
+
+void ARGBToUVJRow_AVX2(const uint8* src_argb, int src_stride_argb,
+                       uint8* dst_u, uint8* dst_v, int width) {
+  RGBToUVRow_AVX2(src_argb, src_stride_argb, dst_u, dst_v, width,
+                  &kARGBToYUVJConstants);
+}
+
+void BGRAToUVRow_AVX2(const uint8* src_bgra, int src_stride_bgra,
+                      uint8* dst_u, uint8* dst_v, int width) {
+  RGBToUVRow_AVX2(src_bgra, src_stride_bgra, dst_u, dst_v, width,
+                  &kBGRAToYUVConstants);
+}
+
+void ABGRToUVRow_AVX2(const uint8* src_abgr, int src_stride_abgr,
+                      uint8* dst_u, uint8* dst_v, int width) {
+  RGBToUVRow_AVX2(src_abgr, src_stride_abgr, dst_u, dst_v, width,
+                  &kABGRToYUVConstants);
+}
+
+void RGBAToUVRow_AVX2(const uint8* src_rgba, int src_stride_rgba,
+                      uint8* dst_u, uint8* dst_v, int width) {
+  RGBToUVRow_AVX2(src_rgba, src_stride_rgba, dst_u, dst_v, width,
+                  &kRGBAToYUVConstants);
+}
+
+void RGB24ToUVRow_AVX2(const uint8* src_rgb24, int src_stride_rgb24,
+                       uint8* dst_u, uint8* dst_v, int width) {
+  RGBToUVRow24_AVX2(src_rgb24, src_stride_rgb24, dst_u, dst_v, width,
+                    &kRGB24ToYUVConstants);
+}
+
+void RAWToUVRow_AVX2(const uint8* src_raw, int src_stride_raw,
+                     uint8* dst_u, uint8* dst_v, int width) {
+  RGBToUVRow24_AVX2(src_raw, src_stride_raw, dst_u, dst_v, width,
+                    &kRAWToYUVConstants);
+}
+#endif  // HAS_BGRATOYROW_AVX2
+
 #ifdef HAS_ARGBTOUVJROW_SSSE3
 void ARGBToUVJRow_SSSE3(const uint8* src_argb0, int src_stride_argb,
                         uint8* dst_u, uint8* dst_v, int width) {
@@ -1411,6 +1896,266 @@ void RGBAToUVRow_SSSE3(const uint8* src_rgba0, int src_stride_rgba,
   );
 }
 
+#ifdef HAS_ARGBTOI420ROW_SSSE3
+// Convert 2 rows of 16 pixels to 2 rows of 16 Y and 8 U and V.
+// Each source row is read once; the second row is averaged into the first
+// while its Y is computed, matching ARGBToUVRow_SSSE3 and ARGBToYRow_SSSE3.
+static void RGBToI420Row_SSSE3(const uint8* src_argb, int src_stride_argb,
+                               uint8* dst_y, int dst_stride_y,
+                               uint8* dst_u, uint8* dst_v, int width,
+                               const RGBToYUVConstants* yuvconstants) {
+  asm volatile (
+    "sub       %2,%3                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "movdqu    " MEMACCESS2(0x20,0) ",%%xmm2   \n"
+    "movdqu    " MEMACCESS2(0x30,0) ",%%xmm3   \n"
+    "movdqa    %%xmm0,%%xmm4                   \n"
+    "movdqa    %%xmm1,%%xmm5                   \n"
+    "pmaddubsw " MEMACCESS(7) ",%%xmm4         \n"
+    "pmaddubsw " MEMACCESS(7) ",%%xmm5         \n"
+    "phaddw    %%xmm5,%%xmm4                   \n"
+    "movdqa    %%xmm2,%%xmm5                   \n"
+    "movdqa    %%xmm3,%%xmm6                   \n"
+    "pmaddubsw " MEMACCESS(7) ",%%xmm5         \n"
+    "pmaddubsw " MEMACCESS(7) ",%%xmm6         \n"
+    "phaddw    %%xmm6,%%xmm5                   \n"
+    "paddw     " MEMACCESS2(0x60,7) ",%%xmm4   \n"
+    "paddw     " MEMACCESS2(0x60,7) ",%%xmm5   \n"
+    "psrlw     $0x7,%%xmm4                     \n"
+    "psrlw     $0x7,%%xmm5                     \n"
+    "packuswb  %%xmm5,%%xmm4                   \n"
+    "movdqu    %%xmm4," MEMACCESS(1) "         \n"
+
+    MEMOPREG(movdqu,0x00,0,5,1,xmm4)            //  movdqu (%0,%5,1),%%xmm4
+    MEMOPREG(movdqu,0x10,0,5,1,xmm5)            //  movdqu 0x10(%0,%5,1),%%xmm5
+    "pavgb     %%xmm4,%%xmm0                   \n"
+    "pavgb     %%xmm5,%%xmm1                   \n"
+    "pmaddubsw " MEMACCESS(7) ",%%xmm4         \n"
+    "pmaddubsw " MEMACCESS(7) ",%%xmm5         \n"
+    "phaddw    %%xmm5,%%xmm4                   \n"
+    MEMOPREG(movdqu,0x20,0,5,1,xmm5)            //  movdqu 0x20(%0,%5,1),%%xmm5
+    MEMOPREG(movdqu,0x30,0,5,1,xmm6)            //  movdqu 0x30(%0,%5,1),%%xmm6
+    "pavgb     %%xmm5,%%xmm2                   \n"
+    "pavgb     %%xmm6,%%xmm3                   \n"
+    "pmaddubsw " MEMACCESS(7) ",%%xmm5         \n"
+    "pmaddubsw " MEMACCESS(7) ",%%xmm6         \n"
+    "phaddw    %%xmm6,%%xmm5                   \n"
+    "paddw     " MEMACCESS2(0x60,7) ",%%xmm4   \n"
+    "paddw     " MEMACCESS2(0x60,7) ",%%xmm5   \n"
+    "psrlw     $0x7,%%xmm4                     \n"
+    "psrlw     $0x7,%%xmm5                     \n"
+    "packuswb  %%xmm5,%%xmm4                   \n"
+    MEMOPMEM(movdqu,xmm4,0x00,1,6,1)            //  movdqu %%xmm4,(%1,%6,1)
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+
+    "movdqa    %%xmm0,%%xmm7                   \n"
+    "shufps    $0x88,%%xmm1,%%xmm0             \n"
+    "shufps    $0xdd,%%xmm1,%%xmm7             \n"
+    "pavgb     %%xmm7,%%xmm0                   \n"
+    "movdqa    %%xmm2,%%xmm7                   \n"
+    "shufps    $0x88,%%xmm3,%%xmm2             \n"
+    "shufps    $0xdd,%%xmm3,%%xmm7             \n"
+    "pavgb     %%xmm7,%%xmm2                   \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "movdqa    %%xmm2,%%xmm6                   \n"
+    "pmaddubsw " MEMACCESS2(0x20,7) ",%%xmm0   \n"
+    "pmaddubsw " MEMACCESS2(0x20,7) ",%%xmm2   \n"
+    "pmaddubsw " MEMACCESS2(0x40,7) ",%%xmm1   \n"
+    "pmaddubsw " MEMACCESS2(0x40,7) ",%%xmm6   \n"
+    "phaddw    %%xmm2,%%xmm0                   \n"
+    "phaddw    %%xmm6,%%xmm1                   \n"
+    "paddw     " MEMACCESS2(0x80,7) ",%%xmm0   \n"
+    "paddw     " MEMACCESS2(0x80,7) ",%%xmm1   \n"
+    "psraw     $0x8,%%xmm0                     \n"
+    "psraw     $0x8,%%xmm1                     \n"
+    "packsswb  %%xmm1,%%xmm0                   \n"
+    "movlps    %%xmm0," MEMACCESS(2) "         \n"
+    MEMOPMEM(movhps,xmm0,0x00,2,3,1)           //  movhps    %%xmm0,(%2,%3,1)
+    "lea       " MEMLEA(0x8,2) ",%2            \n"
+    "sub       $0x10,%4                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_argb),        // %0
+    "+r"(dst_y),           // %1
+    "+r"(dst_u),           // %2
+    "+r"(dst_v),           // %3
+    "+rm"(width)           // %4
+  : "r"((intptr_t)(src_stride_argb)),  // %5
+    "r"((intptr_t)(dst_stride_y)),     // %6
+    "r"(yuvconstants)                  // %7
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+
+void ARGBToI420Row_SSSE3(const uint8* src_argb, int src_stride_argb,
+                         uint8* dst_y, int dst_stride_y,
+                         uint8* dst_u, uint8* dst_v, int width) {
+  RGBToI420Row_SSSE3(src_argb, src_stride_argb, dst_y, dst_stride_y,
+                     dst_u, dst_v, width, &kARGBToYUVConstants);
+}
+
+void ARGBToJ420Row_SSSE3(const uint8* src_argb, int src_stride_argb,
+                         uint8* dst_y, int dst_stride_y,
+                         uint8* dst_u, uint8* dst_v, int width) {
+  RGBToI420Row_SSSE3(src_argb, src_stride_argb, dst_y, dst_stride_y,
+                     dst_u, dst_v, width, &kARGBToYUVJConstants);
+}
+
+void BGRAToI420Row_SSSE3(const uint8* src_bgra, int src_stride_bgra,
+                         uint8* dst_y, int dst_stride_y,
+                         uint8* dst_u, uint8* dst_v, int width) {
+  RGBToI420Row_SSSE3(src_bgra, src_stride_bgra, dst_y, dst_stride_y,
+                     dst_u, dst_v, width, &kBGRAToYUVConstants);
+}
+
+void ABGRToI420Row_SSSE3(const uint8* src_abgr, int src_stride_abgr,
+                         uint8* dst_y, int dst_stride_y,
+                         uint8* dst_u, uint8* dst_v, int width) {
+  RGBToI420Row_SSSE3(src_abgr, src_stride_abgr, dst_y, dst_stride_y,
+                     dst_u, dst_v, width, &kABGRToYUVConstants);
+}
+
+void RGBAToI420Row_SSSE3(const uint8* src_rgba, int src_stride_rgba,
+                         uint8* dst_y, int dst_stride_y,
+                         uint8* dst_u, uint8* dst_v, int width) {
+  RGBToI420Row_SSSE3(src_rgba, src_stride_rgba, dst_y, dst_stride_y,
+                     dst_u, dst_v, width, &kRGBAToYUVConstants);
+}
+#endif  // HAS_ARGBTOI420ROW_SSSE3
+
+#ifdef HAS_ARGBTOI420ROW_AVX2
+// Convert 2 rows of 32 pixels to 2 rows of 32 Y and 16 U and V.
+static void RGBToI420Row_AVX2(const uint8* src_argb, int src_stride_argb,
+                              uint8* dst_y, int dst_stride_y,
+                              uint8* dst_u, uint8* dst_v, int width,
+                              const RGBToYUVConstants* yuvconstants) {
+  asm volatile (
+    "vmovdqu    %8,%%ymm7                      \n"
+    "sub       %2,%3                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu    " MEMACCESS(0) ",%%ymm0        \n"
+    "vmovdqu    " MEMACCESS2(0x20,0) ",%%ymm1  \n"
+    "vmovdqu    " MEMACCESS2(0x40,0) ",%%ymm2  \n"
+    "vmovdqu    " MEMACCESS2(0x60,0) ",%%ymm3  \n"
+    "vpmaddubsw " MEMACCESS(7) ",%%ymm0,%%ymm4 \n"
+    "vpmaddubsw " MEMACCESS(7) ",%%ymm1,%%ymm5 \n"
+    "vphaddw    %%ymm5,%%ymm4,%%ymm4           \n"  // mutates.
+    "vpmaddubsw " MEMACCESS(7) ",%%ymm2,%%ymm5 \n"
+    "vpmaddubsw " MEMACCESS(7) ",%%ymm3,%%ymm6 \n"
+    "vphaddw    %%ymm6,%%ymm5,%%ymm5           \n"
+    "vpaddw     " MEMACCESS2(0x60,7) ",%%ymm4,%%ymm4 \n"
+    "vpaddw     " MEMACCESS2(0x60,7) ",%%ymm5,%%ymm5 \n"
+    "vpsrlw     $0x7,%%ymm4,%%ymm4             \n"
+    "vpsrlw     $0x7,%%ymm5,%%ymm5             \n"
+    "vpackuswb  %%ymm5,%%ymm4,%%ymm4           \n"  // mutates.
+    "vpermd     %%ymm4,%%ymm7,%%ymm4           \n"  // unmutate.
+    "vmovdqu    %%ymm4," MEMACCESS(1) "        \n"
+
+    MEMOPREG(vmovdqu,0x00,0,5,1,ymm4)           //  vmovdqu (%0,%5,1),%%ymm4
+    MEMOPREG(vmovdqu,0x20,0,5,1,ymm5)
+    "vpavgb     %%ymm4,%%ymm0,%%ymm0           \n"
+    "vpavgb     %%ymm5,%%ymm1,%%ymm1           \n"
+    "vpmaddubsw " MEMACCESS(7) ",%%ymm4,%%ymm4 \n"
+    "vpmaddubsw " MEMACCESS(7) ",%%ymm5,%%ymm5 \n"
+    "vphaddw    %%ymm5,%%ymm4,%%ymm4           \n"
+    MEMOPREG(vmovdqu,0x40,0,5,1,ymm5)
+    MEMOPREG(vmovdqu,0x60,0,5,1,ymm6)
+    "vpavgb     %%ymm5,%%ymm2,%%ymm2           \n"
+    "vpavgb     %%ymm6,%%ymm3,%%ymm3           \n"
+    "vpmaddubsw " MEMACCESS(7) ",%%ymm5,%%ymm5 \n"
+    "vpmaddubsw " MEMACCESS(7) ",%%ymm6,%%ymm6 \n"
+    "vphaddw    %%ymm6,%%ymm5,%%ymm5           \n"
+    "vpaddw     " MEMACCESS2(0x60,7) ",%%ymm4,%%ymm4 \n"
+    "vpaddw     " MEMACCESS2(0x60,7) ",%%ymm5,%%ymm5 \n"
+    "vpsrlw     $0x7,%%ymm4,%%ymm4             \n"
+    "vpsrlw     $0x7,%%ymm5,%%ymm5             \n"
+    "vpackuswb  %%ymm5,%%ymm4,%%ymm4           \n"
+    "vpermd     %%ymm4,%%ymm7,%%ymm4           \n"
+    MEMOPMEM(vmovdqu,ymm4,0x00,1,6,1)           //  vmovdqu %%ymm4,(%1,%6,1)
+    "lea       " MEMLEA(0x80,0) ",%0           \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+
+    "vshufps    $0x88,%%ymm1,%%ymm0,%%ymm4     \n"
+    "vshufps    $0xdd,%%ymm1,%%ymm0,%%ymm0     \n"
+    "vpavgb     %%ymm4,%%ymm0,%%ymm0           \n"
+    "vshufps    $0x88,%%ymm3,%%ymm2,%%ymm4     \n"
+    "vshufps    $0xdd,%%ymm3,%%ymm2,%%ymm2     \n"
+    "vpavgb     %%ymm4,%%ymm2,%%ymm2           \n"
+    "vpmaddubsw " MEMACCESS2(0x20,7) ",%%ymm0,%%ymm1 \n"
+    "vpmaddubsw " MEMACCESS2(0x20,7) ",%%ymm2,%%ymm3 \n"
+    "vpmaddubsw " MEMACCESS2(0x40,7) ",%%ymm0,%%ymm0 \n"
+    "vpmaddubsw " MEMACCESS2(0x40,7) ",%%ymm2,%%ymm2 \n"
+    "vphaddw    %%ymm3,%%ymm1,%%ymm1           \n"
+    "vphaddw    %%ymm2,%%ymm0,%%ymm0           \n"
+    "vpaddw     " MEMACCESS2(0x80,7) ",%%ymm1,%%ymm1 \n"
+    "vpaddw     " MEMACCESS2(0x80,7) ",%%ymm0,%%ymm0 \n"
+    "vpsraw     $0x8,%%ymm1,%%ymm1             \n"
+    "vpsraw     $0x8,%%ymm0,%%ymm0             \n"
+    "vpacksswb  %%ymm0,%%ymm1,%%ymm0           \n"
+    "vpermq     $0xd8,%%ymm0,%%ymm0            \n"
+    "vpshufb    %9,%%ymm0,%%ymm0               \n"
+    "vextractf128 $0x0,%%ymm0," MEMACCESS(2) " \n"
+    VEXTOPMEM(vextractf128,1,ymm0,0x0,2,3,1) // vextractf128 $1,%%ymm0,(%2,%3,1)
+    "lea       " MEMLEA(0x10,2) ",%2           \n"
+    "sub       $0x20,%4                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_argb),        // %0
+    "+r"(dst_y),           // %1
+    "+r"(dst_u),           // %2
+    "+r"(dst_v),           // %3
+    "+rm"(width)           // %4
+  : "r"((intptr_t)(src_stride_argb)),  // %5
+    "r"((intptr_t)(dst_stride_y)),     // %6
+    "r"(yuvconstants),                 // %7
+    "m"(kPermdARGBToY_AVX),            // %8
+    "m"(kShufARGBToUV_AVX)             // %9
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+
+void ARGBToI420Row_AVX2(const uint8* src_argb, int src_stride_argb,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width) {
+  RGBToI420Row_AVX2(src_argb, src_stride_argb, dst_y, dst_stride_y,
+                    dst_u, dst_v, width, &kARGBToYUVConstants);
+}
+
+void ARGBToJ420Row_AVX2(const uint8* src_argb, int src_stride_argb,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width) {
+  RGBToI420Row_AVX2(src_argb, src_stride_argb, dst_y, dst_stride_y,
+                    dst_u, dst_v, width, &kARGBToYUVJConstants);
+}
+
+void BGRAToI420Row_AVX2(const uint8* src_bgra, int src_stride_bgra,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width) {
+  RGBToI420Row_AVX2(src_bgra, src_stride_bgra, dst_y, dst_stride_y,
+                    dst_u, dst_v, width, &kBGRAToYUVConstants);
+}
+
+void ABGRToI420Row_AVX2(const uint8* src_abgr, int src_stride_abgr,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width) {
+  RGBToI420Row_AVX2(src_abgr, src_stride_abgr, dst_y, dst_stride_y,
+                    dst_u, dst_v, width, &kABGRToYUVConstants);
+}
+
+void RGBAToI420Row_AVX2(const uint8* src_rgba, int src_stride_rgba,
+                        uint8* dst_y, int dst_stride_y,
+                        uint8* dst_u, uint8* dst_v, int width) {
+  RGBToI420Row_AVX2(src_rgba, src_stride_rgba, dst_y, dst_stride_y,
+                    dst_u, dst_v, width, &kRGBAToYUVConstants);
+}
+#endif  // HAS_ARGBTOI420ROW_AVX2
+
 #if defined(HAS_I422TOARGBROW_SSSE3) || defined(HAS_I422TOARGBROW_AVX2)
 
 struct YuvConstants {
@@ -1472,6 +2217,31 @@ static YuvConstants SIMD_ALIGNED(kYvuConstants) = {
   { YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG, YG }
 };
 
+// BT601 constants for the fast precision row functions, which scale Y
+// straight to 8 bits and shift U and V contributions to 8 bits before adding
+// them.  Results are within 1 of kYuvConstants.
+#define YGF 297 /* round(1.164 * 256 * 256 / 257) */
+#define BBF (BB + 32)
+#define BGF (BG + 32)
+#define BRF (BR + 32)
+
+static YuvConstants SIMD_ALIGNED(kYuvFastConstants) = {
+  { UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0,
+    UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0, UB, 0 },
+  { UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG,
+    UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG, UG, VG },
+  { 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR,
+    0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR, 0, VR },
+  { BBF, BBF, BBF, BBF, BBF, BBF, BBF, BBF,
+    BBF, BBF, BBF, BBF, BBF, BBF, BBF, BBF },
+  { BGF, BGF, BGF, BGF, BGF, BGF, BGF, BGF,
+    BGF, BGF, BGF, BGF, BGF, BGF, BGF, BGF },
+  { BRF, BRF, BRF, BRF, BRF, BRF, BRF, BRF,
+    BRF, BRF, BRF, BRF, BRF, BRF, BRF, BRF },
+  { YGF, YGF, YGF, YGF, YGF, YGF, YGF, YGF,
+    YGF, YGF, YGF, YGF, YGF, YGF, YGF, YGF }
+};
+
 #undef YG
 #undef YGB
 #undef UB
@@ -1481,6 +2251,10 @@ static YuvConstants SIMD_ALIGNED(kYvuConstants) = {
 #undef BB
 #undef BG
 #undef BR
+#undef YGF
+#undef BBF
+#undef BGF
+#undef BRF
 
 // JPEG YUV to RGB reference
 // *  R = Y                - V * -1.40200
@@ -2075,6 +2849,179 @@ void OMITFP I422ToARGBRow_AVX2(const uint8* y_buf,
 }
 #endif  // HAS_I422TOARGBROW_AVX2
 
+#if defined(HAS_I422TOARGBFASTROW_SSSE3)
+// 16 pixels
+// 8 UV values, each converted once for 2 pixels, mixed with 16 Y producing
+// 16 ARGB (64 bytes).  Within 1 of I422ToARGBRow_SSSE3.
+void OMITFP I422ToARGBFastRow_SSSE3(const uint8* y_buf,
+                                     const uint8* u_buf,
+                                     const uint8* v_buf,
+                                     uint8* dst_argb,
+                                     int width) {
+  asm volatile (
+    "sub       %[u_buf],%[v_buf]               \n"
+    "pcmpeqb   %%xmm5,%%xmm5                   \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movq      " MEMACCESS([u_buf]) ",%%xmm0   \n"
+    MEMOPREG(movq, 0x00, [u_buf], [v_buf], 1, xmm1)
+    "lea       " MEMLEA(0x8, [u_buf]) ",%[u_buf] \n"
+    "punpcklbw %%xmm1,%%xmm0                   \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "movdqa    " MEMACCESS2(96, [kYuvConstants]) ",%%xmm3 \n"
+    "movdqa    " MEMACCESS2(128, [kYuvConstants]) ",%%xmm4 \n"
+    "movdqa    " MEMACCESS2(160, [kYuvConstants]) ",%%xmm6 \n"
+    "pmaddubsw " MEMACCESS([kYuvConstants]) ",%%xmm0 \n"
+    "pmaddubsw " MEMACCESS2(32, [kYuvConstants]) ",%%xmm1 \n"
+    "pmaddubsw " MEMACCESS2(64, [kYuvConstants]) ",%%xmm2 \n"
+    "psubw     %%xmm0,%%xmm3                   \n"
+    "psubw     %%xmm1,%%xmm4                   \n"
+    "psubw     %%xmm2,%%xmm6                   \n"
+    "psraw     $0x6,%%xmm3                     \n"  // B for 8 UV
+    "psraw     $0x6,%%xmm4                     \n"  // G for 8 UV
+    "psraw     $0x6,%%xmm6                     \n"  // R for 8 UV
+    "movdqu    " MEMACCESS([y_buf]) ",%%xmm7   \n"
+    "lea       " MEMLEA(0x10, [y_buf]) ",%[y_buf] \n"
+    "movdqa    %%xmm7,%%xmm0                   \n"
+    "punpcklbw %%xmm0,%%xmm0                   \n"
+    "punpckhbw %%xmm7,%%xmm7                   \n"
+    "pmulhuw   " MEMACCESS2(192, [kYuvConstants]) ",%%xmm0 \n"
+    "pmulhuw   " MEMACCESS2(192, [kYuvConstants]) ",%%xmm7 \n"
+    "movdqa    %%xmm3,%%xmm1                   \n"
+    "punpcklwd %%xmm1,%%xmm1                   \n"
+    "punpckhwd %%xmm3,%%xmm3                   \n"
+    "paddsw    %%xmm0,%%xmm1                   \n"
+    "paddsw    %%xmm7,%%xmm3                   \n"
+    "packuswb  %%xmm3,%%xmm1                   \n"  // 16 B
+    "movdqa    %%xmm4,%%xmm2                   \n"
+    "punpcklwd %%xmm2,%%xmm2                   \n"
+    "punpckhwd %%xmm4,%%xmm4                   \n"
+    "paddsw    %%xmm0,%%xmm2                   \n"
+    "paddsw    %%xmm7,%%xmm4                   \n"
+    "packuswb  %%xmm4,%%xmm2                   \n"  // 16 G
+    "movdqa    %%xmm6,%%xmm3                   \n"
+    "punpcklwd %%xmm3,%%xmm3                   \n"
+    "punpckhwd %%xmm6,%%xmm6                   \n"
+    "paddsw    %%xmm0,%%xmm3                   \n"
+    "paddsw    %%xmm7,%%xmm6                   \n"
+    "packuswb  %%xmm6,%%xmm3                   \n"  // 16 R
+    "movdqa    %%xmm1,%%xmm0                   \n"
+    "punpcklbw %%xmm2,%%xmm0                   \n"  // BG first 8 pixels
+    "punpckhbw %%xmm2,%%xmm1                   \n"  // BG next 8 pixels
+    "movdqa    %%xmm3,%%xmm4                   \n"
+    "punpcklbw %%xmm5,%%xmm3                   \n"  // RA first 8 pixels
+    "punpckhbw %%xmm5,%%xmm4                   \n"  // RA next 8 pixels
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "punpcklwd %%xmm3,%%xmm0                   \n"
+    "punpckhwd %%xmm3,%%xmm2                   \n"
+    "movdqa    %%xmm1,%%xmm6                   \n"
+    "punpcklwd %%xmm4,%%xmm1                   \n"
+    "punpckhwd %%xmm4,%%xmm6                   \n"
+    "movdqu    %%xmm0," MEMACCESS([dst_argb]) " \n"
+    "movdqu    %%xmm2," MEMACCESS2(0x10, [dst_argb]) " \n"
+    "movdqu    %%xmm1," MEMACCESS2(0x20, [dst_argb]) " \n"
+    "movdqu    %%xmm6," MEMACCESS2(0x30, [dst_argb]) " \n"
+    "lea       " MEMLEA(0x40, [dst_argb]) ",%[dst_argb] \n"
+    "sub       $0x10,%[width]                  \n"
+    "jg        1b                              \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [u_buf]"+r"(u_buf),    // %[u_buf]
+    [v_buf]"+r"(v_buf),    // %[v_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [kYuvConstants]"r"(&kYuvFastConstants.kUVToB)  // %[kYuvConstants]
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_I422TOARGBFASTROW_SSSE3
+
+#if defined(HAS_I422TOARGBFASTROW_AVX2)
+// 32 pixels
+// 16 UV values, each converted once for 2 pixels, mixed with 32 Y producing
+// 32 ARGB (128 bytes).  Within 1 of I422ToARGBRow_AVX2.
+void OMITFP I422ToARGBFastRow_AVX2(const uint8* y_buf,
+                                    const uint8* u_buf,
+                                    const uint8* v_buf,
+                                    uint8* dst_argb,
+                                    int width) {
+  asm volatile (
+    "sub       %[u_buf],%[v_buf]               \n"
+    "vpcmpeqb   %%ymm5,%%ymm5,%%ymm5           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu    " MEMACCESS([u_buf]) ",%%xmm0  \n"
+    MEMOPREG(vmovdqu, 0x00, [u_buf], [v_buf], 1, xmm1)
+    "lea        " MEMLEA(0x10, [u_buf]) ",%[u_buf] \n"
+    "vpunpckhbw %%xmm1,%%xmm0,%%xmm2           \n"
+    "vpunpcklbw %%xmm1,%%xmm0,%%xmm0           \n"
+    "vinserti128 $0x1,%%xmm2,%%ymm0,%%ymm0     \n"  // 16 UV in order
+    "vpmaddubsw " MEMACCESS2(64, [kYuvConstants]) ",%%ymm0,%%ymm2 \n"
+    "vpmaddubsw " MEMACCESS2(32, [kYuvConstants]) ",%%ymm0,%%ymm1 \n"
+    "vpmaddubsw " MEMACCESS([kYuvConstants]) ",%%ymm0,%%ymm0 \n"
+    "vmovdqu    " MEMACCESS2(160, [kYuvConstants]) ",%%ymm3 \n"
+    "vpsubw     %%ymm2,%%ymm3,%%ymm2           \n"
+    "vmovdqu    " MEMACCESS2(128, [kYuvConstants]) ",%%ymm3 \n"
+    "vpsubw     %%ymm1,%%ymm3,%%ymm1           \n"
+    "vmovdqu    " MEMACCESS2(96, [kYuvConstants]) ",%%ymm3 \n"
+    "vpsubw     %%ymm0,%%ymm3,%%ymm0           \n"
+    "vpsraw     $0x6,%%ymm0,%%ymm0             \n"  // B for 16 UV
+    "vpsraw     $0x6,%%ymm1,%%ymm1             \n"  // G for 16 UV
+    "vpsraw     $0x6,%%ymm2,%%ymm2             \n"  // R for 16 UV
+    "vmovdqu    " MEMACCESS([y_buf]) ",%%ymm3  \n"
+    "lea        " MEMLEA(0x20, [y_buf]) ",%[y_buf] \n"
+    "vpunpckhbw %%ymm3,%%ymm3,%%ymm4           \n"
+    "vpunpcklbw %%ymm3,%%ymm3,%%ymm3           \n"
+    "vpmulhuw   " MEMACCESS2(192, [kYuvConstants]) ",%%ymm3,%%ymm3 \n"
+    "vpmulhuw   " MEMACCESS2(192, [kYuvConstants]) ",%%ymm4,%%ymm4 \n"
+    "vpunpckhwd %%ymm0,%%ymm0,%%ymm6           \n"
+    "vpunpcklwd %%ymm0,%%ymm0,%%ymm0           \n"
+    "vpaddsw    %%ymm3,%%ymm0,%%ymm0           \n"
+    "vpaddsw    %%ymm4,%%ymm6,%%ymm6           \n"
+    "vpackuswb  %%ymm6,%%ymm0,%%ymm0           \n"  // 32 B
+    "vpunpckhwd %%ymm1,%%ymm1,%%ymm6           \n"
+    "vpunpcklwd %%ymm1,%%ymm1,%%ymm1           \n"
+    "vpaddsw    %%ymm3,%%ymm1,%%ymm1           \n"
+    "vpaddsw    %%ymm4,%%ymm6,%%ymm6           \n"
+    "vpackuswb  %%ymm6,%%ymm1,%%ymm1           \n"  // 32 G
+    "vpunpckhwd %%ymm2,%%ymm2,%%ymm6           \n"
+    "vpunpcklwd %%ymm2,%%ymm2,%%ymm2           \n"
+    "vpaddsw    %%ymm3,%%ymm2,%%ymm2           \n"
+    "vpaddsw    %%ymm4,%%ymm6,%%ymm6           \n"
+    "vpackuswb  %%ymm6,%%ymm2,%%ymm2           \n"  // 32 R
+    "vpunpcklbw %%ymm1,%%ymm0,%%ymm3           \n"  // BG 0-7, 16-23
+    "vpunpckhbw %%ymm1,%%ymm0,%%ymm0           \n"  // BG 8-15, 24-31
+    "vpunpcklbw %%ymm5,%%ymm2,%%ymm4           \n"  // RA 0-7, 16-23
+    "vpunpckhbw %%ymm5,%%ymm2,%%ymm2           \n"  // RA 8-15, 24-31
+    "vpunpcklwd %%ymm4,%%ymm3,%%ymm1           \n"  // 0-3, 16-19
+    "vpunpckhwd %%ymm4,%%ymm3,%%ymm3           \n"  // 4-7, 20-23
+    "vpunpcklwd %%ymm2,%%ymm0,%%ymm4           \n"  // 8-11, 24-27
+    "vpunpckhwd %%ymm2,%%ymm0,%%ymm0           \n"  // 12-15, 28-31
+    "vperm2i128 $0x20,%%ymm3,%%ymm1,%%ymm2     \n"  // 0-7
+    "vperm2i128 $0x20,%%ymm0,%%ymm4,%%ymm6     \n"  // 8-15
+    "vperm2i128 $0x31,%%ymm3,%%ymm1,%%ymm1     \n"  // 16-23
+    "vperm2i128 $0x31,%%ymm0,%%ymm4,%%ymm4     \n"  // 24-31
+    "vmovdqu    %%ymm2," MEMACCESS([dst_argb]) "\n"
+    "vmovdqu    %%ymm6," MEMACCESS2(0x20,[dst_argb]) "\n"
+    "vmovdqu    %%ymm1," MEMACCESS2(0x40,[dst_argb]) "\n"
+    "vmovdqu    %%ymm4," MEMACCESS2(0x60,[dst_argb]) "\n"
+    "lea       " MEMLEA(0x80,[dst_argb]) ",%[dst_argb] \n"
+    "sub       $0x20,%[width]                  \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [u_buf]"+r"(u_buf),    // %[u_buf]
+    [v_buf]"+r"(v_buf),    // %[v_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [kYuvConstants]"r"(&kYuvFastConstants.kUVToB)  // %[kYuvConstants]
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6"
+  );
+}
+#endif  // HAS_I422TOARGBFASTROW_AVX2
+
 #if defined(HAS_J422TOARGBROW_AVX2)
 // 16 pixels
 // 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 ARGB (64 bytes).
@@ -2457,6 +3404,59 @@ void ARGBMirrorRow_AVX2(const uint8* src, uint8* dst, int width) {
 }
 #endif  // HAS_ARGBMIRRORROW_AVX2
 
+#ifdef HAS_MIRRORNVUVROW_SSE2
+void MirrorNVUVRow_SSE2(const uint8* src_uv, uint8* dst_uv, int width) {
+  intptr_t temp_width = (intptr_t)(width);
+  asm volatile (
+    "lea       " MEMLEA4(-0x10,0,2,2) ",%0     \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "pshuflw   $0x1b,%%xmm0,%%xmm0             \n"
+    "pshufhw   $0x1b,%%xmm0,%%xmm0             \n"
+    "pshufd    $0x4e,%%xmm0,%%xmm0             \n"
+    "lea       " MEMLEA(-0x10,0) ",%0          \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+  : "+r"(src_uv),  // %0
+    "+r"(dst_uv),  // %1
+    "+r"(temp_width)  // %2
+  :
+  : "memory", "cc"
+    , "xmm0"
+  );
+}
+#endif  // HAS_MIRRORNVUVROW_SSE2
+
+#ifdef HAS_MIRRORNVUVROW_AVX2
+void MirrorNVUVRow_AVX2(const uint8* src_uv, uint8* dst_uv, int width) {
+  intptr_t temp_width = (intptr_t)(width);
+  asm volatile (
+    "lea       " MEMLEA4(-0x20,0,2,2) ",%0     \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vpshuflw  $0x1b,%%ymm0,%%ymm0             \n"
+    "vpshufhw  $0x1b,%%ymm0,%%ymm0             \n"
+    "vpermq    $0x1b,%%ymm0,%%ymm0             \n"
+    "lea       " MEMLEA(-0x20,0) ",%0          \n"
+    "vmovdqu   %%ymm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_uv),  // %0
+    "+r"(dst_uv),  // %1
+    "+r"(temp_width)  // %2
+  :
+  : "memory", "cc"
+    , "xmm0"
+  );
+}
+#endif  // HAS_MIRRORNVUVROW_AVX2
+
 #ifdef HAS_SPLITUVROW_AVX2
 void SplitUVRow_AVX2(const uint8* src_uv, uint8* dst_u, uint8* dst_v, int pix) {
   asm volatile (
@@ -2611,6 +3611,36 @@ void CopyRow_SSE2(const uint8* src, uint8* dst, int count) {
 }
 #endif  // HAS_COPYROW_SSE2
 
+#ifdef HAS_COPYROW_NT_SSE2
+// Copy a cache line at a time with non-temporal stores that bypass the cache.
+// dst must be 16 byte aligned.  The fence orders the stores with later ones.
+void CopyRow_NT_SSE2(const uint8* src, uint8* dst, int count) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "movdqu    " MEMACCESS2(0x20,0) ",%%xmm2   \n"
+    "movdqu    " MEMACCESS2(0x30,0) ",%%xmm3   \n"
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "movntdq   %%xmm0," MEMACCESS(1) "         \n"
+    "movntdq   %%xmm1," MEMACCESS2(0x10,1) "   \n"
+    "movntdq   %%xmm2," MEMACCESS2(0x20,1) "   \n"
+    "movntdq   %%xmm3," MEMACCESS2(0x30,1) "   \n"
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x40,%2                        \n"
+    "jg        1b                              \n"
+    "sfence                                    \n"
+  : "+r"(src),   // %0
+    "+r"(dst),   // %1
+    "+r"(count)  // %2
+  :
+  : "memory", "cc"
+    , "xmm0", "xmm1", "xmm2", "xmm3"
+  );
+}
+#endif  // HAS_COPYROW_NT_SSE2
+
 #ifdef HAS_COPYROW_AVX
 void CopyRow_AVX(const uint8* src, uint8* dst, int count) {
   asm volatile (
@@ -2965,50 +3995,110 @@ void UYVYToUVRow_SSE2(const uint8* src_uyvy, int stride_uyvy,
     "lea       " MEMLEA(0x8,1) ",%1            \n"
     "sub       $0x10,%3                        \n"
     "jg        1b                              \n"
-  : "+r"(src_uyvy),    // %0
-    "+r"(dst_u),       // %1
-    "+r"(dst_v),       // %2
-    "+r"(pix)          // %3
-  : "r"((intptr_t)(stride_uyvy))  // %4
+  : "+r"(src_uyvy),    // %0
+    "+r"(dst_u),       // %1
+    "+r"(dst_v),       // %2
+    "+r"(pix)          // %3
+  : "r"((intptr_t)(stride_uyvy))  // %4
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
+  );
+}
+
+void UYVYToUV422Row_SSE2(const uint8* src_uyvy,
+                         uint8* dst_u, uint8* dst_v, int pix) {
+  asm volatile (
+    "pcmpeqb   %%xmm5,%%xmm5                   \n"
+    "psrlw     $0x8,%%xmm5                     \n"
+    "sub       %1,%2                           \n"
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "pand      %%xmm5,%%xmm0                   \n"
+    "pand      %%xmm5,%%xmm1                   \n"
+    "packuswb  %%xmm1,%%xmm0                   \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "pand      %%xmm5,%%xmm0                   \n"
+    "packuswb  %%xmm0,%%xmm0                   \n"
+    "psrlw     $0x8,%%xmm1                     \n"
+    "packuswb  %%xmm1,%%xmm1                   \n"
+    "movq      %%xmm0," MEMACCESS(1) "         \n"
+    MEMOPMEM(movq,xmm1,0x00,1,2,1)             //  movq    %%xmm1,(%1,%2)
+    "lea       " MEMLEA(0x8,1) ",%1            \n"
+    "sub       $0x10,%3                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_uyvy),    // %0
+    "+r"(dst_u),       // %1
+    "+r"(dst_v),       // %2
+    "+r"(pix)          // %3
+  :
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm5"
+  );
+}
+#endif  // HAS_YUY2TOYROW_SSE2
+
+#ifdef HAS_YUY2TONVUVROW_SSE2
+void YUY2ToNVUVRow_SSE2(const uint8* src_yuy2, int stride_yuy2,
+                        uint8* dst_uv, int pix) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    MEMOPREG(movdqu,0x00,0,3,1,xmm2)           //  movdqu  (%0,%3,1),%%xmm2
+    MEMOPREG(movdqu,0x10,0,3,1,xmm3)           //  movdqu  0x10(%0,%3,1),%%xmm3
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "pavgb     %%xmm2,%%xmm0                   \n"
+    "pavgb     %%xmm3,%%xmm1                   \n"
+    "psrlw     $0x8,%%xmm0                     \n"
+    "psrlw     $0x8,%%xmm1                     \n"
+    "packuswb  %%xmm1,%%xmm0                   \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_yuy2),    // %0
+    "+r"(dst_uv),      // %1
+    "+r"(pix)          // %2
+  : "r"((intptr_t)(stride_yuy2))  // %3
   : "memory", "cc", NACL_R14
-    "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
+    "xmm0", "xmm1", "xmm2", "xmm3"
   );
 }
 
-void UYVYToUV422Row_SSE2(const uint8* src_uyvy,
-                         uint8* dst_u, uint8* dst_v, int pix) {
+void UYVYToNVUVRow_SSE2(const uint8* src_uyvy, int stride_uyvy,
+                        uint8* dst_uv, int pix) {
   asm volatile (
     "pcmpeqb   %%xmm5,%%xmm5                   \n"
     "psrlw     $0x8,%%xmm5                     \n"
-    "sub       %1,%2                           \n"
     LABELALIGN
   "1:                                          \n"
     "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
     "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    MEMOPREG(movdqu,0x00,0,3,1,xmm2)           //  movdqu  (%0,%3,1),%%xmm2
+    MEMOPREG(movdqu,0x10,0,3,1,xmm3)           //  movdqu  0x10(%0,%3,1),%%xmm3
     "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "pavgb     %%xmm2,%%xmm0                   \n"
+    "pavgb     %%xmm3,%%xmm1                   \n"
     "pand      %%xmm5,%%xmm0                   \n"
     "pand      %%xmm5,%%xmm1                   \n"
     "packuswb  %%xmm1,%%xmm0                   \n"
-    "movdqa    %%xmm0,%%xmm1                   \n"
-    "pand      %%xmm5,%%xmm0                   \n"
-    "packuswb  %%xmm0,%%xmm0                   \n"
-    "psrlw     $0x8,%%xmm1                     \n"
-    "packuswb  %%xmm1,%%xmm1                   \n"
-    "movq      %%xmm0," MEMACCESS(1) "         \n"
-    MEMOPMEM(movq,xmm1,0x00,1,2,1)             //  movq    %%xmm1,(%1,%2)
-    "lea       " MEMLEA(0x8,1) ",%1            \n"
-    "sub       $0x10,%3                        \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x10,%2                        \n"
     "jg        1b                              \n"
   : "+r"(src_uyvy),    // %0
-    "+r"(dst_u),       // %1
-    "+r"(dst_v),       // %2
-    "+r"(pix)          // %3
-  :
+    "+r"(dst_uv),      // %1
+    "+r"(pix)          // %2
+  : "r"((intptr_t)(stride_uyvy))  // %3
   : "memory", "cc", NACL_R14
-    "xmm0", "xmm1", "xmm5"
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
   );
 }
-#endif  // HAS_YUY2TOYROW_SSE2
+#endif  // HAS_YUY2TONVUVROW_SSE2
 
 #ifdef HAS_YUY2TOYROW_AVX2
 void YUY2ToYRow_AVX2(const uint8* src_yuy2, uint8* dst_y, int pix) {
@@ -3216,6 +4306,66 @@ void UYVYToUV422Row_AVX2(const uint8* src_uyvy,
 }
 #endif  // HAS_YUY2TOYROW_AVX2
 
+#ifdef HAS_YUY2TONVUVROW_AVX2
+void YUY2ToNVUVRow_AVX2(const uint8* src_yuy2, int stride_yuy2,
+                        uint8* dst_uv, int pix) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm1   \n"
+    VMEMOPREG(vpavgb,0x00,0,3,1,ymm0,ymm0)     // vpavgb (%0,%3,1),%%ymm0,%%ymm0
+    VMEMOPREG(vpavgb,0x20,0,3,1,ymm1,ymm1)
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "vpsrlw    $0x8,%%ymm0,%%ymm0              \n"
+    "vpsrlw    $0x8,%%ymm1,%%ymm1              \n"
+    "vpackuswb %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vmovdqu   %%ymm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x20,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_yuy2),    // %0
+    "+r"(dst_uv),      // %1
+    "+r"(pix)          // %2
+  : "r"((intptr_t)(stride_yuy2))  // %3
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1"
+  );
+}
+
+void UYVYToNVUVRow_AVX2(const uint8* src_uyvy, int stride_uyvy,
+                        uint8* dst_uv, int pix) {
+  asm volatile (
+    "vpcmpeqb  %%ymm5,%%ymm5,%%ymm5            \n"
+    "vpsrlw    $0x8,%%ymm5,%%ymm5              \n"
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0         \n"
+    "vmovdqu   " MEMACCESS2(0x20,0) ",%%ymm1   \n"
+    VMEMOPREG(vpavgb,0x00,0,3,1,ymm0,ymm0)     // vpavgb (%0,%3,1),%%ymm0,%%ymm0
+    VMEMOPREG(vpavgb,0x20,0,3,1,ymm1,ymm1)
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "vpand     %%ymm5,%%ymm0,%%ymm0            \n"
+    "vpand     %%ymm5,%%ymm1,%%ymm1            \n"
+    "vpackuswb %%ymm1,%%ymm0,%%ymm0            \n"
+    "vpermq    $0xd8,%%ymm0,%%ymm0             \n"
+    "vmovdqu   %%ymm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x20,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_uyvy),    // %0
+    "+r"(dst_uv),      // %1
+    "+r"(pix)          // %2
+  : "r"((intptr_t)(stride_uyvy))  // %3
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm5"
+  );
+}
+#endif  // HAS_YUY2TONVUVROW_AVX2
+
 #ifdef HAS_ARGBBLENDROW_SSE2
 // Blend 8 pixels at a time.
 void ARGBBlendRow_SSE2(const uint8* src_argb0, const uint8* src_argb1,
@@ -5030,6 +6180,169 @@ void InterpolateRow_SSE2(uint8* dst_ptr, const uint8* src_ptr,
 }
 #endif  // HAS_INTERPOLATEROW_SSE2
 
+#ifdef HAS_INTERPOLATEROW_16_SSE2
+// Bilinear filter 8x2 -> 8x1 for 16 bit samples.
+// Products are formed as 32 bit values so the result matches C exactly.
+void InterpolateRow_16_SSE2(uint16* dst_ptr, const uint16* src_ptr,
+                            ptrdiff_t src_stride, int dst_width,
+                            int source_y_fraction) {
+  asm volatile (
+    "sub       %1,%0                           \n"
+    "cmp       $0x0,%3                         \n"
+    "je        100f                            \n"
+    "cmp       $0x80,%3                        \n"
+    "je        50f                             \n"
+
+    "movd      %3,%%xmm7                       \n"
+    "neg       %3                              \n"
+    "add       $0x100,%3                       \n"
+    "movd      %3,%%xmm6                       \n"
+    "pshuflw   $0x0,%%xmm7,%%xmm7              \n"
+    "pshuflw   $0x0,%%xmm6,%%xmm6              \n"
+    "pshufd    $0x0,%%xmm7,%%xmm7              \n"
+    "pshufd    $0x0,%%xmm6,%%xmm6              \n"
+
+    // General purpose row blend.
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm0         \n"
+    MEMOPREG(movdqu,0x00,1,4,2,xmm1)           //  movdqu    (%1,%4,2),%%xmm1
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "pmullw    %%xmm6,%%xmm0                   \n"
+    "pmulhuw   %%xmm6,%%xmm2                   \n"
+    "movdqa    %%xmm0,%%xmm3                   \n"
+    "punpcklwd %%xmm2,%%xmm0                   \n"
+    "punpckhwd %%xmm2,%%xmm3                   \n"
+    "movdqa    %%xmm1,%%xmm2                   \n"
+    "pmullw    %%xmm7,%%xmm1                   \n"
+    "pmulhuw   %%xmm7,%%xmm2                   \n"
+    "movdqa    %%xmm1,%%xmm4                   \n"
+    "punpcklwd %%xmm2,%%xmm1                   \n"
+    "punpckhwd %%xmm2,%%xmm4                   \n"
+    "paddd     %%xmm1,%%xmm0                   \n"
+    "paddd     %%xmm4,%%xmm3                   \n"
+    "pslld     $0x8,%%xmm0                     \n"
+    "pslld     $0x8,%%xmm3                     \n"
+    "psrad     $0x10,%%xmm0                    \n"
+    "psrad     $0x10,%%xmm3                    \n"
+    "packssdw  %%xmm3,%%xmm0                   \n"
+    MEMOPMEM(movdqu,xmm0,0x00,1,0,1)           //  movdqu    %%xmm0,(%1,%0,1)
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+    "jmp       99f                             \n"
+
+    // Blend 50 / 50.
+    LABELALIGN
+  "50:                                         \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm0         \n"
+    MEMOPREG(movdqu,0x00,1,4,2,xmm1)           //  movdqu    (%1,%4,2),%%xmm1
+    "pavgw     %%xmm1,%%xmm0                   \n"
+    MEMOPMEM(movdqu,xmm0,0x00,1,0,1)           //  movdqu    %%xmm0,(%1,%0,1)
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        50b                             \n"
+    "jmp       99f                             \n"
+
+    // Blend 100 / 0 - Copy row unchanged.
+    LABELALIGN
+  "100:                                        \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm0         \n"
+    MEMOPMEM(movdqu,xmm0,0x00,1,0,1)           //  movdqu    %%xmm0,(%1,%0,1)
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        100b                            \n"
+
+  "99:                                         \n"
+  : "+r"(dst_ptr),    // %0
+    "+r"(src_ptr),    // %1
+    "+r"(dst_width),  // %2
+    "+r"(source_y_fraction)  // %3
+  : "r"((intptr_t)(src_stride))  // %4
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_INTERPOLATEROW_16_SSE2
+
+#ifdef HAS_INTERPOLATEROW_16_AVX2
+// Bilinear filter 16x2 -> 16x1 for 16 bit samples.
+void InterpolateRow_16_AVX2(uint16* dst_ptr, const uint16* src_ptr,
+                            ptrdiff_t src_stride, int dst_width,
+                            int source_y_fraction) {
+  asm volatile (
+    "sub       %1,%0                           \n"
+    "cmp       $0x0,%3                         \n"
+    "je        100f                            \n"
+    "cmp       $0x80,%3                        \n"
+    "je        50f                             \n"
+
+    "vmovd      %3,%%xmm7                      \n"
+    "neg        %3                             \n"
+    "add        $0x100,%3                      \n"
+    "vmovd      %3,%%xmm6                      \n"
+    "vpbroadcastw %%xmm7,%%ymm7                \n"
+    "vpbroadcastw %%xmm6,%%ymm6                \n"
+
+    // General purpose row blend.
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu    " MEMACCESS(1) ",%%ymm0        \n"
+    MEMOPREG(vmovdqu,0x00,1,4,2,ymm1)
+    "vpmullw    %%ymm6,%%ymm0,%%ymm2           \n"
+    "vpmulhuw   %%ymm6,%%ymm0,%%ymm3           \n"
+    "vpunpcklwd %%ymm3,%%ymm2,%%ymm0           \n"
+    "vpunpckhwd %%ymm3,%%ymm2,%%ymm2           \n"
+    "vpmullw    %%ymm7,%%ymm1,%%ymm3           \n"
+    "vpmulhuw   %%ymm7,%%ymm1,%%ymm4           \n"
+    "vpunpcklwd %%ymm4,%%ymm3,%%ymm1           \n"
+    "vpunpckhwd %%ymm4,%%ymm3,%%ymm3           \n"
+    "vpaddd     %%ymm1,%%ymm0,%%ymm0           \n"
+    "vpaddd     %%ymm3,%%ymm2,%%ymm2           \n"
+    "vpslld     $0x8,%%ymm0,%%ymm0             \n"
+    "vpslld     $0x8,%%ymm2,%%ymm2             \n"
+    "vpsrad     $0x10,%%ymm0,%%ymm0            \n"
+    "vpsrad     $0x10,%%ymm2,%%ymm2            \n"
+    "vpackssdw  %%ymm2,%%ymm0,%%ymm0           \n"
+    MEMOPMEM(vmovdqu,ymm0,0x00,1,0,1)
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+    "jmp       99f                             \n"
+
+    // Blend 50 / 50.
+    LABELALIGN
+  "50:                                         \n"
+    "vmovdqu    " MEMACCESS(1) ",%%ymm0        \n"
+    VMEMOPREG(vpavgw,0x00,1,4,2,ymm0,ymm0)     // vpavgw (%1,%4,2),%%ymm0,%%ymm0
+    MEMOPMEM(vmovdqu,ymm0,0x00,1,0,1)
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x10,%2                        \n"
+    "jg        50b                             \n"
+    "jmp       99f                             \n"
+
+    // Blend 100 / 0 - Copy row unchanged.
+    LABELALIGN
+  "100:                                        \n"
+    "vmovdqu    " MEMACCESS(1) ",%%ymm0        \n"
+    MEMOPMEM(vmovdqu,ymm0,0x00,1,0,1)
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x10,%2                        \n"
+    "jg        100b                            \n"
+
+  "99:                                         \n"
+    "vzeroupper                                \n"
+  : "+r"(dst_ptr),    // %0
+    "+r"(src_ptr),    // %1
+    "+r"(dst_width),  // %2
+    "+r"(source_y_fraction)  // %3
+  : "r"((intptr_t)(src_stride))  // %4
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_INTERPOLATEROW_16_AVX2
+
 #ifdef HAS_ARGBSHUFFLEROW_SSSE3
 // For BGRAToARGB, ABGRToARGB, RGBAToARGB, and ARGBToRGBA.
 void ARGBShuffleRow_SSSE3(const uint8* src_argb, uint8* dst_argb,
@@ -5277,6 +6590,126 @@ void I422ToUYVYRow_SSE2(const uint8* src_y,
 }
 #endif  // HAS_I422TOUYVYROW_SSE2
 
+#ifdef HAS_NV12TOYUY2ROW_SSE2
+void NV12ToYUY2Row_SSE2(const uint8* src_y,
+                        const uint8* src_uv,
+                        uint8* dst_frame, int width) {
+ asm volatile (
+    LABELALIGN
+  "1:                                            \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0           \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm2           \n"
+    "lea       " MEMLEA(0x10,0) ",%0             \n"
+    "lea       " MEMLEA(0x10,1) ",%1             \n"
+    "movdqa    %%xmm0,%%xmm1                     \n"
+    "punpcklbw %%xmm2,%%xmm0                     \n"
+    "punpckhbw %%xmm2,%%xmm1                     \n"
+    "movdqu    %%xmm0," MEMACCESS(2) "           \n"
+    "movdqu    %%xmm1," MEMACCESS2(0x10,2) "     \n"
+    "lea       " MEMLEA(0x20,2) ",%2             \n"
+    "sub       $0x10,%3                          \n"
+    "jg         1b                               \n"
+    : "+r"(src_y),  // %0
+      "+r"(src_uv),  // %1
+      "+r"(dst_frame),  // %2
+      "+rm"(width)  // %3
+    :
+    : "memory", "cc"
+    , "xmm0", "xmm1", "xmm2"
+  );
+}
+
+void NV12ToUYVYRow_SSE2(const uint8* src_y,
+                        const uint8* src_uv,
+                        uint8* dst_frame, int width) {
+ asm volatile (
+    LABELALIGN
+  "1:                                            \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm2           \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm0           \n"
+    "lea       " MEMLEA(0x10,0) ",%0             \n"
+    "lea       " MEMLEA(0x10,1) ",%1             \n"
+    "movdqa    %%xmm0,%%xmm1                     \n"
+    "punpcklbw %%xmm2,%%xmm0                     \n"
+    "punpckhbw %%xmm2,%%xmm1                     \n"
+    "movdqu    %%xmm0," MEMACCESS(2) "           \n"
+    "movdqu    %%xmm1," MEMACCESS2(0x10,2) "     \n"
+    "lea       " MEMLEA(0x20,2) ",%2             \n"
+    "sub       $0x10,%3                          \n"
+    "jg         1b                               \n"
+    : "+r"(src_y),  // %0
+      "+r"(src_uv),  // %1
+      "+r"(dst_frame),  // %2
+      "+rm"(width)  // %3
+    :
+    : "memory", "cc"
+    , "xmm0", "xmm1", "xmm2"
+  );
+}
+#endif  // HAS_NV12TOYUY2ROW_SSE2
+
+#ifdef HAS_NV12TOYUY2ROW_AVX2
+void NV12ToYUY2Row_AVX2(const uint8* src_y,
+                        const uint8* src_uv,
+                        uint8* dst_frame, int width) {
+ asm volatile (
+    LABELALIGN
+  "1:                                            \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm0           \n"
+    "vmovdqu   " MEMACCESS(1) ",%%ymm2           \n"
+    "lea       " MEMLEA(0x20,0) ",%0             \n"
+    "lea       " MEMLEA(0x20,1) ",%1             \n"
+    "vpunpcklbw %%ymm2,%%ymm0,%%ymm1             \n"
+    "vpunpckhbw %%ymm2,%%ymm0,%%ymm2             \n"
+    "vperm2i128 $0x20,%%ymm2,%%ymm1,%%ymm0       \n"
+    "vperm2i128 $0x31,%%ymm2,%%ymm1,%%ymm1       \n"
+    "vmovdqu   %%ymm0," MEMACCESS(2) "           \n"
+    "vmovdqu   %%ymm1," MEMACCESS2(0x20,2) "     \n"
+    "lea       " MEMLEA(0x40,2) ",%2             \n"
+    "sub       $0x20,%3                          \n"
+    "jg         1b                               \n"
+    "vzeroupper                                  \n"
+    : "+r"(src_y),  // %0
+      "+r"(src_uv),  // %1
+      "+r"(dst_frame),  // %2
+      "+rm"(width)  // %3
+    :
+    : "memory", "cc"
+    , "xmm0", "xmm1", "xmm2"
+  );
+}
+
+void NV12ToUYVYRow_AVX2(const uint8* src_y,
+                        const uint8* src_uv,
+                        uint8* dst_frame, int width) {
+ asm volatile (
+    LABELALIGN
+  "1:                                            \n"
+    "vmovdqu   " MEMACCESS(0) ",%%ymm2           \n"
+    "vmovdqu   " MEMACCESS(1) ",%%ymm0           \n"
+    "lea       " MEMLEA(0x20,0) ",%0             \n"
+    "lea       " MEMLEA(0x20,1) ",%1             \n"
+    "vpunpcklbw %%ymm2,%%ymm0,%%ymm1             \n"
+    "vpunpckhbw %%ymm2,%%ymm0,%%ymm2             \n"
+    "vperm2i128 $0x20,%%ymm2,%%ymm1,%%ymm0       \n"
+    "vperm2i128 $0x31,%%ymm2,%%ymm1,%%ymm1       \n"
+    "vmovdqu   %%ymm0," MEMACCESS(2) "           \n"
+    "vmovdqu   %%ymm1," MEMACCESS2(0x20,2) "     \n"
+    "lea       " MEMLEA(0x40,2) ",%2             \n"
+    "sub       $0x20,%3                          \n"
+    "jg         1b                               \n"
+    "vzeroupper                                  \n"
+    : "+r"(src_y),  // %0
+      "+r"(src_uv),  // %1
+      "+r"(dst_frame),  // %2
+      "+rm"(width)  // %3
+    :
+    : "memory", "cc"
+    , "xmm0", "xmm1", "xmm2"
+  );
+}
+#endif  // HAS_NV12TOYUY2ROW_AVX2
+
 #ifdef HAS_ARGBPOLYNOMIALROW_SSE2
 void ARGBPolynomialRow_SSE2(const uint8* src_argb,
                             uint8* dst_argb, const float* poly,
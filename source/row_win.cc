@@ -608,6 +608,8 @@ void ARGB1555ToARGBRow_AVX2(const uint8* src_argb1555, uint8* dst_argb,
     vpmulhuw   ymm0, ymm0, ymm6    // << 6 * (256 + 8)
     vpand      ymm2, ymm2, ymm7
     vpor       ymm0, ymm0, ymm2    // AG
+    vpermq     ymm0, ymm0, 0xd8    // mutate for unpack
+    vpermq     ymm1, ymm1, 0xd8
     vpunpckhbw ymm2, ymm1, ymm0
     vpunpcklbw ymm1, ymm1, ymm0
     vmovdqu    [eax * 2 + edx], ymm1  // store 8 pixels of ARGB
@@ -644,6 +646,8 @@ void ARGB4444ToARGBRow_AVX2(const uint8* src_argb4444, uint8* dst_argb,
     vpsllw     ymm1, ymm0, 4
     vpor       ymm2, ymm2, ymm3
     vpor       ymm0, ymm0, ymm1
+    vpermq     ymm0, ymm0, 0xd8    // mutate for unpack
+    vpermq     ymm2, ymm2, 0xd8
     vpunpckhbw ymm1, ymm0, ymm2
     vpunpcklbw ymm0, ymm0, ymm2
     vmovdqu    [eax * 2 + edx], ymm0  // store 8 pixels of ARGB
@@ -3350,6 +3354,35 @@ void CopyRow_SSE2(const uint8* src, uint8* dst, int count) {
 }
 #endif  // HAS_COPYROW_SSE2
 
+#ifdef HAS_COPYROW_NT_SSE2
+// CopyRow with non-temporal stores that bypass the cache, 64 bytes at time.
+// dst must be 16 byte aligned.  The fence orders the stores with later ones.
+__declspec(naked)
+void CopyRow_NT_SSE2(const uint8* src, uint8* dst, int count) {
+  __asm {
+    mov        eax, [esp + 4]   // src
+    mov        edx, [esp + 8]   // dst
+    mov        ecx, [esp + 12]  // count
+
+  convertloop:
+    movdqu     xmm0, [eax]
+    movdqu     xmm1, [eax + 16]
+    movdqu     xmm2, [eax + 32]
+    movdqu     xmm3, [eax + 48]
+    lea        eax, [eax + 64]
+    movntdq    [edx], xmm0
+    movntdq    [edx + 16], xmm1
+    movntdq    [edx + 32], xmm2
+    movntdq    [edx + 48], xmm3
+    lea        edx, [edx + 64]
+    sub        ecx, 64
+    jg         convertloop
+    sfence
+    ret
+  }
+}
+#endif  // HAS_COPYROW_NT_SSE2
+
 #ifdef HAS_COPYROW_AVX
 // CopyRow copys 'count' bytes using a 32 byte load/store, 64 bytes at time.
 __declspec(naked)
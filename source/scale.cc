@@ -15,6 +15,7 @@
 
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"  // For CopyPlane
+#include "libyuv/profile.h"
 #include "libyuv/row.h"
 #include "libyuv/scale_row.h"
 
@@ -129,10 +130,15 @@ static void ScalePlaneDown2_16(int src_width, int src_height,
   }
 #endif
 #if defined(HAS_SCALEROWDOWN2_16_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 16)) {
-    ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_16_SSE2 :
-        (filtering == kFilterLinear ? ScaleRowDown2Linear_16_SSE2 :
-        ScaleRowDown2Box_16_SSE2);
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_Any_16_SSE2 :
+        (filtering == kFilterLinear ? ScaleRowDown2Linear_Any_16_SSE2 :
+        ScaleRowDown2Box_Any_16_SSE2);
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleRowDown2 = filtering == kFilterNone ? ScaleRowDown2_16_SSE2 :
+          (filtering == kFilterLinear ? ScaleRowDown2Linear_16_SSE2 :
+          ScaleRowDown2Box_16_SSE2);
+    }
   }
 #endif
 #if defined(HAS_SCALEROWDOWN2_16_MIPS_DSPR2)
@@ -240,9 +246,13 @@ static void ScalePlaneDown4_16(int src_width, int src_height,
   }
 #endif
 #if defined(HAS_SCALEROWDOWN4_16_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
-    ScaleRowDown4 = filtering ? ScaleRowDown4Box_16_SSE2 :
-        ScaleRowDown4_16_SSE2;
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ScaleRowDown4 = filtering ? ScaleRowDown4Box_Any_16_SSE2 :
+        ScaleRowDown4_Any_16_SSE2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleRowDown4 = filtering ? ScaleRowDown4Box_16_SSE2 :
+          ScaleRowDown4_16_SSE2;
+    }
   }
 #endif
 #if defined(HAS_SCALEROWDOWN4_16_MIPS_DSPR2)
@@ -822,8 +832,11 @@ static void ScalePlaneBox_16(int src_width, int src_height,
         ScaleAddRow_16_C;
 
 #if defined(HAS_SCALEADDROW_16_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(src_width, 16)) {
-      ScaleAddRow = ScaleAddRow_16_SSE2;
+    if (TestCpuFlag(kCpuHasSSE2)) {
+      ScaleAddRow = ScaleAddRow_Any_16_SSE2;
+      if (IS_ALIGNED(src_width, 8)) {
+        ScaleAddRow = ScaleAddRow_16_SSE2;
+      }
     }
 #endif
 
@@ -848,37 +861,42 @@ static void ScalePlaneBox_16(int src_width, int src_height,
   }
 }
 
-// Scale plane down with bilinear interpolation.
-void ScalePlaneBilinearDown(int src_width, int src_height,
-                            int dst_width, int dst_height,
-                            int src_stride, int dst_stride,
-                            const uint8* src_ptr, uint8* dst_ptr,
-                            enum FilterMode filtering) {
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
-  // Allocate a row buffer.
-  align_buffer_64(row, src_width);
-
+// Scale plane down with bilinear interpolation from a 16.16 start and step.
+// Only the source columns that are sampled are interpolated.
+static void ScalePlaneBilinearDownXY(int src_width, int src_height,
+                                     int dst_width, int dst_height,
+                                     int src_stride, int dst_stride,
+                                     const uint8* src_ptr, uint8* dst_ptr,
+                                     int x, int dx, int y, int dy,
+                                     enum FilterMode filtering) {
+  int64 xlast = x + (int64)(dst_width - 1) * dx;
+  int64 xl = (dx >= 0) ? x : xlast;
+  int64 xr = (dx >= 0) ? xlast : x;
+  int clip_src_width;
   const int max_y = (src_height - 1) << 16;
   int j;
   void (*ScaleFilterCols)(uint8* dst_ptr, const uint8* src_ptr,
       int dst_width, int x, int dx) =
       (src_width >= 32768) ? ScaleFilterCols64_C : ScaleFilterCols_C;
+  void (*ScaleFilterColsTable)(uint8* dst_ptr, const uint8* src_ptr,
+      int dst_width, const int* offsets, const uint8* weights) = NULL;
   void (*InterpolateRow)(uint8* dst_ptr, const uint8* src_ptr,
       ptrdiff_t src_stride, int dst_width, int source_y_fraction) =
       InterpolateRow_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering,
-             &x, &y, &dx, &dy);
-  src_width = Abs(src_width);
+  void (*CopyRow_NT)(const uint8* src, uint8* dst, int width) = NULL;
+  xl = xl >> 16;
+  xr = (xr >> 16) + 2;  // 1 beyond right most pixel.  Bilinear uses 2 pixels.
+  if (xr > src_width) {
+    xr = src_width;
+  }
+  clip_src_width = (int)(xr - xl);
+  src_ptr += xl;
+  x -= (int)(xl << 16);
 
 #if defined(HAS_INTERPOLATEROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     InterpolateRow = InterpolateRow_Any_SSE2;
-    if (IS_ALIGNED(src_width, 16)) {
+    if (IS_ALIGNED(clip_src_width, 16)) {
       InterpolateRow = InterpolateRow_SSE2;
     }
   }
@@ -886,7 +904,7 @@ void ScalePlaneBilinearDown(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     InterpolateRow = InterpolateRow_Any_SSSE3;
-    if (IS_ALIGNED(src_width, 16)) {
+    if (IS_ALIGNED(clip_src_width, 16)) {
       InterpolateRow = InterpolateRow_SSSE3;
     }
   }
@@ -894,7 +912,7 @@ void ScalePlaneBilinearDown(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
     InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(src_width, 32)) {
+    if (IS_ALIGNED(clip_src_width, 32)) {
       InterpolateRow = InterpolateRow_AVX2;
     }
   }
@@ -902,7 +920,7 @@ void ScalePlaneBilinearDown(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(src_width, 16)) {
+    if (IS_ALIGNED(clip_src_width, 16)) {
       InterpolateRow = InterpolateRow_NEON;
     }
   }
@@ -910,7 +928,7 @@ void ScalePlaneBilinearDown(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_MIPS_DSPR2)
   if (TestCpuFlag(kCpuHasMIPS_DSPR2)) {
     InterpolateRow = InterpolateRow_Any_MIPS_DSPR2;
-    if (IS_ALIGNED(src_width, 4)) {
+    if (IS_ALIGNED(clip_src_width, 4)) {
       InterpolateRow = InterpolateRow_MIPS_DSPR2;
     }
   }
@@ -930,27 +948,90 @@ void ScalePlaneBilinearDown(int src_width, int src_height,
     }
   }
 #endif
-  if (y > max_y) {
-    y = max_y;
+#if defined(HAS_SCALEFILTERCOLSTABLE_SSSE3)
+  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    ScaleFilterColsTable = ScaleFilterColsTable_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleFilterColsTable = ScaleFilterColsTable_SSSE3;
+    }
   }
-
-  for (j = 0; j < dst_height; ++j) {
-    int yi = y >> 16;
-    const uint8* src = src_ptr + yi * src_stride;
-    if (filtering == kFilterLinear) {
-      ScaleFilterCols(dst_ptr, src, dst_width, x, dx);
-    } else {
-      int yf = (y >> 8) & 255;
-      InterpolateRow(row, src, src_stride, src_width, yf);
-      ScaleFilterCols(dst_ptr, row, dst_width, x, dx);
+#endif
+#if defined(HAS_COPYROW_NT_SSE2)
+  if (UseStreamingStores(dst_ptr, dst_stride,
+                         (int64)(dst_width) * dst_height)) {
+    CopyRow_NT = IS_ALIGNED(dst_width, 64) ? CopyRow_NT_SSE2 :
+        CopyRow_NT_Any_SSE2;
+  }
+#endif
+  // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
+  // Allocate a row buffer.
+  {
+    align_buffer_64(row, clip_src_width);
+    // Column offsets and weights are computed once for all rows.
+    align_buffer_64_if(coltable, ScaleFilterColsTable, dst_width * 6);
+    // Rows to be streamed out are scaled into cache first.
+    align_buffer_64_if(stream_row, CopyRow_NT, dst_width);
+    int* offsets = NULL;
+    uint8* weights = NULL;
+
+    if (ScaleFilterColsTable) {
+      offsets = (int*)(coltable);
+      weights = coltable + dst_width * 4;
+      ScaleFilterColsSetup_C(offsets, weights, dst_width, x, dx);
     }
-    dst_ptr += dst_stride;
-    y += dy;
     if (y > max_y) {
       y = max_y;
     }
+
+    for (j = 0; j < dst_height; ++j) {
+      int yi = y >> 16;
+      const uint8* src = src_ptr + yi * src_stride;
+      uint8* dst_row = CopyRow_NT ? stream_row : dst_ptr;
+      if (filtering == kFilterLinear) {
+        if (ScaleFilterColsTable) {
+          ScaleFilterColsTable(dst_row, src, dst_width, offsets, weights);
+        } else {
+          ScaleFilterCols(dst_row, src, dst_width, x, dx);
+        }
+      } else {
+        int yf = (y >> 8) & 255;
+        InterpolateRow(row, src, src_stride, clip_src_width, yf);
+        if (ScaleFilterColsTable) {
+          ScaleFilterColsTable(dst_row, row, dst_width, offsets, weights);
+        } else {
+          ScaleFilterCols(dst_row, row, dst_width, x, dx);
+        }
+      }
+      if (CopyRow_NT) {
+        CopyRow_NT(stream_row, dst_ptr, dst_width);
+      }
+      dst_ptr += dst_stride;
+      y += dy;
+      if (y > max_y) {
+        y = max_y;
+      }
+    }
+    free_aligned_buffer_64(row);
+    free_aligned_buffer_64(coltable);
+    free_aligned_buffer_64(stream_row);
   }
-  free_aligned_buffer_64(row);
+}
+
+void ScalePlaneBilinearDown(int src_width, int src_height,
+                            int dst_width, int dst_height,
+                            int src_stride, int dst_stride,
+                            const uint8* src_ptr, uint8* dst_ptr,
+                            enum FilterMode filtering) {
+  // Initial source x/y coordinate and step values as 16.16 fixed point.
+  int x = 0;
+  int y = 0;
+  int dx = 0;
+  int dy = 0;
+  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering,
+             &x, &y, &dx, &dy);
+  ScalePlaneBilinearDownXY(Abs(src_width), src_height, dst_width, dst_height,
+                           src_stride, dst_stride, src_ptr, dst_ptr,
+                           x, dx, y, dy, filtering);
 }
 
 void ScalePlaneBilinearDown_16(int src_width, int src_height,
@@ -982,7 +1063,7 @@ void ScalePlaneBilinearDown_16(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     InterpolateRow = InterpolateRow_Any_16_SSE2;
-    if (IS_ALIGNED(src_width, 16)) {
+    if (IS_ALIGNED(src_width, 8)) {
       InterpolateRow = InterpolateRow_16_SSE2;
     }
   }
@@ -998,7 +1079,7 @@ void ScalePlaneBilinearDown_16(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
     InterpolateRow = InterpolateRow_Any_16_AVX2;
-    if (IS_ALIGNED(src_width, 32)) {
+    if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_16_AVX2;
     }
   }
@@ -1049,18 +1130,14 @@ void ScalePlaneBilinearDown_16(int src_width, int src_height,
   free_aligned_buffer_64(row);
 }
 
-// Scale up down with bilinear interpolation.
-void ScalePlaneBilinearUp(int src_width, int src_height,
-                          int dst_width, int dst_height,
-                          int src_stride, int dst_stride,
-                          const uint8* src_ptr, uint8* dst_ptr,
-                          enum FilterMode filtering) {
+// Scale plane up with bilinear interpolation from a 16.16 start and step.
+static void ScalePlaneBilinearUpXY(int src_width, int src_height,
+                                   int dst_width, int dst_height,
+                                   int src_stride, int dst_stride,
+                                   const uint8* src_ptr, uint8* dst_ptr,
+                                   int x, int dx, int y, int dy,
+                                   enum FilterMode filtering) {
   int j;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
   const int max_y = (src_height - 1) << 16;
   void (*InterpolateRow)(uint8* dst_ptr, const uint8* src_ptr,
       ptrdiff_t src_stride, int dst_width, int source_y_fraction) =
@@ -1068,9 +1145,8 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
   void (*ScaleFilterCols)(uint8* dst_ptr, const uint8* src_ptr,
       int dst_width, int x, int dx) =
       filtering ? ScaleFilterCols_C : ScaleCols_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering,
-             &x, &y, &dx, &dy);
-  src_width = Abs(src_width);
+  void (*ScaleFilterColsTable)(uint8* dst_ptr, const uint8* src_ptr,
+      int dst_width, const int* offsets, const uint8* weights) = NULL;
 
 #if defined(HAS_INTERPOLATEROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
@@ -1128,6 +1204,14 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
       ScaleFilterCols = ScaleFilterCols_NEON;
     }
   }
+#endif
+#if defined(HAS_SCALEFILTERCOLSTABLE_SSSE3)
+  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    ScaleFilterColsTable = ScaleFilterColsTable_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleFilterColsTable = ScaleFilterColsTable_SSSE3;
+    }
+  }
 #endif
   if (!filtering && src_width * 2 == dst_width && x < 0x8000) {
     ScaleFilterCols = ScaleColsUp2_C;
@@ -1148,16 +1232,32 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
     // Allocate 2 row buffers.
     const int kRowSize = (dst_width + 31) & ~31;
     align_buffer_64(row, kRowSize * 2);
+    // Column offsets and weights are computed once for all rows.
+    align_buffer_64_if(coltable, ScaleFilterColsTable, dst_width * 6);
+    int* offsets = NULL;
+    uint8* weights = NULL;
 
     uint8* rowptr = row;
     int rowstride = kRowSize;
     int lasty = yi;
 
-    ScaleFilterCols(rowptr, src, dst_width, x, dx);
+    if (ScaleFilterColsTable) {
+      offsets = (int*)(coltable);
+      weights = coltable + dst_width * 4;
+      ScaleFilterColsSetup_C(offsets, weights, dst_width, x, dx);
+      ScaleFilterColsTable(rowptr, src, dst_width, offsets, weights);
+    } else {
+      ScaleFilterCols(rowptr, src, dst_width, x, dx);
+    }
     if (src_height > 1) {
       src += src_stride;
     }
-    ScaleFilterCols(rowptr + rowstride, src, dst_width, x, dx);
+    if (ScaleFilterColsTable) {
+      ScaleFilterColsTable(rowptr + rowstride, src, dst_width,
+                           offsets, weights);
+    } else {
+      ScaleFilterCols(rowptr + rowstride, src, dst_width, x, dx);
+    }
     src += src_stride;
 
     for (j = 0; j < dst_height; ++j) {
@@ -1169,7 +1269,11 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
           src = src_ptr + yi * src_stride;
         }
         if (yi != lasty) {
-          ScaleFilterCols(rowptr, src, dst_width, x, dx);
+          if (ScaleFilterColsTable) {
+            ScaleFilterColsTable(rowptr, src, dst_width, offsets, weights);
+          } else {
+            ScaleFilterCols(rowptr, src, dst_width, x, dx);
+          }
           rowptr += rowstride;
           rowstride = -rowstride;
           lasty = yi;
@@ -1186,9 +1290,27 @@ void ScalePlaneBilinearUp(int src_width, int src_height,
       y += dy;
     }
     free_aligned_buffer_64(row);
+    free_aligned_buffer_64(coltable);
   }
 }
 
+void ScalePlaneBilinearUp(int src_width, int src_height,
+                          int dst_width, int dst_height,
+                          int src_stride, int dst_stride,
+                          const uint8* src_ptr, uint8* dst_ptr,
+                          enum FilterMode filtering) {
+  // Initial source x/y coordinate and step values as 16.16 fixed point.
+  int x = 0;
+  int y = 0;
+  int dx = 0;
+  int dy = 0;
+  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering,
+             &x, &y, &dx, &dy);
+  ScalePlaneBilinearUpXY(Abs(src_width), src_height, dst_width, dst_height,
+                         src_stride, dst_stride, src_ptr, dst_ptr,
+                         x, dx, y, dy, filtering);
+}
+
 void ScalePlaneBilinearUp_16(int src_width, int src_height,
                              int dst_width, int dst_height,
                              int src_stride, int dst_stride,
@@ -1214,7 +1336,7 @@ void ScalePlaneBilinearUp_16(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     InterpolateRow = InterpolateRow_Any_16_SSE2;
-    if (IS_ALIGNED(dst_width, 16)) {
+    if (IS_ALIGNED(dst_width, 8)) {
       InterpolateRow = InterpolateRow_16_SSE2;
     }
   }
@@ -1230,7 +1352,7 @@ void ScalePlaneBilinearUp_16(int src_width, int src_height,
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
     InterpolateRow = InterpolateRow_Any_16_AVX2;
-    if (IS_ALIGNED(dst_width, 32)) {
+    if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_16_AVX2;
     }
   }
@@ -1581,6 +1703,9 @@ int I420Scale(const uint8* src_y, int src_stride_y,
       !dst_y || !dst_u || !dst_v || dst_width <= 0 || dst_height <= 0) {
     return -1;
   }
+  PROFILE_BEGIN((int64)(dst_width) * dst_height,
+                ((int64)(Abs(src_width)) * Abs(src_height) +
+                 (int64)(dst_width) * dst_height) * 3 / 2);
 
   ScalePlane(src_y, src_stride_y, src_width, src_height,
              dst_y, dst_stride_y, dst_width, dst_height,
@@ -1591,6 +1716,7 @@ int I420Scale(const uint8* src_y, int src_stride_y,
   ScalePlane(src_v, src_stride_v, src_halfwidth, src_halfheight,
              dst_v, dst_stride_v, dst_halfwidth, dst_halfheight,
              filtering);
+  PROFILE_END(kProfileI420Scale);
   return 0;
 }
 
@@ -1626,6 +1752,298 @@ int I420Scale_16(const uint16* src_y, int src_stride_y,
   return 0;
 }
 
+// Scale an I422 image.
+// This function in turn calls a scaling function for each plane.
+// The planes do not share row functions or row buffers.  Picking the row
+// functions costs well under a microsecond per plane.  SetScratchArena
+// removes the malloc of the rows.  Sharing them would mean passing all 3
+// planes through every ScalePlane path.  I444Scale and I400Scale are the same.
+LIBYUV_API
+int I422Scale(const uint8* src_y, int src_stride_y,
+              const uint8* src_u, int src_stride_u,
+              const uint8* src_v, int src_stride_v,
+              int src_width, int src_height,
+              uint8* dst_y, int dst_stride_y,
+              uint8* dst_u, int dst_stride_u,
+              uint8* dst_v, int dst_stride_v,
+              int dst_width, int dst_height,
+              enum FilterMode filtering) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  if (!src_y || !src_u || !src_v || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 ||
+      !dst_y || !dst_u || !dst_v || dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane(src_y, src_stride_y, src_width, src_height,
+             dst_y, dst_stride_y, dst_width, dst_height,
+             filtering);
+  ScalePlane(src_u, src_stride_u, src_halfwidth, src_height,
+             dst_u, dst_stride_u, dst_halfwidth, dst_height,
+             filtering);
+  ScalePlane(src_v, src_stride_v, src_halfwidth, src_height,
+             dst_v, dst_stride_v, dst_halfwidth, dst_height,
+             filtering);
+  return 0;
+}
+
+LIBYUV_API
+int I422Scale_16(const uint16* src_y, int src_stride_y,
+                 const uint16* src_u, int src_stride_u,
+                 const uint16* src_v, int src_stride_v,
+                 int src_width, int src_height,
+                 uint16* dst_y, int dst_stride_y,
+                 uint16* dst_u, int dst_stride_u,
+                 uint16* dst_v, int dst_stride_v,
+                 int dst_width, int dst_height,
+                 enum FilterMode filtering) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  if (!src_y || !src_u || !src_v || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 ||
+      !dst_y || !dst_u || !dst_v || dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane_16(src_y, src_stride_y, src_width, src_height,
+                dst_y, dst_stride_y, dst_width, dst_height,
+                filtering);
+  ScalePlane_16(src_u, src_stride_u, src_halfwidth, src_height,
+                dst_u, dst_stride_u, dst_halfwidth, dst_height,
+                filtering);
+  ScalePlane_16(src_v, src_stride_v, src_halfwidth, src_height,
+                dst_v, dst_stride_v, dst_halfwidth, dst_height,
+                filtering);
+  return 0;
+}
+
+// Scale an I444 image.
+// This function in turn calls a scaling function for each plane.
+LIBYUV_API
+int I444Scale(const uint8* src_y, int src_stride_y,
+              const uint8* src_u, int src_stride_u,
+              const uint8* src_v, int src_stride_v,
+              int src_width, int src_height,
+              uint8* dst_y, int dst_stride_y,
+              uint8* dst_u, int dst_stride_u,
+              uint8* dst_v, int dst_stride_v,
+              int dst_width, int dst_height,
+              enum FilterMode filtering) {
+  if (!src_y || !src_u || !src_v || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 ||
+      !dst_y || !dst_u || !dst_v || dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane(src_y, src_stride_y, src_width, src_height,
+             dst_y, dst_stride_y, dst_width, dst_height,
+             filtering);
+  ScalePlane(src_u, src_stride_u, src_width, src_height,
+             dst_u, dst_stride_u, dst_width, dst_height,
+             filtering);
+  ScalePlane(src_v, src_stride_v, src_width, src_height,
+             dst_v, dst_stride_v, dst_width, dst_height,
+             filtering);
+  return 0;
+}
+
+LIBYUV_API
+int I444Scale_16(const uint16* src_y, int src_stride_y,
+                 const uint16* src_u, int src_stride_u,
+                 const uint16* src_v, int src_stride_v,
+                 int src_width, int src_height,
+                 uint16* dst_y, int dst_stride_y,
+                 uint16* dst_u, int dst_stride_u,
+                 uint16* dst_v, int dst_stride_v,
+                 int dst_width, int dst_height,
+                 enum FilterMode filtering) {
+  if (!src_y || !src_u || !src_v || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 ||
+      !dst_y || !dst_u || !dst_v || dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane_16(src_y, src_stride_y, src_width, src_height,
+                dst_y, dst_stride_y, dst_width, dst_height,
+                filtering);
+  ScalePlane_16(src_u, src_stride_u, src_width, src_height,
+                dst_u, dst_stride_u, dst_width, dst_height,
+                filtering);
+  ScalePlane_16(src_v, src_stride_v, src_width, src_height,
+                dst_v, dst_stride_v, dst_width, dst_height,
+                filtering);
+  return 0;
+}
+
+// Scale an I400 (grey) image.
+LIBYUV_API
+int I400Scale(const uint8* src_y, int src_stride_y,
+              int src_width, int src_height,
+              uint8* dst_y, int dst_stride_y,
+              int dst_width, int dst_height,
+              enum FilterMode filtering) {
+  if (!src_y || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 ||
+      !dst_y || dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane(src_y, src_stride_y, src_width, src_height,
+             dst_y, dst_stride_y, dst_width, dst_height,
+             filtering);
+  return 0;
+}
+
+LIBYUV_API
+int I400Scale_16(const uint16* src_y, int src_stride_y,
+                 int src_width, int src_height,
+                 uint16* dst_y, int dst_stride_y,
+                 int dst_width, int dst_height,
+                 enum FilterMode filtering) {
+  if (!src_y || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 ||
+      !dst_y || dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane_16(src_y, src_stride_y, src_width, src_height,
+                dst_y, dst_stride_y, dst_width, dst_height,
+                filtering);
+  return 0;
+}
+
+// Scale a 16.16 fixed point rectangle of a plane.
+// The rectangle is scaled in place without cropping or padding first.
+static void ScalePlaneRect(const uint8* src, int src_stride,
+                           int src_width, int src_height,
+                           int crop_x, int crop_y,
+                           int crop_width, int crop_height,
+                           uint8* dst, int dst_stride,
+                           int dst_width, int dst_height,
+                           enum FilterMode filtering) {
+  // Initial source x/y coordinate and step values as 16.16 fixed point.
+  int x = 0;
+  int y = 0;
+  int dx = 0;
+  int dy = 0;
+  // Whole pixel rectangles use the specialized scalers.
+  if (((crop_x | crop_y | crop_width | crop_height) & 0xffff) == 0) {
+    ScalePlane(src + (crop_y >> 16) * src_stride + (crop_x >> 16), src_stride,
+               crop_width >> 16, crop_height >> 16,
+               dst, dst_stride, dst_width, dst_height, filtering);
+    return;
+  }
+  ScaleSlopeRect(crop_x, crop_y, crop_width, crop_height,
+                 dst_width, dst_height, filtering, &x, &y, &dx, &dy);
+  if (filtering == kFilterNone) {
+    int i;
+    for (i = 0; i < dst_height; ++i) {
+      ScaleCols_C(dst, src + (y >> 16) * src_stride, dst_width, x, dx);
+      dst += dst_stride;
+      y += dy;
+    }
+    return;
+  }
+  if (filtering == kFilterBox) {
+    filtering = kFilterBilinear;
+  }
+  if (dy < 65536) {
+    ScalePlaneBilinearUpXY(src_width, src_height, dst_width, dst_height,
+                           src_stride, dst_stride, src, dst,
+                           x, dx, y, dy, filtering);
+    return;
+  }
+  ScalePlaneBilinearDownXY(src_width, src_height, dst_width, dst_height,
+                           src_stride, dst_stride, src, dst,
+                           x, dx, y, dy, filtering);
+}
+
+// Returns true if a 16.16 rectangle is at least min_size and within the image.
+static LIBYUV_BOOL ValidRect(int width, int height,
+                             int crop_x, int crop_y,
+                             int crop_width, int crop_height, int min_size) {
+  return crop_x >= 0 && crop_y >= 0 &&
+         crop_width >= min_size && crop_height >= min_size &&
+         (int64)crop_x + crop_width <= (int64)width << 16 &&
+         (int64)crop_y + crop_height <= (int64)height << 16;
+}
+
+LIBYUV_API
+int ScalePlaneCrop(const uint8* src, int src_stride,
+                   int src_width, int src_height,
+                   int crop_x, int crop_y, int crop_width, int crop_height,
+                   uint8* dst, int dst_stride,
+                   int dst_width, int dst_height,
+                   enum FilterMode filtering) {
+  if (!src || src_width <= 0 || src_height == 0 ||
+      src_width > 32767 || src_height > 32767 || src_height < -32767 ||
+      !dst || dst_width <= 0 || dst_height <= 0 ||
+      !ValidRect(src_width, Abs(src_height), crop_x, crop_y,
+                 crop_width, crop_height, 65536)) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (src_height < 0) {
+    src_height = -src_height;
+    src = src + (src_height - 1) * src_stride;
+    src_stride = -src_stride;
+  }
+  ScalePlaneRect(src, src_stride, src_width, src_height,
+                 crop_x, crop_y, crop_width, crop_height,
+                 dst, dst_stride, dst_width, dst_height, filtering);
+  return 0;
+}
+
+LIBYUV_API
+int I420ScaleCrop(const uint8* src_y, int src_stride_y,
+                  const uint8* src_u, int src_stride_u,
+                  const uint8* src_v, int src_stride_v,
+                  int src_width, int src_height,
+                  int crop_x, int crop_y, int crop_width, int crop_height,
+                  uint8* dst_y, int dst_stride_y,
+                  uint8* dst_u, int dst_stride_u,
+                  uint8* dst_v, int dst_stride_v,
+                  int dst_width, int dst_height,
+                  enum FilterMode filtering) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  // Chroma rectangle is half the luma rectangle, keeping the fraction.
+  if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
+      src_width > 32767 || src_height > 32767 || src_height < -32767 ||
+      !dst_y || !dst_u || !dst_v || dst_width <= 0 || dst_height <= 0 ||
+      !ValidRect(src_width, Abs(src_height), crop_x, crop_y,
+                 crop_width, crop_height, 65536 * 2)) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (src_height < 0) {
+    src_height = -src_height;
+    src_halfheight = SUBSAMPLE(src_height, 1, 1);
+    src_y = src_y + (src_height - 1) * src_stride_y;
+    src_u = src_u + (src_halfheight - 1) * src_stride_u;
+    src_v = src_v + (src_halfheight - 1) * src_stride_v;
+    src_stride_y = -src_stride_y;
+    src_stride_u = -src_stride_u;
+    src_stride_v = -src_stride_v;
+  }
+
+  ScalePlaneRect(src_y, src_stride_y, src_width, src_height,
+                 crop_x, crop_y, crop_width, crop_height,
+                 dst_y, dst_stride_y, dst_width, dst_height, filtering);
+  ScalePlaneRect(src_u, src_stride_u, src_halfwidth, src_halfheight,
+                 crop_x >> 1, crop_y >> 1, crop_width >> 1, crop_height >> 1,
+                 dst_u, dst_stride_u, dst_halfwidth, dst_halfheight,
+                 filtering);
+  ScalePlaneRect(src_v, src_stride_v, src_halfwidth, src_halfheight,
+                 crop_x >> 1, crop_y >> 1, crop_width >> 1, crop_height >> 1,
+                 dst_v, dst_stride_v, dst_halfwidth, dst_halfheight,
+                 filtering);
+  return 0;
+}
+
 // Deprecated api
 LIBYUV_API
 int Scale(const uint8* src_y, const uint8* src_u, const uint8* src_v,
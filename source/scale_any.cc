@@ -42,6 +42,32 @@ CANY(ScaleARGBFilterCols_Any_NEON, ScaleARGBFilterCols_NEON,
 #endif
 #undef CANY
 
+// Definition for ScaleFilterColsTable and ScaleARGBFilterColsTable
+#define CTANY(NAMEANY, TERP_SIMD, TERP_C, BPP, MASK)                           \
+    void NAMEANY(uint8* dst_ptr, const uint8* src_ptr,                         \
+                 int dst_width, const int* offsets, const uint8* weights) {    \
+      int n = dst_width & ~MASK;                                               \
+      if (n > 0) {                                                             \
+        TERP_SIMD(dst_ptr, src_ptr, n, offsets, weights);                      \
+      }                                                                        \
+      TERP_C(dst_ptr + n * BPP, src_ptr,                                       \
+             dst_width & MASK, offsets + n, weights + n * 2);                  \
+    }
+
+#ifdef HAS_SCALEFILTERCOLSTABLE_SSSE3
+CTANY(ScaleFilterColsTable_Any_SSSE3, ScaleFilterColsTable_SSSE3,
+      ScaleFilterColsTable_C, 1, 7)
+#endif
+#ifdef HAS_SCALEARGBFILTERCOLSTABLE_SSSE3
+CTANY(ScaleARGBFilterColsTable_Any_SSSE3, ScaleARGBFilterColsTable_SSSE3,
+      ScaleARGBFilterColsTable_C, 4, 3)
+#endif
+#ifdef HAS_SCALEARGBFILTERCOLSTABLE_AVX2
+CTANY(ScaleARGBFilterColsTable_Any_AVX2, ScaleARGBFilterColsTable_AVX2,
+      ScaleARGBFilterColsTable_C, 4, 7)
+#endif
+#undef CTANY
+
 // Fixed scale down.
 #define SDANY(NAMEANY, SCALEROWDOWN_SIMD, SCALEROWDOWN_C, FACTOR, BPP, MASK)   \
     void NAMEANY(const uint8* src_ptr, ptrdiff_t src_stride,                   \
@@ -142,6 +168,34 @@ SDANY(ScaleARGBRowDown2Box_Any_NEON, ScaleARGBRowDown2Box_NEON,
 #endif
 #undef SDANY
 
+// Fixed scale down for 16 bit planes.  Stride is in shorts.
+#define SDANY16(NAMEANY, SCALEROWDOWN_SIMD, SCALEROWDOWN_C, FACTOR, MASK)      \
+    void NAMEANY(const uint16* src_ptr, ptrdiff_t src_stride,                  \
+                 uint16* dst_ptr, int dst_width) {                             \
+      int r = (int)((unsigned int)dst_width % (MASK + 1));                     \
+      int n = dst_width - r;                                                   \
+      if (n > 0) {                                                             \
+        SCALEROWDOWN_SIMD(src_ptr, src_stride, dst_ptr, n);                    \
+      }                                                                        \
+      SCALEROWDOWN_C(src_ptr + n * FACTOR, src_stride, dst_ptr + n, r);        \
+    }
+
+#ifdef HAS_SCALEROWDOWN2_16_SSE2
+SDANY16(ScaleRowDown2_Any_16_SSE2, ScaleRowDown2_16_SSE2, ScaleRowDown2_16_C,
+        2, 7)
+SDANY16(ScaleRowDown2Linear_Any_16_SSE2, ScaleRowDown2Linear_16_SSE2,
+        ScaleRowDown2Linear_16_C, 2, 7)
+SDANY16(ScaleRowDown2Box_Any_16_SSE2, ScaleRowDown2Box_16_SSE2,
+        ScaleRowDown2Box_16_C, 2, 7)
+#endif
+#ifdef HAS_SCALEROWDOWN4_16_SSE2
+SDANY16(ScaleRowDown4_Any_16_SSE2, ScaleRowDown4_16_SSE2, ScaleRowDown4_16_C,
+        4, 7)
+SDANY16(ScaleRowDown4Box_Any_16_SSE2, ScaleRowDown4Box_16_SSE2,
+        ScaleRowDown4Box_16_C, 4, 3)
+#endif
+#undef SDANY16
+
 // Scale down by even scale factor.
 #define SDAANY(NAMEANY, SCALEROWDOWN_SIMD, SCALEROWDOWN_C, BPP, MASK)          \
     void NAMEANY(const uint8* src_ptr, ptrdiff_t src_stride, int src_stepx,    \
@@ -189,6 +243,76 @@ SAANY(ScaleAddRow_Any_NEON, ScaleAddRow_NEON, ScaleAddRow_C, 15)
 #endif
 #undef SAANY
 
+// Scale up by 2 with filtering.  Source is half of destination width.
+#define SUANY(NAMEANY, SCALEROWUP_SIMD, SCALEROWUP_C, MASK)                    \
+    void NAMEANY(const uint8* src_ptr, ptrdiff_t src_stride,                   \
+                 uint8* dst_ptr, int dst_width) {                              \
+      int r = dst_width & MASK;                                                \
+      int n = dst_width - r;                                                   \
+      if (n > 0) {                                                             \
+        SCALEROWUP_SIMD(src_ptr, src_stride, dst_ptr, n);                      \
+      }                                                                        \
+      SCALEROWUP_C(src_ptr + n / 2, src_stride, dst_ptr + n, r);               \
+    }
+
+#ifdef HAS_SCALEROWUP2_BILINEAR_SSE2
+SUANY(ScaleRowUp2_Bilinear_Any_SSE2, ScaleRowUp2_Bilinear_SSE2,
+      ScaleRowUp2_Bilinear_C, 15)
+#endif
+#ifdef HAS_SCALEROWUP2_BILINEAR_AVX2
+SUANY(ScaleRowUp2_Bilinear_Any_AVX2, ScaleRowUp2_Bilinear_AVX2,
+      ScaleRowUp2_Bilinear_C, 31)
+#endif
+#undef SUANY
+
+// Linear light conversion of ARGB rows.
+#define STLANY(NAMEANY, TOLINEAR_SIMD, TOLINEAR_C, MASK)                       \
+    void NAMEANY(const uint8* src_argb, uint16* dst_argb, int width) {         \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        TOLINEAR_SIMD(src_argb, dst_argb, n);                                  \
+      }                                                                        \
+      TOLINEAR_C(src_argb + n * 4, dst_argb + n * 4, width & MASK);            \
+    }
+
+#define SFLANY(NAMEANY, FROMLINEAR_SIMD, FROMLINEAR_C, MASK)                   \
+    void NAMEANY(const uint16* src_argb, uint8* dst_argb,                      \
+                 const uint8* table, int width) {                              \
+      int n = width & ~MASK;                                                   \
+      if (n > 0) {                                                             \
+        FROMLINEAR_SIMD(src_argb, dst_argb, table, n);                         \
+      }                                                                        \
+      FROMLINEAR_C(src_argb + n * 4, dst_argb + n * 4, table, width & MASK);   \
+    }
+
+#ifdef HAS_SCALEARGBROWTOLINEAR_AVX2
+STLANY(ScaleARGBRowToLinear_Any_AVX2, ScaleARGBRowToLinear_AVX2,
+       ScaleARGBRowToLinear_C, 7)
+#endif
+#ifdef HAS_SCALEARGBROWFROMLINEAR_AVX2
+SFLANY(ScaleARGBRowFromLinear_Any_AVX2, ScaleARGBRowFromLinear_AVX2,
+       ScaleARGBRowFromLinear_C, 7)
+#endif
+#undef STLANY
+#undef SFLANY
+
+// Add rows box filter scale down for 16 bit planes.
+#define SAANY16(NAMEANY, SCALEADDROW_SIMD, SCALEADDROW_C, MASK)                \
+  void NAMEANY(const uint16* src_ptr, uint32* dst_ptr, int src_width) {        \
+      int n = src_width & ~MASK;                                               \
+      if (n > 0) {                                                             \
+        SCALEADDROW_SIMD(src_ptr, dst_ptr, n);                                 \
+      }                                                                        \
+      if (src_width & MASK) {                                                  \
+        SCALEADDROW_C(src_ptr + n, dst_ptr + n, src_width & MASK);             \
+      }                                                                        \
+    }
+
+#ifdef HAS_SCALEADDROW_16_SSE2
+SAANY16(ScaleAddRow_Any_16_SSE2, ScaleAddRow_16_SSE2, ScaleAddRow_16_C, 7)
+#endif
+#undef SAANY16
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
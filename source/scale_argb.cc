@@ -15,6 +15,7 @@
 
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"  // For CopyARGB
+#include "libyuv/profile.h"
 #include "libyuv/row.h"
 #include "libyuv/scale_row.h"
 
@@ -45,11 +46,13 @@ static void ScaleARGBDown2(int src_width, int src_height,
         ScaleARGBRowDown2Box_C);
   assert(dx == 65536 * 2);  // Test scale factor of 2.
   assert((dy & 0x1ffff) == 0);  // Test vertical scale is multiple of 2.
-  // Advance to odd row, even column.
-  if (filtering == kFilterBilinear) {
-    src_argb += (y >> 16) * src_stride + (x >> 16) * 4;
-  } else {
+  // Advance to odd row, even column.  Point sampling starts at x = 1 and
+  // takes the odd column.  Filters start at x = 0 or 0.5 and average the
+  // even column with the odd one.
+  if (filtering == kFilterNone) {
     src_argb += (y >> 16) * src_stride + ((x >> 16) - 1) * 4;
+  } else {
+    src_argb += (y >> 16) * src_stride + (x >> 16) * 4;
   }
 
 #if defined(HAS_SCALEARGBROWDOWN2_SSE2)
@@ -197,6 +200,8 @@ static void ScaleARGBBilinearDown(int src_width, int src_height,
   void (*ScaleARGBFilterCols)(uint8* dst_argb, const uint8* src_argb,
       int dst_width, int x, int dx) =
       (src_width >= 32768) ? ScaleARGBFilterCols64_C : ScaleARGBFilterCols_C;
+  void (*ScaleARGBFilterColsTable)(uint8* dst_argb, const uint8* src_argb,
+      int dst_width, const int* offsets, const uint8* weights) = NULL;
   int64 xlast = x + (int64)(dst_width - 1) * dx;
   int64 xl = (dx >= 0) ? x : xlast;
   int64 xr = (dx >= 0) ? xlast : x;
@@ -263,13 +268,38 @@ static void ScaleARGBBilinearDown(int src_width, int src_height,
       ScaleARGBFilterCols = ScaleARGBFilterCols_NEON;
     }
   }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLSTABLE_SSSE3)
+  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    ScaleARGBFilterColsTable = ScaleARGBFilterColsTable_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 4)) {
+      ScaleARGBFilterColsTable = ScaleARGBFilterColsTable_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLSTABLE_AVX2)
+  if (filtering && TestCpuFlag(kCpuHasAVX2) && src_width < 32768) {
+    ScaleARGBFilterColsTable = ScaleARGBFilterColsTable_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleARGBFilterColsTable = ScaleARGBFilterColsTable_AVX2;
+    }
+  }
 #endif
   // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
   // Allocate a row of ARGB.
   {
     align_buffer_64(row, clip_src_width * 4);
-
+    // Column offsets and weights are computed once for all rows.
+    align_buffer_64_if(coltable, ScaleARGBFilterColsTable, dst_width * 6);
+    int* offsets = NULL;
+    uint8* weights = NULL;
     const int max_y = (src_height - 1) << 16;
+
+    if (ScaleARGBFilterColsTable) {
+      offsets = (int*)(coltable);
+      weights = coltable + dst_width * 4;
+      ScaleFilterColsSetup_C(offsets, weights, dst_width, x, dx);
+    }
     if (y > max_y) {
       y = max_y;
     }
@@ -277,11 +307,19 @@ static void ScaleARGBBilinearDown(int src_width, int src_height,
       int yi = y >> 16;
       const uint8* src = src_argb + yi * src_stride;
       if (filtering == kFilterLinear) {
-        ScaleARGBFilterCols(dst_argb, src, dst_width, x, dx);
+        if (ScaleARGBFilterColsTable) {
+          ScaleARGBFilterColsTable(dst_argb, src, dst_width, offsets, weights);
+        } else {
+          ScaleARGBFilterCols(dst_argb, src, dst_width, x, dx);
+        }
       } else {
         int yf = (y >> 8) & 255;
         InterpolateRow(row, src, src_stride, clip_src_width, yf);
-        ScaleARGBFilterCols(dst_argb, row, dst_width, x, dx);
+        if (ScaleARGBFilterColsTable) {
+          ScaleARGBFilterColsTable(dst_argb, row, dst_width, offsets, weights);
+        } else {
+          ScaleARGBFilterCols(dst_argb, row, dst_width, x, dx);
+        }
       }
       dst_argb += dst_stride;
       y += dy;
@@ -290,6 +328,7 @@ static void ScaleARGBBilinearDown(int src_width, int src_height,
       }
     }
     free_aligned_buffer_64(row);
+    free_aligned_buffer_64(coltable);
   }
 }
 
@@ -307,6 +346,8 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
   void (*ScaleARGBFilterCols)(uint8* dst_argb, const uint8* src_argb,
       int dst_width, int x, int dx) =
       filtering ? ScaleARGBFilterCols_C : ScaleARGBCols_C;
+  void (*ScaleARGBFilterColsTable)(uint8* dst_argb, const uint8* src_argb,
+      int dst_width, const int* offsets, const uint8* weights) = NULL;
   const int max_y = (src_height - 1) << 16;
 #if defined(HAS_INTERPOLATEROW_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
@@ -363,6 +404,22 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
     }
   }
 #endif
+#if defined(HAS_SCALEARGBFILTERCOLSTABLE_SSSE3)
+  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    ScaleARGBFilterColsTable = ScaleARGBFilterColsTable_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 4)) {
+      ScaleARGBFilterColsTable = ScaleARGBFilterColsTable_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLSTABLE_AVX2)
+  if (filtering && TestCpuFlag(kCpuHasAVX2) && src_width < 32768) {
+    ScaleARGBFilterColsTable = ScaleARGBFilterColsTable_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleARGBFilterColsTable = ScaleARGBFilterColsTable_AVX2;
+    }
+  }
+#endif
 #if defined(HAS_SCALEARGBCOLS_SSE2)
   if (!filtering && TestCpuFlag(kCpuHasSSE2) && src_width < 32768) {
     ScaleARGBFilterCols = ScaleARGBCols_SSE2;
@@ -396,16 +453,32 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
     // Allocate 2 rows of ARGB.
     const int kRowSize = (dst_width * 4 + 31) & ~31;
     align_buffer_64(row, kRowSize * 2);
+    // Column offsets and weights are computed once for all rows.
+    align_buffer_64_if(coltable, ScaleARGBFilterColsTable, dst_width * 6);
+    int* offsets = NULL;
+    uint8* weights = NULL;
 
     uint8* rowptr = row;
     int rowstride = kRowSize;
     int lasty = yi;
 
-    ScaleARGBFilterCols(rowptr, src, dst_width, x, dx);
+    if (ScaleARGBFilterColsTable) {
+      offsets = (int*)(coltable);
+      weights = coltable + dst_width * 4;
+      ScaleFilterColsSetup_C(offsets, weights, dst_width, x, dx);
+      ScaleARGBFilterColsTable(rowptr, src, dst_width, offsets, weights);
+    } else {
+      ScaleARGBFilterCols(rowptr, src, dst_width, x, dx);
+    }
     if (src_height > 1) {
       src += src_stride;
     }
-    ScaleARGBFilterCols(rowptr + rowstride, src, dst_width, x, dx);
+    if (ScaleARGBFilterColsTable) {
+      ScaleARGBFilterColsTable(rowptr + rowstride, src, dst_width,
+                               offsets, weights);
+    } else {
+      ScaleARGBFilterCols(rowptr + rowstride, src, dst_width, x, dx);
+    }
     src += src_stride;
 
     for (j = 0; j < dst_height; ++j) {
@@ -417,7 +490,11 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
           src = src_argb + yi * src_stride;
         }
         if (yi != lasty) {
-          ScaleARGBFilterCols(rowptr, src, dst_width, x, dx);
+          if (ScaleARGBFilterColsTable) {
+            ScaleARGBFilterColsTable(rowptr, src, dst_width, offsets, weights);
+          } else {
+            ScaleARGBFilterCols(rowptr, src, dst_width, x, dx);
+          }
           rowptr += rowstride;
           rowstride = -rowstride;
           lasty = yi;
@@ -434,6 +511,7 @@ static void ScaleARGBBilinearUp(int src_width, int src_height,
       y += dy;
     }
     free_aligned_buffer_64(row);
+    free_aligned_buffer_64(coltable);
   }
 }
 
@@ -698,6 +776,243 @@ static void ScaleARGBSimple(int src_width, int src_height,
   }
 }
 
+#define MIN1(x) ((x) < 1 ? 1 : (x))
+
+typedef void (*ScaleARGBRowToLinearFunction)(const uint8* src_argb,
+                                             uint16* dst_argb, int width);
+typedef void (*ScaleARGBRowFromLinearFunction)(const uint16* src_argb,
+                                               uint8* dst_argb,
+                                               const uint8* table, int width);
+
+static ScaleARGBRowToLinearFunction GetScaleARGBRowToLinear(int width) {
+  ScaleARGBRowToLinearFunction ScaleARGBRowToLinear = ScaleARGBRowToLinear_C;
+#if defined(HAS_SCALEARGBROWTOLINEAR_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ScaleARGBRowToLinear = ScaleARGBRowToLinear_Any_AVX2;
+    if (IS_ALIGNED(width, 8)) {
+      ScaleARGBRowToLinear = ScaleARGBRowToLinear_AVX2;
+    }
+  }
+#endif
+  return ScaleARGBRowToLinear;
+}
+
+static ScaleARGBRowFromLinearFunction GetScaleARGBRowFromLinear(int width) {
+  ScaleARGBRowFromLinearFunction ScaleARGBRowFromLinear =
+      ScaleARGBRowFromLinear_C;
+#if defined(HAS_SCALEARGBROWFROMLINEAR_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ScaleARGBRowFromLinear = ScaleARGBRowFromLinear_Any_AVX2;
+    if (IS_ALIGNED(width, 8)) {
+      ScaleARGBRowFromLinear = ScaleARGBRowFromLinear_AVX2;
+    }
+  }
+#endif
+  return ScaleARGBRowFromLinear;
+}
+
+// Sum a box of 16 bit linear ARGB pixels per channel and average them.
+// Box widths differ by at most 1, so the average multiplies by one of 2
+// reciprocals computed per row instead of dividing for each pixel.
+static void ScaleARGBAddCols_16_C(int dst_width, int boxheight, int x, int dx,
+                                  const uint32* src_ptr, uint16* dst_ptr) {
+  int i;
+  uint64 scaletbl[2];
+  int minboxwidth = dx >> 16;
+  uint64* scaleptr = scaletbl - minboxwidth;
+  scaletbl[0] = ((uint64)(1) << 32) / (uint32)(MIN1(minboxwidth) * boxheight);
+  scaletbl[1] = ((uint64)(1) << 32) / (uint32)((minboxwidth + 1) * boxheight);
+  for (i = 0; i < dst_width; ++i) {
+    int ix = x >> 16;
+    int boxwidth;
+    uint64 scaleval;
+    int c;
+    x += dx;
+    boxwidth = MIN1((x >> 16) - ix);
+    scaleval = scaleptr[boxwidth];
+    for (c = 0; c < 4; ++c) {
+      uint64 sum = 0u;
+      int k;
+      for (k = 0; k < boxwidth; ++k) {
+        sum += src_ptr[(ix + k) * 4 + c];
+      }
+      dst_ptr[c] = (uint16)((sum * scaleval + 0x80000000u) >> 32);
+    }
+    dst_ptr += 4;
+  }
+}
+
+// Scale ARGB down in linear light with a box filter.
+// Each source row is linearized once and accumulated in 32 bits.
+static void ScaleARGBBoxLinearLight(int src_width, int src_height,
+                                    int dst_width, int dst_height,
+                                    int src_stride, int dst_stride,
+                                    const uint8* src_argb, uint8* dst_argb,
+                                    int x, int dx, int y, int dy,
+                                    const uint8* table) {
+  int j, k;
+  const int max_y = (src_height << 16);
+  void (*ScaleAddRow)(const uint16* src_ptr, uint32* dst_ptr, int src_width) =
+      ScaleAddRow_16_C;
+  ScaleARGBRowToLinearFunction ScaleARGBRowToLinear =
+      GetScaleARGBRowToLinear(src_width);
+  ScaleARGBRowFromLinearFunction ScaleARGBRowFromLinear =
+      GetScaleARGBRowFromLinear(dst_width);
+#if defined(HAS_SCALEADDROW_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ScaleAddRow = ScaleAddRow_Any_16_SSE2;
+    if (IS_ALIGNED(src_width * 4, 8)) {
+      ScaleAddRow = ScaleAddRow_16_SSE2;
+    }
+  }
+#endif
+  {
+    // Allocate a linear row, a row of sums and a destination row.
+    align_buffer_64(row16, src_width * 4 * 2);
+    align_buffer_64(row32, src_width * 4 * 4);
+    align_buffer_64(dst16, dst_width * 4 * 2);
+    for (j = 0; j < dst_height; ++j) {
+      int boxheight;
+      int iy = y >> 16;
+      const uint8* src = src_argb + iy * src_stride;
+      y += dy;
+      if (y > max_y) {
+        y = max_y;
+      }
+      boxheight = MIN1((y >> 16) - iy);
+      memset(row32, 0, src_width * 4 * 4);
+      for (k = 0; k < boxheight; ++k) {
+        ScaleARGBRowToLinear(src, (uint16*)(row16), src_width);
+        ScaleAddRow((const uint16*)(row16), (uint32*)(row32), src_width * 4);
+        src += src_stride;
+      }
+      ScaleARGBAddCols_16_C(dst_width, boxheight, x, dx,
+                            (const uint32*)(row32), (uint16*)(dst16));
+      ScaleARGBRowFromLinear((const uint16*)(dst16), dst_argb, table,
+                             dst_width);
+      dst_argb += dst_stride;
+    }
+    free_aligned_buffer_64(dst16);
+    free_aligned_buffer_64(row32);
+    free_aligned_buffer_64(row16);
+  }
+}
+
+// Linearize a row of ARGB and replicate the last pixel so the column filter
+// can read one pixel beyond the right edge.
+static void LinearizeRow(ScaleARGBRowToLinearFunction ScaleARGBRowToLinear,
+                         const uint8* src_argb, uint16* dst, int width) {
+  ScaleARGBRowToLinear(src_argb, dst, width);
+  memcpy(dst + width * 4, dst + (width - 1) * 4, 8);
+}
+
+// Scale ARGB in linear light with bilinear interpolation.
+// Source rows are linearized once and reused while they are in use.
+static void ScaleARGBBilinearLinearLight(int src_width, int src_height,
+                                         int dst_width, int dst_height,
+                                         int src_stride, int dst_stride,
+                                         const uint8* src_argb,
+                                         uint8* dst_argb,
+                                         int x, int dx, int y, int dy,
+                                         enum FilterMode filtering,
+                                         const uint8* table) {
+  int j;
+  void (*InterpolateRow)(uint16* dst_ptr, const uint16* src_ptr,
+      ptrdiff_t src_stride, int dst_width, int source_y_fraction) =
+      InterpolateRow_16_C;
+  void (*ScaleARGBFilterCols)(uint16* dst_argb, const uint16* src_argb,
+      int dst_width, int x, int dx) = ScaleARGBFilterCols_16_C;
+  ScaleARGBRowToLinearFunction ScaleARGBRowToLinear;
+  ScaleARGBRowFromLinearFunction ScaleARGBRowFromLinear;
+  int64 xlast = x + (int64)(dst_width - 1) * dx;
+  int64 xl = (dx >= 0) ? x : xlast;
+  int64 xr = (dx >= 0) ? xlast : x;
+  int clip_src_width;
+  const int max_y = (src_height - 1) << 16;
+  xl = xl >> 16;
+  xr = (xr >> 16) + 2;  // 1 beyond right most pixel used.
+  if (xr > src_width) {
+    xr = src_width;
+  }
+  clip_src_width = (int)(xr - xl);
+  src_argb += xl * 4;
+  x -= (int)(xl << 16);
+  ScaleARGBRowToLinear = GetScaleARGBRowToLinear(clip_src_width);
+  ScaleARGBRowFromLinear = GetScaleARGBRowFromLinear(dst_width);
+#if defined(HAS_INTERPOLATEROW_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    InterpolateRow = InterpolateRow_Any_16_SSE2;
+    if (IS_ALIGNED(clip_src_width * 4, 8)) {
+      InterpolateRow = InterpolateRow_16_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    InterpolateRow = InterpolateRow_Any_16_AVX2;
+    if (IS_ALIGNED(clip_src_width * 4, 16)) {
+      InterpolateRow = InterpolateRow_16_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2) && clip_src_width < 32768) {
+    ScaleARGBFilterCols = ScaleARGBFilterCols_16_SSE2;
+  }
+#endif
+  {
+    // 3 linear rows of clip_src_width + 1 pixels and a destination row.
+    const int kRowSize = (clip_src_width + 1) * 4;
+    align_buffer_64(row, kRowSize * 2 * 3);
+    align_buffer_64(dst16, dst_width * 4 * 2);
+    uint16* rowptr0 = (uint16*)(row);
+    uint16* rowptr1 = rowptr0 + kRowSize;
+    uint16* rowptri = rowptr1 + kRowSize;
+    int lasty = -2;
+
+    if (y > max_y) {
+      y = max_y;
+    }
+    for (j = 0; j < dst_height; ++j) {
+      int yi = y >> 16;
+      const uint16* rowptr;
+      if (yi != lasty) {
+        if (filtering != kFilterLinear && yi == lasty + 1) {
+          uint16* tmp = rowptr0;
+          rowptr0 = rowptr1;
+          rowptr1 = tmp;
+        } else {
+          LinearizeRow(ScaleARGBRowToLinear, src_argb + yi * src_stride,
+                       rowptr0, clip_src_width);
+        }
+        if (filtering != kFilterLinear) {
+          int yi1 = (yi + 1 < src_height) ? yi + 1 : yi;
+          LinearizeRow(ScaleARGBRowToLinear, src_argb + yi1 * src_stride,
+                       rowptr1, clip_src_width);
+        }
+        lasty = yi;
+      }
+      rowptr = rowptr0;
+      if (filtering != kFilterLinear) {
+        int yf = (y >> 8) & 255;
+        InterpolateRow(rowptri, rowptr0, rowptr1 - rowptr0,
+                       clip_src_width * 4, yf);
+        rowptr = rowptri;
+      }
+      ScaleARGBFilterCols((uint16*)(dst16), rowptr, dst_width, x, dx);
+      ScaleARGBRowFromLinear((const uint16*)(dst16), dst_argb, table,
+                             dst_width);
+      dst_argb += dst_stride;
+      y += dy;
+      if (y > max_y) {
+        y = max_y;
+      }
+    }
+    free_aligned_buffer_64(dst16);
+    free_aligned_buffer_64(row);
+  }
+}
+
 // ScaleARGB a ARGB.
 // This function in turn calls a scaling function
 // suitable for handling the desired resolutions.
@@ -841,9 +1156,131 @@ int ARGBScale(const uint8* src_argb, int src_stride_argb,
       !dst_argb || dst_width <= 0 || dst_height <= 0) {
     return -1;
   }
+  PROFILE_BEGIN((int64)(dst_width) * dst_height,
+                ((int64)(Abs(src_width)) * Abs(src_height) +
+                 (int64)(dst_width) * dst_height) * 4);
   ScaleARGB(src_argb, src_stride_argb, src_width, src_height,
             dst_argb, dst_stride_argb, dst_width, dst_height,
             0, 0, dst_width, dst_height, filtering);
+  PROFILE_END(kProfileARGBScale);
+  return 0;
+}
+
+// Scale a 16.16 fixed point rectangle of an ARGB image.
+LIBYUV_API
+int ARGBScaleCrop(const uint8* src_argb, int src_stride_argb,
+                  int src_width, int src_height,
+                  int crop_x, int crop_y, int crop_width, int crop_height,
+                  uint8* dst_argb, int dst_stride_argb,
+                  int dst_width, int dst_height,
+                  enum FilterMode filtering) {
+  // Initial source x/y coordinate and step values as 16.16 fixed point.
+  int x = 0;
+  int y = 0;
+  int dx = 0;
+  int dy = 0;
+  if (!src_argb || src_width <= 0 || src_height == 0 ||
+      src_width > 32767 || src_height > 32767 || src_height < -32767 ||
+      !dst_argb || dst_width <= 0 || dst_height <= 0 ||
+      crop_x < 0 || crop_y < 0 || crop_width < 65536 || crop_height < 65536 ||
+      (int64)crop_x + crop_width > (int64)src_width << 16 ||
+      (int64)crop_y + crop_height > (int64)Abs(src_height) << 16) {
+    return -1;
+  }
+  // Negative src_height means invert the image.
+  if (src_height < 0) {
+    src_height = -src_height;
+    src_argb = src_argb + (src_height - 1) * src_stride_argb;
+    src_stride_argb = -src_stride_argb;
+  }
+  // Whole pixel rectangles use the specialized scalers.
+  if (((crop_x | crop_y | crop_width | crop_height) & 0xffff) == 0) {
+    ScaleARGB(src_argb + (crop_y >> 16) * src_stride_argb + (crop_x >> 16) * 4,
+              src_stride_argb, crop_width >> 16, crop_height >> 16,
+              dst_argb, dst_stride_argb, dst_width, dst_height,
+              0, 0, dst_width, dst_height, filtering);
+    return 0;
+  }
+  ScaleSlopeRect(crop_x, crop_y, crop_width, crop_height,
+                 dst_width, dst_height, filtering, &x, &y, &dx, &dy);
+  if (filtering == kFilterNone) {
+    ScaleARGBSimple(src_width, src_height, dst_width, dst_height,
+                    src_stride_argb, dst_stride_argb, src_argb, dst_argb,
+                    x, dx, y, dy);
+    return 0;
+  }
+  if (filtering == kFilterBox) {
+    filtering = kFilterBilinear;
+  }
+  if (dy < 65536) {
+    ScaleARGBBilinearUp(src_width, src_height, dst_width, dst_height,
+                        src_stride_argb, dst_stride_argb, src_argb, dst_argb,
+                        x, dx, y, dy, filtering);
+    return 0;
+  }
+  ScaleARGBBilinearDown(src_width, src_height, dst_width, dst_height,
+                        src_stride_argb, dst_stride_argb, src_argb, dst_argb,
+                        x, dx, y, dy, filtering);
+  return 0;
+}
+
+// Scale an ARGB image in linear light.
+LIBYUV_API
+int ARGBScaleLinearLight(const uint8* src_argb, int src_stride_argb,
+                         int src_width, int src_height,
+                         uint8* dst_argb, int dst_stride_argb,
+                         int dst_width, int dst_height,
+                         enum FilterMode filtering) {
+  int x = 0;
+  int y = 0;
+  int dx = 0;
+  int dy = 0;
+  // The AVX2 row function reads 4 bytes at each entry, so the table is
+  // padded.
+  uint8 table[4096 + 4];
+  if (!src_argb || src_width == 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 ||
+      !dst_argb || dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  filtering = ScaleFilterReduce(src_width, src_height,
+                                dst_width, dst_height,
+                                filtering);
+  // Point sampling does not depend on gamma.
+  if (filtering == kFilterNone) {
+    ScaleARGB(src_argb, src_stride_argb, src_width, src_height,
+              dst_argb, dst_stride_argb, dst_width, dst_height,
+              0, 0, dst_width, dst_height, kFilterNone);
+    return 0;
+  }
+  ScaleARGBLinearTable_C(table);
+  memset(table + 4096, 0, 4);
+
+  // Negative src_height means invert the image.
+  if (src_height < 0) {
+    src_height = -src_height;
+    src_argb = src_argb + (src_height - 1) * src_stride_argb;
+    src_stride_argb = -src_stride_argb;
+  }
+  if (filtering == kFilterBox && src_width > 0 &&
+      dst_height * 2 < src_height) {
+    ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterBox,
+               &x, &y, &dx, &dy);
+    ScaleARGBBoxLinearLight(src_width, src_height, dst_width, dst_height,
+                            src_stride_argb, dst_stride_argb,
+                            src_argb, dst_argb, x, dx, y, dy, table);
+    return 0;
+  }
+  if (filtering == kFilterBox) {
+    filtering = kFilterBilinear;
+  }
+  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering,
+             &x, &y, &dx, &dy);
+  ScaleARGBBilinearLinearLight(Abs(src_width), src_height,
+                               dst_width, dst_height,
+                               src_stride_argb, dst_stride_argb,
+                               src_argb, dst_argb, x, dx, y, dy,
+                               filtering, table);
   return 0;
 }
 
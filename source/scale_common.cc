@@ -381,6 +381,20 @@ void ScaleColsUp2_C(uint8* dst_ptr, const uint8* src_ptr,
   }
 }
 
+void ScaleRowUp2_Bilinear_C(const uint8* src_ptr, ptrdiff_t src_stride,
+                            uint8* dst_ptr, int dst_width) {
+  const uint8* s = src_ptr;
+  const uint8* t = src_ptr + src_stride;
+  int x;
+  for (x = 0; x < dst_width; x += 2) {
+    dst_ptr[0] = (s[0] * 9 + s[1] * 3 + t[0] * 3 + t[1] + 8) >> 4;
+    dst_ptr[1] = (s[0] * 3 + s[1] * 9 + t[0] + t[1] * 3 + 8) >> 4;
+    dst_ptr += 2;
+    s += 1;
+    t += 1;
+  }
+}
+
 void ScaleColsUp2_16_C(uint16* dst_ptr, const uint16* src_ptr,
                        int dst_width, int x, int dx) {
   int j;
@@ -857,6 +871,148 @@ void ScaleARGBFilterCols64_C(uint8* dst_argb, const uint8* src_argb,
 #undef BLENDERC
 #undef BLENDER
 
+// Precompute the source column and 7 bit weights of each destination pixel.
+// Filtering with the table avoids stepping x for every row of a scale.
+// Weights match the SSSE3 blender, so results are the same as FilterCols.
+void ScaleFilterColsSetup_C(int* offsets, uint8* weights,
+                            int dst_width, int x, int dx) {
+  int j;
+  for (j = 0; j < dst_width; ++j) {
+    int xf = (x >> 9) & 0x7f;
+    offsets[j] = x >> 16;
+    weights[0] = (uint8)(0x7f ^ xf);
+    weights[1] = (uint8)(xf);
+    weights += 2;
+    x += dx;
+  }
+}
+
+void ScaleFilterColsTable_C(uint8* dst_ptr, const uint8* src_ptr,
+                            int dst_width, const int* offsets,
+                            const uint8* weights) {
+  int j;
+  for (j = 0; j < dst_width; ++j) {
+    const uint8* src = src_ptr + offsets[j];
+    dst_ptr[j] = (src[0] * weights[0] + src[1] * weights[1]) >> 7;
+    weights += 2;
+  }
+}
+
+void ScaleARGBFilterColsTable_C(uint8* dst_argb, const uint8* src_argb,
+                                int dst_width, const int* offsets,
+                                const uint8* weights) {
+  int j;
+  for (j = 0; j < dst_width; ++j) {
+    const uint8* src = src_argb + offsets[j] * 4;
+    dst_argb[0] = (src[0] * weights[0] + src[4] * weights[1]) >> 7;
+    dst_argb[1] = (src[1] * weights[0] + src[5] * weights[1]) >> 7;
+    dst_argb[2] = (src[2] * weights[0] + src[6] * weights[1]) >> 7;
+    dst_argb[3] = (src[3] * weights[0] + src[7] * weights[1]) >> 7;
+    dst_argb += 4;
+    weights += 2;
+  }
+}
+
+// sRGB encoded 8 bit values to 16 bit linear light, shared by C and AVX2.
+// Entries are 32 bits so AVX2 can gather them.
+const uint32 kSRGBToLinear[256] = {
+  0, 20, 40, 60, 80, 99, 119, 139,
+  159, 179, 199, 219, 241, 264, 288, 313,
+  340, 367, 396, 427, 458, 491, 526, 562,
+  599, 637, 677, 718, 761, 805, 851, 898,
+  947, 997, 1048, 1101, 1156, 1212, 1270, 1330,
+  1391, 1453, 1517, 1583, 1651, 1720, 1790, 1863,
+  1937, 2013, 2090, 2170, 2250, 2333, 2418, 2504,
+  2592, 2681, 2773, 2866, 2961, 3058, 3157, 3258,
+  3360, 3464, 3570, 3678, 3788, 3900, 4014, 4129,
+  4247, 4366, 4488, 4611, 4736, 4864, 4993, 5124,
+  5257, 5392, 5530, 5669, 5810, 5953, 6099, 6246,
+  6395, 6547, 6700, 6856, 7014, 7174, 7335, 7500,
+  7666, 7834, 8004, 8177, 8352, 8528, 8708, 8889,
+  9072, 9258, 9445, 9635, 9828, 10022, 10219, 10417,
+  10619, 10822, 11028, 11235, 11446, 11658, 11873, 12090,
+  12309, 12530, 12754, 12980, 13209, 13440, 13673, 13909,
+  14146, 14387, 14629, 14874, 15122, 15371, 15623, 15878,
+  16135, 16394, 16656, 16920, 17187, 17456, 17727, 18001,
+  18277, 18556, 18837, 19121, 19407, 19696, 19987, 20281,
+  20577, 20876, 21177, 21481, 21787, 22096, 22407, 22721,
+  23038, 23357, 23678, 24002, 24329, 24658, 24990, 25325,
+  25662, 26001, 26344, 26688, 27036, 27386, 27739, 28094,
+  28452, 28813, 29176, 29542, 29911, 30282, 30656, 31033,
+  31412, 31794, 32179, 32567, 32957, 33350, 33745, 34143,
+  34544, 34948, 35355, 35764, 36176, 36591, 37008, 37429,
+  37852, 38278, 38706, 39138, 39572, 40009, 40449, 40891,
+  41337, 41785, 42236, 42690, 43147, 43606, 44069, 44534,
+  45002, 45473, 45947, 46423, 46903, 47385, 47871, 48359,
+  48850, 49344, 49841, 50341, 50844, 51349, 51858, 52369,
+  52884, 53401, 53921, 54445, 54971, 55500, 56032, 56567,
+  57105, 57646, 58190, 58737, 59287, 59840, 60396, 60955,
+  61517, 62082, 62650, 63221, 63795, 64372, 64952, 65535
+};
+
+// Convert a row of sRGB ARGB to 16 bit linear light.
+// Alpha is not gamma encoded and is expanded by 257.
+void ScaleARGBRowToLinear_C(const uint8* src_argb, uint16* dst_argb,
+                            int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst_argb[0] = (uint16)(kSRGBToLinear[src_argb[0]]);
+    dst_argb[1] = (uint16)(kSRGBToLinear[src_argb[1]]);
+    dst_argb[2] = (uint16)(kSRGBToLinear[src_argb[2]]);
+    dst_argb[3] = src_argb[3] * 257;
+    src_argb += 4;
+    dst_argb += 4;
+  }
+}
+
+// Build a 4096 entry table that maps the upper 12 bits of a linear light
+// value to the nearest sRGB value.
+void ScaleARGBLinearTable_C(uint8* table) {
+  int i;
+  int v = 0;
+  for (i = 0; i < 4096; ++i) {
+    int center = i * 16 + 8;
+    while (v < 255 &&
+           center * 2 >= (int)(kSRGBToLinear[v] + kSRGBToLinear[v + 1])) {
+      ++v;
+    }
+    table[i] = (uint8)(v);
+  }
+}
+
+// Convert a row of 16 bit linear light ARGB back to sRGB.
+void ScaleARGBRowFromLinear_C(const uint16* src_argb, uint8* dst_argb,
+                              const uint8* table, int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    int a = src_argb[3];
+    dst_argb[0] = table[src_argb[0] >> 4];
+    dst_argb[1] = table[src_argb[1] >> 4];
+    dst_argb[2] = table[src_argb[2] >> 4];
+    dst_argb[3] = (uint8)((a - (a >> 8) + 128) >> 8);
+    src_argb += 4;
+    dst_argb += 4;
+  }
+}
+
+// Bilinear column filter for 16 bit ARGB.
+void ScaleARGBFilterCols_16_C(uint16* dst_argb, const uint16* src_argb,
+                              int dst_width, int x32, int dx) {
+  int64 x = (int64)(x32);
+  int j;
+  for (j = 0; j < dst_width; ++j) {
+    const uint16* a = src_argb + (x >> 16) * 4;
+    int xf = (int)(x >> 8) & 255;
+    int xf0 = 256 - xf;
+    dst_argb[0] = (a[0] * xf0 + a[4] * xf) >> 8;
+    dst_argb[1] = (a[1] * xf0 + a[5] * xf) >> 8;
+    dst_argb[2] = (a[2] * xf0 + a[6] * xf) >> 8;
+    dst_argb[3] = (a[3] * xf0 + a[7] * xf) >> 8;
+    dst_argb += 4;
+    x += dx;
+  }
+}
+
 // Scale plane vertically with bilinear interpolation.
 void ScalePlaneVertical(int src_height,
                         int dst_width, int dst_height,
@@ -953,7 +1109,7 @@ void ScalePlaneVertical_16(int src_height,
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     InterpolateRow = InterpolateRow_Any_16_SSE2;
-    if (IS_ALIGNED(dst_width_bytes, 16)) {
+    if (IS_ALIGNED(dst_width_words, 8)) {
       InterpolateRow = InterpolateRow_16_SSE2;
     }
   }
@@ -961,7 +1117,7 @@ void ScalePlaneVertical_16(int src_height,
 #if defined(HAS_INTERPOLATEROW_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     InterpolateRow = InterpolateRow_Any_16_SSSE3;
-    if (IS_ALIGNED(dst_width_bytes, 16)) {
+    if (IS_ALIGNED(dst_width_words, 16)) {
       InterpolateRow = InterpolateRow_16_SSSE3;
     }
   }
@@ -969,7 +1125,7 @@ void ScalePlaneVertical_16(int src_height,
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
     InterpolateRow = InterpolateRow_Any_16_AVX2;
-    if (IS_ALIGNED(dst_width_bytes, 32)) {
+    if (IS_ALIGNED(dst_width_words, 16)) {
       InterpolateRow = InterpolateRow_16_AVX2;
     }
   }
@@ -977,7 +1133,7 @@ void ScalePlaneVertical_16(int src_height,
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     InterpolateRow = InterpolateRow_Any_16_NEON;
-    if (IS_ALIGNED(dst_width_bytes, 16)) {
+    if (IS_ALIGNED(dst_width_words, 16)) {
       InterpolateRow = InterpolateRow_16_NEON;
     }
   }
@@ -987,7 +1143,7 @@ void ScalePlaneVertical_16(int src_height,
       IS_ALIGNED(src_argb, 4) && IS_ALIGNED(src_stride, 4) &&
       IS_ALIGNED(dst_argb, 4) && IS_ALIGNED(dst_stride, 4)) {
     InterpolateRow = InterpolateRow_Any_16_MIPS_DSPR2;
-    if (IS_ALIGNED(dst_width_bytes, 4)) {
+    if (IS_ALIGNED(dst_width_words, 4)) {
       InterpolateRow = InterpolateRow_16_MIPS_DSPR2;
     }
   }
@@ -1131,6 +1287,57 @@ void ScaleSlope(int src_width, int src_height,
 }
 #undef CENTERSTART
 
+// Compute slope values for stepping over a sub pixel source rectangle.
+// src_x, src_y, src_width and src_height are 16.16 fixed point and the
+// rectangle must be at least 1 pixel in each dimension.
+// Bilinear steps match ScaleSlope, so that the samples for an integer
+// rectangle are the same as scaling that rectangle of the image, and no
+// sample is beyond the right or bottom edge of the rectangle.
+// Box filtering is treated as bilinear.
+void ScaleSlopeRect(int src_x, int src_y, int src_width, int src_height,
+                    int dst_width, int dst_height,
+                    enum FilterMode filtering,
+                    int* x, int* y, int* dx, int* dy) {
+  assert(x != NULL);
+  assert(y != NULL);
+  assert(dx != NULL);
+  assert(dy != NULL);
+  assert(src_x >= 0);
+  assert(src_y >= 0);
+  assert(src_width >= 65536);
+  assert(src_height >= 65536);
+  assert(dst_width > 0);
+  assert(dst_height > 0);
+  if (filtering == kFilterBox) {
+    filtering = kFilterBilinear;
+  }
+  if (filtering != kFilterNone) {
+    // Scale step for bilinear sampling renders last pixel once for upsample.
+    if (dst_width == 1 || src_width >= dst_width * (int64)65536) {
+      *dx = src_width / dst_width;
+      *x = src_x + (*dx >> 1) - 32768;  // Subtract 0.5 to center filter.
+    } else {
+      *dx = (src_width - 0x00010001) / (dst_width - 1);
+      *x = src_x;
+    }
+  } else {
+    *dx = src_width / dst_width;
+    *x = src_x + (*dx >> 1);
+  }
+  if (filtering == kFilterBilinear) {
+    if (dst_height == 1 || src_height >= dst_height * (int64)65536) {
+      *dy = src_height / dst_height;
+      *y = src_y + (*dy >> 1) - 32768;  // Subtract 0.5 to center filter.
+    } else {
+      *dy = (src_height - 0x00010001) / (dst_height - 1);
+      *y = src_y;
+    }
+  } else {
+    *dy = src_height / dst_height;
+    *y = src_y + (*dy >> 1);
+  }
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
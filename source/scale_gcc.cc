@@ -9,6 +9,7 @@
  */
 
 #include "libyuv/row.h"
+#include "libyuv/scale_row.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -690,6 +691,78 @@ void ScaleFilterCols_SSSE3(uint8* dst_ptr, const uint8* src_ptr,
   );
 }
 
+// Bias for signed pixels in pmaddubsw with unsigned 7 bit weights.
+static uvec8 kFilterColsBias = {
+  128u, 128u, 128u, 128u, 128u, 128u, 128u, 128u,
+  128u, 128u, 128u, 128u, 128u, 128u, 128u, 128u
+};
+
+// Restores the bias removed from the pixels (128 * 127).
+static uvec16 kFilterColsUnbias = {
+  0x3f80, 0x3f80, 0x3f80, 0x3f80, 0x3f80, 0x3f80, 0x3f80, 0x3f80
+};
+
+// Bilinear column filtering with precomputed offsets and weights.
+// Reads 8 source pixel pairs and writes 8 pixels at a time.
+void ScaleFilterColsTable_SSSE3(uint8* dst_ptr, const uint8* src_ptr,
+                                int dst_width, const int* offsets,
+                                const uint8* weights) {
+  intptr_t x0 = 0;
+  asm volatile (
+    "movdqa    %6,%%xmm5                       \n"
+    "movdqa    %7,%%xmm4                       \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "movl      " MEMACCESS(2) ",%k5            \n"
+    MEMOPARG(movzwl,0x00,1,5,1,k5)             //  movzwl  (%1,%5,1),%k5
+    "movd      %k5,%%xmm0                      \n"
+    "movl      " MEMACCESS2(0x4,2) ",%k5       \n"
+    MEMOPARG(movzwl,0x00,1,5,1,k5)             //  movzwl  (%1,%5,1),%k5
+    "pinsrw    $0x1,%k5,%%xmm0                 \n"
+    "movl      " MEMACCESS2(0x8,2) ",%k5       \n"
+    MEMOPARG(movzwl,0x00,1,5,1,k5)             //  movzwl  (%1,%5,1),%k5
+    "pinsrw    $0x2,%k5,%%xmm0                 \n"
+    "movl      " MEMACCESS2(0xc,2) ",%k5       \n"
+    MEMOPARG(movzwl,0x00,1,5,1,k5)             //  movzwl  (%1,%5,1),%k5
+    "pinsrw    $0x3,%k5,%%xmm0                 \n"
+    "movl      " MEMACCESS2(0x10,2) ",%k5      \n"
+    MEMOPARG(movzwl,0x00,1,5,1,k5)             //  movzwl  (%1,%5,1),%k5
+    "pinsrw    $0x4,%k5,%%xmm0                 \n"
+    "movl      " MEMACCESS2(0x14,2) ",%k5      \n"
+    MEMOPARG(movzwl,0x00,1,5,1,k5)             //  movzwl  (%1,%5,1),%k5
+    "pinsrw    $0x5,%k5,%%xmm0                 \n"
+    "movl      " MEMACCESS2(0x18,2) ",%k5      \n"
+    MEMOPARG(movzwl,0x00,1,5,1,k5)             //  movzwl  (%1,%5,1),%k5
+    "pinsrw    $0x6,%k5,%%xmm0                 \n"
+    "movl      " MEMACCESS2(0x1c,2) ",%k5      \n"
+    MEMOPARG(movzwl,0x00,1,5,1,k5)             //  movzwl  (%1,%5,1),%k5
+    "pinsrw    $0x7,%k5,%%xmm0                 \n"
+    "movdqu    " MEMACCESS(3) ",%%xmm1         \n"
+    "pxor      %%xmm5,%%xmm0                   \n"
+    "pmaddubsw %%xmm0,%%xmm1                   \n"
+    "paddw     %%xmm4,%%xmm1                   \n"
+    "psrlw     $0x7,%%xmm1                     \n"
+    "packuswb  %%xmm1,%%xmm1                   \n"
+    "movq      %%xmm1," MEMACCESS(0) "         \n"
+    "lea       " MEMLEA(0x8,0) ",%0            \n"
+    "lea       " MEMLEA(0x20,2) ",%2           \n"
+    "lea       " MEMLEA(0x10,3) ",%3           \n"
+    "sub       $0x8,%4                         \n"
+    "jg        1b                              \n"
+  : "+r"(dst_ptr),     // %0
+    "+r"(src_ptr),     // %1
+    "+r"(offsets),     // %2
+    "+r"(weights),     // %3
+    "+rm"(dst_width),  // %4
+    "+r"(x0)           // %5
+  : "m"(kFilterColsBias),   // %6
+    "m"(kFilterColsUnbias)  // %7
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm4", "xmm5"
+  );
+}
+
 // Reads 4 pixels, duplicates them and writes 8 pixels.
 // Alignment requirement: src_argb 16 byte aligned, dst_argb 16 byte aligned.
 void ScaleColsUp2_SSE2(uint8* dst_ptr, const uint8* src_ptr,
@@ -715,6 +788,390 @@ void ScaleColsUp2_SSE2(uint8* dst_ptr, const uint8* src_ptr,
   );
 }
 
+// Reads 9 pixels of 2 rows and writes 16 pixels.
+void ScaleRowUp2_Bilinear_SSE2(const uint8* src_ptr, ptrdiff_t src_stride,
+                               uint8* dst_ptr, int dst_width) {
+  asm volatile (
+    "pxor      %%xmm5,%%xmm5                   \n"
+    "pcmpeqw   %%xmm4,%%xmm4                   \n"
+    "psrlw     $0xf,%%xmm4                     \n"
+    "psllw     $0x3,%%xmm4                     \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "movq      " MEMACCESS(0) ",%%xmm0         \n"
+    "movq      " MEMACCESS2(0x1,0) ",%%xmm1    \n"
+    MEMOPREG(movq,0x00,0,3,1,xmm2)             //  movq    (%0,%3,1),%%xmm2
+    MEMOPREG(movq,0x01,0,3,1,xmm3)             //  movq    0x1(%0,%3,1),%%xmm3
+    "lea       " MEMLEA(0x8,0) ",%0            \n"
+    "punpcklbw %%xmm5,%%xmm0                   \n"
+    "punpcklbw %%xmm5,%%xmm1                   \n"
+    "punpcklbw %%xmm5,%%xmm2                   \n"
+    "punpcklbw %%xmm5,%%xmm3                   \n"
+    // 3 * near row + far row for each column.
+    "paddw     %%xmm0,%%xmm2                   \n"
+    "paddw     %%xmm1,%%xmm3                   \n"
+    "paddw     %%xmm0,%%xmm0                   \n"
+    "paddw     %%xmm1,%%xmm1                   \n"
+    "paddw     %%xmm2,%%xmm0                   \n"
+    "paddw     %%xmm3,%%xmm1                   \n"
+    // (3 * near column + far column + 8) >> 4 for even and odd pixels.
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "paddw     %%xmm1,%%xmm2                   \n"
+    "paddw     %%xmm4,%%xmm2                   \n"
+    "paddw     %%xmm0,%%xmm0                   \n"
+    "paddw     %%xmm1,%%xmm1                   \n"
+    "paddw     %%xmm2,%%xmm0                   \n"
+    "paddw     %%xmm2,%%xmm1                   \n"
+    "psrlw     $0x4,%%xmm0                     \n"
+    "psrlw     $0x4,%%xmm1                     \n"
+    "packuswb  %%xmm0,%%xmm0                   \n"
+    "packuswb  %%xmm1,%%xmm1                   \n"
+    "punpcklbw %%xmm1,%%xmm0                   \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x10,%2                        \n"
+    "jg        1b                              \n"
+  : "+r"(src_ptr),    // %0
+    "+r"(dst_ptr),    // %1
+    "+r"(dst_width)   // %2
+  : "r"((intptr_t)(src_stride))   // %3
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+}
+
+#ifdef HAS_SCALEROWUP2_BILINEAR_AVX2
+// Reads 17 pixels of 2 rows and writes 32 pixels.  Pixels are widened in
+// order, so each even result is in the low byte and each odd result in the
+// high byte of the same word.
+void ScaleRowUp2_Bilinear_AVX2(const uint8* src_ptr, ptrdiff_t src_stride,
+                               uint8* dst_ptr, int dst_width) {
+  asm volatile (
+    "vpcmpeqw   %%ymm4,%%ymm4,%%ymm4           \n"
+    "vpsrlw     $0xf,%%ymm4,%%ymm4             \n"
+    "vpsllw     $0x3,%%ymm4,%%ymm4             \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "vpmovzxbw  " MEMACCESS(0) ",%%ymm0        \n"
+    "vpmovzxbw  " MEMACCESS2(0x1,0) ",%%ymm1   \n"
+    MEMOPREG(vpmovzxbw,0x00,0,3,1,ymm2)        //  vpmovzxbw (%0,%3,1),%%ymm2
+    MEMOPREG(vpmovzxbw,0x01,0,3,1,ymm3)        //  vpmovzxbw 0x1(%0,%3,1),%%ymm3
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    // 3 * near row + far row for each column.
+    "vpaddw     %%ymm0,%%ymm2,%%ymm2           \n"
+    "vpaddw     %%ymm1,%%ymm3,%%ymm3           \n"
+    "vpaddw     %%ymm0,%%ymm0,%%ymm0           \n"
+    "vpaddw     %%ymm1,%%ymm1,%%ymm1           \n"
+    "vpaddw     %%ymm2,%%ymm0,%%ymm0           \n"
+    "vpaddw     %%ymm3,%%ymm1,%%ymm1           \n"
+    // (3 * near column + far column + 8) >> 4 for even and odd pixels.
+    "vpaddw     %%ymm1,%%ymm0,%%ymm2           \n"
+    "vpaddw     %%ymm4,%%ymm2,%%ymm2           \n"
+    "vpaddw     %%ymm0,%%ymm0,%%ymm0           \n"
+    "vpaddw     %%ymm1,%%ymm1,%%ymm1           \n"
+    "vpaddw     %%ymm2,%%ymm0,%%ymm0           \n"
+    "vpaddw     %%ymm2,%%ymm1,%%ymm1           \n"
+    "vpsrlw     $0x4,%%ymm0,%%ymm0             \n"
+    "vpsrlw     $0x4,%%ymm1,%%ymm1             \n"
+    "vpsllw     $0x8,%%ymm1,%%ymm1             \n"
+    "vpor       %%ymm1,%%ymm0,%%ymm0           \n"
+    "vmovdqu    %%ymm0," MEMACCESS(1) "        \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x20,%2                        \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_ptr),    // %0
+    "+r"(dst_ptr),    // %1
+    "+r"(dst_width)   // %2
+  : "r"((intptr_t)(src_stride))   // %3
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4"
+  );
+}
+#endif  // HAS_SCALEROWUP2_BILINEAR_AVX2
+
+// Reads 16 shorts and writes 8 odd shorts.
+void ScaleRowDown2_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                           uint16* dst_ptr, int dst_width) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "psrad     $0x10,%%xmm0                    \n"
+    "psrad     $0x10,%%xmm1                    \n"
+    "packssdw  %%xmm1,%%xmm0                   \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+  : "+r"(src_ptr),    // %0
+    "+r"(dst_ptr),    // %1
+    "+r"(dst_width)   // %2
+  :: "memory", "cc", "xmm0", "xmm1"
+  );
+}
+
+// Shorts are sign extended with psrad so packssdw does not saturate.
+void ScaleRowDown2Linear_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                                 uint16* dst_ptr, int dst_width) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "psrld     $0x10,%%xmm0                    \n"
+    "movdqa    %%xmm1,%%xmm3                   \n"
+    "psrld     $0x10,%%xmm1                    \n"
+    "pavgw     %%xmm2,%%xmm0                   \n"
+    "pavgw     %%xmm3,%%xmm1                   \n"
+    "pslld     $0x10,%%xmm0                    \n"
+    "pslld     $0x10,%%xmm1                    \n"
+    "psrad     $0x10,%%xmm0                    \n"
+    "psrad     $0x10,%%xmm1                    \n"
+    "packssdw  %%xmm1,%%xmm0                   \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+  : "+r"(src_ptr),    // %0
+    "+r"(dst_ptr),    // %1
+    "+r"(dst_width)   // %2
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3"
+  );
+}
+
+// Sums 2x2 shorts as 32 bit values so the result is exact.
+void ScaleRowDown2Box_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                              uint16* dst_ptr, int dst_width) {
+  asm volatile (
+    "pcmpeqb   %%xmm5,%%xmm5                   \n"
+    "psrld     $0x1f,%%xmm5                    \n"
+    "pslld     $0x1,%%xmm5                     \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    MEMOPREG(movdqu,0x00,0,3,2,xmm2)           //  movdqu  (%0,%3,2),%%xmm2
+    MEMOPREG(movdqu,0x10,0,3,2,xmm3)           //  movdqu  0x10(%0,%3,2),%%xmm3
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "movdqa    %%xmm0,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm0                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm0                   \n"
+    "movdqa    %%xmm1,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm1                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm1                   \n"
+    "movdqa    %%xmm2,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm2                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm2                   \n"
+    "movdqa    %%xmm3,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm3                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm3                   \n"
+    "paddd     %%xmm2,%%xmm0                   \n"
+    "paddd     %%xmm3,%%xmm1                   \n"
+    "paddd     %%xmm5,%%xmm0                   \n"
+    "paddd     %%xmm5,%%xmm1                   \n"
+    "pslld     $0xe,%%xmm0                     \n"
+    "pslld     $0xe,%%xmm1                     \n"
+    "psrad     $0x10,%%xmm0                    \n"
+    "psrad     $0x10,%%xmm1                    \n"
+    "packssdw  %%xmm1,%%xmm0                   \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+  : "+r"(src_ptr),    // %0
+    "+r"(dst_ptr),    // %1
+    "+r"(dst_width)   // %2
+  : "r"((intptr_t)(src_stride))   // %3
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+}
+
+// Reads 32 shorts and writes every 4th short, starting at short 2.
+void ScaleRowDown4_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                           uint16* dst_ptr, int dst_width) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "movdqu    " MEMACCESS2(0x20,0) ",%%xmm2   \n"
+    "movdqu    " MEMACCESS2(0x30,0) ",%%xmm3   \n"
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "shufps    $0xdd,%%xmm1,%%xmm0             \n"
+    "shufps    $0xdd,%%xmm3,%%xmm2             \n"
+    "pslld     $0x10,%%xmm0                    \n"
+    "pslld     $0x10,%%xmm2                    \n"
+    "psrad     $0x10,%%xmm0                    \n"
+    "psrad     $0x10,%%xmm2                    \n"
+    "packssdw  %%xmm2,%%xmm0                   \n"
+    "movdqu    %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x10,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+  : "+r"(src_ptr),    // %0
+    "+r"(dst_ptr),    // %1
+    "+r"(dst_width)   // %2
+  :: "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3"
+  );
+}
+
+// Sums 4x4 shorts as 32 bit values and writes 4 shorts at a time.
+void ScaleRowDown4Box_16_SSE2(const uint16* src_ptr, ptrdiff_t src_stride,
+                              uint16* dst_ptr, int dst_width) {
+  intptr_t stridex3 = 0;
+  asm volatile (
+    "pcmpeqb   %%xmm5,%%xmm5                   \n"
+    "psrld     $0x1f,%%xmm5                    \n"
+    "pslld     $0x3,%%xmm5                     \n"
+    "lea       " MEMLEA4(0x00,4,4,2) ",%3      \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS2(0x10,0) ",%%xmm1   \n"
+    "movdqa    %%xmm0,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm0                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm0                   \n"
+    "movdqa    %%xmm1,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm1                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm1                   \n"
+    MEMOPREG(movdqu,0x00,0,4,2,xmm2)           //  movdqu  (%0,%4,2),%%xmm2
+    MEMOPREG(movdqu,0x10,0,4,2,xmm3)           //  movdqu  0x10(%0,%4,2),%%xmm3
+    "movdqa    %%xmm2,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm2                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm2                   \n"
+    "movdqa    %%xmm3,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm3                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm3                   \n"
+    "paddd     %%xmm2,%%xmm0                   \n"
+    "paddd     %%xmm3,%%xmm1                   \n"
+    MEMOPREG(movdqu,0x00,0,4,4,xmm2)           //  movdqu  (%0,%4,4),%%xmm2
+    MEMOPREG(movdqu,0x10,0,4,4,xmm3)           //  movdqu  0x10(%0,%4,4),%%xmm3
+    "movdqa    %%xmm2,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm2                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm2                   \n"
+    "movdqa    %%xmm3,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm3                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm3                   \n"
+    "paddd     %%xmm2,%%xmm0                   \n"
+    "paddd     %%xmm3,%%xmm1                   \n"
+    MEMOPREG(movdqu,0x00,0,3,2,xmm2)           //  movdqu  (%0,%3,2),%%xmm2
+    MEMOPREG(movdqu,0x10,0,3,2,xmm3)           //  movdqu  0x10(%0,%3,2),%%xmm3
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "movdqa    %%xmm2,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm2                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm2                   \n"
+    "movdqa    %%xmm3,%%xmm4                   \n"
+    "psrld     $0x10,%%xmm3                    \n"
+    "pslld     $0x10,%%xmm4                    \n"
+    "psrld     $0x10,%%xmm4                    \n"
+    "paddd     %%xmm4,%%xmm3                   \n"
+    "paddd     %%xmm2,%%xmm0                   \n"
+    "paddd     %%xmm3,%%xmm1                   \n"
+    "movdqa    %%xmm0,%%xmm2                   \n"
+    "shufps    $0x88,%%xmm1,%%xmm0             \n"
+    "shufps    $0xdd,%%xmm1,%%xmm2             \n"
+    "paddd     %%xmm2,%%xmm0                   \n"
+    "paddd     %%xmm5,%%xmm0                   \n"
+    "pslld     $0xc,%%xmm0                     \n"
+    "psrad     $0x10,%%xmm0                    \n"
+    "packssdw  %%xmm0,%%xmm0                   \n"
+    "movq      %%xmm0," MEMACCESS(1) "         \n"
+    "lea       " MEMLEA(0x8,1) ",%1            \n"
+    "sub       $0x4,%2                         \n"
+    "jg        1b                              \n"
+  : "+r"(src_ptr),    // %0
+    "+r"(dst_ptr),    // %1
+    "+r"(dst_width),  // %2
+    "+r"(stridex3)    // %3
+  : "r"((intptr_t)(src_stride))   // %4
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+}
+
+// Reads 8 shorts and accumulates them into 8 ints.
+void ScaleAddRow_16_SSE2(const uint16* src_ptr, uint32* dst_ptr,
+                         int src_width) {
+  asm volatile (
+    "pxor      %%xmm5,%%xmm5                   \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "movdqu    " MEMACCESS(0) ",%%xmm0         \n"
+    "movdqu    " MEMACCESS(1) ",%%xmm2         \n"
+    "movdqu    " MEMACCESS2(0x10,1) ",%%xmm3   \n"
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "movdqa    %%xmm0,%%xmm1                   \n"
+    "punpcklwd %%xmm5,%%xmm0                   \n"
+    "punpckhwd %%xmm5,%%xmm1                   \n"
+    "paddd     %%xmm0,%%xmm2                   \n"
+    "paddd     %%xmm1,%%xmm3                   \n"
+    "movdqu    %%xmm2," MEMACCESS(1) "         \n"
+    "movdqu    %%xmm3," MEMACCESS2(0x10,1) "   \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+  : "+r"(src_ptr),     // %0
+    "+r"(dst_ptr),     // %1
+    "+r"(src_width)    // %2
+  :
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5"
+  );
+}
+
+// Reads 4 shorts, duplicates them and writes 8 shorts.
+void ScaleColsUp2_16_SSE2(uint16* dst_ptr, const uint16* src_ptr,
+                          int dst_width, int x, int dx) {
+  asm volatile (
+    LABELALIGN
+  "1:                                          \n"
+    "movq      " MEMACCESS(1) ",%%xmm0         \n"
+    "lea       " MEMLEA(0x8,1) ",%1            \n"
+    "punpcklwd %%xmm0,%%xmm0                   \n"
+    "movdqu    %%xmm0," MEMACCESS(0) "         \n"
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+
+  : "+r"(dst_ptr),     // %0
+    "+r"(src_ptr),     // %1
+    "+r"(dst_width)    // %2
+  :: "memory", "cc", "xmm0"
+  );
+}
+
 void ScaleARGBRowDown2_SSE2(const uint8* src_argb,
                             ptrdiff_t src_stride,
                             uint8* dst_argb, int dst_width) {
@@ -1048,6 +1505,302 @@ void ScaleARGBFilterCols_SSSE3(uint8* dst_argb, const uint8* src_argb,
   );
 }
 
+// Bilinear column filter for 16 bit ARGB, 1 pixel at a time.
+// Pixels are biased by 0x8000 so pmaddwd can multiply them as signed words,
+// which gives the same result as the C version.
+void ScaleARGBFilterCols_16_SSE2(uint16* dst_argb, const uint16* src_argb,
+                                 int dst_width, int x, int dx) {
+  intptr_t x0 = 0;
+  asm volatile (
+    "pcmpeqb   %%xmm6,%%xmm6                   \n"
+    "psllw     $0xf,%%xmm6                     \n"
+    "pcmpeqb   %%xmm5,%%xmm5                   \n"
+    "psrlw     $0xf,%%xmm5                     \n"
+    "psllw     $0x8,%%xmm5                     \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "mov       %k4,%k3                         \n"
+    "shr       $0x10,%k3                       \n"
+    MEMOPREG(movdqu,0x00,1,3,8,xmm0)           //  movdqu    (%1,%3,8),%%xmm0
+    "movd      %k4,%%xmm1                      \n"
+    "psrld     $0x8,%%xmm1                     \n"
+    "pshuflw   $0x0,%%xmm1,%%xmm1              \n"
+    "psllw     $0x8,%%xmm1                     \n"
+    "psrlw     $0x8,%%xmm1                     \n"
+    "movdqa    %%xmm5,%%xmm2                   \n"
+    "psubw     %%xmm1,%%xmm2                   \n"
+    "punpcklwd %%xmm1,%%xmm2                   \n"
+    "pxor      %%xmm6,%%xmm0                   \n"
+    "pshufd    $0xee,%%xmm0,%%xmm1             \n"
+    "punpcklwd %%xmm1,%%xmm0                   \n"
+    "pmaddwd   %%xmm2,%%xmm0                   \n"
+    "psrad     $0x8,%%xmm0                     \n"
+    "packssdw  %%xmm0,%%xmm0                   \n"
+    "pxor      %%xmm6,%%xmm0                   \n"
+    "movq      %%xmm0," MEMACCESS(0) "         \n"
+    "lea       " MEMLEA(0x8,0) ",%0            \n"
+    "add       %5,%4                           \n"
+    "sub       $0x1,%2                         \n"
+    "jg        1b                              \n"
+  : "+r"(dst_argb),    // %0
+    "+r"(src_argb),    // %1
+    "+rm"(dst_width),  // %2
+    "+r"(x0),          // %3
+    "+r"(x)            // %4
+  : "rm"(dx)           // %5
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm5", "xmm6"
+  );
+}
+
+// Shuffle weight pairs of 2 pixels to the 4 channels of each pixel.
+static uvec8 kShuffleWeightsARGB = {
+  0u, 1u, 0u, 1u, 0u, 1u, 0u, 1u, 2u, 3u, 2u, 3u, 2u, 3u, 2u, 3u
+};
+
+// Bilinear ARGB column filtering with precomputed offsets and weights.
+// Reads 4 source pixel pairs and writes 4 pixels at a time.
+void ScaleARGBFilterColsTable_SSSE3(uint8* dst_argb, const uint8* src_argb,
+                                    int dst_width, const int* offsets,
+                                    const uint8* weights) {
+  intptr_t x0 = 0;
+  asm volatile (
+    "movdqa    %6,%%xmm4                       \n"
+    "movdqa    %7,%%xmm5                       \n"
+    "movdqa    %8,%%xmm6                       \n"
+    "movdqa    %9,%%xmm7                       \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "movl      " MEMACCESS(2) ",%k5            \n"
+    MEMOPREG(movq,0x00,1,5,4,xmm0)             //  movq      (%1,%5,4),%%xmm0
+    "movl      " MEMACCESS2(0x4,2) ",%k5       \n"
+    MEMOPREG(movhps,0x00,1,5,4,xmm0)           //  movhps    (%1,%5,4),%%xmm0
+    "movl      " MEMACCESS2(0x8,2) ",%k5       \n"
+    MEMOPREG(movq,0x00,1,5,4,xmm1)             //  movq      (%1,%5,4),%%xmm1
+    "movl      " MEMACCESS2(0xc,2) ",%k5       \n"
+    MEMOPREG(movhps,0x00,1,5,4,xmm1)           //  movhps    (%1,%5,4),%%xmm1
+    "pshufb    %%xmm4,%%xmm0                   \n"
+    "pshufb    %%xmm4,%%xmm1                   \n"
+    "pxor      %%xmm5,%%xmm0                   \n"
+    "pxor      %%xmm5,%%xmm1                   \n"
+    "movq      " MEMACCESS(3) ",%%xmm2         \n"
+    "movdqa    %%xmm2,%%xmm3                   \n"
+    "psrldq    $0x4,%%xmm3                     \n"
+    "pshufb    %%xmm6,%%xmm2                   \n"
+    "pshufb    %%xmm6,%%xmm3                   \n"
+    "pmaddubsw %%xmm0,%%xmm2                   \n"
+    "pmaddubsw %%xmm1,%%xmm3                   \n"
+    "paddw     %%xmm7,%%xmm2                   \n"
+    "paddw     %%xmm7,%%xmm3                   \n"
+    "psrlw     $0x7,%%xmm2                     \n"
+    "psrlw     $0x7,%%xmm3                     \n"
+    "packuswb  %%xmm3,%%xmm2                   \n"
+    "movdqu    %%xmm2," MEMACCESS(0) "         \n"
+    "lea       " MEMLEA(0x10,0) ",%0           \n"
+    "lea       " MEMLEA(0x10,2) ",%2           \n"
+    "lea       " MEMLEA(0x8,3) ",%3            \n"
+    "sub       $0x4,%4                         \n"
+    "jg        1b                              \n"
+  : "+r"(dst_argb),    // %0
+    "+r"(src_argb),    // %1
+    "+r"(offsets),     // %2
+    "+r"(weights),     // %3
+    "+rm"(dst_width),  // %4
+    "+r"(x0)           // %5
+  : "m"(kShuffleColARGB),      // %6
+    "m"(kFilterColsBias),      // %7
+    "m"(kShuffleWeightsARGB),  // %8
+    "m"(kFilterColsUnbias)     // %9
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+
+#ifdef HAS_SCALEARGBFILTERCOLSTABLE_AVX2
+// Shuffle weight pairs of pixels 0, 1, 4 and 5 to the 4 channels.
+static ulvec8 kShuffleWeightsARGBLo_AVX2 = {
+  0u, 1u, 0u, 1u, 0u, 1u, 0u, 1u, 2u, 3u, 2u, 3u, 2u, 3u, 2u, 3u,
+  8u, 9u, 8u, 9u, 8u, 9u, 8u, 9u,
+  10u, 11u, 10u, 11u, 10u, 11u, 10u, 11u
+};
+
+// Shuffle weight pairs of pixels 2, 3, 6 and 7 to the 4 channels.
+static ulvec8 kShuffleWeightsARGBHi_AVX2 = {
+  4u, 5u, 4u, 5u, 4u, 5u, 4u, 5u, 6u, 7u, 6u, 7u, 6u, 7u, 6u, 7u,
+  12u, 13u, 12u, 13u, 12u, 13u, 12u, 13u,
+  14u, 15u, 14u, 15u, 14u, 15u, 14u, 15u
+};
+
+// Bilinear ARGB column filtering with precomputed offsets and weights.
+// Gathers 8 left and 8 right source pixels and writes 8 pixels at a time.
+void ScaleARGBFilterColsTable_AVX2(uint8* dst_argb, const uint8* src_argb,
+                                   int dst_width, const int* offsets,
+                                   const uint8* weights) {
+  asm volatile (
+    "vbroadcastf128 %5,%%ymm4                  \n"
+    "vbroadcastf128 %6,%%ymm5                  \n"
+    "vmovdqu    %7,%%ymm6                      \n"
+    "vmovdqu    %8,%%ymm7                      \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu    " MEMACCESS(2) ",%%ymm0        \n"
+    "vpcmpeqd   %%ymm3,%%ymm3,%%ymm3           \n"
+    "vpgatherdd %%ymm3,(%1,%%ymm0,4),%%ymm1    \n"
+    "vpcmpeqd   %%ymm3,%%ymm3,%%ymm3           \n"
+    "vpgatherdd %%ymm3,0x4(%1,%%ymm0,4),%%ymm2 \n"
+    "vpunpcklbw %%ymm2,%%ymm1,%%ymm0           \n"
+    "vpunpckhbw %%ymm2,%%ymm1,%%ymm1           \n"
+    "vpxor      %%ymm4,%%ymm0,%%ymm0           \n"
+    "vpxor      %%ymm4,%%ymm1,%%ymm1           \n"
+    "vbroadcastf128 " MEMACCESS(3) ",%%ymm2    \n"
+    "vpshufb    %%ymm6,%%ymm2,%%ymm3           \n"
+    "vpshufb    %%ymm7,%%ymm2,%%ymm2           \n"
+    "vpmaddubsw %%ymm0,%%ymm3,%%ymm3           \n"
+    "vpmaddubsw %%ymm1,%%ymm2,%%ymm2           \n"
+    "vpaddw     %%ymm5,%%ymm3,%%ymm3           \n"
+    "vpaddw     %%ymm5,%%ymm2,%%ymm2           \n"
+    "vpsrlw     $0x7,%%ymm3,%%ymm3             \n"
+    "vpsrlw     $0x7,%%ymm2,%%ymm2             \n"
+    "vpackuswb  %%ymm2,%%ymm3,%%ymm3           \n"
+    "vmovdqu    %%ymm3," MEMACCESS(0) "        \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "lea       " MEMLEA(0x20,2) ",%2           \n"
+    "lea       " MEMLEA(0x10,3) ",%3           \n"
+    "sub       $0x8,%4                         \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(dst_argb),    // %0
+    "+r"(src_argb),    // %1
+    "+r"(offsets),     // %2
+    "+r"(weights),     // %3
+    "+rm"(dst_width)   // %4
+  : "m"(kFilterColsBias),              // %5
+    "m"(kFilterColsUnbias),            // %6
+    "m"(kShuffleWeightsARGBLo_AVX2),   // %7
+    "m"(kShuffleWeightsARGBHi_AVX2)    // %8
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_SCALEARGBFILTERCOLSTABLE_AVX2
+
+#ifdef HAS_SCALEARGBROWTOLINEAR_AVX2
+// Converts 8 pixels at a time.  Blue, green and red are gathered from
+// kSRGBToLinear and alpha is expanded by 257 with shifts.  Each pixel is built
+// as 2 dwords, blue and green then red and alpha, which unpack to 4 words.
+void ScaleARGBRowToLinear_AVX2(const uint8* src_argb, uint16* dst_argb,
+                               int width) {
+  asm volatile (
+    "vpcmpeqb   %%ymm7,%%ymm7,%%ymm7           \n"
+    "vpslld     $0x18,%%ymm7,%%ymm6            \n"
+    "vpsrld     $0x18,%%ymm7,%%ymm7            \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu    " MEMACCESS(0) ",%%ymm0        \n"
+    "lea       " MEMLEA(0x20,0) ",%0           \n"
+    "vpand      %%ymm7,%%ymm0,%%ymm1           \n"
+    "vpcmpeqd   %%ymm5,%%ymm5,%%ymm5           \n"
+    "vpgatherdd %%ymm5,(%3,%%ymm1,4),%%ymm2    \n"
+    "vpsrld     $0x8,%%ymm0,%%ymm1             \n"
+    "vpand      %%ymm7,%%ymm1,%%ymm1           \n"
+    "vpcmpeqd   %%ymm5,%%ymm5,%%ymm5           \n"
+    "vpgatherdd %%ymm5,(%3,%%ymm1,4),%%ymm3    \n"
+    "vpsrld     $0x10,%%ymm0,%%ymm1            \n"
+    "vpand      %%ymm7,%%ymm1,%%ymm1           \n"
+    "vpcmpeqd   %%ymm5,%%ymm5,%%ymm5           \n"
+    "vpgatherdd %%ymm5,(%3,%%ymm1,4),%%ymm4    \n"
+    "vpand      %%ymm6,%%ymm0,%%ymm0           \n"  // A << 24
+    "vpsrld     $0x8,%%ymm0,%%ymm1             \n"
+    "vpor       %%ymm1,%%ymm0,%%ymm0           \n"  // A * 257 << 16
+    "vpor       %%ymm4,%%ymm0,%%ymm0           \n"
+    "vpslld     $0x10,%%ymm3,%%ymm3            \n"
+    "vpor       %%ymm3,%%ymm2,%%ymm2           \n"
+    "vpunpckldq %%ymm0,%%ymm2,%%ymm1           \n"  // Pixels 0, 1, 4, 5
+    "vpunpckhdq %%ymm0,%%ymm2,%%ymm2           \n"  // Pixels 2, 3, 6, 7
+    "vperm2i128 $0x20,%%ymm2,%%ymm1,%%ymm0     \n"
+    "vperm2i128 $0x31,%%ymm2,%%ymm1,%%ymm1     \n"
+    "vmovdqu    %%ymm0," MEMACCESS(1) "        \n"
+    "vmovdqu    %%ymm1," MEMACCESS2(0x20,1) "  \n"
+    "lea       " MEMLEA(0x40,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_argb),    // %0
+    "+r"(dst_argb),    // %1
+    "+r"(width)        // %2
+  : "r"(kSRGBToLinear)  // %3
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_SCALEARGBROWTOLINEAR_AVX2
+
+#ifdef HAS_SCALEARGBROWFROMLINEAR_AVX2
+// Converts 8 pixels at a time.  vshufps splits the blue and green dwords from
+// the red and alpha dwords in the pixel order 0, 1, 4, 5, 2, 3, 6, 7, and
+// vpermq restores the order at the end.  Blue, green and red are gathered as
+// dwords from the byte table and masked to their low byte.
+void ScaleARGBRowFromLinear_AVX2(const uint16* src_argb, uint8* dst_argb,
+                                 const uint8* table, int width) {
+  asm volatile (
+    "vpcmpeqb   %%ymm7,%%ymm7,%%ymm7           \n"
+    "vpsrld     $0x1f,%%ymm7,%%ymm6            \n"
+    "vpslld     $0x7,%%ymm6,%%ymm6             \n"  // 128 for rounding.
+    "vpsrld     $0x18,%%ymm7,%%ymm7            \n"
+
+    LABELALIGN
+  "1:                                          \n"
+    "vmovdqu    " MEMACCESS(0) ",%%ymm0        \n"
+    "vmovdqu    " MEMACCESS2(0x20,0) ",%%ymm1  \n"
+    "lea       " MEMLEA(0x40,0) ",%0           \n"
+    "vshufps    $0x88,%%ymm1,%%ymm0,%%ymm2     \n"  // B | G << 16
+    "vshufps    $0xdd,%%ymm1,%%ymm0,%%ymm3     \n"  // R | A << 16
+    "vpslld     $0x10,%%ymm2,%%ymm1            \n"
+    "vpsrld     $0x14,%%ymm1,%%ymm1            \n"
+    "vpcmpeqd   %%ymm5,%%ymm5,%%ymm5           \n"
+    "vpgatherdd %%ymm5,(%3,%%ymm1,1),%%ymm0    \n"
+    "vpsrld     $0x14,%%ymm2,%%ymm1            \n"
+    "vpcmpeqd   %%ymm5,%%ymm5,%%ymm5           \n"
+    "vpgatherdd %%ymm5,(%3,%%ymm1,1),%%ymm2    \n"
+    "vpslld     $0x10,%%ymm3,%%ymm1            \n"
+    "vpsrld     $0x14,%%ymm1,%%ymm1            \n"
+    "vpcmpeqd   %%ymm5,%%ymm5,%%ymm5           \n"
+    "vpgatherdd %%ymm5,(%3,%%ymm1,1),%%ymm4    \n"
+    // Alpha is (a - (a >> 8) + 128) >> 8.
+    "vpsrld     $0x10,%%ymm3,%%ymm3            \n"
+    "vpsrld     $0x8,%%ymm3,%%ymm1             \n"
+    "vpsubd     %%ymm1,%%ymm3,%%ymm3           \n"
+    "vpaddd     %%ymm6,%%ymm3,%%ymm3           \n"
+    "vpsrld     $0x8,%%ymm3,%%ymm3             \n"
+    "vpslld     $0x18,%%ymm3,%%ymm3            \n"
+    "vpand      %%ymm7,%%ymm0,%%ymm0           \n"
+    "vpand      %%ymm7,%%ymm2,%%ymm2           \n"
+    "vpand      %%ymm7,%%ymm4,%%ymm4           \n"
+    "vpslld     $0x8,%%ymm2,%%ymm2             \n"
+    "vpslld     $0x10,%%ymm4,%%ymm4            \n"
+    "vpor       %%ymm2,%%ymm0,%%ymm0           \n"
+    "vpor       %%ymm4,%%ymm3,%%ymm3           \n"
+    "vpor       %%ymm3,%%ymm0,%%ymm0           \n"
+    "vpermq     $0xd8,%%ymm0,%%ymm0            \n"
+    "vmovdqu    %%ymm0," MEMACCESS(1) "        \n"
+    "lea       " MEMLEA(0x20,1) ",%1           \n"
+    "sub       $0x8,%2                         \n"
+    "jg        1b                              \n"
+    "vzeroupper                                \n"
+  : "+r"(src_argb),    // %0
+    "+r"(dst_argb),    // %1
+    "+r"(width)        // %2
+  : "r"(table)         // %3
+  : "memory", "cc", NACL_R14
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7"
+  );
+}
+#endif  // HAS_SCALEARGBROWFROMLINEAR_AVX2
+
 // Divide num by div and return as 16.16 fixed point result.
 int FixedDiv_X86(int num, int div) {
   asm volatile (
@@ -0,0 +1,149 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/scratch.h"
+
+#include <stdlib.h>  // For malloc.
+
+#include "libyuv/row.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Scratch buffers are freed in roughly the reverse order they are allocated
+// and few are live at once, so the arena is a stack with a small table of
+// live allocations.  Allocations beyond the table go to malloc with their
+// size in a header, so they are still counted in the peak.
+static const int kMaxScratchAllocs = 16;
+static const size_t kScratchHeaderSize = 64;  // Keeps malloc alignment.
+
+struct ScratchRecord {
+  uint8* ptr;  // NULL once freed.
+  size_t size;
+  int from_arena;
+};
+
+static LIBYUV_THREAD_LOCAL uint8* scratch_buffer = NULL;
+static LIBYUV_THREAD_LOCAL size_t scratch_size = 0;
+static LIBYUV_THREAD_LOCAL size_t scratch_used = 0;
+static LIBYUV_THREAD_LOCAL size_t scratch_in_use = 0;
+static LIBYUV_THREAD_LOCAL size_t scratch_peak = 0;
+static LIBYUV_THREAD_LOCAL int scratch_num_records = 0;
+static LIBYUV_THREAD_LOCAL struct ScratchRecord
+    scratch_records[kMaxScratchAllocs];
+
+LIBYUV_API
+void SetScratchArena(uint8* buffer, size_t size) {
+  scratch_buffer = buffer;
+  scratch_size = buffer ? size : 0;
+  scratch_used = 0;
+  scratch_in_use = 0;
+  scratch_peak = 0;
+  scratch_num_records = 0;
+}
+
+LIBYUV_API
+size_t GetScratchArenaPeak(void) {
+  return scratch_peak;
+}
+
+LIBYUV_BOOL HasScratchArena(void) {
+  return scratch_buffer ? LIBYUV_TRUE : LIBYUV_FALSE;
+}
+
+static void AddScratchInUse(size_t size) {
+  scratch_in_use += size;
+  if (scratch_in_use > scratch_peak) {
+    scratch_peak = scratch_in_use;
+  }
+}
+
+LIBYUV_API
+void* ScratchAlloc(size_t size) {
+  struct ScratchRecord* record;
+  if (!scratch_buffer) {
+    return malloc(size);
+  }
+  if (scratch_num_records == kMaxScratchAllocs) {
+    uint8* mem = (uint8*)(malloc(size + kScratchHeaderSize));
+    if (!mem) {
+      return NULL;
+    }
+    *(size_t*)(mem) = size;
+    AddScratchInUse(size);
+    return mem + kScratchHeaderSize;
+  }
+  size = (size + 63) & ~63;
+  record = &scratch_records[scratch_num_records];
+  if (size <= scratch_size - scratch_used) {
+    record->ptr = scratch_buffer + scratch_used;
+    record->from_arena = 1;
+    scratch_used += size;
+  } else {
+    record->ptr = (uint8*)(malloc(size));
+    record->from_arena = 0;
+    if (!record->ptr) {
+      return NULL;
+    }
+  }
+  record->size = size;
+  ++scratch_num_records;
+  AddScratchInUse(size);
+  return record->ptr;
+}
+
+LIBYUV_API
+void ScratchFree(void* ptr) {
+  int i;
+  if (!ptr) {
+    return;
+  }
+  for (i = scratch_num_records - 1; i >= 0; --i) {
+    if (scratch_records[i].ptr == ptr) {
+      break;
+    }
+  }
+  if (i < 0) {
+    if (scratch_buffer) {
+      // Allocated while the table was full.
+      uint8* mem = (uint8*)(ptr) - kScratchHeaderSize;
+      scratch_in_use -= *(size_t*)(mem);
+      free(mem);
+    } else {
+      free(ptr);  // Allocated without an arena.
+    }
+    return;
+  }
+  if (!scratch_records[i].from_arena) {
+    free(ptr);
+  }
+  scratch_in_use -= scratch_records[i].size;
+  scratch_records[i].ptr = NULL;
+  // Pop freed records and give their arena space back.
+  while (scratch_num_records > 0 &&
+         !scratch_records[scratch_num_records - 1].ptr) {
+    --scratch_num_records;
+  }
+  scratch_used = 0;
+  for (i = scratch_num_records - 1; i >= 0; --i) {
+    if (scratch_records[i].from_arena && scratch_records[i].ptr) {
+      scratch_used = scratch_records[i].ptr - scratch_buffer +
+          scratch_records[i].size;
+      break;
+    }
+  }
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -0,0 +1,170 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+
+#include "libyuv/autotune.h"
+#include "libyuv/basic_types.h"
+#include "libyuv/convert_from.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/rotate.h"
+#include "libyuv/row.h"
+#include "../unit_test/unit_test.h"
+
+namespace libyuv {
+
+// Path of a table file in the temp directory, not the current directory.
+static std::string AutotuneTempFile() {
+  const char* dir = getenv("TMPDIR");
+  if (!dir || !*dir) {
+    dir = getenv("TEMP");
+  }
+  if (!dir || !*dir) {
+#if defined(_WIN32)
+    dir = ".";
+#else
+    dir = "/tmp";
+#endif
+  }
+  return std::string(dir) + "/libyuv_autotune_test.txt";
+}
+
+// Tuned functions give the same results as untuned ones.
+TEST_F(libyuvTest, TestAutotuneCopyPlane) {
+  const int kWidth = 1280;
+  const int kHeight = 4;
+  align_buffer_64(src, kWidth * kHeight);
+  align_buffer_64(dst, kWidth * kHeight);
+  MemRandomize(src, kWidth * kHeight);
+  memset(dst, 0, kWidth * kHeight);
+
+  MaskCpuFlags(-1);
+  ResetAutotuneTable();
+  SetAutotuneEnabled(1);
+  CopyPlane(src, kWidth, dst, kWidth, kWidth - 3, kHeight);
+  SetAutotuneEnabled(0);
+  for (int y = 0; y < kHeight; ++y) {
+    EXPECT_EQ(0, memcmp(src + y * kWidth, dst + y * kWidth, kWidth - 3));
+    EXPECT_EQ(0, dst[y * kWidth + kWidth - 1]);
+  }
+#if defined(HAS_COPYROW_SSE2) && defined(HAS_COPYROW_AVX) && \
+    defined(HAS_COPYROW_ERMS)
+  if (TestCpuFlag(kCpuHasAVX) || TestCpuFlag(kCpuHasERMS)) {
+    int choice = GetAutotuneChoice(kAutotuneCopyRow, kWidth);
+    EXPECT_GE(choice, 0);
+    EXPECT_LE(choice, 2);
+  }
+#endif
+  // Other widths are tuned separately.
+  EXPECT_EQ(-1, GetAutotuneChoice(kAutotuneCopyRow, 64));
+  ResetAutotuneTable();
+  EXPECT_EQ(-1, GetAutotuneChoice(kAutotuneCopyRow, kWidth));
+
+  free_aligned_buffer_64(src);
+  free_aligned_buffer_64(dst);
+}
+
+TEST_F(libyuvTest, TestAutotuneI420ToARGB) {
+  const int kWidth = 1920;
+  const int kHeight = 2;
+  const int kHalfWidth = kWidth / 2;
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kHalfWidth);
+  align_buffer_64(src_v, kHalfWidth);
+  align_buffer_64(dst_argb_c, kWidth * kHeight * 4);
+  align_buffer_64(dst_argb_opt, kWidth * kHeight * 4);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_u, kHalfWidth);
+  MemRandomize(src_v, kHalfWidth);
+
+  MaskCpuFlags(-1);
+  I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+             dst_argb_c, kWidth * 4, kWidth, kHeight);
+  ResetAutotuneTable();
+  SetAutotuneEnabled(1);
+  I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+             dst_argb_opt, kWidth * 4, kWidth, kHeight);
+  SetAutotuneEnabled(0);
+  // SSSE3 and AVX2 round the same.
+  EXPECT_EQ(0, memcmp(dst_argb_c, dst_argb_opt, kWidth * kHeight * 4));
+#if defined(HAS_I422TOARGBROW_SSSE3) && defined(HAS_I422TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    EXPECT_GE(GetAutotuneChoice(kAutotuneI422ToARGBRow, kWidth), 0);
+  }
+#endif
+  ResetAutotuneTable();
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_argb_c);
+  free_aligned_buffer_64(dst_argb_opt);
+}
+
+TEST_F(libyuvTest, TestAutotuneSaveLoad) {
+  const int kWidth = 640;
+  const int kTransposeWidth = 16;
+  const int kTransposeHeight = 8;
+  const std::string file = AutotuneTempFile();
+  const char* autotune_file = file.c_str();
+  align_buffer_64(plane, kWidth * 2);
+  align_buffer_64(transpose_src, kTransposeWidth * kTransposeHeight);
+  align_buffer_64(transpose_dst, kTransposeWidth * kTransposeHeight);
+  memset(plane, 0, kWidth * 2);
+  MemRandomize(transpose_src, kTransposeWidth * kTransposeHeight);
+
+  MaskCpuFlags(-1);
+  ResetAutotuneTable();
+  SetAutotuneEnabled(1);
+  SetPlane(plane, kWidth, kWidth, 2, 7);
+  TransposePlane(transpose_src, kTransposeWidth,
+                 transpose_dst, kTransposeHeight,
+                 kTransposeWidth, kTransposeHeight);
+  SetAutotuneEnabled(0);
+  EXPECT_EQ(7, plane[kWidth * 2 - 1]);
+  for (int y = 0; y < kTransposeHeight; ++y) {
+    for (int x = 0; x < kTransposeWidth; ++x) {
+      EXPECT_EQ(transpose_src[y * kTransposeWidth + x],
+                transpose_dst[x * kTransposeHeight + y]);
+    }
+  }
+  int set_choice = GetAutotuneChoice(kAutotuneSetRow, kWidth);
+  int transpose_choice = GetAutotuneChoice(kAutotuneTransposeWx8,
+                                           kTransposeWidth);
+
+  EXPECT_EQ(0, SaveAutotuneTable(autotune_file));
+  ResetAutotuneTable();
+  EXPECT_EQ(0, LoadAutotuneTable(autotune_file));
+  EXPECT_EQ(set_choice, GetAutotuneChoice(kAutotuneSetRow, kWidth));
+  EXPECT_EQ(transpose_choice, GetAutotuneChoice(kAutotuneTransposeWx8,
+                                                kTransposeWidth));
+
+  // A table for other cpu features is not loaded.
+  FILE* f = fopen(autotune_file, "w");
+  ASSERT_TRUE(f != NULL);
+  fprintf(f, "libyuv autotune 1\ncpu 1\nSetRow 1 1\n");
+  fclose(f);
+  EXPECT_EQ(-1, LoadAutotuneTable(autotune_file));
+  EXPECT_EQ(set_choice, GetAutotuneChoice(kAutotuneSetRow, kWidth));
+  EXPECT_EQ(-1, LoadAutotuneTable("does_not_exist/autotune.txt"));
+  remove(autotune_file);
+  ResetAutotuneTable();
+
+  free_aligned_buffer_64(plane);
+  free_aligned_buffer_64(transpose_src);
+  free_aligned_buffer_64(transpose_dst);
+}
+
+}  // namespace libyuv
@@ -0,0 +1,203 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+#include "libyuv/basic_types.h"
+#include "libyuv/batch.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/row.h"
+#include "libyuv/scale_argb.h"
+#include "../unit_test/unit_test.h"
+
+namespace libyuv {
+
+static const int kBatchFrames = 37;
+
+// Frames of varied sizes, including odd widths and an inverted frame.
+static void BatchFrameSize(int i, int* width, int* height) {
+  *width = 8 + (i * 13) % 57;
+  *height = 2 + (i * 7) % 23;
+}
+
+struct I420ToARGBBatchTest {
+  I420ToARGBFrame frames[kBatchFrames];
+  uint8* src;
+  uint8* dst;
+  uint8* expected;
+};
+
+static void I420ToARGBBatchInit(I420ToARGBBatchTest* test) {
+  size_t src_size = 0;
+  size_t dst_size = 0;
+  int i;
+  for (i = 0; i < kBatchFrames; ++i) {
+    int width, height;
+    BatchFrameSize(i, &width, &height);
+    src_size += width * height * 2;
+    dst_size += width * height * 4;
+  }
+  test->src = static_cast<uint8*>(malloc(src_size));
+  test->dst = static_cast<uint8*>(malloc(dst_size));
+  test->expected = static_cast<uint8*>(malloc(dst_size));
+  MemRandomize(test->src, static_cast<int>(src_size));
+  memset(test->dst, 0, dst_size);
+  uint8* src = test->src;
+  uint8* dst = test->dst;
+  for (i = 0; i < kBatchFrames; ++i) {
+    I420ToARGBFrame* frame = &test->frames[i];
+    int width, height;
+    BatchFrameSize(i, &width, &height);
+    int halfwidth = (width + 1) / 2;
+    frame->src_y = src;
+    frame->src_stride_y = width;
+    frame->src_u = src + width * height;
+    frame->src_stride_u = halfwidth;
+    frame->src_v = frame->src_u + halfwidth * ((height + 1) / 2);
+    frame->src_stride_v = halfwidth;
+    frame->dst_argb = dst;
+    frame->dst_stride_argb = width * 4;
+    frame->width = width;
+    frame->height = (i == 5) ? -height : height;
+    frame->result = 1;
+    I420ToARGB(frame->src_y, frame->src_stride_y,
+               frame->src_u, frame->src_stride_u,
+               frame->src_v, frame->src_stride_v,
+               test->expected + (dst - test->dst), frame->dst_stride_argb,
+               frame->width, frame->height);
+    src += width * height * 2;
+    dst += width * height * 4;
+  }
+}
+
+static void I420ToARGBBatchCheck(I420ToARGBBatchTest* test) {
+  for (int i = 0; i < kBatchFrames; ++i) {
+    const I420ToARGBFrame& frame = test->frames[i];
+    int height = frame.height < 0 ? -frame.height : frame.height;
+    EXPECT_EQ(0, frame.result);
+    EXPECT_EQ(0, memcmp(test->expected + (frame.dst_argb - test->dst),
+                        frame.dst_argb, frame.width * 4 * height));
+  }
+  free(test->src);
+  free(test->dst);
+  free(test->expected);
+}
+
+// A batch matches converting each frame on its own.
+TEST_F(libyuvTest, I420ToARGBBatch) {
+  I420ToARGBBatchTest test;
+  I420ToARGBBatchInit(&test);
+  EXPECT_EQ(0, I420ToARGBBatch(test.frames, kBatchFrames, NULL));
+  I420ToARGBBatchCheck(&test);
+}
+
+TEST_F(libyuvTest, I420ToARGBBatchInvalid) {
+  I420ToARGBBatchTest test;
+  I420ToARGBBatchInit(&test);
+  test.frames[3].src_u = NULL;
+  EXPECT_EQ(-1, I420ToARGBBatch(test.frames, kBatchFrames, NULL));
+  EXPECT_EQ(-1, test.frames[3].result);
+  EXPECT_EQ(0, test.frames[4].result);
+  test.frames[3].result = 0;
+  memcpy(test.frames[3].dst_argb,
+         test.expected + (test.frames[3].dst_argb - test.dst),
+         test.frames[3].width * 4 * test.frames[3].height);
+  I420ToARGBBatchCheck(&test);
+  EXPECT_EQ(-1, I420ToARGBBatch(NULL, 1, NULL));
+  EXPECT_EQ(0, I420ToARGBBatch(test.frames, 0, NULL));
+}
+
+// Calls that share a counter convert each frame once between them.
+TEST_F(libyuvTest, I420ToARGBBatchShared) {
+  I420ToARGBBatchTest test;
+  I420ToARGBBatchInit(&test);
+  int next_frame = 0;
+  EXPECT_EQ(0, I420ToARGBBatch(test.frames, kBatchFrames, &next_frame));
+  EXPECT_EQ(0, I420ToARGBBatch(test.frames, kBatchFrames, &next_frame));
+  EXPECT_LE(kBatchFrames, next_frame);
+  I420ToARGBBatchCheck(&test);
+}
+
+#if !defined(_WIN32)
+struct ARGBScaleBatchThread {
+  ARGBScaleFrame* frames;
+  int* next_frame;
+  int result;
+};
+
+static void* ARGBScaleBatchThreadMain(void* arg) {
+  ARGBScaleBatchThread* thread = static_cast<ARGBScaleBatchThread*>(arg);
+  thread->result = ARGBScaleBatch(thread->frames, kBatchFrames, kFilterBox,
+                                  thread->next_frame);
+  return NULL;
+}
+#endif
+
+TEST_F(libyuvTest, ARGBScaleBatch) {
+  ARGBScaleFrame frames[kBatchFrames];
+  const int kSrcWidth = 96;
+  const int kSrcHeight = 64;
+  const int kDstSize = kSrcWidth * kSrcHeight * 4;
+  align_buffer_64(src, kSrcWidth * kSrcHeight * 4);
+  align_buffer_64(dst, kDstSize * kBatchFrames);
+  align_buffer_64(expected, kDstSize * kBatchFrames);
+  MemRandomize(src, kSrcWidth * kSrcHeight * 4);
+  memset(dst, 0, kDstSize * kBatchFrames);
+  for (int i = 0; i < kBatchFrames; ++i) {
+    int width, height;
+    BatchFrameSize(i, &width, &height);
+    frames[i].src_argb = src;
+    frames[i].src_stride_argb = kSrcWidth * 4;
+    frames[i].src_width = kSrcWidth;
+    frames[i].src_height = kSrcHeight;
+    frames[i].dst_argb = dst + i * kDstSize;
+    frames[i].dst_stride_argb = width * 4;
+    frames[i].dst_width = width;
+    frames[i].dst_height = height;
+    frames[i].result = 1;
+    ARGBScale(src, kSrcWidth * 4, kSrcWidth, kSrcHeight,
+              expected + i * kDstSize, width * 4, width, height, kFilterBox);
+  }
+
+#if !defined(_WIN32)
+  int next_frame = 0;
+  ARGBScaleBatchThread threads[3];
+  pthread_t thread_ids[3];
+  for (int t = 0; t < 3; ++t) {
+    threads[t].frames = frames;
+    threads[t].next_frame = &next_frame;
+    threads[t].result = 1;
+    pthread_create(&thread_ids[t], NULL, ARGBScaleBatchThreadMain,
+                   &threads[t]);
+  }
+  for (int t = 0; t < 3; ++t) {
+    pthread_join(thread_ids[t], NULL);
+    EXPECT_EQ(0, threads[t].result);
+  }
+#else
+  EXPECT_EQ(0, ARGBScaleBatch(frames, kBatchFrames, kFilterBox, NULL));
+#endif
+  for (int i = 0; i < kBatchFrames; ++i) {
+    EXPECT_EQ(0, frames[i].result);
+    EXPECT_EQ(0, memcmp(expected + i * kDstSize, dst + i * kDstSize,
+                        frames[i].dst_width * frames[i].dst_height * 4));
+  }
+
+  free_aligned_buffer_64(src);
+  free_aligned_buffer_64(dst);
+  free_aligned_buffer_64(expected);
+}
+
+}  // namespace libyuv
@@ -16,6 +16,7 @@
 #include "libyuv/convert_argb.h"
 #include "libyuv/convert_from.h"
 #include "libyuv/convert_from_argb.h"
+#include "libyuv/convert_frame.h"
 #include "libyuv/cpu_id.h"
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
@@ -23,6 +24,7 @@
 #include "libyuv/planar_functions.h"
 #include "libyuv/rotate.h"
 #include "libyuv/row.h"
+#include "libyuv/scale.h"
 #include "libyuv/video_common.h"
 #include "../unit_test/unit_test.h"
 
@@ -89,16 +91,19 @@ TEST_F(libyuvTest, SRC_FMT_PLANAR##To##FMT_PLANAR##N) {                        \
                                  dst_v_c, SUBSAMPLE(kWidth, SUBSAMP_X),        \
                                  kWidth, NEG kHeight);                         \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    SRC_FMT_PLANAR##To##FMT_PLANAR(src_y + OFF, kWidth,                        \
-                                   src_u + OFF,                                \
-                                       SUBSAMPLE(kWidth, SRC_SUBSAMP_X),       \
-                                   src_v + OFF,                                \
-                                       SUBSAMPLE(kWidth, SRC_SUBSAMP_X),       \
-                                   dst_y_opt, kWidth,                          \
-                                   dst_u_opt, SUBSAMPLE(kWidth, SUBSAMP_X),    \
-                                   dst_v_opt, SUBSAMPLE(kWidth, SUBSAMP_X),    \
-                                   kWidth, NEG kHeight);                       \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      SRC_FMT_PLANAR##To##FMT_PLANAR(src_y + OFF, kWidth,                      \
+                                     src_u + OFF,                              \
+                                         SUBSAMPLE(kWidth, SRC_SUBSAMP_X),     \
+                                     src_v + OFF,                              \
+                                         SUBSAMPLE(kWidth, SRC_SUBSAMP_X),     \
+                                     dst_y_opt, kWidth,                        \
+                                     dst_u_opt, SUBSAMPLE(kWidth, SUBSAMP_X),  \
+                                     dst_v_opt, SUBSAMPLE(kWidth, SUBSAMP_X),  \
+                                     kWidth, NEG kHeight);                     \
+    }                                                                          \
   }                                                                            \
   int max_diff = 0;                                                            \
   for (int i = 0; i < kHeight; ++i) {                                          \
@@ -221,16 +226,19 @@ TEST_F(libyuvTest, SRC_FMT_PLANAR##To##FMT_PLANAR##N) {                        \
                                  dst_uv_c, SUBSAMPLE(kWidth * 2, SUBSAMP_X),   \
                                  kWidth, NEG kHeight);                         \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    SRC_FMT_PLANAR##To##FMT_PLANAR(src_y + OFF, kWidth,                        \
-                                   src_u + OFF,                                \
-                                   SUBSAMPLE(kWidth, SRC_SUBSAMP_X),           \
-                                   src_v + OFF,                                \
-                                   SUBSAMPLE(kWidth, SRC_SUBSAMP_X),           \
-                                   dst_y_opt, kWidth,                          \
-                                   dst_uv_opt,                                 \
-                                   SUBSAMPLE(kWidth * 2, SUBSAMP_X),           \
-                                   kWidth, NEG kHeight);                       \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      SRC_FMT_PLANAR##To##FMT_PLANAR(src_y + OFF, kWidth,                      \
+                                     src_u + OFF,                              \
+                                     SUBSAMPLE(kWidth, SRC_SUBSAMP_X),         \
+                                     src_v + OFF,                              \
+                                     SUBSAMPLE(kWidth, SRC_SUBSAMP_X),         \
+                                     dst_y_opt, kWidth,                        \
+                                     dst_uv_opt,                               \
+                                     SUBSAMPLE(kWidth * 2, SUBSAMP_X),         \
+                                     kWidth, NEG kHeight);                     \
+    }                                                                          \
   }                                                                            \
   int max_diff = 0;                                                            \
   for (int i = 0; i < kHeight; ++i) {                                          \
@@ -335,14 +343,17 @@ TEST_F(libyuvTest, SRC_FMT_PLANAR##To##FMT_PLANAR##N) {                        \
                                  dst_v_c, SUBSAMPLE(kWidth, SUBSAMP_X),        \
                                  kWidth, NEG kHeight);                         \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    SRC_FMT_PLANAR##To##FMT_PLANAR(src_y + OFF, kWidth,                        \
-                                   src_uv + OFF,                               \
-                                   2 * SUBSAMPLE(kWidth, SRC_SUBSAMP_X),       \
-                                   dst_y_opt, kWidth,                          \
-                                   dst_u_opt, SUBSAMPLE(kWidth, SUBSAMP_X),    \
-                                   dst_v_opt, SUBSAMPLE(kWidth, SUBSAMP_X),    \
-                                   kWidth, NEG kHeight);                       \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      SRC_FMT_PLANAR##To##FMT_PLANAR(src_y + OFF, kWidth,                      \
+                                     src_uv + OFF,                             \
+                                     2 * SUBSAMPLE(kWidth, SRC_SUBSAMP_X),     \
+                                     dst_y_opt, kWidth,                        \
+                                     dst_u_opt, SUBSAMPLE(kWidth, SUBSAMP_X),  \
+                                     dst_v_opt, SUBSAMPLE(kWidth, SUBSAMP_X),  \
+                                     kWidth, NEG kHeight);                     \
+    }                                                                          \
   }                                                                            \
   int max_diff = 0;                                                            \
   for (int i = 0; i < kHeight; ++i) {                                          \
@@ -442,12 +453,15 @@ TEST_F(libyuvTest, FMT_PLANAR##To##FMT_B##N) {                                 \
                         dst_argb_c + OFF, kStrideB,                            \
                         kWidth, NEG kHeight);                                  \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    FMT_PLANAR##To##FMT_B(src_y + OFF, kWidth,                                 \
-                          src_u + OFF, SUBSAMPLE(kWidth, SUBSAMP_X),           \
-                          src_v + OFF, SUBSAMPLE(kWidth, SUBSAMP_X),           \
-                          dst_argb_opt + OFF, kStrideB,                        \
-                          kWidth, NEG kHeight);                                \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT_PLANAR##To##FMT_B(src_y + OFF, kWidth,                               \
+                            src_u + OFF, SUBSAMPLE(kWidth, SUBSAMP_X),         \
+                            src_v + OFF, SUBSAMPLE(kWidth, SUBSAMP_X),         \
+                            dst_argb_opt + OFF, kStrideB,                      \
+                            kWidth, NEG kHeight);                              \
+    }                                                                          \
   }                                                                            \
   int max_diff = 0;                                                            \
   /* Convert to ARGB so 565 is expanded to bytes that can be compared. */      \
@@ -544,11 +558,14 @@ TEST_F(libyuvTest, FMT_PLANAR##To##FMT_B##N) {                                 \
                         dst_argb_c, kWidth * BPP_B,                            \
                         kWidth, NEG kHeight);                                  \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    FMT_PLANAR##To##FMT_B(src_y + OFF, kWidth,                                 \
-                          src_uv + OFF, SUBSAMPLE(kWidth, SUBSAMP_X) * 2,      \
-                          dst_argb_opt, kWidth * BPP_B,                        \
-                          kWidth, NEG kHeight);                                \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT_PLANAR##To##FMT_B(src_y + OFF, kWidth,                               \
+                            src_uv + OFF, SUBSAMPLE(kWidth, SUBSAMP_X) * 2,    \
+                            dst_argb_opt, kWidth * BPP_B,                      \
+                            kWidth, NEG kHeight);                              \
+    }                                                                          \
   }                                                                            \
   /* Convert to ARGB so 565 is expanded to bytes that can be compared. */      \
   align_buffer_64(dst_argb32_c, kWidth * 4 * kHeight);                         \
@@ -639,12 +656,15 @@ TEST_F(libyuvTest, FMT_A##To##FMT_PLANAR##N) {                                 \
                         dst_v_c, SUBSAMPLE(kWidth, SUBSAMP_X),                 \
                         kWidth, NEG kHeight);                                  \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    FMT_A##To##FMT_PLANAR(src_argb + OFF, kStride,                             \
-                          dst_y_opt, kWidth,                                   \
-                          dst_u_opt, SUBSAMPLE(kWidth, SUBSAMP_X),             \
-                          dst_v_opt, SUBSAMPLE(kWidth, SUBSAMP_X),             \
-                          kWidth, NEG kHeight);                                \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT_A##To##FMT_PLANAR(src_argb + OFF, kStride,                           \
+                            dst_y_opt, kWidth,                                 \
+                            dst_u_opt, SUBSAMPLE(kWidth, SUBSAMP_X),           \
+                            dst_v_opt, SUBSAMPLE(kWidth, SUBSAMP_X),           \
+                            kWidth, NEG kHeight);                              \
+    }                                                                          \
   }                                                                            \
   for (int i = 0; i < kHeight; ++i) {                                          \
     for (int j = 0; j < kWidth; ++j) {                                         \
@@ -715,6 +735,202 @@ TESTATOPLANAR(UYVY, 2, 1, I422, 2, 1, 2)
 TESTATOPLANAR(I400, 1, 1, I420, 2, 2, 2)
 TESTATOPLANAR(J400, 1, 1, J420, 2, 2, 2)
 
+// Packed 4:2:2 to NV12 and back matches going through I420.
+#define TESTPACKEDNV12I(FMT, W1280, N, NEG)                                    \
+TEST_F(libyuvTest, FMT##ToNV12##N) {                                           \
+  const int kWidth = ((W1280) > 0) ? (W1280) : 1;                              \
+  const int kHeight = benchmark_height_;                                       \
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);                                 \
+  const int kHalfHeight = SUBSAMPLE(kHeight, 2);                               \
+  const int kStride = kHalfWidth * 4;                                          \
+  align_buffer_64(src_packed, kStride * kHeight);                              \
+  align_buffer_64(dst_y_c, kWidth * kHeight);                                  \
+  align_buffer_64(dst_uv_c, kHalfWidth * 2 * kHalfHeight);                     \
+  align_buffer_64(dst_y_opt, kWidth * kHeight);                                \
+  align_buffer_64(dst_uv_opt, kHalfWidth * 2 * kHalfHeight);                   \
+  align_buffer_64(dst_u, kHalfWidth * kHalfHeight);                            \
+  align_buffer_64(dst_v, kHalfWidth * kHalfHeight);                            \
+  align_buffer_64(dst_packed_c, kStride * kHeight);                            \
+  align_buffer_64(dst_packed_opt, kStride * kHeight);                          \
+  MemRandomize(src_packed, kStride * kHeight);                                 \
+  memset(dst_packed_c, 1, kStride * kHeight);                                  \
+  memset(dst_packed_opt, 2, kStride * kHeight);                                \
+  MaskCpuFlags(disable_cpu_flags_);                                            \
+  FMT##ToNV12(src_packed, kStride, dst_y_c, kWidth,                            \
+              dst_uv_c, kHalfWidth * 2, kWidth, NEG kHeight);                  \
+  NV12To##FMT(dst_y_c, kWidth, dst_uv_c, kHalfWidth * 2,                       \
+              dst_packed_c, kStride, kWidth, NEG kHeight);                     \
+  MaskCpuFlags(-1);                                                            \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT##ToNV12(src_packed, kStride, dst_y_opt, kWidth,                      \
+                  dst_uv_opt, kHalfWidth * 2, kWidth, NEG kHeight);            \
+    }                                                                          \
+  }                                                                            \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      NV12To##FMT(dst_y_opt, kWidth, dst_uv_opt, kHalfWidth * 2,               \
+                  dst_packed_opt, kStride, kWidth, NEG kHeight);               \
+    }                                                                          \
+  }                                                                            \
+  EXPECT_EQ(0, memcmp(dst_y_c, dst_y_opt, kWidth * kHeight));                  \
+  EXPECT_EQ(0, memcmp(dst_uv_c, dst_uv_opt, kHalfWidth * 2 * kHalfHeight));    \
+  EXPECT_EQ(0, memcmp(dst_packed_c, dst_packed_opt, kStride * kHeight));       \
+  FMT##ToI420(src_packed, kStride, dst_y_c, kWidth,                            \
+              dst_u, kHalfWidth, dst_v, kHalfWidth, kWidth, NEG kHeight);      \
+  EXPECT_EQ(0, memcmp(dst_y_c, dst_y_opt, kWidth * kHeight));                  \
+  for (int i = 0; i < kHalfWidth * kHalfHeight; ++i) {                         \
+    EXPECT_EQ(dst_u[i], dst_uv_opt[i * 2 + 0]);                                \
+    EXPECT_EQ(dst_v[i], dst_uv_opt[i * 2 + 1]);                                \
+  }                                                                            \
+  I420To##FMT(dst_y_c, kWidth, dst_u, kHalfWidth, dst_v, kHalfWidth,           \
+              dst_packed_c, kStride, kWidth, NEG kHeight);                     \
+  EXPECT_EQ(0, memcmp(dst_packed_c, dst_packed_opt, kStride * kHeight));       \
+  free_aligned_buffer_64(src_packed);                                          \
+  free_aligned_buffer_64(dst_y_c);                                             \
+  free_aligned_buffer_64(dst_uv_c);                                            \
+  free_aligned_buffer_64(dst_y_opt);                                           \
+  free_aligned_buffer_64(dst_uv_opt);                                          \
+  free_aligned_buffer_64(dst_u);                                               \
+  free_aligned_buffer_64(dst_v);                                               \
+  free_aligned_buffer_64(dst_packed_c);                                        \
+  free_aligned_buffer_64(dst_packed_opt);                                      \
+}
+
+#define TESTPACKEDNV12(FMT)                                                    \
+    TESTPACKEDNV12I(FMT, benchmark_width_ - 3, _Any, +)                        \
+    TESTPACKEDNV12I(FMT, benchmark_width_, _Invert, -)                         \
+    TESTPACKEDNV12I(FMT, benchmark_width_, _Opt, +)
+
+TESTPACKEDNV12(YUY2)
+TESTPACKEDNV12(UYVY)
+
+#ifdef HAS_ARGBTOI420ROW_SSSE3
+// Fused row pair kernels must match the separate Y and UV row functions.
+// Width leaves the same remainder for C with 16 and 32 pixel kernels.
+#define TESTATOI420ROW(FMT_A, FMT_PLANAR, YROW, UVROW, SIMD)                   \
+TEST_F(libyuvTest, FMT_A##To##FMT_PLANAR##Row_##SIMD) {                        \
+  const int kWidth = (benchmark_width_ & ~31) + 3;                             \
+  const int kWidthUV = SUBSAMPLE(kWidth, 2);                                   \
+  const int kStride = kWidth * 4;                                              \
+  align_buffer_64(src_argb, kStride * 2);                                      \
+  align_buffer_64(dst_y_c, kWidth * 2);                                        \
+  align_buffer_64(dst_u_c, kWidthUV);                                          \
+  align_buffer_64(dst_v_c, kWidthUV);                                          \
+  align_buffer_64(dst_y_opt, kWidth * 2);                                      \
+  align_buffer_64(dst_u_opt, kWidthUV);                                        \
+  align_buffer_64(dst_v_opt, kWidthUV);                                        \
+  if (!TestCpuFlag(kCpuHas##SIMD)) {                                           \
+    printf("Skipped.  No " #SIMD "\n");                                        \
+  } else {                                                                     \
+    for (int i = 0; i < kStride * 2; ++i) {                                    \
+      src_argb[i] = (random() & 0xff);                                         \
+    }                                                                          \
+    UVROW##_Any_SSSE3(src_argb, kStride, dst_u_c, dst_v_c, kWidth);            \
+    YROW##_Any_SSSE3(src_argb, dst_y_c, kWidth);                               \
+    YROW##_Any_SSSE3(src_argb + kStride, dst_y_c + kWidth, kWidth);            \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT_A##To##FMT_PLANAR##Row_Any_##SIMD(src_argb, kStride,                 \
+                                            dst_y_opt, kWidth,                 \
+                                            dst_u_opt, dst_v_opt, kWidth);     \
+    }                                                                          \
+    for (int i = 0; i < kWidth * 2; ++i) {                                     \
+      EXPECT_EQ(dst_y_c[i], dst_y_opt[i]);                                     \
+    }                                                                          \
+    for (int i = 0; i < kWidthUV; ++i) {                                       \
+      EXPECT_EQ(dst_u_c[i], dst_u_opt[i]);                                     \
+      EXPECT_EQ(dst_v_c[i], dst_v_opt[i]);                                     \
+    }                                                                          \
+  }                                                                            \
+  free_aligned_buffer_64(dst_y_c);                                             \
+  free_aligned_buffer_64(dst_u_c);                                             \
+  free_aligned_buffer_64(dst_v_c);                                             \
+  free_aligned_buffer_64(dst_y_opt);                                           \
+  free_aligned_buffer_64(dst_u_opt);                                           \
+  free_aligned_buffer_64(dst_v_opt);                                           \
+  free_aligned_buffer_64(src_argb);                                            \
+}
+
+TESTATOI420ROW(ARGB, I420, ARGBToYRow, ARGBToUVRow, SSSE3)
+TESTATOI420ROW(ARGB, J420, ARGBToYJRow, ARGBToUVJRow, SSSE3)
+TESTATOI420ROW(BGRA, I420, BGRAToYRow, BGRAToUVRow, SSSE3)
+TESTATOI420ROW(ABGR, I420, ABGRToYRow, ABGRToUVRow, SSSE3)
+TESTATOI420ROW(RGBA, I420, RGBAToYRow, RGBAToUVRow, SSSE3)
+#ifdef HAS_ARGBTOI420ROW_AVX2
+TESTATOI420ROW(ARGB, I420, ARGBToYRow, ARGBToUVRow, AVX2)
+TESTATOI420ROW(ARGB, J420, ARGBToYJRow, ARGBToUVJRow, AVX2)
+TESTATOI420ROW(BGRA, I420, BGRAToYRow, BGRAToUVRow, AVX2)
+TESTATOI420ROW(ABGR, I420, ABGRToYRow, ABGRToUVRow, AVX2)
+TESTATOI420ROW(RGBA, I420, RGBAToYRow, RGBAToUVRow, AVX2)
+#endif
+#endif  // HAS_ARGBTOI420ROW_SSSE3
+
+#ifdef HAS_BGRATOYROW_AVX2
+// Compare AVX2 Y and UV rows against converting to ARGB and using the SSSE3
+// ARGB rows, which is what the I420 converters did before.
+#define TESTATOPLANARROWAVX2(FMT_A, BPP_A, FMT_PLANAR, TOARGB, YROW, UVROW,    \
+                             ARGBYROW, ARGBUVROW)                              \
+TEST_F(libyuvTest, FMT_A##To##FMT_PLANAR##Rows_AVX2) {                         \
+  const int kWidth = (benchmark_width_ & ~31) + 3;                             \
+  const int kWidthUV = SUBSAMPLE(kWidth, 2);                                   \
+  const int kStride = kWidth * BPP_A;                                          \
+  align_buffer_64(src_a, kStride * 2);                                         \
+  align_buffer_64(src_argb, kWidth * 4 * 2);                                   \
+  align_buffer_64(dst_y_c, kWidth * 2);                                        \
+  align_buffer_64(dst_u_c, kWidthUV);                                          \
+  align_buffer_64(dst_v_c, kWidthUV);                                          \
+  align_buffer_64(dst_y_opt, kWidth * 2);                                      \
+  align_buffer_64(dst_u_opt, kWidthUV);                                        \
+  align_buffer_64(dst_v_opt, kWidthUV);                                        \
+  if (!TestCpuFlag(kCpuHasAVX2)) {                                             \
+    printf("Skipped.  No AVX2\n");                                             \
+  } else {                                                                     \
+    for (int i = 0; i < kStride * 2; ++i) {                                    \
+      src_a[i] = (random() & 0xff);                                            \
+    }                                                                          \
+    TOARGB(src_a, kStride, src_argb, kWidth * 4, kWidth, 2);                   \
+    ARGBUVROW##_Any_SSSE3(src_argb, kWidth * 4, dst_u_c, dst_v_c, kWidth);     \
+    ARGBYROW##_Any_SSSE3(src_argb, dst_y_c, kWidth);                           \
+    ARGBYROW##_Any_SSSE3(src_argb + kWidth * 4, dst_y_c + kWidth, kWidth);     \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      UVROW##_Any_AVX2(src_a, kStride, dst_u_opt, dst_v_opt, kWidth);          \
+      YROW##_Any_AVX2(src_a, dst_y_opt, kWidth);                               \
+      YROW##_Any_AVX2(src_a + kStride, dst_y_opt + kWidth, kWidth);            \
+    }                                                                          \
+    for (int i = 0; i < kWidth * 2; ++i) {                                     \
+      EXPECT_EQ(dst_y_c[i], dst_y_opt[i]);                                     \
+    }                                                                          \
+    for (int i = 0; i < kWidthUV; ++i) {                                       \
+      EXPECT_EQ(dst_u_c[i], dst_u_opt[i]);                                     \
+      EXPECT_EQ(dst_v_c[i], dst_v_opt[i]);                                     \
+    }                                                                          \
+  }                                                                            \
+  free_aligned_buffer_64(dst_y_c);                                             \
+  free_aligned_buffer_64(dst_u_c);                                             \
+  free_aligned_buffer_64(dst_v_c);                                             \
+  free_aligned_buffer_64(dst_y_opt);                                           \
+  free_aligned_buffer_64(dst_u_opt);                                           \
+  free_aligned_buffer_64(dst_v_opt);                                           \
+  free_aligned_buffer_64(src_argb);                                            \
+  free_aligned_buffer_64(src_a);                                               \
+}
+
+TESTATOPLANARROWAVX2(ARGB, 4, J420, ARGBCopy, ARGBToYJRow, ARGBToUVJRow,
+                     ARGBToYJRow, ARGBToUVJRow)
+TESTATOPLANARROWAVX2(BGRA, 4, I420, BGRAToARGB, BGRAToYRow, BGRAToUVRow,
+                     ARGBToYRow, ARGBToUVRow)
+TESTATOPLANARROWAVX2(ABGR, 4, I420, ABGRToARGB, ABGRToYRow, ABGRToUVRow,
+                     ARGBToYRow, ARGBToUVRow)
+TESTATOPLANARROWAVX2(RGBA, 4, I420, RGBAToARGB, RGBAToYRow, RGBAToUVRow,
+                     ARGBToYRow, ARGBToUVRow)
+TESTATOPLANARROWAVX2(RGB24, 3, I420, RGB24ToARGB, RGB24ToYRow, RGB24ToUVRow,
+                     ARGBToYRow, ARGBToUVRow)
+TESTATOPLANARROWAVX2(RAW, 3, I420, RAWToARGB, RAWToYRow, RAWToUVRow,
+                     ARGBToYRow, ARGBToUVRow)
+#endif  // HAS_BGRATOYROW_AVX2
+
 #define TESTATOBIPLANARI(FMT_A, BPP_A, FMT_PLANAR, SUBSAMP_X, SUBSAMP_Y,       \
                        W1280, N, NEG, OFF)                                     \
 TEST_F(libyuvTest, FMT_A##To##FMT_PLANAR##N) {                                 \
@@ -746,11 +962,14 @@ TEST_F(libyuvTest, FMT_A##To##FMT_PLANAR##N) {                                 \
                         dst_uv_c, SUBSAMPLE(kWidth, SUBSAMP_X) * 2,            \
                         kWidth, NEG kHeight);                                  \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    FMT_A##To##FMT_PLANAR(src_argb + OFF, kStride,                             \
-                          dst_y_opt, kWidth,                                   \
-                          dst_uv_opt, SUBSAMPLE(kWidth, SUBSAMP_X) * 2,        \
-                          kWidth, NEG kHeight);                                \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT_A##To##FMT_PLANAR(src_argb + OFF, kStride,                           \
+                            dst_y_opt, kWidth,                                 \
+                            dst_uv_opt, SUBSAMPLE(kWidth, SUBSAMP_X) * 2,      \
+                            kWidth, NEG kHeight);                              \
+    }                                                                          \
   }                                                                            \
   int max_diff = 0;                                                            \
   for (int i = 0; i < kHeight; ++i) {                                          \
@@ -821,10 +1040,13 @@ TEST_F(libyuvTest, FMT_A##To##FMT_B##N) {                                      \
                    dst_argb_c, kStrideB,                                       \
                    kWidth, NEG kHeight);                                       \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    FMT_A##To##FMT_B(src_argb + OFF, kStrideA,                                 \
-                     dst_argb_opt, kStrideB,                                   \
-                     kWidth, NEG kHeight);                                     \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT_A##To##FMT_B(src_argb + OFF, kStrideA,                               \
+                       dst_argb_opt, kStrideB,                                 \
+                       kWidth, NEG kHeight);                                   \
+    }                                                                          \
   }                                                                            \
   int max_diff = 0;                                                            \
   for (int i = 0; i < kStrideB * kHeightB; ++i) {                              \
@@ -955,10 +1177,13 @@ TEST_F(libyuvTest, FMT_A##To##FMT_B##Dither##N) {                              \
                            dst_argb_c, kStrideB,                               \
                            NULL, kWidth, NEG kHeight);                         \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    FMT_A##To##FMT_B##Dither(src_argb + OFF, kStrideA,                         \
-                             dst_argb_opt, kStrideB,                           \
-                             NULL, kWidth, NEG kHeight);                       \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT_A##To##FMT_B##Dither(src_argb + OFF, kStrideA,                       \
+                               dst_argb_opt, kStrideB,                         \
+                               NULL, kWidth, NEG kHeight);                     \
+    }                                                                          \
   }                                                                            \
   int max_diff = 0;                                                            \
   for (int i = 0; i < kStrideB * kHeightB; ++i) {                              \
@@ -1058,10 +1283,13 @@ TEST_F(libyuvTest, FMT_ATOB##_Symetric##N) {                                   \
            dst_argb_c, kStrideA,                                               \
            kWidth, NEG kHeight);                                               \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    FMT_ATOB(src_argb + OFF, kStrideA,                                         \
-             dst_argb_opt, kStrideA,                                           \
-             kWidth, NEG kHeight);                                             \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT_ATOB(src_argb + OFF, kStrideA,                                       \
+               dst_argb_opt, kStrideA,                                         \
+               kWidth, NEG kHeight);                                           \
+    }                                                                          \
   }                                                                            \
   MaskCpuFlags(disable_cpu_flags_);                                            \
   FMT_ATOB(dst_argb_c, kStrideA,                                               \
@@ -1479,12 +1707,15 @@ TEST_F(libyuvTest, FMT_PLANAR##To##FMT_B##Dither##N) {                         \
                         dst_argb_c + OFF, kStrideB,                            \
                         NULL, kWidth, NEG kHeight);                            \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    FMT_PLANAR##To##FMT_B##Dither(src_y + OFF, kWidth,                         \
-                          src_u + OFF, SUBSAMPLE(kWidth, SUBSAMP_X),           \
-                          src_v + OFF, SUBSAMPLE(kWidth, SUBSAMP_X),           \
-                          dst_argb_opt + OFF, kStrideB,                        \
-                          NULL, kWidth, NEG kHeight);                          \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      FMT_PLANAR##To##FMT_B##Dither(src_y + OFF, kWidth,                       \
+                            src_u + OFF, SUBSAMPLE(kWidth, SUBSAMP_X),         \
+                            src_v + OFF, SUBSAMPLE(kWidth, SUBSAMP_X),         \
+                            dst_argb_opt + OFF, kStrideB,                      \
+                            NULL, kWidth, NEG kHeight);                        \
+    }                                                                          \
   }                                                                            \
   int max_diff = 0;                                                            \
   /* Convert to ARGB so 565 is expanded to bytes that can be compared. */      \
@@ -1529,4 +1760,485 @@ TEST_F(libyuvTest, FMT_PLANAR##To##FMT_B##Dither##N) {                         \
 
 TESTPLANARTOBD(I420, 2, 2, RGB565, 2, 2, 1, 9, ARGB, 4)
 
+TEST_F(libyuvTest, FrameConvertPlanSteps) {
+  FrameConvertPlan plan;
+  // Same size packed to packed converts in stripes through I420.
+  EXPECT_EQ(0, FrameConvertPlanInit(&plan, FOURCC_YUY2, 1280, 720,
+                                    0, 0, 1280, 720, FOURCC_ARGB, 1280, 720,
+                                    kRotate0, kFilterBox));
+  EXPECT_EQ(2, plan.num_steps);
+  EXPECT_EQ(kFrameStepToI420, plan.steps[0]);
+  EXPECT_EQ(kFrameStepFromI420, plan.steps[1]);
+  EXPECT_GT(plan.stripe_height, 0);
+  EXPECT_EQ(0, plan.stripe_height & 1);
+  FrameConvertPlanFree(&plan);
+
+  // NV12 rotates while converting straight into I420.
+  EXPECT_EQ(0, FrameConvertPlanInit(&plan, FOURCC_NV12, 640, 360,
+                                    0, 0, 640, 360, FOURCC_I420, 360, 640,
+                                    kRotate90, kFilterBox));
+  EXPECT_EQ(1, plan.num_steps);
+  EXPECT_EQ(kFrameStepToI420, plan.steps[0]);
+  EXPECT_EQ(NULL, plan.buffer_mem);
+  FrameConvertPlanFree(&plan);
+
+  // I420 is scaled in place.
+  EXPECT_EQ(0, FrameConvertPlanInit(&plan, FOURCC_I420, 640, 360,
+                                    0, 0, 640, 360, FOURCC_ARGB, 320, 180,
+                                    kRotate0, kFilterBox));
+  EXPECT_EQ(2, plan.num_steps);
+  EXPECT_EQ(kFrameStepScale, plan.steps[0]);
+  EXPECT_EQ(kFrameStepFromI420, plan.steps[1]);
+  FrameConvertPlanFree(&plan);
+
+  // Scale down before rotating; scale up after.
+  EXPECT_EQ(0, FrameConvertPlanInit(&plan, FOURCC_YUY2, 640, 360,
+                                    0, 0, 640, 360, FOURCC_ARGB, 180, 320,
+                                    kRotate90, kFilterBox));
+  EXPECT_EQ(4, plan.num_steps);
+  EXPECT_EQ(kFrameStepScale, plan.steps[1]);
+  EXPECT_EQ(kFrameStepRotate, plan.steps[2]);
+  FrameConvertPlanFree(&plan);
+  EXPECT_EQ(0, FrameConvertPlanInit(&plan, FOURCC_YUY2, 640, 360,
+                                    0, 0, 640, 360, FOURCC_ARGB, 720, 1280,
+                                    kRotate90, kFilterBox));
+  EXPECT_EQ(4, plan.num_steps);
+  EXPECT_EQ(kFrameStepRotate, plan.steps[1]);
+  EXPECT_EQ(kFrameStepScale, plan.steps[2]);
+  FrameConvertPlanFree(&plan);
+
+  EXPECT_EQ(-1, FrameConvertPlanInit(&plan, FOURCC_H264, 640, 360,
+                                     0, 0, 640, 360, FOURCC_ARGB, 640, 360,
+                                     kRotate0, kFilterBox));
+  EXPECT_EQ(-1, FrameConvertPlanInit(&plan, FOURCC_YUY2, 640, 360,
+                                     0, 0, 640, 360, FOURCC_MJPG, 640, 360,
+                                     kRotate0, kFilterBox));
+}
+
+// Compare a striped plan with converting the whole frame through I420.
+TEST_F(libyuvTest, ConvertFrameYUY2ToARGBCrop) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kCropX = (kWidth / 8) & ~1;
+  const int kCropY = (kHeight / 8) & ~1;
+  const int kCropWidth = kWidth - kCropX * 2;
+  const int kCropHeight = kHeight - kCropY * 2 + 1;
+  const int kStrideUV = SUBSAMPLE(kCropWidth, 2);
+  const int kSizeUV = kStrideUV * SUBSAMPLE(kCropHeight, 2);
+  const int kSrcSize = SUBSAMPLE(kWidth, 2) * 4 * kHeight;
+  align_buffer_64(src_yuy2, kSrcSize);
+  align_buffer_64(tmp_y, kCropWidth * kCropHeight);
+  align_buffer_64(tmp_u, kSizeUV);
+  align_buffer_64(tmp_v, kSizeUV);
+  align_buffer_64(dst_argb_c, kCropWidth * 4 * kCropHeight);
+  align_buffer_64(dst_argb_opt, kCropWidth * 4 * kCropHeight);
+  for (int i = 0; i < kSrcSize; ++i) {
+    src_yuy2[i] = (random() & 0xff);
+  }
+  memset(dst_argb_c, 1, kCropWidth * 4 * kCropHeight);
+  memset(dst_argb_opt, 2, kCropWidth * 4 * kCropHeight);
+  ConvertToI420(src_yuy2, kSrcSize,
+                tmp_y, kCropWidth,
+                tmp_u, kStrideUV,
+                tmp_v, kStrideUV,
+                kCropX, kCropY, kWidth, kHeight, kCropWidth, kCropHeight,
+                kRotate0, FOURCC_YUY2);
+  ConvertFromI420(tmp_y, kCropWidth,
+                  tmp_u, kStrideUV,
+                  tmp_v, kStrideUV,
+                  dst_argb_c, 0, kCropWidth, kCropHeight, FOURCC_ARGB);
+
+  FrameConvertPlan plan;
+  EXPECT_EQ(0, FrameConvertPlanInit(&plan, FOURCC_YUY2, kWidth, kHeight,
+                                    kCropX, kCropY, kCropWidth, kCropHeight,
+                                    FOURCC_ARGB, kCropWidth, kCropHeight,
+                                    kRotate0, kFilterBox));
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    EXPECT_EQ(0, FrameConvertPlanRun(&plan, src_yuy2, kSrcSize,
+                                     dst_argb_opt, 0));
+  }
+  FrameConvertPlanFree(&plan);
+  for (int i = 0; i < kCropWidth * 4 * kCropHeight; ++i) {
+    EXPECT_EQ(dst_argb_c[i], dst_argb_opt[i]);
+  }
+  free_aligned_buffer_64(src_yuy2);
+  free_aligned_buffer_64(tmp_y);
+  free_aligned_buffer_64(tmp_u);
+  free_aligned_buffer_64(tmp_v);
+  free_aligned_buffer_64(dst_argb_c);
+  free_aligned_buffer_64(dst_argb_opt);
+}
+
+// Compare scaling down and rotating with calling each step.
+TEST_F(libyuvTest, ConvertFrameI420ScaleRotateToARGB) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);
+  const int kHalfHeight = SUBSAMPLE(kHeight, 2);
+  const int kSrcSize = kWidth * kHeight + kHalfWidth * kHalfHeight * 2;
+  // Destination is rotated 90 degrees.
+  const int kDstWidth = SUBSAMPLE(kHeight, 2);
+  const int kDstHeight = SUBSAMPLE(kWidth, 2);
+  const int kScaleSize = kDstHeight * kDstWidth +
+      SUBSAMPLE(kDstHeight, 2) * SUBSAMPLE(kDstWidth, 2) * 2;
+  align_buffer_64(src_i420, kSrcSize);
+  align_buffer_64(scaled, kScaleSize);
+  align_buffer_64(rotated, kScaleSize);
+  align_buffer_64(dst_argb_c, kDstWidth * 4 * kDstHeight);
+  align_buffer_64(dst_argb_opt, kDstWidth * 4 * kDstHeight);
+  for (int i = 0; i < kSrcSize; ++i) {
+    src_i420[i] = (random() & 0xff);
+  }
+  memset(dst_argb_c, 1, kDstWidth * 4 * kDstHeight);
+  memset(dst_argb_opt, 2, kDstWidth * 4 * kDstHeight);
+  uint8* scaled_u = scaled + kDstHeight * kDstWidth;
+  uint8* scaled_v = scaled_u +
+      SUBSAMPLE(kDstHeight, 2) * SUBSAMPLE(kDstWidth, 2);
+  uint8* rotated_u = rotated + kDstHeight * kDstWidth;
+  uint8* rotated_v = rotated_u +
+      SUBSAMPLE(kDstHeight, 2) * SUBSAMPLE(kDstWidth, 2);
+  I420Scale(src_i420, kWidth,
+            src_i420 + kWidth * kHeight, kHalfWidth,
+            src_i420 + kWidth * kHeight + kHalfWidth * kHalfHeight,
+            kHalfWidth,
+            kWidth, kHeight,
+            scaled, kDstHeight,
+            scaled_u, SUBSAMPLE(kDstHeight, 2),
+            scaled_v, SUBSAMPLE(kDstHeight, 2),
+            kDstHeight, kDstWidth, kFilterBilinear);
+  I420Rotate(scaled, kDstHeight,
+             scaled_u, SUBSAMPLE(kDstHeight, 2),
+             scaled_v, SUBSAMPLE(kDstHeight, 2),
+             rotated, kDstWidth,
+             rotated_u, SUBSAMPLE(kDstWidth, 2),
+             rotated_v, SUBSAMPLE(kDstWidth, 2),
+             kDstHeight, kDstWidth, kRotate90);
+  I420ToARGB(rotated, kDstWidth,
+             rotated_u, SUBSAMPLE(kDstWidth, 2),
+             rotated_v, SUBSAMPLE(kDstWidth, 2),
+             dst_argb_c, kDstWidth * 4, kDstWidth, kDstHeight);
+
+  FrameConvertPlan plan;
+  EXPECT_EQ(0, FrameConvertPlanInit(&plan, FOURCC_I420, kWidth, kHeight,
+                                    0, 0, kWidth, kHeight,
+                                    FOURCC_ARGB, kDstWidth, kDstHeight,
+                                    kRotate90, kFilterBilinear));
+  EXPECT_EQ(3, plan.num_steps);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    EXPECT_EQ(0, FrameConvertPlanRun(&plan, src_i420, kSrcSize,
+                                     dst_argb_opt, kDstWidth * 4));
+  }
+  FrameConvertPlanFree(&plan);
+  for (int i = 0; i < kDstWidth * 4 * kDstHeight; ++i) {
+    EXPECT_EQ(dst_argb_c[i], dst_argb_opt[i]);
+  }
+  free_aligned_buffer_64(src_i420);
+  free_aligned_buffer_64(scaled);
+  free_aligned_buffer_64(rotated);
+  free_aligned_buffer_64(dst_argb_c);
+  free_aligned_buffer_64(dst_argb_opt);
+}
+
+// Compare rotating and scaling up into I420 with calling each step.
+TEST_F(libyuvTest, ConvertFrameARGBRotateScaleToI420) {
+  const int kWidth = 64;
+  const int kHeight = 48;
+  const int kDstWidth = 100;  // Rotated 270 degrees.
+  const int kDstHeight = 130;
+  const int kSrcSize = kWidth * 4 * kHeight;
+  const int kRotSize = kWidth * kHeight +
+      SUBSAMPLE(kWidth, 2) * SUBSAMPLE(kHeight, 2) * 2;
+  const int kDstSize = kDstWidth * kDstHeight +
+      SUBSAMPLE(kDstWidth, 2) * SUBSAMPLE(kDstHeight, 2) * 2;
+  align_buffer_64(src_argb, kSrcSize);
+  align_buffer_64(rotated, kRotSize);
+  align_buffer_64(dst_c, kDstSize);
+  align_buffer_64(dst_opt, kDstSize);
+  for (int i = 0; i < kSrcSize; ++i) {
+    src_argb[i] = (random() & 0xff);
+  }
+  memset(dst_c, 1, kDstSize);
+  memset(dst_opt, 2, kDstSize);
+  uint8* rotated_u = rotated + kWidth * kHeight;
+  uint8* rotated_v = rotated_u + SUBSAMPLE(kWidth, 2) * SUBSAMPLE(kHeight, 2);
+  uint8* dst_u = dst_c + kDstWidth * kDstHeight;
+  uint8* dst_v = dst_u + SUBSAMPLE(kDstWidth, 2) * SUBSAMPLE(kDstHeight, 2);
+  ConvertToI420(src_argb, kSrcSize,
+                rotated, kHeight,
+                rotated_u, SUBSAMPLE(kHeight, 2),
+                rotated_v, SUBSAMPLE(kHeight, 2),
+                0, 0, kWidth, kHeight, kWidth, kHeight,
+                kRotate270, FOURCC_ARGB);
+  I420Scale(rotated, kHeight,
+            rotated_u, SUBSAMPLE(kHeight, 2),
+            rotated_v, SUBSAMPLE(kHeight, 2),
+            kHeight, kWidth,
+            dst_c, kDstWidth,
+            dst_u, SUBSAMPLE(kDstWidth, 2),
+            dst_v, SUBSAMPLE(kDstWidth, 2),
+            kDstWidth, kDstHeight, kFilterBox);
+
+  FrameConvertPlan plan;
+  EXPECT_EQ(0, FrameConvertPlanInit(&plan, FOURCC_ARGB, kWidth, kHeight,
+                                    0, 0, kWidth, kHeight,
+                                    FOURCC_I420, kDstWidth, kDstHeight,
+                                    kRotate270, kFilterBox));
+  EXPECT_EQ(3, plan.num_steps);
+  // Run twice to check the plan can be reused.
+  EXPECT_EQ(0, FrameConvertPlanRun(&plan, src_argb, kSrcSize, dst_opt, 0));
+  EXPECT_EQ(0, FrameConvertPlanRun(&plan, src_argb, kSrcSize, dst_opt, 0));
+  FrameConvertPlanFree(&plan);
+  for (int i = 0; i < kDstSize; ++i) {
+    EXPECT_EQ(dst_c[i], dst_opt[i]);
+  }
+  free_aligned_buffer_64(src_argb);
+  free_aligned_buffer_64(rotated);
+  free_aligned_buffer_64(dst_c);
+  free_aligned_buffer_64(dst_opt);
+}
+
+// Fast precision is within 1 of exact precision for every y, u and v.
+TEST_F(libyuvTest, I420ToARGBFastPrecisionExhaustive) {
+  const int kWidth = 512;
+  const int kHeight = 2;
+  const int kHalfWidth = kWidth / 2;
+#if !defined(LIBYUV_TARGET_FLAGS)  // MaskCpuFlags has no effect.
+  // Without AVX2 the SSSE3 fast kernel is used.
+  const int kCpuMasks[] = { -1, ~kCpuHasAVX2 };
+#else
+  const int kCpuMasks[] = { -1 };
+#endif
+  const int kNumCpuMasks =
+      static_cast<int>(sizeof(kCpuMasks) / sizeof(kCpuMasks[0]));
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kHalfWidth);
+  align_buffer_64(src_v, kHalfWidth);
+  align_buffer_64(dst_exact, kWidth * kHeight * 4);
+  align_buffer_64(dst_fast, kWidth * kHeight * 4);
+
+  for (int x = 0; x < kHalfWidth; ++x) {
+    src_v[x] = x;
+  }
+  for (int m = 0; m < kNumCpuMasks; ++m) {
+    int max_diff = 0;
+    MaskCpuFlags(kCpuMasks[m]);
+    for (int u = 0; u < 256; ++u) {
+      memset(src_u, u, kHalfWidth);
+      for (int yblock = 0; yblock < 64; ++yblock) {
+        for (int i = 0; i < kWidth * kHeight; ++i) {
+          src_y[i] = yblock * 4 + (i & 1) + 2 * (i / kWidth);
+        }
+        SetPrecision(kPrecisionExact);
+        I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                   dst_exact, kWidth * 4, kWidth, kHeight);
+        SetPrecision(kPrecisionFast);
+        I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                   dst_fast, kWidth * 4, kWidth, kHeight);
+        for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+          int abs_diff = abs(static_cast<int>(dst_exact[i]) -
+                             static_cast<int>(dst_fast[i]));
+          if (abs_diff > max_diff) {
+            max_diff = abs_diff;
+          }
+        }
+      }
+    }
+    SetPrecision(kPrecisionExact);
+    EXPECT_LE(max_diff, 1);
+  }
+  MaskCpuFlags(-1);
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_exact);
+  free_aligned_buffer_64(dst_fast);
+}
+
+TEST_F(libyuvTest, I420ToARGBFastPrecision) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);
+  const int kHalfHeight = SUBSAMPLE(kHeight, 2);
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kHalfWidth * kHalfHeight);
+  align_buffer_64(src_v, kHalfWidth * kHalfHeight);
+  align_buffer_64(dst_exact, kWidth * kHeight * 4);
+  align_buffer_64(dst_fast, kWidth * kHeight * 4);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_u, kHalfWidth * kHalfHeight);
+  MemRandomize(src_v, kHalfWidth * kHalfHeight);
+
+  MaskCpuFlags(-1);
+  I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+             dst_exact, kWidth * 4, kWidth, kHeight);
+  SetPrecision(kPrecisionFast);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+               dst_fast, kWidth * 4, kWidth, kHeight);
+  }
+  SetPrecision(kPrecisionExact);
+  int max_diff = 0;
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    int abs_diff = abs(static_cast<int>(dst_exact[i]) -
+                       static_cast<int>(dst_fast[i]));
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  EXPECT_LE(max_diff, 1);
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_exact);
+  free_aligned_buffer_64(dst_fast);
+}
+
+// Chroma for luma pixel (x, y) filtered from its 4 nearest chroma samples,
+// weighted 9:3:3:1.  Chroma is sited between pixels, so neighbours past the
+// edge are replaced by the nearest sample.
+static int FilterChromaSample(const uint8* src, int stride, int halfwidth,
+                              int halfheight, int x, int y,
+                              FilterMode filtering) {
+  int kx = x >> 1;
+  int ky = y >> 1;
+  int nx = (x & 1) ? kx + 1 : kx - 1;
+  int ny = (y & 1) ? ky + 1 : ky - 1;
+  if (nx < 0 || nx >= halfwidth) {
+    nx = kx;
+  }
+  if (ny < 0 || ny >= halfheight || filtering == kFilterLinear) {
+    ny = ky;
+  }
+  return (src[ky * stride + kx] * 9 + src[ky * stride + nx] * 3 +
+          src[ny * stride + kx] * 3 + src[ny * stride + nx] + 8) >> 4;
+}
+
+static void TestI420ToARGBFilter(int width, int height, FilterMode filtering,
+                                 int benchmark_iterations,
+                                 int disable_cpu_flags) {
+  const int kHalfWidth = SUBSAMPLE(width, 2);
+  const int kHalfHeight = SUBSAMPLE(height, 2);
+  align_buffer_64(src_y, width * height);
+  align_buffer_64(src_u, kHalfWidth * kHalfHeight);
+  align_buffer_64(src_v, kHalfWidth * kHalfHeight);
+  align_buffer_64(src_uv, kHalfWidth * 2 * kHalfHeight);
+  align_buffer_64(dst_u, width * height);
+  align_buffer_64(dst_v, width * height);
+  align_buffer_64(dst_argb_ref, width * height * 4);
+  align_buffer_64(dst_argb_c, width * height * 4);
+  align_buffer_64(dst_argb_opt, width * height * 4);
+  MemRandomize(src_y, width * height);
+  MemRandomize(src_u, kHalfWidth * kHalfHeight);
+  MemRandomize(src_v, kHalfWidth * kHalfHeight);
+  for (int i = 0; i < kHalfWidth * kHalfHeight; ++i) {
+    src_uv[i * 2 + 0] = src_u[i];
+    src_uv[i * 2 + 1] = src_v[i];
+  }
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      dst_u[y * width + x] = FilterChromaSample(src_u, kHalfWidth, kHalfWidth,
+                                                kHalfHeight, x, y, filtering);
+      dst_v[y * width + x] = FilterChromaSample(src_v, kHalfWidth, kHalfWidth,
+                                                kHalfHeight, x, y, filtering);
+    }
+  }
+  I444ToARGB(src_y, width, dst_u, width, dst_v, width,
+             dst_argb_ref, width * 4, width, height);
+
+  MaskCpuFlags(disable_cpu_flags);
+  EXPECT_EQ(0, I420ToARGBFilter(src_y, width, src_u, kHalfWidth,
+                                src_v, kHalfWidth, dst_argb_c, width * 4,
+                                width, height, filtering));
+  MaskCpuFlags(-1);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    EXPECT_EQ(0, I420ToARGBFilter(src_y, width, src_u, kHalfWidth,
+                                  src_v, kHalfWidth, dst_argb_opt, width * 4,
+                                  width, height, filtering));
+  }
+  EXPECT_EQ(0, memcmp(dst_argb_ref, dst_argb_c, width * height * 4));
+  EXPECT_EQ(0, memcmp(dst_argb_ref, dst_argb_opt, width * height * 4));
+
+  // NV12 filters the same as I420.
+  memset(dst_argb_opt, 0, width * height * 4);
+  EXPECT_EQ(0, NV12ToARGBFilter(src_y, width, src_uv, kHalfWidth * 2,
+                                dst_argb_opt, width * 4, width, height,
+                                filtering));
+  EXPECT_EQ(0, memcmp(dst_argb_ref, dst_argb_opt, width * height * 4));
+
+  // Negative height writes the same rows bottom up.
+  EXPECT_EQ(0, I420ToARGBFilter(src_y, width, src_u, kHalfWidth,
+                                src_v, kHalfWidth, dst_argb_opt, width * 4,
+                                width, -height, filtering));
+  for (int y = 0; y < height; ++y) {
+    EXPECT_EQ(0, memcmp(dst_argb_ref + y * width * 4,
+                        dst_argb_opt + (height - 1 - y) * width * 4,
+                        width * 4));
+  }
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(src_uv);
+  free_aligned_buffer_64(dst_u);
+  free_aligned_buffer_64(dst_v);
+  free_aligned_buffer_64(dst_argb_ref);
+  free_aligned_buffer_64(dst_argb_c);
+  free_aligned_buffer_64(dst_argb_opt);
+}
+
+TEST_F(libyuvTest, I420ToARGBFilter_Bilinear) {
+  TestI420ToARGBFilter(benchmark_width_, benchmark_height_, kFilterBilinear,
+                       benchmark_iterations_, disable_cpu_flags_);
+}
+
+TEST_F(libyuvTest, I420ToARGBFilter_Linear) {
+  TestI420ToARGBFilter(benchmark_width_, benchmark_height_, kFilterLinear,
+                       benchmark_iterations_, disable_cpu_flags_);
+}
+
+TEST_F(libyuvTest, I420ToARGBFilter_Odd) {
+  TestI420ToARGBFilter(benchmark_width_ - 3, benchmark_height_ - 1,
+                       kFilterBilinear, 1, disable_cpu_flags_);
+  TestI420ToARGBFilter(1, 1, kFilterBilinear, 1, disable_cpu_flags_);
+  TestI420ToARGBFilter(2, 3, kFilterBox, 1, disable_cpu_flags_);
+  TestI420ToARGBFilter(35, 2, kFilterBilinear, 1, disable_cpu_flags_);
+  // Chroma widths that are whole SSE2 and AVX2 upsample rows.
+  TestI420ToARGBFilter(33, 4, kFilterBilinear, 1, disable_cpu_flags_);
+  TestI420ToARGBFilter(65, 4, kFilterBilinear, 1, disable_cpu_flags_);
+}
+
+// kFilterNone is the same as I420ToARGB.
+TEST_F(libyuvTest, I420ToARGBFilter_None) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);
+  const int kHalfHeight = SUBSAMPLE(kHeight, 2);
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kHalfWidth * kHalfHeight);
+  align_buffer_64(src_v, kHalfWidth * kHalfHeight);
+  align_buffer_64(dst_argb, kWidth * kHeight * 4);
+  align_buffer_64(dst_argb_none, kWidth * kHeight * 4);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_u, kHalfWidth * kHalfHeight);
+  MemRandomize(src_v, kHalfWidth * kHalfHeight);
+
+  I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+             dst_argb, kWidth * 4, kWidth, kHeight);
+  EXPECT_EQ(0, I420ToARGBFilter(src_y, kWidth, src_u, kHalfWidth,
+                                src_v, kHalfWidth, dst_argb_none, kWidth * 4,
+                                kWidth, kHeight, kFilterNone));
+  EXPECT_EQ(0, memcmp(dst_argb, dst_argb_none, kWidth * kHeight * 4));
+  EXPECT_EQ(-1, I420ToARGBFilter(src_y, kWidth, NULL, kHalfWidth,
+                                 src_v, kHalfWidth, dst_argb_none, kWidth * 4,
+                                 kWidth, kHeight, kFilterBilinear));
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_argb);
+  free_aligned_buffer_64(dst_argb_none);
+}
+
 }  // namespace libyuv
@@ -13,7 +13,8 @@
 
 #include "libyuv/basic_types.h"
 #include "libyuv/cpu_id.h"
-#include "libyuv/row.h"  // For HAS_ARGBSHUFFLEROW_AVX2.
+#include "libyuv/planar_functions.h"  // For SetPrecision.
+#include "libyuv/row.h"  // For HAS_ARGBSHUFFLEROW_AVX2 and GetRowFunctions.
 #include "libyuv/version.h"
 #include "../unit_test/unit_test.h"
 
@@ -135,4 +136,130 @@ TEST_F(libyuvTest, TestLinuxNeon) {
 #endif
 }
 
+TEST_F(libyuvTest, TestCpuCacheInfo) {
+  CpuCacheInfo info;
+  GetCpuCacheInfo(&info);
+  printf("L1 %d KB, L2 %d KB, L3 %d KB, line %d bytes\n",
+         info.l1d_size / 1024, info.l2_size / 1024, info.l3_size / 1024,
+         info.line_size);
+  printf("Cores %d, threads %d\n", info.num_cores, info.num_threads);
+  EXPECT_GE(info.l1d_size, 4096);
+  EXPECT_GE(info.l2_size, info.l1d_size);
+  EXPECT_GE(info.l3_size, 0);
+  EXPECT_EQ(0, info.line_size & (info.line_size - 1));  // Power of 2.
+  EXPECT_GE(info.num_cores, 1);
+  EXPECT_GE(info.num_threads, info.num_cores);
+
+  // Replaced topology is returned until detection is restored.
+  CpuCacheInfo small = { 16 * 1024, 128 * 1024, 0, 32, 1, 1 };
+  CpuCacheInfo replaced;
+  SetCpuCacheInfo(&small);
+  GetCpuCacheInfo(&replaced);
+  EXPECT_EQ(128 * 1024, replaced.l2_size);
+  EXPECT_EQ(32, replaced.line_size);
+  SetCpuCacheInfo(NULL);
+  GetCpuCacheInfo(&replaced);
+  EXPECT_EQ(0, memcmp(&info, &replaced, sizeof(info)));
+}
+
+TEST_F(libyuvTest, TestLinuxCpuCacheInfo) {
+  CpuCacheInfo info;
+  memset(&info, 0, sizeof(info));
+  EXPECT_EQ(0, LinuxCpuCacheInfo("/nonexistent", &info));
+  EXPECT_EQ(0, info.l2_size);
+  if (FileExists("../../unit_test/testdata/sys_cpu/cpu0/cache/index0/size")) {
+    EXPECT_NE(0, LinuxCpuCacheInfo("../../unit_test/testdata/sys_cpu",
+                                   &info));
+    EXPECT_EQ(48 * 1024, info.l1d_size);
+    EXPECT_EQ(1280 * 1024, info.l2_size);
+    EXPECT_EQ(30 * 1024 * 1024, info.l3_size);
+    EXPECT_EQ(64, info.line_size);
+    EXPECT_EQ(2, info.num_cores);
+    EXPECT_EQ(4, info.num_threads);
+  } else {
+    printf("WARNING: unable to load \"../../unit_test/testdata/sys_cpu\"\n");
+  }
+}
+
+#if defined(LIBYUV_TARGET_FLAGS)
+// Cpu flags are fixed by the build.
+TEST_F(libyuvTest, TestCpuTarget) {
+  EXPECT_EQ(LIBYUV_TARGET_FLAGS, TestCpuFlag(-1));
+  MaskCpuFlags(0);
+  EXPECT_EQ(LIBYUV_TARGET_FLAGS, TestCpuFlag(-1));
+  EXPECT_EQ(LIBYUV_TARGET_FLAGS, GetRowFunctions()->cpu_info);
+  MaskCpuFlags(-1);
+}
+
+// The kernels picked at compile time match the table.
+TEST_F(libyuvTest, TestRowFunctionsTarget) {
+  for (int fast = 0; fast < 2; ++fast) {
+    SetPrecision(fast ? kPrecisionFast : kPrecisionExact);
+    const struct RowFunctions* rows = GetRowFunctions();
+    EXPECT_EQ(fast, rows->fast);
+    for (int width = 1; width <= 64; ++width) {
+      EXPECT_TRUE(ROW_FUNCTION(rows, CopyRow, width) ==
+                  ROW_TABLE_FUNCTION(rows, CopyRow, width));
+      EXPECT_TRUE(ROW_FUNCTION(rows, SetRow, width) ==
+                  ROW_TABLE_FUNCTION(rows, SetRow, width));
+      EXPECT_TRUE(ROW_FUNCTION(rows, MergeUVRow, width) ==
+                  ROW_TABLE_FUNCTION(rows, MergeUVRow, width));
+      EXPECT_TRUE(ROW_FUNCTION(rows, I422ToARGBRow, width) ==
+                  ROW_TABLE_FUNCTION(rows, I422ToARGBRow, width));
+      EXPECT_TRUE(ROW_FUNCTION(rows, NV12ToARGBRow, width) ==
+                  ROW_TABLE_FUNCTION(rows, NV12ToARGBRow, width));
+      EXPECT_TRUE(ROW_FUNCTION(rows, ARGBToYRow, width) ==
+                  ROW_TABLE_FUNCTION(rows, ARGBToYRow, width));
+      EXPECT_TRUE(ROW_FUNCTION(rows, ARGBToUVRow, width) ==
+                  ROW_TABLE_FUNCTION(rows, ARGBToUVRow, width));
+      EXPECT_TRUE(ROW_FUNCTION(rows, ARGBToI420Row, width) ==
+                  ROW_TABLE_FUNCTION(rows, ARGBToI420Row, width));
+    }
+  }
+  SetPrecision(kPrecisionExact);
+}
+#else
+// The row function table follows MaskCpuFlags.
+TEST_F(libyuvTest, TestRowFunctions) {
+  MaskCpuFlags(0);
+  const struct RowFunctions* rows = GetRowFunctions();
+  EXPECT_EQ(0, rows->cpu_info);
+  EXPECT_TRUE(rows->CopyRow == CopyRow_C);
+  EXPECT_TRUE(ROW_FUNCTION(rows, I422ToARGBRow, 7) == I422ToARGBRow_C);
+  EXPECT_TRUE(rows->ARGBToI420Row == NULL);
+
+  MaskCpuFlags(-1);
+  rows = GetRowFunctions();
+  EXPECT_EQ(TestCpuFlag(-1), rows->cpu_info);
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3) && !TestCpuFlag(kCpuHasAVX2)) {
+    EXPECT_TRUE(ROW_FUNCTION(rows, I422ToARGBRow, 64) == I422ToARGBRow_SSSE3);
+    EXPECT_TRUE(ROW_FUNCTION(rows, I422ToARGBRow, 7) ==
+                I422ToARGBRow_Any_SSSE3);
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    EXPECT_TRUE(ROW_FUNCTION(rows, I422ToARGBRow, 64) == I422ToARGBRow_AVX2);
+    EXPECT_TRUE(ROW_FUNCTION(rows, I422ToARGBRow, 7) ==
+                I422ToARGBRow_Any_AVX2);
+  }
+#endif
+}
+#endif  // LIBYUV_TARGET_FLAGS
+
+// A table that a caller still holds is not rebuilt after SetPrecision.
+TEST_F(libyuvTest, TestRowFunctionsPrecisionRebuild) {
+  SetPrecision(kPrecisionExact);
+  const struct RowFunctions* exact_rows = GetRowFunctions();
+  SetPrecision(kPrecisionFast);
+  const struct RowFunctions* fast_rows = GetRowFunctions();
+  EXPECT_TRUE(exact_rows != fast_rows);
+  EXPECT_EQ(0, exact_rows->fast);
+  EXPECT_EQ(1, fast_rows->fast);
+  SetPrecision(kPrecisionExact);
+  EXPECT_EQ(1, fast_rows->fast);
+  EXPECT_EQ(0, GetRowFunctions()->fast);
+}
+
 }  // namespace libyuv
@@ -0,0 +1,154 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libyuv/basic_types.h"
+#include "libyuv/convert_from.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/dispatch.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/row.h"
+#include "../unit_test/unit_test.h"
+
+namespace libyuv {
+
+static int num_dispatches = 0;
+static char last_function[64];
+static char last_kernel[64];
+static int last_any = 0;
+static int last_width = 0;
+
+static void RecordDispatch(const char* function, const char* kernel,
+                           LIBYUV_BOOL any, int width) {
+  ++num_dispatches;
+  strncpy(last_function, function, sizeof(last_function) - 1);
+  strncpy(last_kernel, kernel, sizeof(last_kernel) - 1);
+  last_any = any;
+  last_width = width;
+}
+
+TEST_F(libyuvTest, TestGetKernelName) {
+  EXPECT_STREQ("CopyRow_C",
+               GetKernelName(reinterpret_cast<const void*>(CopyRow_C)));
+#if defined(HAS_COPYROW_SSE2)
+  EXPECT_STREQ("CopyRow_Any_SSE2",
+               GetKernelName(reinterpret_cast<const void*>(CopyRow_Any_SSE2)));
+#endif
+  EXPECT_TRUE(NULL == GetKernelName(reinterpret_cast<const void*>(malloc)));
+}
+
+TEST_F(libyuvTest, TestKernelDispatchCallback) {
+  const int kWidth = 1280;
+  align_buffer_64(src, kWidth);
+  align_buffer_64(dst, kWidth);
+  memset(src, 1, kWidth);
+  num_dispatches = 0;
+  SetKernelDispatchCallback(RecordDispatch);
+
+  MaskCpuFlags(0);
+  CopyPlane(src, kWidth, dst, kWidth, kWidth, 1);
+  EXPECT_EQ(1, num_dispatches);
+  EXPECT_STREQ("CopyPlane", last_function);
+#if !defined(LIBYUV_TARGET_FLAGS)  // MaskCpuFlags has no effect.
+  EXPECT_STREQ("CopyRow_C", last_kernel);
+  EXPECT_EQ(0, last_any);
+#endif
+  EXPECT_EQ(kWidth, last_width);
+
+  // An odd width can only use an _Any_ row function, if any.
+  MaskCpuFlags(-1);
+  CopyPlane(src, kWidth, dst, kWidth, kWidth - 1, 1);
+  EXPECT_EQ(2, num_dispatches);
+  EXPECT_STRNE("unknown", last_kernel);
+  EXPECT_EQ(strstr(last_kernel, "_Any_") != NULL, last_any != 0);
+  EXPECT_EQ(kWidth - 1, last_width);
+
+  SetKernelDispatchCallback(NULL);
+  CopyPlane(src, kWidth, dst, kWidth, kWidth, 1);
+  EXPECT_EQ(2, num_dispatches);
+
+  free_aligned_buffer_64(src);
+  free_aligned_buffer_64(dst);
+}
+
+// Reports the unaligned width that misses I422ToARGBRow_SSSE3.
+TEST_F(libyuvTest, TestKernelDispatchI420ToARGB) {
+  const int kWidth = 17;
+  const int kHeight = 2;
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kWidth);
+  align_buffer_64(src_v, kWidth);
+  align_buffer_64(dst_argb, kWidth * kHeight * 4);
+  memset(src_y, 16, kWidth * kHeight);
+  memset(src_u, 128, kWidth);
+  memset(src_v, 128, kWidth);
+  num_dispatches = 0;
+  SetKernelDispatchCallback(RecordDispatch);
+  MaskCpuFlags(-1);
+  I420ToARGB(src_y, kWidth, src_u, kWidth, src_v, kWidth,
+             dst_argb, kWidth * 4, kWidth, kHeight);
+  SetKernelDispatchCallback(NULL);
+
+  EXPECT_EQ(1, num_dispatches);
+  EXPECT_STREQ("I420ToARGB", last_function);
+  EXPECT_EQ(0, strncmp(last_kernel, "I422ToARGBRow_", 14));
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    EXPECT_EQ(1, last_any);
+  }
+#endif
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_argb);
+}
+
+// Fast precision reports its own kernels by name.
+TEST_F(libyuvTest, TestKernelDispatchI420ToARGBFast) {
+  const int kWidth = 64;
+  const int kHeight = 2;
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kWidth);
+  align_buffer_64(src_v, kWidth);
+  align_buffer_64(dst_argb, kWidth * kHeight * 4);
+  memset(src_y, 16, kWidth * kHeight);
+  memset(src_u, 128, kWidth);
+  memset(src_v, 128, kWidth);
+  num_dispatches = 0;
+  SetKernelDispatchCallback(RecordDispatch);
+  MaskCpuFlags(-1);
+  SetPrecision(kPrecisionFast);
+  I420ToARGB(src_y, kWidth, src_u, kWidth, src_v, kWidth,
+             dst_argb, kWidth * 4, kWidth, kHeight);
+  I420ToARGB(src_y, kWidth, src_u, kWidth, src_v, kWidth,
+             dst_argb, kWidth * 4, kWidth - 1, kHeight);
+  SetPrecision(kPrecisionExact);
+  SetKernelDispatchCallback(NULL);
+
+  EXPECT_EQ(2, num_dispatches);
+  EXPECT_STREQ("I420ToARGB", last_function);
+  EXPECT_STRNE("unknown", last_kernel);
+  EXPECT_EQ(strstr(last_kernel, "_Any_") != NULL, last_any != 0);
+#if defined(HAS_I422TOARGBFASTROW_SSSE3) && !defined(LIBYUV_TARGET_FLAGS)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    EXPECT_EQ(0, strncmp(last_kernel, "I422ToARGBFastRow_Any_", 22));
+  }
+#endif
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_argb);
+}
+
+}  // namespace libyuv
@@ -0,0 +1,125 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libyuv/basic_types.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/frame_buffer_pool.h"
+#include "libyuv/row.h"
+#include "libyuv/video_common.h"
+#include "../unit_test/unit_test.h"
+
+namespace libyuv {
+
+static bool IsFrameAligned(const FrameBuffer* buffer) {
+  for (int i = 0; i < buffer->num_planes; ++i) {
+    if (!IS_ALIGNED(buffer->plane[i], kFrameBufferAlignment) ||
+        !IS_ALIGNED(buffer->stride[i], kFrameBufferAlignment)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST_F(libyuvTest, FrameBufferPoolLayout) {
+  FrameBufferPool pool;
+  FrameBufferPoolInit(&pool, 0, 4);
+
+  FrameBuffer* i420 = FrameBufferPoolAcquire(&pool, FOURCC_IYUV, 33, 17);
+  ASSERT_TRUE(i420 != NULL);
+  EXPECT_EQ(FOURCC_I420, i420->fourcc);
+  EXPECT_EQ(3, i420->num_planes);
+  EXPECT_EQ(64, i420->stride[0]);
+  EXPECT_EQ(64, i420->stride[1]);
+  EXPECT_EQ(i420->plane[0] + 64 * 17, i420->plane[1]);
+  EXPECT_EQ(i420->plane[1] + 64 * 9, i420->plane[2]);
+  EXPECT_TRUE(IsFrameAligned(i420));
+
+  FrameBuffer* nv12 = FrameBufferPoolAcquire(&pool, FOURCC_NV12, 65, 3);
+  ASSERT_TRUE(nv12 != NULL);
+  EXPECT_EQ(2, nv12->num_planes);
+  EXPECT_EQ(128, nv12->stride[0]);
+  EXPECT_EQ(128, nv12->stride[1]);
+  EXPECT_TRUE(nv12->plane[2] == NULL);
+  EXPECT_TRUE(IsFrameAligned(nv12));
+
+  FrameBuffer* rgb24 = FrameBufferPoolAcquire(&pool, FOURCC_24BG, 100, 2);
+  ASSERT_TRUE(rgb24 != NULL);
+  EXPECT_EQ(1, rgb24->num_planes);
+  EXPECT_EQ(320, rgb24->stride[0]);
+  EXPECT_TRUE(IsFrameAligned(rgb24));
+
+  EXPECT_TRUE(FrameBufferPoolAcquire(&pool, FOURCC_MJPG, 64, 64) == NULL);
+  EXPECT_TRUE(FrameBufferPoolAcquire(&pool, FOURCC_I420, 0, 64) == NULL);
+
+  FrameBufferPoolRelease(&pool, i420);
+  FrameBufferPoolRelease(&pool, nv12);
+  FrameBufferPoolRelease(&pool, rgb24);
+  FrameBufferPoolFree(&pool);
+}
+
+TEST_F(libyuvTest, FrameBufferPoolRecycle) {
+  FrameBufferPool pool;
+  FrameBufferPoolInit(&pool, 0, 2);
+
+  FrameBuffer* a = FrameBufferPoolAcquire(&pool, FOURCC_I420, 64, 64);
+  FrameBuffer* b = FrameBufferPoolAcquire(&pool, FOURCC_I420, 32, 32);
+  FrameBuffer* c = FrameBufferPoolAcquire(&pool, FOURCC_ARGB, 64, 64);
+  ASSERT_TRUE(a != NULL && b != NULL && c != NULL);
+  FrameBufferPoolRelease(&pool, a);
+  FrameBufferPoolRelease(&pool, b);
+  EXPECT_EQ(2, pool.num_free);
+  // Full pool drops the oldest frame, a.
+  FrameBufferPoolRelease(&pool, c);
+  EXPECT_EQ(2, pool.num_free);
+
+  // Same geometry is reused.
+  EXPECT_EQ(b, FrameBufferPoolAcquire(&pool, FOURCC_I420, 32, 32));
+  EXPECT_EQ(c, FrameBufferPoolAcquire(&pool, FOURCC_ARGB, 64, 64));
+  EXPECT_EQ(0, pool.num_free);
+  FrameBufferPoolRelease(&pool, b);
+  FrameBufferPoolRelease(&pool, c);
+  FrameBufferPoolFree(&pool);
+  EXPECT_EQ(0, pool.num_free);
+}
+
+// Large frames with huge pages requested are usable.
+TEST_F(libyuvTest, FrameBufferPoolHugePages) {
+  const int kWidth = 1920;
+  const int kHeight = 1080;
+  FrameBufferPool pool;
+  FrameBufferPoolInit(&pool, kFrameBufferPoolHugePages, 2);
+
+  FrameBuffer* i420 = FrameBufferPoolAcquire(&pool, FOURCC_I420,
+                                             kWidth, kHeight);
+  FrameBuffer* argb = FrameBufferPoolAcquire(&pool, FOURCC_ARGB,
+                                             kWidth, kHeight);
+  ASSERT_TRUE(i420 != NULL && argb != NULL);
+  EXPECT_TRUE(IsFrameAligned(i420));
+  EXPECT_TRUE(IsFrameAligned(argb));
+  memset(i420->plane[0], 128, i420->stride[0] * kHeight);
+  memset(i420->plane[1], 128, i420->stride[1] * kHeight / 2);
+  memset(i420->plane[2], 128, i420->stride[2] * kHeight / 2);
+  EXPECT_EQ(0, I420ToARGB(i420->plane[0], i420->stride[0],
+                          i420->plane[1], i420->stride[1],
+                          i420->plane[2], i420->stride[2],
+                          argb->plane[0], argb->stride[0],
+                          kWidth, kHeight));
+  uint8* last = argb->plane[0] + argb->stride[0] * (kHeight - 1);
+  EXPECT_EQ(255u, last[(kWidth - 1) * 4 + 3]);
+
+  FrameBufferPoolRelease(&pool, i420);
+  FrameBufferPoolRelease(&pool, argb);
+  FrameBufferPoolFree(&pool);
+}
+
+}  // namespace libyuv
@@ -11,6 +11,10 @@
 #include <stdlib.h>
 #include <time.h>
 
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
 #include "libyuv/compare.h"
 #include "libyuv/convert.h"
 #include "libyuv/convert_argb.h"
@@ -785,6 +789,70 @@ TEST_F(libyuvTest, TestARGBMirror) {
   }
 }
 
+// NV12Mirror matches I420Mirror with U and V interleaved, and with a
+// negative height matches NV12Rotate by 180.
+TEST_F(libyuvTest, TestNV12Mirror) {
+  const int kWidth = benchmark_width_ - 3 > 0 ? benchmark_width_ - 3 : 1;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  const int kUVSize = kHalfWidth * kHalfHeight;
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_uv, kUVSize * 2);
+  align_buffer_64(src_u, kUVSize);
+  align_buffer_64(src_v, kUVSize);
+  align_buffer_64(dst_y, kWidth * kHeight);
+  align_buffer_64(dst_uv, kUVSize * 2);
+  align_buffer_64(dst_uv_c, kUVSize * 2);
+  align_buffer_64(dst_i420, kWidth * kHeight + kUVSize * 2);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_uv, kUVSize * 2);
+  for (int i = 0; i < kUVSize; ++i) {
+    src_u[i] = src_uv[i * 2 + 0];
+    src_v[i] = src_uv[i * 2 + 1];
+  }
+
+  MaskCpuFlags(disable_cpu_flags_);
+  EXPECT_EQ(0, NV12Mirror(src_y, kWidth, src_uv, kHalfWidth * 2,
+                          dst_y, kWidth, dst_uv_c, kHalfWidth * 2,
+                          kWidth, kHeight));
+  MaskCpuFlags(-1);
+  {
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);
+    for (int i = 0; i < benchmark_iterations_; ++i) {
+      NV12Mirror(src_y, kWidth, src_uv, kHalfWidth * 2,
+                 dst_y, kWidth, dst_uv, kHalfWidth * 2, kWidth, kHeight);
+    }
+  }
+  EXPECT_EQ(0, memcmp(dst_uv_c, dst_uv, kUVSize * 2));
+  I420Mirror(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+             dst_i420, kWidth, dst_i420 + kWidth * kHeight, kHalfWidth,
+             dst_i420 + kWidth * kHeight + kUVSize, kHalfWidth,
+             kWidth, kHeight);
+  EXPECT_EQ(0, memcmp(dst_i420, dst_y, kWidth * kHeight));
+  for (int i = 0; i < kUVSize; ++i) {
+    EXPECT_EQ(dst_i420[kWidth * kHeight + i], dst_uv[i * 2 + 0]);
+    EXPECT_EQ(dst_i420[kWidth * kHeight + kUVSize + i], dst_uv[i * 2 + 1]);
+  }
+
+  NV12Mirror(src_y, kWidth, src_uv, kHalfWidth * 2,
+             dst_y, kWidth, dst_uv, kHalfWidth * 2, kWidth, -kHeight);
+  NV12Rotate(src_y, kWidth, src_uv, kHalfWidth * 2,
+             dst_i420, kWidth, dst_uv_c, kHalfWidth * 2,
+             kWidth, kHeight, kRotate180);
+  EXPECT_EQ(0, memcmp(dst_i420, dst_y, kWidth * kHeight));
+  EXPECT_EQ(0, memcmp(dst_uv_c, dst_uv, kUVSize * 2));
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_uv);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_y);
+  free_aligned_buffer_64(dst_uv);
+  free_aligned_buffer_64(dst_uv_c);
+  free_aligned_buffer_64(dst_i420);
+}
+
 TEST_F(libyuvTest, TestShade) {
   SIMD_ALIGNED(uint8 orig_pixels[1280][4]);
   SIMD_ALIGNED(uint8 shade_pixels[1280][4]);
@@ -947,11 +1015,14 @@ TEST_F(libyuvTest, ARGBInterpolate##TERP##N) {                                 \
                   dst_argb_c, kStrideB,                                        \
                   kWidth, NEG kHeight, TERP);                                  \
   MaskCpuFlags(-1);                                                            \
-  for (int i = 0; i < benchmark_iterations_; ++i) {                            \
-    ARGBInterpolate(src_argb_a + OFF, kStrideA,                                \
-                    src_argb_b + OFF, kStrideA,                                \
-                    dst_argb_opt, kStrideB,                                    \
-                    kWidth, NEG kHeight, TERP);                                \
+  {                                                                            \
+    PerfScope perf(kWidth, kHeight, benchmark_iterations_);                    \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                          \
+      ARGBInterpolate(src_argb_a + OFF, kStrideA,                              \
+                      src_argb_b + OFF, kStrideA,                              \
+                      dst_argb_opt, kStrideB,                                  \
+                      kWidth, NEG kHeight, TERP);                              \
+    }                                                                          \
   }                                                                            \
   int max_diff = 0;                                                            \
   for (int i = 0; i < kStrideB * kHeight; ++i) {                               \
@@ -1360,6 +1431,204 @@ TEST_F(libyuvTest, TestCopyPlane) {
   EXPECT_EQ(0, err);
 }
 
+// Streaming stores give the same result as cached stores.
+TEST_F(libyuvTest, TestCopyPlaneStreaming) {
+  const int kWidth = benchmark_width_ | 1;  // Odd width exercises the tail.
+  const int kHeight = benchmark_height_;
+  const int kStride = (kWidth + 15) & ~15;
+  align_buffer_64(src_y, kStride * kHeight);
+  align_buffer_64(dst_cached, kStride * kHeight);
+  align_buffer_64(dst_streamed, kStride * kHeight);
+  for (int i = 0; i < kStride * kHeight; ++i) {
+    src_y[i] = (random() & 0xff);
+  }
+  memset(dst_cached, 1, kStride * kHeight);
+  memset(dst_streamed, 1, kStride * kHeight);
+
+  SetStreamingStoreThreshold(-1);
+  CopyPlane(src_y, kStride, dst_cached, kStride, kWidth, kHeight);
+  SetStreamingStoreThreshold(0);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    CopyPlane(src_y, kStride, dst_streamed, kStride, kWidth, kHeight);
+  }
+  SetStreamingStoreThreshold(kStreamingStoreThreshold);
+  EXPECT_EQ(0, memcmp(dst_cached, dst_streamed, kStride * kHeight));
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(dst_cached);
+  free_aligned_buffer_64(dst_streamed);
+}
+
+TEST_F(libyuvTest, TestI420ToARGBStreaming) {
+  const int kWidth = benchmark_width_ | 1;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  const int kStrideARGB = (kWidth * 4 + 15) & ~15;
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kHalfWidth * kHalfHeight);
+  align_buffer_64(src_v, kHalfWidth * kHalfHeight);
+  align_buffer_64(dst_cached, kStrideARGB * kHeight);
+  align_buffer_64(dst_streamed, kStrideARGB * kHeight);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    src_y[i] = (random() & 0xff);
+  }
+  for (int i = 0; i < kHalfWidth * kHalfHeight; ++i) {
+    src_u[i] = (random() & 0xff);
+    src_v[i] = (random() & 0xff);
+  }
+  memset(dst_cached, 1, kStrideARGB * kHeight);
+  memset(dst_streamed, 1, kStrideARGB * kHeight);
+
+  SetStreamingStoreThreshold(-1);
+  I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+             dst_cached, kStrideARGB, kWidth, kHeight);
+  SetStreamingStoreThreshold(0);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+               dst_streamed, kStrideARGB, kWidth, kHeight);
+  }
+  SetStreamingStoreThreshold(kStreamingStoreThreshold);
+  EXPECT_EQ(0, memcmp(dst_cached, dst_streamed, kStrideARGB * kHeight));
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_cached);
+  free_aligned_buffer_64(dst_streamed);
+}
+
+// Time a pass over a small working set after each copy of a 4K ARGB frame,
+// as another workload sharing the cache would see it.  Streaming stores
+// leave the working set in cache.
+static double TimeWorkingSetAfterCopy(const uint8* src, uint8* dst,
+                                      int width, int height,
+                                      uint8* working_set, int working_size,
+                                      int iterations, uint32* sum) {
+  double time = 0.0;
+  for (int i = 0; i < iterations; ++i) {
+    CopyPlane(src, width, dst, width, width, height);
+    double start = get_time();
+    for (int j = 0; j < working_size; j += 64) {
+      *sum += working_set[j];
+      working_set[j] = static_cast<uint8>(*sum);
+    }
+    time += get_time() - start;
+  }
+  return time / iterations;
+}
+
+TEST_F(libyuvTest, BenchmarkCopyPlaneStreamingWorkingSet) {
+  const int kWidth = 3840 * 4;
+  const int kHeight = 2160;
+  const int kWorkingSize = 1024 * 1024;
+  align_buffer_64(src, kWidth * kHeight);
+  align_buffer_64(dst, kWidth * kHeight);
+  align_buffer_64(working_set, kWorkingSize);
+  memset(src, 3, kWidth * kHeight);
+  memset(dst, 0, kWidth * kHeight);  // Fault in pages before timing.
+  memset(working_set, 0, kWorkingSize);
+  uint32 sum = 0;
+
+  SetStreamingStoreThreshold(-1);
+  double copy_time = get_time();
+  CopyPlane(src, kWidth, dst, kWidth, kWidth, kHeight);
+  copy_time = get_time() - copy_time;
+  double cached_time = TimeWorkingSetAfterCopy(src, dst, kWidth, kHeight,
+      working_set, kWorkingSize, benchmark_iterations_, &sum);
+  SetStreamingStoreThreshold(0);
+  double stream_copy_time = get_time();
+  CopyPlane(src, kWidth, dst, kWidth, kWidth, kHeight);
+  stream_copy_time = get_time() - stream_copy_time;
+  double streamed_time = TimeWorkingSetAfterCopy(src, dst, kWidth, kHeight,
+      working_set, kWorkingSize, benchmark_iterations_, &sum);
+  SetStreamingStoreThreshold(kStreamingStoreThreshold);
+
+  printf("CopyPlane 4K ARGB cached %8d us streamed %8d us\n",
+         static_cast<int>(copy_time * 1e6),
+         static_cast<int>(stream_copy_time * 1e6));
+  printf("Working set after copy cached %8d us streamed %8d us\n",
+         static_cast<int>(cached_time * 1e6),
+         static_cast<int>(streamed_time * 1e6));
+  EXPECT_EQ(3, dst[kWidth * kHeight - 1]);
+
+  free_aligned_buffer_64(src);
+  free_aligned_buffer_64(dst);
+  free_aligned_buffer_64(working_set);
+}
+
+#if !defined(_WIN32)
+// A workload on another core that sweeps its working set until stopped.
+struct WorkingSetThread {
+  uint8* working_set;
+  int working_size;
+  volatile int stop;
+  int passes;
+  double time;
+  uint32 sum;
+};
+
+static void* WorkingSetThreadMain(void* arg) {
+  WorkingSetThread* thread = static_cast<WorkingSetThread*>(arg);
+  double start = get_time();
+  while (!thread->stop) {
+    for (int j = 0; j < thread->working_size; j += 64) {
+      thread->sum += thread->working_set[j];
+      thread->working_set[j] = static_cast<uint8>(thread->sum);
+    }
+    ++thread->passes;
+  }
+  thread->time = get_time() - start;
+  return NULL;
+}
+
+// Time a pass over the working set while this thread copies 4K ARGB frames,
+// which share the last level cache with it.
+static double TimeWorkingSetDuringCopy(const uint8* src, uint8* dst,
+                                       int width, int height,
+                                       uint8* working_set, int working_size,
+                                       int iterations) {
+  WorkingSetThread thread = { working_set, working_size, 0, 0, 0.0, 0u };
+  pthread_t thread_id;
+  pthread_create(&thread_id, NULL, WorkingSetThreadMain, &thread);
+  for (int i = 0; i < iterations; ++i) {
+    CopyPlane(src, width, dst, width, width, height);
+  }
+  thread.stop = 1;
+  pthread_join(thread_id, NULL);
+  return thread.passes ? thread.time / thread.passes : 0.0;
+}
+
+TEST_F(libyuvTest, BenchmarkCopyPlaneStreamingConcurrent) {
+  const int kWidth = 3840 * 4;
+  const int kHeight = 2160;
+  const int kWorkingSize = 4 * 1024 * 1024;
+  align_buffer_64(src, kWidth * kHeight);
+  align_buffer_64(dst, kWidth * kHeight);
+  align_buffer_64(working_set, kWorkingSize);
+  memset(src, 3, kWidth * kHeight);
+  memset(dst, 0, kWidth * kHeight);  // Fault in pages before timing.
+  memset(working_set, 0, kWorkingSize);
+
+  SetStreamingStoreThreshold(-1);
+  double cached_time = TimeWorkingSetDuringCopy(src, dst, kWidth, kHeight,
+      working_set, kWorkingSize, benchmark_iterations_);
+  SetStreamingStoreThreshold(0);
+  double streamed_time = TimeWorkingSetDuringCopy(src, dst, kWidth, kHeight,
+      working_set, kWorkingSize, benchmark_iterations_);
+  SetStreamingStoreThreshold(kStreamingStoreThreshold);
+
+  printf("Working set during copy cached %8d us streamed %8d us\n",
+         static_cast<int>(cached_time * 1e6),
+         static_cast<int>(streamed_time * 1e6));
+  EXPECT_EQ(3, dst[kWidth * kHeight - 1]);
+
+  free_aligned_buffer_64(src);
+  free_aligned_buffer_64(dst);
+  free_aligned_buffer_64(working_set);
+}
+#endif  // !defined(_WIN32)
+
 static int TestMultiply(int width, int height, int benchmark_iterations,
                         int disable_cpu_flags, int invert, int off) {
   if (width < 1) {
@@ -2198,4 +2467,135 @@ TEST_F(libyuvTest, SetPlane_Opt) {
   EXPECT_EQ(0, max_diff);
 }
 
+#if defined(HAS_I422TOARGBROW_SSSE3) && defined(HAS_NV12TOARGBROW_SSSE3) && \
+    defined(HAS_YUY2TOARGBROW_SSSE3) && defined(HAS_SPLITUVROW_SSE2)
+static int MaxRowDiff(const uint8* dst_c, const uint8* dst_opt, int size) {
+  int max_diff = 0;
+  for (int i = 0; i < size; ++i) {
+    int abs_diff = abs(static_cast<int>(dst_c[i]) -
+                       static_cast<int>(dst_opt[i]));
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  return max_diff;
+}
+
+// _Any_ row functions redo the last pixels with SIMD.  Check every tail
+// length matches C and nothing is written past the row.
+TEST_F(libyuvTest, TestAnyRowTails) {
+  const int kMaxWidth = 100;
+  // 2 rows of ARGB for the functions that subsample vertically.
+  align_buffer_64(src, kMaxWidth * 4 * 2);
+  align_buffer_64(dst_c, kMaxWidth * 4 + 16);
+  align_buffer_64(dst_opt, kMaxWidth * 4 + 16);
+  if (!TestCpuFlag(kCpuHasSSSE3)) {
+    printf("Skipped.  No SSSE3\n");
+  } else {
+    MemRandomize(src, kMaxWidth * 4 * 2);
+    for (int width = 1; width <= kMaxWidth; ++width) {
+      memset(dst_c, 0, kMaxWidth * 4 + 16);
+      memset(dst_opt, 0, kMaxWidth * 4 + 16);
+      I422ToARGBRow_C(src, src + kMaxWidth, src + kMaxWidth * 2, dst_c,
+                      width);
+      I422ToARGBRow_Any_SSSE3(src, src + kMaxWidth, src + kMaxWidth * 2,
+                              dst_opt, width);
+      EXPECT_EQ(0, memcmp(dst_c, dst_opt, kMaxWidth * 4 + 16));
+
+      NV12ToARGBRow_C(src, src + kMaxWidth, dst_c, width);
+      NV12ToARGBRow_Any_SSSE3(src, src + kMaxWidth, dst_opt, width);
+      EXPECT_EQ(0, memcmp(dst_c, dst_opt, kMaxWidth * 4 + 16));
+
+      memset(dst_c, 0, kMaxWidth * 4 + 16);
+      memset(dst_opt, 0, kMaxWidth * 4 + 16);
+      YUY2ToARGBRow_C(src, dst_c, width);
+      YUY2ToARGBRow_Any_SSSE3(src, dst_opt, width);
+      EXPECT_EQ(0, memcmp(dst_c, dst_opt, kMaxWidth * 4 + 16));
+
+      memset(dst_c, 0, kMaxWidth * 4 + 16);
+      memset(dst_opt, 0, kMaxWidth * 4 + 16);
+      SplitUVRow_C(src, dst_c, dst_c + kMaxWidth + 8, width);
+      SplitUVRow_Any_SSE2(src, dst_opt, dst_opt + kMaxWidth + 8, width);
+      EXPECT_EQ(0, memcmp(dst_c, dst_opt, kMaxWidth * 4 + 16));
+
+#if defined(HAS_MERGEUVROW_SSE2)
+      memset(dst_c, 0, kMaxWidth * 4 + 16);
+      memset(dst_opt, 0, kMaxWidth * 4 + 16);
+      MergeUVRow_C(src, src + kMaxWidth, dst_c, width);
+      MergeUVRow_Any_SSE2(src, src + kMaxWidth, dst_opt, width);
+      EXPECT_EQ(0, memcmp(dst_c, dst_opt, kMaxWidth * 4 + 16));
+#endif
+
+      // ARGB to YUV SIMD rounds differently than C, so allow a difference
+      // of 2.  Y, U and V are at least 16, so writing past the row into the
+      // zeroed buffer is still caught.
+#if defined(HAS_ARGBTOYROW_SSSE3)
+      memset(dst_c, 0, kMaxWidth * 4 + 16);
+      memset(dst_opt, 0, kMaxWidth * 4 + 16);
+      ARGBToYRow_C(src, dst_c, width);
+      ARGBToYRow_Any_SSSE3(src, dst_opt, width);
+      EXPECT_LE(MaxRowDiff(dst_c, dst_opt, kMaxWidth * 4 + 16), 2);
+#endif
+
+#if defined(HAS_ARGBTOUVROW_SSSE3)
+      memset(dst_c, 0, kMaxWidth * 4 + 16);
+      memset(dst_opt, 0, kMaxWidth * 4 + 16);
+      ARGBToUVRow_C(src, kMaxWidth * 4, dst_c, dst_c + kMaxWidth, width);
+      ARGBToUVRow_Any_SSSE3(src, kMaxWidth * 4, dst_opt, dst_opt + kMaxWidth,
+                            width);
+      EXPECT_LE(MaxRowDiff(dst_c, dst_opt, kMaxWidth * 4 + 16), 2);
+#endif
+
+#if defined(HAS_ARGBTOI420ROW_SSSE3)
+      // 2 rows of Y, then U and V.
+      memset(dst_c, 0, kMaxWidth * 4 + 16);
+      memset(dst_opt, 0, kMaxWidth * 4 + 16);
+      ARGBToI420Row_C(src, kMaxWidth * 4, dst_c, kMaxWidth,
+                      dst_c + kMaxWidth * 2, dst_c + kMaxWidth * 3, width);
+      ARGBToI420Row_Any_SSSE3(src, kMaxWidth * 4, dst_opt, kMaxWidth,
+                              dst_opt + kMaxWidth * 2,
+                              dst_opt + kMaxWidth * 3, width);
+      EXPECT_LE(MaxRowDiff(dst_c, dst_opt, kMaxWidth * 4 + 16), 2);
+#endif
+
+#if defined(HAS_ARGBTOYROW_AVX2) && defined(HAS_ARGBTOUVROW_AVX2) && \
+    defined(HAS_ARGBTOI420ROW_AVX2) && defined(HAS_MERGEUVROW_AVX2)
+      if (TestCpuFlag(kCpuHasAVX2)) {
+        memset(dst_c, 0, kMaxWidth * 4 + 16);
+        memset(dst_opt, 0, kMaxWidth * 4 + 16);
+        ARGBToYRow_C(src, dst_c, width);
+        ARGBToYRow_Any_AVX2(src, dst_opt, width);
+        EXPECT_LE(MaxRowDiff(dst_c, dst_opt, kMaxWidth * 4 + 16), 2);
+
+        memset(dst_c, 0, kMaxWidth * 4 + 16);
+        memset(dst_opt, 0, kMaxWidth * 4 + 16);
+        ARGBToUVRow_C(src, kMaxWidth * 4, dst_c, dst_c + kMaxWidth, width);
+        ARGBToUVRow_Any_AVX2(src, kMaxWidth * 4, dst_opt,
+                             dst_opt + kMaxWidth, width);
+        EXPECT_LE(MaxRowDiff(dst_c, dst_opt, kMaxWidth * 4 + 16), 2);
+
+        memset(dst_c, 0, kMaxWidth * 4 + 16);
+        memset(dst_opt, 0, kMaxWidth * 4 + 16);
+        ARGBToI420Row_C(src, kMaxWidth * 4, dst_c, kMaxWidth,
+                        dst_c + kMaxWidth * 2, dst_c + kMaxWidth * 3, width);
+        ARGBToI420Row_Any_AVX2(src, kMaxWidth * 4, dst_opt, kMaxWidth,
+                               dst_opt + kMaxWidth * 2,
+                               dst_opt + kMaxWidth * 3, width);
+        EXPECT_LE(MaxRowDiff(dst_c, dst_opt, kMaxWidth * 4 + 16), 2);
+
+        memset(dst_c, 0, kMaxWidth * 4 + 16);
+        memset(dst_opt, 0, kMaxWidth * 4 + 16);
+        MergeUVRow_C(src, src + kMaxWidth, dst_c, width);
+        MergeUVRow_Any_AVX2(src, src + kMaxWidth, dst_opt, width);
+        EXPECT_EQ(0, memcmp(dst_c, dst_opt, kMaxWidth * 4 + 16));
+      }
+#endif
+    }
+  }
+  free_aligned_buffer_64(src);
+  free_aligned_buffer_64(dst_c);
+  free_aligned_buffer_64(dst_opt);
+}
+#endif
+
 }  // namespace libyuv
@@ -0,0 +1,143 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
+
+#include "libyuv/basic_types.h"
+#include "libyuv/convert_from.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/profile.h"
+#include "libyuv/row.h"
+#include "../unit_test/unit_test.h"
+
+namespace libyuv {
+
+TEST_F(libyuvTest, TestProfileFunctionNames) {
+  EXPECT_STREQ("I420ToARGB", GetProfileFunctionName(kProfileI420ToARGB));
+  EXPECT_STREQ("ConvertFromI420",
+               GetProfileFunctionName(kProfileConvertFromI420));
+  EXPECT_STREQ("", GetProfileFunctionName(kProfileFunctionCount));
+  for (int i = 0; i < kProfileFunctionCount; ++i) {
+    EXPECT_NE(0u, strlen(GetProfileFunctionName(
+        static_cast<ProfileFunction>(i))));
+  }
+}
+
+// Nothing is counted while disabled, and a reset starts from zero.
+TEST_F(libyuvTest, TestProfileReset) {
+  ProfileCounters counters[kProfileFunctionCount];
+  char text[256];
+  SetProfileEnabled(0);
+  ResetProfileCounters();
+  align_buffer_64(plane, benchmark_width_ * 2);
+  CopyPlane(plane, benchmark_width_, plane + benchmark_width_,
+            benchmark_width_, benchmark_width_, 1);
+  free_aligned_buffer_64(plane);
+  GetProfileCounters(counters);
+  for (int i = 0; i < kProfileFunctionCount; ++i) {
+    EXPECT_EQ(0u, counters[i].calls);
+    EXPECT_EQ(0u, counters[i].nanoseconds);
+  }
+  EXPECT_EQ(3, FormatProfileCounters(text, sizeof(text), 1));
+  EXPECT_STREQ("{}\n", text);
+  EXPECT_EQ(0, FormatProfileCounters(text, sizeof(text), 0));
+  EXPECT_STREQ("", text);
+}
+
+#ifdef LIBYUV_PROFILE
+TEST_F(libyuvTest, TestProfileI420ToARGB) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  ProfileCounters counters[kProfileFunctionCount];
+  align_buffer_64(src_y, kWidth * kHeight);
+  align_buffer_64(src_u, kHalfWidth * kHalfHeight);
+  align_buffer_64(src_v, kHalfWidth * kHalfHeight);
+  align_buffer_64(dst_argb, kWidth * kHeight * 4);
+  memset(src_y, 16, kWidth * kHeight);
+  memset(src_u, 128, kHalfWidth * kHalfHeight);
+  memset(src_v, 128, kHalfWidth * kHalfHeight);
+
+  ResetProfileCounters();
+  SetProfileEnabled(1);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+               dst_argb, kWidth * 4, kWidth, kHeight);
+  }
+  // Failed calls are not counted.
+  I420ToARGB(NULL, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+             dst_argb, kWidth * 4, kWidth, kHeight);
+  SetProfileEnabled(0);
+  GetProfileCounters(counters);
+
+  EXPECT_EQ(static_cast<uint64>(benchmark_iterations_),
+            counters[kProfileI420ToARGB].calls);
+  EXPECT_EQ(static_cast<uint64>(benchmark_iterations_) * kWidth * kHeight,
+            counters[kProfileI420ToARGB].pixels);
+  EXPECT_LT(counters[kProfileI420ToARGB].pixels,
+            counters[kProfileI420ToARGB].bytes);
+  EXPECT_EQ(0u, counters[kProfileARGBToI420].calls);
+
+  char text[1024];
+  int length = FormatProfileCounters(text, sizeof(text), 1);
+  EXPECT_EQ(static_cast<int>(strlen(text)), length);
+  EXPECT_TRUE(strstr(text, "\"I420ToARGB\": {\"calls\": ") != NULL);
+  // Truncated like snprintf.
+  EXPECT_EQ(length, FormatProfileCounters(text, 8, 1));
+  EXPECT_EQ(7u, strlen(text));
+
+  ResetProfileCounters();
+  GetProfileCounters(counters);
+  EXPECT_EQ(0u, counters[kProfileI420ToARGB].calls);
+
+  free_aligned_buffer_64(src_y);
+  free_aligned_buffer_64(src_u);
+  free_aligned_buffer_64(src_v);
+  free_aligned_buffer_64(dst_argb);
+}
+
+#if !defined(_WIN32)
+static void* ProfileCopyPlaneThreadMain(void* arg) {
+  uint8* plane = static_cast<uint8*>(arg);
+  CopyPlane(plane, 64, plane + 64, 64, 64, 1);
+  return NULL;
+}
+
+// Counts of threads that have exited are kept when their records are
+// taken over by new threads.
+TEST_F(libyuvTest, TestProfileThreadExit) {
+  const int kThreads = 8;
+  ProfileCounters counters[kProfileFunctionCount];
+  align_buffer_64(plane, 128);
+  memset(plane, 0, 128);
+  ResetProfileCounters();
+  SetProfileEnabled(1);
+  for (int t = 0; t < kThreads; ++t) {
+    pthread_t thread_id;
+    pthread_create(&thread_id, NULL, ProfileCopyPlaneThreadMain, plane);
+    pthread_join(thread_id, NULL);
+  }
+  SetProfileEnabled(0);
+  GetProfileCounters(counters);
+  EXPECT_EQ(static_cast<uint64>(kThreads), counters[kProfileCopyPlane].calls);
+  EXPECT_EQ(static_cast<uint64>(kThreads) * 64,
+            counters[kProfileCopyPlane].pixels);
+  free_aligned_buffer_64(plane);
+}
+#endif  // !defined(_WIN32)
+#endif  // LIBYUV_PROFILE
+
+}  // namespace libyuv
@@ -55,10 +55,13 @@ void TestRotateBpp(int src_width, int src_height,
                 src_width, src_height, mode);
 
     MaskCpuFlags(-1);  // Enable all CPU optimization.
-    for (int i = 0; i < benchmark_iterations; ++i) {
-      RotatePlane(src_argb, src_stride_argb,
-                  dst_argb_opt, dst_stride_argb,
-                  src_width, src_height, mode);
+    {
+      PerfScope perf(src_width, src_height, benchmark_iterations);
+      for (int i = 0; i < benchmark_iterations; ++i) {
+        RotatePlane(src_argb, src_stride_argb,
+                    dst_argb_opt, dst_stride_argb,
+                    src_width, src_height, mode);
+      }
     }
   } else if (kBpp == 4) {
     MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
@@ -67,10 +70,13 @@ void TestRotateBpp(int src_width, int src_height,
                src_width, src_height, mode);
 
     MaskCpuFlags(-1);  // Enable all CPU optimization.
-    for (int i = 0; i < benchmark_iterations; ++i) {
-      ARGBRotate(src_argb, src_stride_argb,
-                 dst_argb_opt, dst_stride_argb,
-                 src_width, src_height, mode);
+    {
+      PerfScope perf(src_width, src_height, benchmark_iterations);
+      for (int i = 0; i < benchmark_iterations; ++i) {
+        ARGBRotate(src_argb, src_stride_argb,
+                   dst_argb_opt, dst_stride_argb,
+                   src_width, src_height, mode);
+      }
     }
   }
 
@@ -60,16 +60,19 @@ static void I420TestRotate(int src_width, int src_height,
              src_width, src_height, mode);
 
   MaskCpuFlags(-1);  // Enable all CPU optimization.
-  for (int i = 0; i < benchmark_iterations; ++i) {
-    I420Rotate(src_i420, src_width,
-               src_i420 + src_i420_y_size, (src_width + 1) / 2,
-               src_i420 + src_i420_y_size + src_i420_uv_size,
-                 (src_width + 1) / 2,
-               dst_i420_opt, dst_width,
-               dst_i420_opt + dst_i420_y_size, (dst_width + 1) / 2,
-               dst_i420_opt + dst_i420_y_size + dst_i420_uv_size,
-                 (dst_width + 1) / 2,
-               src_width, src_height, mode);
+  {
+    PerfScope perf(src_width, src_height, benchmark_iterations);
+    for (int i = 0; i < benchmark_iterations; ++i) {
+      I420Rotate(src_i420, src_width,
+                 src_i420 + src_i420_y_size, (src_width + 1) / 2,
+                 src_i420 + src_i420_y_size + src_i420_uv_size,
+                   (src_width + 1) / 2,
+                 dst_i420_opt, dst_width,
+                 dst_i420_opt + dst_i420_y_size, (dst_width + 1) / 2,
+                 dst_i420_opt + dst_i420_y_size + dst_i420_uv_size,
+                   (dst_width + 1) / 2,
+                 src_width, src_height, mode);
+    }
   }
 
   // Rotation should be exact.
@@ -172,14 +175,17 @@ static void NV12TestRotate(int src_width, int src_height,
                    src_width, src_height, mode);
 
   MaskCpuFlags(-1);  // Enable all CPU optimization.
-  for (int i = 0; i < benchmark_iterations; ++i) {
-    NV12ToI420Rotate(src_nv12, src_width,
-                     src_nv12 + src_nv12_y_size, (src_width + 1) & ~1,
-                     dst_i420_opt, dst_width,
-                     dst_i420_opt + dst_i420_y_size, (dst_width + 1) / 2,
-                     dst_i420_opt + dst_i420_y_size + dst_i420_uv_size,
-                       (dst_width + 1) / 2,
-                     src_width, src_height, mode);
+  {
+    PerfScope perf(src_width, src_height, benchmark_iterations);
+    for (int i = 0; i < benchmark_iterations; ++i) {
+      NV12ToI420Rotate(src_nv12, src_width,
+                       src_nv12 + src_nv12_y_size, (src_width + 1) & ~1,
+                       dst_i420_opt, dst_width,
+                       dst_i420_opt + dst_i420_y_size, (dst_width + 1) / 2,
+                       dst_i420_opt + dst_i420_y_size + dst_i420_uv_size,
+                         (dst_width + 1) / 2,
+                       src_width, src_height, mode);
+    }
   }
 
   // Rotation should be exact.
@@ -264,6 +270,140 @@ TEST_F(libyuvTest, NV12Rotate270_Inverted) {
                  kRotate270, benchmark_iterations_, disable_cpu_flags_);
 }
 
+// NV12Rotate matches NV12ToI420Rotate with U and V interleaved.
+static void NV12TestRotateNV12(int src_width, int src_height,
+                               int dst_width, int dst_height,
+                               libyuv::RotationMode mode,
+                               int benchmark_iterations,
+                               int disable_cpu_flags) {
+  if (src_width < 1) {
+    src_width = 1;
+  }
+  if (src_height == 0) {  // allow negative for inversion test.
+    src_height = 1;
+  }
+  if (dst_width < 1) {
+    dst_width = 1;
+  }
+  if (dst_height < 1) {
+    dst_height = 1;
+  }
+  int src_nv12_y_size = src_width * Abs(src_height);
+  int src_nv12_uv_size = ((src_width + 1) / 2) * ((Abs(src_height) + 1) / 2) * 2;
+  int src_nv12_size = src_nv12_y_size + src_nv12_uv_size;
+  align_buffer_64(src_nv12, src_nv12_size);
+  for (int i = 0; i < src_nv12_size; ++i) {
+    src_nv12[i] = random() & 0xff;
+  }
+
+  int dst_halfwidth = (dst_width + 1) / 2;
+  int dst_y_size = dst_width * dst_height;
+  int dst_uv_size = dst_halfwidth * ((dst_height + 1) / 2);
+  int dst_nv12_size = dst_y_size + dst_uv_size * 2;
+  align_buffer_64(dst_nv12_c, dst_nv12_size);
+  align_buffer_64(dst_nv12_opt, dst_nv12_size);
+  align_buffer_64(dst_i420, dst_nv12_size);
+  memset(dst_nv12_c, 2, dst_nv12_size);
+  memset(dst_nv12_opt, 3, dst_nv12_size);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  EXPECT_EQ(0, NV12Rotate(src_nv12, src_width,
+                          src_nv12 + src_nv12_y_size, (src_width + 1) & ~1,
+                          dst_nv12_c, dst_width,
+                          dst_nv12_c + dst_y_size, dst_halfwidth * 2,
+                          src_width, src_height, mode));
+
+  MaskCpuFlags(-1);  // Enable all CPU optimization.
+  {
+    PerfScope perf(src_width, src_height, benchmark_iterations);
+    for (int i = 0; i < benchmark_iterations; ++i) {
+      NV12Rotate(src_nv12, src_width,
+                 src_nv12 + src_nv12_y_size, (src_width + 1) & ~1,
+                 dst_nv12_opt, dst_width,
+                 dst_nv12_opt + dst_y_size, dst_halfwidth * 2,
+                 src_width, src_height, mode);
+    }
+  }
+  NV12ToI420Rotate(src_nv12, src_width,
+                   src_nv12 + src_nv12_y_size, (src_width + 1) & ~1,
+                   dst_i420, dst_width,
+                   dst_i420 + dst_y_size, dst_halfwidth,
+                   dst_i420 + dst_y_size + dst_uv_size, dst_halfwidth,
+                   src_width, src_height, mode);
+
+  // Rotation should be exact.
+  for (int i = 0; i < dst_nv12_size; ++i) {
+    EXPECT_EQ(dst_nv12_c[i], dst_nv12_opt[i]);
+  }
+  for (int i = 0; i < dst_y_size; ++i) {
+    EXPECT_EQ(dst_i420[i], dst_nv12_opt[i]);
+  }
+  for (int i = 0; i < dst_uv_size; ++i) {
+    EXPECT_EQ(dst_i420[dst_y_size + i], dst_nv12_opt[dst_y_size + i * 2]);
+    EXPECT_EQ(dst_i420[dst_y_size + dst_uv_size + i],
+              dst_nv12_opt[dst_y_size + i * 2 + 1]);
+  }
+
+  free_aligned_buffer_64(dst_nv12_c);
+  free_aligned_buffer_64(dst_nv12_opt);
+  free_aligned_buffer_64(dst_i420);
+  free_aligned_buffer_64(src_nv12);
+}
+
+TEST_F(libyuvTest, NV12RotateNV12_0) {
+  NV12TestRotateNV12(benchmark_width_, benchmark_height_,
+                     benchmark_width_, benchmark_height_,
+                     kRotate0, benchmark_iterations_, disable_cpu_flags_);
+}
+
+TEST_F(libyuvTest, NV12RotateNV12_90) {
+  NV12TestRotateNV12(benchmark_width_, benchmark_height_,
+                     benchmark_height_, benchmark_width_,
+                     kRotate90, benchmark_iterations_, disable_cpu_flags_);
+}
+
+TEST_F(libyuvTest, NV12RotateNV12_180) {
+  NV12TestRotateNV12(benchmark_width_, benchmark_height_,
+                     benchmark_width_, benchmark_height_,
+                     kRotate180, benchmark_iterations_, disable_cpu_flags_);
+}
+
+TEST_F(libyuvTest, NV12RotateNV12_270) {
+  NV12TestRotateNV12(benchmark_width_, benchmark_height_,
+                     benchmark_height_, benchmark_width_,
+                     kRotate270, benchmark_iterations_, disable_cpu_flags_);
+}
+
+TEST_F(libyuvTest, NV12RotateNV12_90_Odd) {
+  NV12TestRotateNV12(benchmark_width_ - 3, benchmark_height_ - 1,
+                     benchmark_height_ - 1, benchmark_width_ - 3,
+                     kRotate90, benchmark_iterations_, disable_cpu_flags_);
+}
+
+TEST_F(libyuvTest, NV12RotateNV12_180_Odd) {
+  NV12TestRotateNV12(benchmark_width_ - 3, benchmark_height_ - 1,
+                     benchmark_width_ - 3, benchmark_height_ - 1,
+                     kRotate180, benchmark_iterations_, disable_cpu_flags_);
+}
+
+TEST_F(libyuvTest, NV12RotateNV12_270_Odd) {
+  NV12TestRotateNV12(benchmark_width_ - 3, benchmark_height_ - 1,
+                     benchmark_height_ - 1, benchmark_width_ - 3,
+                     kRotate270, benchmark_iterations_, disable_cpu_flags_);
+}
+
+TEST_F(libyuvTest, NV12RotateNV12_90_Inverted) {
+  NV12TestRotateNV12(benchmark_width_, -benchmark_height_,
+                     benchmark_height_, benchmark_width_,
+                     kRotate90, benchmark_iterations_, disable_cpu_flags_);
+}
+
+TEST_F(libyuvTest, NV12RotateNV12_180_Inverted) {
+  NV12TestRotateNV12(benchmark_width_, -benchmark_height_,
+                     benchmark_width_, benchmark_height_,
+                     kRotate180, benchmark_iterations_, disable_cpu_flags_);
+}
+
 
 
 
@@ -8,11 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <math.h>
 #include <stdlib.h>
 #include <time.h>
 
 #include "libyuv/cpu_id.h"
 #include "libyuv/scale_argb.h"
+#include "libyuv/scale_row.h"
 #include "libyuv/row.h"
 #include "../unit_test/unit_test.h"
 
@@ -75,11 +77,14 @@ static int ARGBTestFilter(int src_width, int src_height,
 
   MaskCpuFlags(-1);  // Enable all CPU optimization.
   double opt_time = get_time();
-  for (i = 0; i < benchmark_iterations; ++i) {
-    ARGBScale(src_argb + (src_stride_argb * b) + b * 4, src_stride_argb,
-              src_width, src_height,
-              dst_argb_opt + (dst_stride_argb * b) + b * 4, dst_stride_argb,
-              dst_width, dst_height, f);
+  {
+    PerfScope perf(dst_width, dst_height, benchmark_iterations);
+    for (i = 0; i < benchmark_iterations; ++i) {
+      ARGBScale(src_argb + (src_stride_argb * b) + b * 4, src_stride_argb,
+                src_width, src_height,
+                dst_argb_opt + (dst_stride_argb * b) + b * 4, dst_stride_argb,
+                dst_width, dst_height, f);
+    }
   }
   opt_time = (get_time() - opt_time) / benchmark_iterations;
 
@@ -302,4 +307,383 @@ TEST_SCALETO(ARGBScale, 1280, 720)
 #undef TEST_SCALETO1
 #undef TEST_SCALETO
 
+// Test linear light scaling with C vs Opt and return maximum difference.
+static int ARGBLinearLightTestFilter(int src_width, int src_height,
+                                     int dst_width, int dst_height,
+                                     FilterMode f, int benchmark_iterations,
+                                     int disable_cpu_flags) {
+  const int kBpp = 4;
+  int i;
+  int64 src_argb_plane_size = Abs(src_width) * Abs(src_height) * kBpp;
+  int src_stride_argb = Abs(src_width) * kBpp;
+  int64 dst_argb_plane_size = dst_width * dst_height * kBpp;
+  int dst_stride_argb = dst_width * kBpp;
+
+  align_buffer_page_end(src_argb, src_argb_plane_size)
+  align_buffer_page_end(dst_argb_c, dst_argb_plane_size)
+  align_buffer_page_end(dst_argb_opt, dst_argb_plane_size)
+  srandom(time(NULL));
+  MemRandomize(src_argb, src_argb_plane_size);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  EXPECT_EQ(0, ARGBScaleLinearLight(src_argb, src_stride_argb,
+                                    src_width, src_height,
+                                    dst_argb_c, dst_stride_argb,
+                                    dst_width, dst_height, f));
+  MaskCpuFlags(-1);  // Enable all CPU optimization.
+  for (i = 0; i < benchmark_iterations; ++i) {
+    ARGBScaleLinearLight(src_argb, src_stride_argb,
+                         src_width, src_height,
+                         dst_argb_opt, dst_stride_argb,
+                         dst_width, dst_height, f);
+  }
+
+  int max_diff = 0;
+  for (i = 0; i < dst_argb_plane_size; ++i) {
+    int abs_diff = Abs(dst_argb_c[i] - dst_argb_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_argb_c)
+  free_aligned_buffer_page_end(dst_argb_opt)
+  free_aligned_buffer_page_end(src_argb)
+  return max_diff;
+}
+
+#define TEST_LINEARLIGHT1(width, height, filter)                               \
+    TEST_F(libyuvTest, ARGBScaleLinearLightTo##width##x##height##_##filter) {  \
+      int diff = ARGBLinearLightTestFilter(benchmark_width_,                   \
+                                           benchmark_height_,                  \
+                                           width, height,                      \
+                                           kFilter##filter,                    \
+                                           benchmark_iterations_,              \
+                                           disable_cpu_flags_);                \
+      EXPECT_EQ(0, diff);                                                      \
+    }                                                                          \
+    TEST_F(libyuvTest, ARGBScaleLinearLightFrom##width##x##height##_##filter) {\
+      int diff = ARGBLinearLightTestFilter(width, height,                      \
+                                           Abs(benchmark_width_),              \
+                                           Abs(benchmark_height_),             \
+                                           kFilter##filter,                    \
+                                           benchmark_iterations_,              \
+                                           disable_cpu_flags_);                \
+      EXPECT_EQ(0, diff);                                                      \
+    }
+
+#define TEST_LINEARLIGHT(width, height)                                        \
+    TEST_LINEARLIGHT1(width, height, Linear)                                   \
+    TEST_LINEARLIGHT1(width, height, Bilinear)                                 \
+    TEST_LINEARLIGHT1(width, height, Box)
+
+TEST_LINEARLIGHT(1, 1)
+TEST_LINEARLIGHT(32, 18)
+TEST_LINEARLIGHT(569, 480)
+#undef TEST_LINEARLIGHT1
+#undef TEST_LINEARLIGHT
+
+// sRGB transfer functions for reference values, with values from 0 to 1.
+static double SRGBToLinear(int v) {
+  double c = v / 255.;
+  return c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+}
+
+static int LinearToSRGB(double l) {
+  double c = l <= 0.0031308 ? l * 12.92 : 1.055 * pow(l, 1. / 2.4) - 0.055;
+  return static_cast<int>(c * 255. + 0.5);
+}
+
+// A black and white checkerboard averages to mid grey in linear light, which
+// is sRGB 188 rather than the gamma space average of 128.
+TEST_F(libyuvTest, ARGBScaleLinearLightCheckerboard) {
+  const int kSize = 16;
+  SIMD_ALIGNED(uint8 src_argb[kSize * kSize * 4]);
+  SIMD_ALIGNED(uint8 dst_argb[4 * 4 * 4]);
+  for (int i = 0; i < kSize; ++i) {
+    for (int j = 0; j < kSize; ++j) {
+      uint8 v = ((i ^ j) & 1) ? 255u : 0u;
+      src_argb[(i * kSize + j) * 4 + 0] = v;
+      src_argb[(i * kSize + j) * 4 + 1] = v;
+      src_argb[(i * kSize + j) * 4 + 2] = v;
+      src_argb[(i * kSize + j) * 4 + 3] = 255u;
+    }
+  }
+  EXPECT_EQ(0, ARGBScaleLinearLight(src_argb, kSize * 4, kSize, kSize,
+                                    dst_argb, 4 * 4, 4, 4, kFilterBox));
+  for (int i = 0; i < 4 * 4; ++i) {
+    EXPECT_NEAR(188, dst_argb[i * 4 + 0], 1);
+    EXPECT_NEAR(188, dst_argb[i * 4 + 1], 1);
+    EXPECT_NEAR(188, dst_argb[i * 4 + 2], 1);
+    EXPECT_EQ(255u, dst_argb[i * 4 + 3]);
+  }
+  // Bilinear quarter size samples the middle of 2x2 pixels, 2 black and 2
+  // white, so each pixel is the linear light average of black and white.
+  double mid = (SRGBToLinear(0) + SRGBToLinear(255)) / 2.;
+  int expected = LinearToSRGB(mid);
+  EXPECT_NEAR(188, expected, 1);
+  EXPECT_EQ(0, ARGBScaleLinearLight(src_argb, kSize * 4, kSize, kSize,
+                                    dst_argb, 4 * 4, 4, 4, kFilterBilinear));
+  for (int i = 0; i < 4 * 4; ++i) {
+    EXPECT_NEAR(expected, dst_argb[i * 4 + 0], 1);
+    EXPECT_NEAR(expected, dst_argb[i * 4 + 1], 1);
+    EXPECT_NEAR(expected, dst_argb[i * 4 + 2], 1);
+    EXPECT_EQ(255u, dst_argb[i * 4 + 3]);
+  }
+}
+
+// Linear light conversion round trips all sRGB values.
+TEST_F(libyuvTest, ARGBScaleLinearLightRoundTrip) {
+  SIMD_ALIGNED(uint8 src_argb[256 * 4]);
+  SIMD_ALIGNED(uint8 dst_argb[256 * 4]);
+  for (int i = 0; i < 256; ++i) {
+    src_argb[i * 4 + 0] = i;
+    src_argb[i * 4 + 1] = 255 - i;
+    src_argb[i * 4 + 2] = i;
+    src_argb[i * 4 + 3] = 255 - i;
+  }
+  // Vertical only scale with bilinear filter on identical rows.
+  EXPECT_EQ(0, ARGBScaleLinearLight(src_argb, 0, 256, 2,
+                                    dst_argb, 256 * 4, 256, 1,
+                                    kFilterBilinear));
+  for (int i = 0; i < 256 * 4; ++i) {
+    EXPECT_EQ(src_argb[i], dst_argb[i]);
+  }
+}
+
+// Linear light row functions match C for every sRGB value in each channel
+// and every entry of the linear to sRGB table.
+TEST_F(libyuvTest, TestScaleARGBRowLinear) {
+  const int kLinearPixels = 65536 / 4;
+  SIMD_ALIGNED(uint8 src_argb[256 * 4]);
+  SIMD_ALIGNED(uint16 linear_c[256 * 4]);
+  SIMD_ALIGNED(uint16 linear_opt[256 * 4]);
+  uint8 table[4096 + 4];
+  align_buffer_64(src_linear, kLinearPixels * 4 * 2);
+  align_buffer_64(dst_argb_c, kLinearPixels * 4);
+  align_buffer_64(dst_argb_opt, kLinearPixels * 4);
+  uint16* linear = reinterpret_cast<uint16*>(src_linear);
+  for (int i = 0; i < 256; ++i) {
+    for (int c = 0; c < 4; ++c) {
+      src_argb[i * 4 + c] = static_cast<uint8>(i + c * 85);
+    }
+  }
+  for (int i = 0; i < kLinearPixels; ++i) {
+    for (int c = 0; c < 4; ++c) {
+      linear[i * 4 + c] = static_cast<uint16>(i * 4 + ((i + c) & 3));
+    }
+  }
+  ScaleARGBLinearTable_C(table);
+  memset(table + 4096, 0, 4);
+  ScaleARGBRowToLinear_C(src_argb, linear_c, 256);
+  ScaleARGBRowFromLinear_C(linear, dst_argb_c, table, kLinearPixels);
+  EXPECT_EQ(65535, linear_c[255 * 4 + 0]);
+  EXPECT_EQ(65535, linear_c[3]);
+
+#if defined(HAS_SCALEARGBROWTOLINEAR_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    memset(linear_opt, 0, sizeof(linear_opt));
+    for (int i = 0; i < benchmark_pixels_div256_; ++i) {
+      ScaleARGBRowToLinear_Any_AVX2(src_argb, linear_opt, 255);
+    }
+    EXPECT_EQ(0, memcmp(linear_c, linear_opt, 255 * 4 * 2));
+    ScaleARGBRowToLinear_AVX2(src_argb, linear_opt, 256);
+    EXPECT_EQ(0, memcmp(linear_c, linear_opt, sizeof(linear_opt)));
+  }
+#endif
+#if defined(HAS_SCALEARGBROWFROMLINEAR_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    memset(dst_argb_opt, 0, kLinearPixels * 4);
+    ScaleARGBRowFromLinear_Any_AVX2(linear, dst_argb_opt, table,
+                                    kLinearPixels - 1);
+    EXPECT_EQ(0, memcmp(dst_argb_c, dst_argb_opt, (kLinearPixels - 1) * 4));
+    ScaleARGBRowFromLinear_AVX2(linear, dst_argb_opt, table, kLinearPixels);
+    EXPECT_EQ(0, memcmp(dst_argb_c, dst_argb_opt, kLinearPixels * 4));
+  }
+#endif
+
+  free_aligned_buffer_64(src_linear);
+  free_aligned_buffer_64(dst_argb_c);
+  free_aligned_buffer_64(dst_argb_opt);
+}
+
+// Test sub pixel crop with C vs Opt.
+static void ARGBTestScaleCrop(int src_width, int src_height,
+                              int crop_x, int crop_y,
+                              int crop_width, int crop_height,
+                              int dst_width, int dst_height,
+                              FilterMode f, int benchmark_iterations,
+                              int disable_cpu_flags) {
+  const int kBpp = 4;
+  int src_size = src_width * src_height * kBpp;
+  int dst_size = dst_width * dst_height * kBpp;
+  align_buffer_page_end(src_argb, src_size)
+  align_buffer_page_end(dst_argb_c, dst_size)
+  align_buffer_page_end(dst_argb_opt, dst_size)
+  MemRandomize(src_argb, src_size);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  EXPECT_EQ(0, ARGBScaleCrop(src_argb, src_width * kBpp,
+                             src_width, src_height,
+                             crop_x, crop_y, crop_width, crop_height,
+                             dst_argb_c, dst_width * kBpp,
+                             dst_width, dst_height, f));
+  MaskCpuFlags(-1);  // Enable all CPU optimization.
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    ARGBScaleCrop(src_argb, src_width * kBpp, src_width, src_height,
+                  crop_x, crop_y, crop_width, crop_height,
+                  dst_argb_opt, dst_width * kBpp,
+                  dst_width, dst_height, f);
+  }
+  for (int i = 0; i < dst_size; ++i) {
+    EXPECT_NEAR(dst_argb_c[i], dst_argb_opt[i], 2);
+  }
+
+  free_aligned_buffer_page_end(src_argb)
+  free_aligned_buffer_page_end(dst_argb_c)
+  free_aligned_buffer_page_end(dst_argb_opt)
+}
+
+#define TEST_ARGBSCALECROP(name, crop_x, crop_y, dst_width, dst_height)       \
+    TEST_F(libyuvTest, ARGBScaleCrop##name##_Bilinear) {                       \
+      ARGBTestScaleCrop(640, 360, crop_x, crop_y,                              \
+                        (320 << 16) + 0x5555, (180 << 16) + 0x3333,            \
+                        dst_width, dst_height, kFilterBilinear,                \
+                        benchmark_iterations_, disable_cpu_flags_);            \
+    }                                                                          \
+    TEST_F(libyuvTest, ARGBScaleCrop##name##_None) {                           \
+      ARGBTestScaleCrop(640, 360, crop_x, crop_y,                              \
+                        (320 << 16) + 0x5555, (180 << 16) + 0x3333,            \
+                        dst_width, dst_height, kFilterNone,                    \
+                        benchmark_iterations_, disable_cpu_flags_);            \
+    }
+
+TEST_ARGBSCALECROP(Up, (101 << 16) + 0x8000, (77 << 16) + 0x1234, 1280, 720)
+TEST_ARGBSCALECROP(Down, (3 << 16) + 0xfedc, (1 << 16) + 0x4000, 160, 90)
+TEST_ARGBSCALECROP(Same, (250 << 16) + 0x2000, (100 << 16) + 0x8000, 320, 180)
+#undef TEST_ARGBSCALECROP
+
+// A half pixel offset averages neighboring pixels and whole pixel crops
+// match scaling that part of the image.
+TEST_F(libyuvTest, ARGBScaleCrop_HalfPixel) {
+  const int kWidth = 24;
+  const int kHeight = 4;
+  SIMD_ALIGNED(uint8 src_argb[kWidth * kHeight * 4]);
+  SIMD_ALIGNED(uint8 dst_argb[kWidth * kHeight * 4]);
+  SIMD_ALIGNED(uint8 dst_argb2[kWidth * kHeight * 4]);
+  for (int i = 0; i < kHeight; ++i) {
+    for (int j = 0; j < kWidth * 4; ++j) {
+      src_argb[(i * kWidth) * 4 + j] = j * 2 + i * 16;
+    }
+  }
+  EXPECT_EQ(0, ARGBScaleCrop(src_argb, kWidth * 4, kWidth, kHeight,
+                             0x8000, 0x8000,
+                             (kWidth - 1) << 16, (kHeight - 1) << 16,
+                             dst_argb, (kWidth - 1) * 4,
+                             kWidth - 1, kHeight - 1, kFilterBilinear));
+  for (int i = 0; i < kHeight - 1; ++i) {
+    for (int j = 0; j < (kWidth - 1) * 4; ++j) {
+      EXPECT_NEAR(j * 2 + 4 + i * 16 + 8,
+                  dst_argb[i * (kWidth - 1) * 4 + j], 2);
+    }
+  }
+
+  EXPECT_EQ(0, ARGBScaleCrop(src_argb, kWidth * 4, kWidth, kHeight,
+                             3 << 16, 1 << 16, 20 << 16, 3 << 16,
+                             dst_argb, 10 * 4, 10, 2, kFilterBilinear));
+  EXPECT_EQ(0, ARGBScale(src_argb + (kWidth + 3) * 4, kWidth * 4, 20, 3,
+                         dst_argb2, 10 * 4, 10, 2, kFilterBilinear));
+  for (int i = 0; i < 10 * 2 * 4; ++i) {
+    EXPECT_EQ(dst_argb2[i], dst_argb[i]);
+  }
+}
+
+// 1/2 scaling averages each pair of pixels, starting at the first pixel.
+TEST_F(libyuvTest, ARGBScaleDownBy2_PixelPairs) {
+  const int kWidth = 16;
+  const int kHeight = 2;
+  SIMD_ALIGNED(uint8 src_argb[kWidth * kHeight * 4]);
+  SIMD_ALIGNED(uint8 dst_argb[kWidth / 2 * 4]);
+  for (int i = 0; i < kHeight; ++i) {
+    for (int j = 0; j < kWidth * 4; ++j) {
+      src_argb[(i * kWidth) * 4 + j] = (j / 4) * 8 + i * 4;
+    }
+  }
+  // Box averages 2x2 pixels.  Pixel x is x * 8 + 2 on average of the rows.
+  EXPECT_EQ(0, ARGBScale(src_argb, kWidth * 4, kWidth, kHeight,
+                         dst_argb, kWidth / 2 * 4, kWidth / 2, 1, kFilterBox));
+  for (int j = 0; j < kWidth / 2 * 4; ++j) {
+    EXPECT_EQ((j / 4) * 16 + 4 + 2, dst_argb[j]);
+  }
+  // Linear averages 2 pixels of the second row.
+  EXPECT_EQ(0, ARGBScale(src_argb, kWidth * 4, kWidth, kHeight,
+                         dst_argb, kWidth / 2 * 4, kWidth / 2, 1,
+                         kFilterLinear));
+  for (int j = 0; j < kWidth / 2 * 4; ++j) {
+    EXPECT_EQ((j / 4) * 16 + 4 + 4, dst_argb[j]);
+  }
+  // Point sampling takes the odd pixel of the odd row.
+  EXPECT_EQ(0, ARGBScale(src_argb, kWidth * 4, kWidth, kHeight,
+                         dst_argb, kWidth / 2 * 4, kWidth / 2, 1, kFilterNone));
+  for (int j = 0; j < kWidth / 2 * 4; ++j) {
+    EXPECT_EQ((j / 4) * 16 + 8 + 4, dst_argb[j]);
+  }
+}
+
+// Column filtering with a precomputed table matches stepping x.
+TEST_F(libyuvTest, TestScaleFilterColsTable) {
+  SIMD_ALIGNED(uint8 orig_pixels[1280 + 1][4]);
+  SIMD_ALIGNED(uint8 cols_pixels_c[1280][4]);
+  SIMD_ALIGNED(uint8 cols_pixels_opt[1280][4]);
+  SIMD_ALIGNED(int offsets[1280]);
+  SIMD_ALIGNED(uint8 weights[1280 * 2]);
+  const int kDx = 0x10000 * 853 / 1280;
+  const int kX = 0x1234;
+
+  MemRandomize(&orig_pixels[0][0], sizeof(orig_pixels));
+  ScaleFilterColsSetup_C(offsets, weights, 1280, kX, kDx);
+  EXPECT_EQ(0, offsets[0]);
+  EXPECT_EQ(0x7f ^ (kX >> 9), weights[0]);
+  EXPECT_EQ(kX >> 9, weights[1]);
+
+  ScaleARGBFilterCols_C(&cols_pixels_c[0][0], &orig_pixels[0][0], 1280,
+                        kX, kDx);
+  ScaleARGBFilterColsTable_C(&cols_pixels_opt[0][0], &orig_pixels[0][0], 1280,
+                             offsets, weights);
+  EXPECT_EQ(0, memcmp(cols_pixels_opt, cols_pixels_c, 1280 * 4));
+
+#if defined(HAS_SCALEARGBFILTERCOLSTABLE_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    for (int i = 0; i < benchmark_pixels_div1280_; ++i) {
+      ScaleARGBFilterColsTable_Any_SSSE3(&cols_pixels_opt[0][0],
+                                         &orig_pixels[0][0], 1279,
+                                         offsets, weights);
+    }
+    EXPECT_EQ(0, memcmp(cols_pixels_opt, cols_pixels_c, 1279 * 4));
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLSTABLE_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    for (int i = 0; i < benchmark_pixels_div1280_; ++i) {
+      ScaleARGBFilterColsTable_Any_AVX2(&cols_pixels_opt[0][0],
+                                        &orig_pixels[0][0], 1279,
+                                        offsets, weights);
+    }
+    EXPECT_EQ(0, memcmp(cols_pixels_opt, cols_pixels_c, 1279 * 4));
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLSTABLE_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ScaleFilterColsTable_C(&cols_pixels_c[0][0], &orig_pixels[0][0], 1280,
+                           offsets, weights);
+    for (int i = 0; i < benchmark_pixels_div1280_; ++i) {
+      ScaleFilterColsTable_Any_SSSE3(&cols_pixels_opt[0][0],
+                                     &orig_pixels[0][0], 1279,
+                                     offsets, weights);
+    }
+    EXPECT_EQ(0, memcmp(cols_pixels_opt, cols_pixels_c, 1279));
+  }
+#endif
+}
+
 }  // namespace libyuv
@@ -12,6 +12,7 @@
 #include <time.h>
 
 #include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"  // For SetStreamingStoreThreshold.
 #include "libyuv/scale.h"
 #include "../unit_test/unit_test.h"
 
@@ -83,15 +84,18 @@ static int TestFilter(int src_width, int src_height,
 
   MaskCpuFlags(-1);  // Enable all CPU optimization.
   double opt_time = get_time();
-  for (i = 0; i < benchmark_iterations; ++i) {
-    I420Scale(src_y + (src_stride_y * b) + b, src_stride_y,
-              src_u + (src_stride_uv * b) + b, src_stride_uv,
-              src_v + (src_stride_uv * b) + b, src_stride_uv,
-              src_width, src_height,
-              dst_y_opt + (dst_stride_y * b) + b, dst_stride_y,
-              dst_u_opt + (dst_stride_uv * b) + b, dst_stride_uv,
-              dst_v_opt + (dst_stride_uv * b) + b, dst_stride_uv,
-              dst_width, dst_height, f);
+  {
+    PerfScope perf(dst_width, dst_height, benchmark_iterations);
+    for (i = 0; i < benchmark_iterations; ++i) {
+      I420Scale(src_y + (src_stride_y * b) + b, src_stride_y,
+                src_u + (src_stride_uv * b) + b, src_stride_uv,
+                src_v + (src_stride_uv * b) + b, src_stride_uv,
+                src_width, src_height,
+                dst_y_opt + (dst_stride_y * b) + b, dst_stride_y,
+                dst_u_opt + (dst_stride_uv * b) + b, dst_stride_uv,
+                dst_v_opt + (dst_stride_uv * b) + b, dst_stride_uv,
+                dst_width, dst_height, f);
+    }
   }
   opt_time = (get_time() - opt_time) / benchmark_iterations;
   // Report performance of C vs OPT
@@ -273,6 +277,121 @@ static int TestFilter_16(int src_width, int src_height,
   return max_diff;
 }
 
+// Test 16 bit scaling with C vs Opt and return maximum pixel difference.
+// 0 = exact.
+static int TestFilter_16Opt(int src_width, int src_height,
+                            int dst_width, int dst_height,
+                            FilterMode f, int benchmark_iterations,
+                            int disable_cpu_flags) {
+  int i;
+  int src_width_uv = (Abs(src_width) + 1) >> 1;
+  int src_height_uv = (Abs(src_height) + 1) >> 1;
+  int64 src_y_plane_size = Abs(src_width) * Abs(src_height);
+  int64 src_uv_plane_size = src_width_uv * src_height_uv;
+  int src_stride_y = Abs(src_width);
+  int src_stride_uv = src_width_uv;
+
+  align_buffer_page_end(src_y, src_y_plane_size * 2)
+  align_buffer_page_end(src_u, src_uv_plane_size * 2)
+  align_buffer_page_end(src_v, src_uv_plane_size * 2)
+  if (!src_y || !src_u || !src_v) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  srandom(time(NULL));
+  MemRandomize(src_y, src_y_plane_size * 2);
+  MemRandomize(src_u, src_uv_plane_size * 2);
+  MemRandomize(src_v, src_uv_plane_size * 2);
+
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+  int64 dst_y_plane_size = dst_width * dst_height;
+  int64 dst_uv_plane_size = dst_width_uv * dst_height_uv;
+  int dst_stride_y = dst_width;
+  int dst_stride_uv = dst_width_uv;
+
+  align_buffer_page_end(dst_y_c, dst_y_plane_size * 2)
+  align_buffer_page_end(dst_u_c, dst_uv_plane_size * 2)
+  align_buffer_page_end(dst_v_c, dst_uv_plane_size * 2)
+  align_buffer_page_end(dst_y_opt, dst_y_plane_size * 2)
+  align_buffer_page_end(dst_u_opt, dst_uv_plane_size * 2)
+  align_buffer_page_end(dst_v_opt, dst_uv_plane_size * 2)
+  if (!dst_y_c || !dst_u_c || !dst_v_c ||
+      !dst_y_opt|| !dst_u_opt|| !dst_v_opt) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  double c_time = get_time();
+  I420Scale_16(reinterpret_cast<uint16*>(src_y), src_stride_y,
+               reinterpret_cast<uint16*>(src_u), src_stride_uv,
+               reinterpret_cast<uint16*>(src_v), src_stride_uv,
+               src_width, src_height,
+               reinterpret_cast<uint16*>(dst_y_c), dst_stride_y,
+               reinterpret_cast<uint16*>(dst_u_c), dst_stride_uv,
+               reinterpret_cast<uint16*>(dst_v_c), dst_stride_uv,
+               dst_width, dst_height, f);
+  c_time = (get_time() - c_time);
+
+  MaskCpuFlags(-1);  // Enable all CPU optimization.
+  double opt_time = get_time();
+  {
+    PerfScope perf(dst_width, dst_height, benchmark_iterations);
+    for (i = 0; i < benchmark_iterations; ++i) {
+      I420Scale_16(reinterpret_cast<uint16*>(src_y), src_stride_y,
+                   reinterpret_cast<uint16*>(src_u), src_stride_uv,
+                   reinterpret_cast<uint16*>(src_v), src_stride_uv,
+                   src_width, src_height,
+                   reinterpret_cast<uint16*>(dst_y_opt), dst_stride_y,
+                   reinterpret_cast<uint16*>(dst_u_opt), dst_stride_uv,
+                   reinterpret_cast<uint16*>(dst_v_opt), dst_stride_uv,
+                   dst_width, dst_height, f);
+    }
+  }
+  opt_time = (get_time() - opt_time) / benchmark_iterations;
+  printf("filter %d - %8d us C - %8d us OPT\n",
+         f,
+         static_cast<int>(c_time * 1e6),
+         static_cast<int>(opt_time * 1e6));
+
+  int max_diff = 0;
+  const uint16* y_c = reinterpret_cast<const uint16*>(dst_y_c);
+  const uint16* y_opt = reinterpret_cast<const uint16*>(dst_y_opt);
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    int abs_diff = Abs(y_c[i] - y_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  const uint16* u_c = reinterpret_cast<const uint16*>(dst_u_c);
+  const uint16* u_opt = reinterpret_cast<const uint16*>(dst_u_opt);
+  const uint16* v_c = reinterpret_cast<const uint16*>(dst_v_c);
+  const uint16* v_opt = reinterpret_cast<const uint16*>(dst_v_opt);
+  for (i = 0; i < dst_uv_plane_size; ++i) {
+    int abs_diff = Abs(u_c[i] - u_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+    abs_diff = Abs(v_c[i] - v_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_y_c)
+  free_aligned_buffer_page_end(dst_u_c)
+  free_aligned_buffer_page_end(dst_v_c)
+  free_aligned_buffer_page_end(dst_y_opt)
+  free_aligned_buffer_page_end(dst_u_opt)
+  free_aligned_buffer_page_end(dst_v_opt)
+  free_aligned_buffer_page_end(src_y)
+  free_aligned_buffer_page_end(src_u)
+  free_aligned_buffer_page_end(src_v)
+
+  return max_diff;
+}
+
 // The following adjustments in dimensions ensure the scale factor will be
 // exactly achieved.
 // 2 is chroma subsample
@@ -296,6 +415,15 @@ static int TestFilter_16(int src_width, int src_height,
                                DX(benchmark_height_, nom, denom),              \
                                kFilter##filter, benchmark_iterations_);        \
       EXPECT_LE(diff, max_diff);                                               \
+    }                                                                          \
+    TEST_F(libyuvTest, ScaleDownBy##name##_##filter##_16Opt) {                 \
+      int diff = TestFilter_16Opt(SX(benchmark_width_, nom, denom),            \
+                                  SX(benchmark_height_, nom, denom),           \
+                                  DX(benchmark_width_, nom, denom),            \
+                                  DX(benchmark_height_, nom, denom),           \
+                                  kFilter##filter, benchmark_iterations_,      \
+                                  disable_cpu_flags_);                         \
+      EXPECT_EQ(0, diff);                                                      \
     }
 
 // Test a scale factor with all 4 filters.  Expect unfiltered to be exact, but
@@ -345,6 +473,21 @@ TEST_FACTOR(3, 1, 3)
                                Abs(benchmark_width_), Abs(benchmark_height_),  \
                                kFilter##filter, benchmark_iterations_);        \
       EXPECT_LE(diff, max_diff);                                               \
+    }                                                                          \
+    TEST_F(libyuvTest, name##To##width##x##height##_##filter##_16Opt) {        \
+      int diff = TestFilter_16Opt(benchmark_width_, benchmark_height_,         \
+                                  width, height,                               \
+                                  kFilter##filter, benchmark_iterations_,      \
+                                  disable_cpu_flags_);                         \
+      EXPECT_EQ(0, diff);                                                      \
+    }                                                                          \
+    TEST_F(libyuvTest, name##From##width##x##height##_##filter##_16Opt) {      \
+      int diff = TestFilter_16Opt(width, height,                               \
+                                  Abs(benchmark_width_),                       \
+                                  Abs(benchmark_height_),                      \
+                                  kFilter##filter, benchmark_iterations_,      \
+                                  disable_cpu_flags_);                         \
+      EXPECT_EQ(0, diff);                                                      \
     }
 
 // Test scale to a specified size with all 4 filters.
@@ -363,4 +506,328 @@ TEST_SCALETO(Scale, 1280, 720)
 #undef TEST_SCALETO1
 #undef TEST_SCALETO
 
+typedef int (*I4xxScaleFunc)(const uint8* src_y, int src_stride_y,
+                             const uint8* src_u, int src_stride_u,
+                             const uint8* src_v, int src_stride_v,
+                             int src_width, int src_height,
+                             uint8* dst_y, int dst_stride_y,
+                             uint8* dst_u, int dst_stride_u,
+                             uint8* dst_v, int dst_stride_v,
+                             int dst_width, int dst_height,
+                             enum FilterMode filtering);
+
+// Test I422Scale or I444Scale with C vs Opt and return maximum pixel
+// difference.  subsamp_x is 2 for 4:2:2 and 1 for 4:4:4.
+static int TestI4xxScale(I4xxScaleFunc scale, int subsamp_x,
+                         int src_width, int src_height,
+                         int dst_width, int dst_height,
+                         FilterMode f, int benchmark_iterations,
+                         int disable_cpu_flags) {
+  int i;
+  int src_width_uv = (Abs(src_width) + subsamp_x - 1) / subsamp_x;
+  int64 src_y_plane_size = Abs(src_width) * Abs(src_height);
+  int64 src_uv_plane_size = src_width_uv * Abs(src_height);
+  int dst_width_uv = (dst_width + subsamp_x - 1) / subsamp_x;
+  int64 dst_y_plane_size = dst_width * dst_height;
+  int64 dst_uv_plane_size = dst_width_uv * dst_height;
+
+  align_buffer_page_end(src_y, src_y_plane_size)
+  align_buffer_page_end(src_u, src_uv_plane_size)
+  align_buffer_page_end(src_v, src_uv_plane_size)
+  align_buffer_page_end(dst_y_c, dst_y_plane_size)
+  align_buffer_page_end(dst_u_c, dst_uv_plane_size)
+  align_buffer_page_end(dst_v_c, dst_uv_plane_size)
+  align_buffer_page_end(dst_y_opt, dst_y_plane_size)
+  align_buffer_page_end(dst_u_opt, dst_uv_plane_size)
+  align_buffer_page_end(dst_v_opt, dst_uv_plane_size)
+  srandom(time(NULL));
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_u, src_uv_plane_size);
+  MemRandomize(src_v, src_uv_plane_size);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  EXPECT_EQ(0, scale(src_y, Abs(src_width), src_u, src_width_uv,
+                     src_v, src_width_uv, src_width, src_height,
+                     dst_y_c, dst_width, dst_u_c, dst_width_uv,
+                     dst_v_c, dst_width_uv, dst_width, dst_height, f));
+  MaskCpuFlags(-1);  // Enable all CPU optimization.
+  for (i = 0; i < benchmark_iterations; ++i) {
+    scale(src_y, Abs(src_width), src_u, src_width_uv,
+          src_v, src_width_uv, src_width, src_height,
+          dst_y_opt, dst_width, dst_u_opt, dst_width_uv,
+          dst_v_opt, dst_width_uv, dst_width, dst_height, f);
+  }
+
+  int max_diff = 0;
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    int abs_diff = Abs(dst_y_c[i] - dst_y_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  for (i = 0; i < dst_uv_plane_size; ++i) {
+    int abs_diff = Abs(dst_u_c[i] - dst_u_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+    abs_diff = Abs(dst_v_c[i] - dst_v_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_y_c)
+  free_aligned_buffer_page_end(dst_u_c)
+  free_aligned_buffer_page_end(dst_v_c)
+  free_aligned_buffer_page_end(dst_y_opt)
+  free_aligned_buffer_page_end(dst_u_opt)
+  free_aligned_buffer_page_end(dst_v_opt)
+  free_aligned_buffer_page_end(src_y)
+  free_aligned_buffer_page_end(src_u)
+  free_aligned_buffer_page_end(src_v)
+  return max_diff;
+}
+
+#define TEST_I4XXSCALE1(name, subsamp_x, width, height, filter, max_diff)      \
+    TEST_F(libyuvTest, name##To##width##x##height##_##filter) {                \
+      int diff = TestI4xxScale(name, subsamp_x,                                \
+                               benchmark_width_, benchmark_height_,            \
+                               width, height,                                  \
+                               kFilter##filter, benchmark_iterations_,         \
+                               disable_cpu_flags_);                            \
+      EXPECT_LE(diff, max_diff);                                               \
+    }                                                                          \
+    TEST_F(libyuvTest, name##From##width##x##height##_##filter) {              \
+      int diff = TestI4xxScale(name, subsamp_x, width, height,                 \
+                               Abs(benchmark_width_), Abs(benchmark_height_),  \
+                               kFilter##filter, benchmark_iterations_,         \
+                               disable_cpu_flags_);                            \
+      EXPECT_LE(diff, max_diff);                                               \
+    }
+
+#define TEST_I4XXSCALE(name, subsamp_x, width, height)                         \
+    TEST_I4XXSCALE1(name, subsamp_x, width, height, None, 0)                   \
+    TEST_I4XXSCALE1(name, subsamp_x, width, height, Bilinear, 3)               \
+    TEST_I4XXSCALE1(name, subsamp_x, width, height, Box, 3)
+
+TEST_I4XXSCALE(I422Scale, 2, 320, 240)
+TEST_I4XXSCALE(I422Scale, 2, 569, 480)
+TEST_I4XXSCALE(I444Scale, 1, 320, 240)
+TEST_I4XXSCALE(I444Scale, 1, 569, 480)
+#undef TEST_I4XXSCALE1
+#undef TEST_I4XXSCALE
+
+TEST_F(libyuvTest, I400Scale_Opt) {
+  const int kDstWidth = 569;
+  const int kDstHeight = 480;
+  int src_width = Abs(benchmark_width_);
+  int src_height = Abs(benchmark_height_);
+  align_buffer_page_end(src_y, src_width * src_height)
+  align_buffer_page_end(dst_y_c, kDstWidth * kDstHeight)
+  align_buffer_page_end(dst_y_opt, kDstWidth * kDstHeight)
+  MemRandomize(src_y, src_width * src_height);
+
+  MaskCpuFlags(disable_cpu_flags_);  // Disable all CPU optimization.
+  EXPECT_EQ(0, I400Scale(src_y, src_width, src_width, src_height,
+                         dst_y_c, kDstWidth, kDstWidth, kDstHeight,
+                         kFilterBox));
+  MaskCpuFlags(-1);  // Enable all CPU optimization.
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    I400Scale(src_y, src_width, src_width, src_height,
+              dst_y_opt, kDstWidth, kDstWidth, kDstHeight, kFilterBox);
+  }
+  for (int i = 0; i < kDstWidth * kDstHeight; ++i) {
+    EXPECT_NEAR(dst_y_c[i], dst_y_opt[i], 3);
+  }
+
+  // 16 bit I400 with 8 bit values matches the 8 bit scaler when unfiltered.
+  align_buffer_page_end(src_y_16, src_width * src_height * 2)
+  align_buffer_page_end(dst_y_16, kDstWidth * kDstHeight * 2)
+  uint16* p_src_y_16 = reinterpret_cast<uint16*>(src_y_16);
+  uint16* p_dst_y_16 = reinterpret_cast<uint16*>(dst_y_16);
+  for (int i = 0; i < src_width * src_height; ++i) {
+    p_src_y_16[i] = src_y[i];
+  }
+  EXPECT_EQ(0, I400Scale(src_y, src_width, src_width, src_height,
+                         dst_y_opt, kDstWidth, kDstWidth, kDstHeight,
+                         kFilterNone));
+  EXPECT_EQ(0, I400Scale_16(p_src_y_16, src_width, src_width, src_height,
+                            p_dst_y_16, kDstWidth, kDstWidth, kDstHeight,
+                            kFilterNone));
+  for (int i = 0; i < kDstWidth * kDstHeight; ++i) {
+    EXPECT_EQ(dst_y_opt[i], p_dst_y_16[i]);
+  }
+
+  free_aligned_buffer_page_end(src_y)
+  free_aligned_buffer_page_end(dst_y_c)
+  free_aligned_buffer_page_end(dst_y_opt)
+  free_aligned_buffer_page_end(src_y_16)
+  free_aligned_buffer_page_end(dst_y_16)
+}
+
+static void TestI420ScaleCrop(int src_width, int src_height,
+                              int crop_x, int crop_y,
+                              int crop_width, int crop_height,
+                              int dst_width, int dst_height,
+                              FilterMode f, int benchmark_iterations,
+                              int disable_cpu_flags) {
+  int src_width_uv = (src_width + 1) >> 1;
+  int src_height_uv = (src_height + 1) >> 1;
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+  int src_size = src_width * src_height + src_width_uv * src_height_uv * 2;
+  int dst_size = dst_width * dst_height + dst_width_uv * dst_height_uv * 2;
+  align_buffer_page_end(src, src_size)
+  align_buffer_page_end(dst_c, dst_size)
+  align_buffer_page_end(dst_opt, dst_size)
+  uint8* src_u = src + src_width * src_height;
+  uint8* src_v = src_u + src_width_uv * src_height_uv;
+  uint8* dst_u_c = dst_c + dst_width * dst_height;
+  uint8* dst_v_c = dst_u_c + dst_width_uv * dst_height_uv;
+  uint8* dst_u_opt = dst_opt + dst_width * dst_height;
+  uint8* dst_v_opt = dst_u_opt + dst_width_uv * dst_height_uv;
+  MemRandomize(src, src_size);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  EXPECT_EQ(0, I420ScaleCrop(src, src_width, src_u, src_width_uv,
+                             src_v, src_width_uv, src_width, src_height,
+                             crop_x, crop_y, crop_width, crop_height,
+                             dst_c, dst_width, dst_u_c, dst_width_uv,
+                             dst_v_c, dst_width_uv, dst_width, dst_height, f));
+  MaskCpuFlags(-1);  // Enable all CPU optimization.
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    I420ScaleCrop(src, src_width, src_u, src_width_uv,
+                  src_v, src_width_uv, src_width, src_height,
+                  crop_x, crop_y, crop_width, crop_height,
+                  dst_opt, dst_width, dst_u_opt, dst_width_uv,
+                  dst_v_opt, dst_width_uv, dst_width, dst_height, f);
+  }
+  for (int i = 0; i < dst_size; ++i) {
+    EXPECT_NEAR(dst_c[i], dst_opt[i], 3);
+  }
+
+  free_aligned_buffer_page_end(src)
+  free_aligned_buffer_page_end(dst_c)
+  free_aligned_buffer_page_end(dst_opt)
+}
+
+#define TEST_I420SCALECROP(name, crop_x, crop_y, dst_width, dst_height)       \
+    TEST_F(libyuvTest, I420ScaleCrop##name##_Bilinear) {                       \
+      TestI420ScaleCrop(640, 360, crop_x, crop_y,                              \
+                        (320 << 16) + 0x5555, (180 << 16) + 0x3333,            \
+                        dst_width, dst_height, kFilterBilinear,                \
+                        benchmark_iterations_, disable_cpu_flags_);            \
+    }                                                                          \
+    TEST_F(libyuvTest, I420ScaleCrop##name##_None) {                           \
+      TestI420ScaleCrop(640, 360, crop_x, crop_y,                              \
+                        (320 << 16) + 0x5555, (180 << 16) + 0x3333,            \
+                        dst_width, dst_height, kFilterNone,                    \
+                        benchmark_iterations_, disable_cpu_flags_);            \
+    }
+
+TEST_I420SCALECROP(Up, (101 << 16) + 0x8000, (77 << 16) + 0x1234, 1280, 720)
+TEST_I420SCALECROP(Down, (3 << 16) + 0xfedc, (1 << 16) + 0x4000, 160, 90)
+TEST_I420SCALECROP(Same, (250 << 16) + 0x2000, (100 << 16) + 0x8000, 320, 180)
+#undef TEST_I420SCALECROP
+
+// A whole pixel crop matches scaling that part of the image.
+TEST_F(libyuvTest, I420ScaleCrop_WholePixel) {
+  const int kWidth = 64;
+  const int kHeight = 48;
+  const int kDstWidth = 50;
+  const int kDstHeight = 30;
+  uint8 src[kWidth * kHeight * 3 / 2];
+  uint8 dst_crop[kDstWidth * kDstHeight * 3 / 2];
+  uint8 dst_scale[kDstWidth * kDstHeight * 3 / 2];
+  uint8* src_u = src + kWidth * kHeight;
+  uint8* src_v = src_u + kWidth * kHeight / 4;
+  uint8* dst_crop_u = dst_crop + kDstWidth * kDstHeight;
+  uint8* dst_crop_v = dst_crop_u + kDstWidth * kDstHeight / 4;
+  uint8* dst_scale_u = dst_scale + kDstWidth * kDstHeight;
+  uint8* dst_scale_v = dst_scale_u + kDstWidth * kDstHeight / 4;
+  MemRandomize(src, kWidth * kHeight * 3 / 2);
+  EXPECT_EQ(0, I420ScaleCrop(src, kWidth, src_u, kWidth / 2,
+                             src_v, kWidth / 2, kWidth, kHeight,
+                             6 << 16, 4 << 16, 40 << 16, 36 << 16,
+                             dst_crop, kDstWidth,
+                             dst_crop_u, kDstWidth / 2,
+                             dst_crop_v, kDstWidth / 2,
+                             kDstWidth, kDstHeight, kFilterBox));
+  EXPECT_EQ(0, I420Scale(src + 4 * kWidth + 6, kWidth,
+                         src_u + 2 * kWidth / 2 + 3, kWidth / 2,
+                         src_v + 2 * kWidth / 2 + 3, kWidth / 2,
+                         40, 36,
+                         dst_scale, kDstWidth,
+                         dst_scale_u, kDstWidth / 2,
+                         dst_scale_v, kDstWidth / 2,
+                         kDstWidth, kDstHeight, kFilterBox));
+  for (int i = 0; i < kDstWidth * kDstHeight * 3 / 2; ++i) {
+    EXPECT_EQ(dst_scale[i], dst_crop[i]);
+  }
+  // Rectangle must be within the image.
+  EXPECT_EQ(-1, I420ScaleCrop(src, kWidth, src_u, kWidth / 2,
+                              src_v, kWidth / 2, kWidth, kHeight,
+                              (24 << 16) + 1, 0, 40 << 16, 36 << 16,
+                              dst_crop, kDstWidth,
+                              dst_crop_u, kDstWidth / 2,
+                              dst_crop_v, kDstWidth / 2,
+                              kDstWidth, kDstHeight, kFilterBox));
+}
+
+// A half pixel offset averages neighboring pixels.
+TEST_F(libyuvTest, ScalePlaneCrop_HalfPixel) {
+  const int kWidth = 64;
+  const int kHeight = 4;
+  uint8 src[kWidth * kHeight];
+  uint8 dst[(kWidth - 1) * (kHeight - 1)];
+  for (int i = 0; i < kHeight; ++i) {
+    for (int j = 0; j < kWidth; ++j) {
+      src[i * kWidth + j] = j * 2 + i * 16;
+    }
+  }
+  EXPECT_EQ(0, ScalePlaneCrop(src, kWidth, kWidth, kHeight,
+                              0x8000, 0x8000,
+                              (kWidth - 1) << 16, (kHeight - 1) << 16,
+                              dst, kWidth - 1, kWidth - 1, kHeight - 1,
+                              kFilterBilinear));
+  for (int i = 0; i < kHeight - 1; ++i) {
+    for (int j = 0; j < kWidth - 1; ++j) {
+      EXPECT_NEAR(j * 2 + 1 + i * 16 + 8, dst[i * (kWidth - 1) + j], 2);
+    }
+  }
+}
+
+// Bilinear downscaling with streaming stores matches cached stores.
+TEST_F(libyuvTest, ScalePlaneBilinearStreaming) {
+  const int kSrcWidth = benchmark_width_;
+  const int kSrcHeight = benchmark_height_;
+  const int kDstWidth = kSrcWidth * 2 / 3 + 1;
+  const int kDstHeight = kSrcHeight * 2 / 3 + 1;
+  const int kDstStride = (kDstWidth + 15) & ~15;
+  align_buffer_page_end(src, kSrcWidth * kSrcHeight);
+  align_buffer_page_end(dst_cached, kDstStride * kDstHeight);
+  align_buffer_page_end(dst_streamed, kDstStride * kDstHeight);
+  for (int i = 0; i < kSrcWidth * kSrcHeight; ++i) {
+    src[i] = (random() & 0xff);
+  }
+  memset(dst_cached, 1, kDstStride * kDstHeight);
+  memset(dst_streamed, 1, kDstStride * kDstHeight);
+
+  SetStreamingStoreThreshold(-1);
+  ScalePlane(src, kSrcWidth, kSrcWidth, kSrcHeight,
+             dst_cached, kDstStride, kDstWidth, kDstHeight, kFilterBilinear);
+  SetStreamingStoreThreshold(0);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    ScalePlane(src, kSrcWidth, kSrcWidth, kSrcHeight,
+               dst_streamed, kDstStride, kDstWidth, kDstHeight,
+               kFilterBilinear);
+  }
+  SetStreamingStoreThreshold(kStreamingStoreThreshold);
+  EXPECT_EQ(0, memcmp(dst_cached, dst_streamed, kDstStride * kDstHeight));
+
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst_cached);
+  free_aligned_buffer_page_end(dst_streamed);
+}
+
 }  // namespace libyuv
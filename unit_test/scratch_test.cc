@@ -0,0 +1,161 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "libyuv/basic_types.h"
+#include "libyuv/convert.h"
+#include "libyuv/row.h"
+#include "libyuv/scale.h"
+#include "libyuv/scratch.h"
+#include "../unit_test/unit_test.h"
+
+namespace libyuv {
+
+static const int kArenaSize = 1024 * 1024;
+
+// Allocations inside the arena are handed out as a stack and space freed out
+// of order is reused once the allocations above it are freed.
+TEST_F(libyuvTest, ScratchArenaStack) {
+  uint8* arena = static_cast<uint8*>(malloc(kArenaSize));
+  SetScratchArena(arena, kArenaSize);
+  uint8* a = static_cast<uint8*>(ScratchAlloc(100));
+  uint8* b = static_cast<uint8*>(ScratchAlloc(200));
+  uint8* c = static_cast<uint8*>(ScratchAlloc(kArenaSize));  // Too big.
+  EXPECT_EQ(arena, a);
+  EXPECT_EQ(arena + 128, b);
+  EXPECT_TRUE(c < arena || c >= arena + kArenaSize);
+  EXPECT_EQ(static_cast<size_t>(128 + 256 + kArenaSize),
+            GetScratchArenaPeak());
+  ScratchFree(a);
+  uint8* d = static_cast<uint8*>(ScratchAlloc(64));
+  EXPECT_EQ(arena + 128 + 256, d);
+  ScratchFree(c);
+  ScratchFree(d);
+  ScratchFree(b);
+  EXPECT_EQ(arena, static_cast<uint8*>(ScratchAlloc(64)));
+  SetScratchArena(NULL, 0);
+  free(arena);
+}
+
+static void RGB565ToI420Frame(const uint8* src_rgb565, int width, int height,
+                              uint8* dst) {
+  int half_width = (width + 1) / 2;
+  int half_height = (height + 1) / 2;
+  uint8* dst_u = dst + width * height;
+  uint8* dst_v = dst_u + half_width * half_height;
+  RGB565ToI420(src_rgb565, width * 2, dst, width, dst_u, half_width,
+               dst_v, half_width, width, height);
+}
+
+// Converting with an arena matches converting with malloc, and the peak
+// reported sizes an arena that the conversion fits in.
+TEST_F(libyuvTest, ScratchArenaRGB565ToI420) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kDstSize = kWidth * kHeight +
+      ((kWidth + 1) / 2) * ((kHeight + 1) / 2) * 2;
+  align_buffer_64(src_rgb565, kWidth * kHeight * 2);
+  align_buffer_64(dst_malloc, kDstSize);
+  align_buffer_64(dst_arena, kDstSize);
+  uint8* arena = static_cast<uint8*>(malloc(kArenaSize));
+  for (int i = 0; i < kWidth * kHeight * 2; ++i) {
+    src_rgb565[i] = (random() & 0xff);
+  }
+  memset(dst_malloc, 1, kDstSize);
+  memset(dst_arena, 2, kDstSize);
+
+  RGB565ToI420Frame(src_rgb565, kWidth, kHeight, dst_malloc);
+  SetScratchArena(arena, kArenaSize);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    RGB565ToI420Frame(src_rgb565, kWidth, kHeight, dst_arena);
+  }
+  size_t peak = GetScratchArenaPeak();
+  SetScratchArena(NULL, 0);
+
+  EXPECT_EQ(0, memcmp(dst_malloc, dst_arena, kDstSize));
+  EXPECT_GT(peak, 0u);
+  EXPECT_LE(peak, static_cast<size_t>(kArenaSize));
+
+  free(arena);
+  free_aligned_buffer_64(src_rgb565);
+  free_aligned_buffer_64(dst_malloc);
+  free_aligned_buffer_64(dst_arena);
+}
+
+// Allocations beyond the table of live allocations are counted in the peak.
+TEST_F(libyuvTest, ScratchArenaManyAllocs) {
+  const int kNumAllocs = 20;
+  SIMD_ALIGNED(uint8 arena[4096]);
+  void* ptrs[kNumAllocs];
+  SetScratchArena(arena, sizeof(arena));
+  for (int i = 0; i < kNumAllocs; ++i) {
+    ptrs[i] = ScratchAlloc(64);
+    ASSERT_TRUE(ptrs[i] != NULL);
+    memset(ptrs[i], i, 64);
+  }
+  EXPECT_EQ(static_cast<size_t>(kNumAllocs * 64), GetScratchArenaPeak());
+  for (int i = kNumAllocs - 1; i >= 0; --i) {
+    ScratchFree(ptrs[i]);
+  }
+  // All space is returned, so the next allocation is at the start.
+  EXPECT_EQ(arena, static_cast<uint8*>(ScratchAlloc(64)));
+  SetScratchArena(NULL, 0);
+}
+
+// Freeing an arena allocation below a live malloc'd one gives its space
+// back.
+TEST_F(libyuvTest, ScratchArenaFreeUnderMalloc) {
+  SIMD_ALIGNED(uint8 arena[256]);
+  SetScratchArena(arena, sizeof(arena));
+  void* in_arena = ScratchAlloc(64);
+  void* in_malloc = ScratchAlloc(1024);  // Too big for the arena.
+  EXPECT_EQ(arena, static_cast<uint8*>(in_arena));
+  ASSERT_TRUE(in_malloc != NULL);
+  ScratchFree(in_arena);
+  in_arena = ScratchAlloc(64);
+  EXPECT_EQ(arena, static_cast<uint8*>(in_arena));
+  ScratchFree(in_arena);
+  ScratchFree(in_malloc);
+  SetScratchArena(NULL, 0);
+}
+
+// An arena too small for the scaler's rows falls back to malloc.
+TEST_F(libyuvTest, ScratchArenaOverflow) {
+  const int kSrcWidth = benchmark_width_;
+  const int kSrcHeight = benchmark_height_;
+  const int kDstWidth = kSrcWidth * 5 / 4;
+  const int kDstHeight = kSrcHeight * 5 / 4;
+  align_buffer_64(src, kSrcWidth * kSrcHeight);
+  align_buffer_64(dst_malloc, kDstWidth * kDstHeight);
+  align_buffer_64(dst_arena, kDstWidth * kDstHeight);
+  uint8 arena[64];
+  for (int i = 0; i < kSrcWidth * kSrcHeight; ++i) {
+    src[i] = (random() & 0xff);
+  }
+
+  ScalePlane(src, kSrcWidth, kSrcWidth, kSrcHeight,
+             dst_malloc, kDstWidth, kDstWidth, kDstHeight, kFilterBilinear);
+  SetScratchArena(arena, sizeof(arena));
+  ScalePlane(src, kSrcWidth, kSrcWidth, kSrcHeight,
+             dst_arena, kDstWidth, kDstWidth, kDstHeight, kFilterBilinear);
+  size_t peak = GetScratchArenaPeak();
+  SetScratchArena(NULL, 0);
+
+  EXPECT_EQ(0, memcmp(dst_malloc, dst_arena, kDstWidth * kDstHeight));
+  EXPECT_GT(peak, sizeof(arena));
+
+  free_aligned_buffer_64(src);
+  free_aligned_buffer_64(dst_malloc);
+  free_aligned_buffer_64(dst_arena);
+}
+
+}  // namespace libyuv
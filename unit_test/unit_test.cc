@@ -10,10 +10,20 @@
 
 #include "../unit_test/unit_test.h"
 
+#include <stdio.h>  // For printf()
 #include <stdlib.h>  // For getenv()
 
 #include <cstring>
 
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define HAS_PERF_EVENTS
+#endif
+
 // Change this to 1000 for benchmarking.
 // TODO(fbarchard): Add command line parsing to pass this as option.
 #define BENCHMARK_ITERATIONS 1
@@ -53,6 +63,110 @@ libyuvTest::libyuvTest() : rotate_max_w_(128), rotate_max_h_(128),
         static_cast<double>(benchmark_iterations_)  + 1279.0) / 1280.0);
 }
 
+#ifdef HAS_PERF_EVENTS
+// Hardware counters, opened as one group so they count the same code.
+enum PerfCounter {
+  kPerfCycles = 0,
+  kPerfInstructions,
+  kPerfCacheMisses,  // Last level cache misses on most cpus.
+  kNumPerfCounters
+};
+static const uint64 kPerfConfigs[kNumPerfCounters] = {
+  PERF_COUNT_HW_CPU_CYCLES,
+  PERF_COUNT_HW_INSTRUCTIONS,
+  PERF_COUNT_HW_CACHE_MISSES,
+};
+static int perf_fds[kNumPerfCounters] = { -1, -1, -1 };
+static int perf_state = 0;  // 0 not opened, 1 opened, -1 off or failed.
+
+static int OpenPerfCounter(uint64 config, int group_fd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof(attr);
+  attr.config = config;
+  attr.disabled = (group_fd == -1);
+  attr.exclude_kernel = 1;  // Allowed with perf_event_paranoid 2.
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1,
+                                  group_fd, 0));
+}
+
+static bool OpenPerfCounters() {
+  if (perf_state == 0) {
+    const char* perf = getenv("LIBYUV_PERF");
+    perf_state = -1;
+    if (perf && atoi(perf)) {  // NOLINT
+      perf_fds[kPerfCycles] = OpenPerfCounter(kPerfConfigs[kPerfCycles], -1);
+      if (perf_fds[kPerfCycles] < 0) {
+        printf("LIBYUV_PERF: counters unavailable, not counting.  "
+               "perf_event_open failed: %s.  "
+               "Check /proc/sys/kernel/perf_event_paranoid.\n",
+               strerror(errno));
+      } else {
+        // Counters the cpu lacks read as not available.
+        for (int i = 1; i < kNumPerfCounters; ++i) {
+          perf_fds[i] = OpenPerfCounter(kPerfConfigs[i],
+                                        perf_fds[kPerfCycles]);
+        }
+        perf_state = 1;
+      }
+    }
+  }
+  return perf_state == 1;
+}
+
+static void StartPerfCounters() {
+  if (OpenPerfCounters()) {
+    ioctl(perf_fds[kPerfCycles], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(perf_fds[kPerfCycles], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+}
+
+static void StopPerfCounters(double pixels) {
+  if (perf_state != 1) {
+    return;
+  }
+  ioctl(perf_fds[kPerfCycles], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+  // Group read is the number of counters then their values, in the order
+  // they were opened.
+  uint64 values[1 + kNumPerfCounters] = { 0 };
+  if (read(perf_fds[kPerfCycles], values, sizeof(values)) <= 0 ||
+      pixels <= 0.) {
+    return;
+  }
+  double counts[kNumPerfCounters];
+  int n = 1;
+  for (int i = 0; i < kNumPerfCounters; ++i) {
+    counts[i] = (perf_fds[i] >= 0 && n <= static_cast<int>(values[0])) ?
+        static_cast<double>(values[n++]) : -1.;
+  }
+  printf("[   PERF   ] %.3f cycles/pixel", counts[kPerfCycles] / pixels);
+  if (counts[kPerfInstructions] >= 0.) {
+    printf(", %.3f instructions/pixel", counts[kPerfInstructions] / pixels);
+  }
+  if (counts[kPerfCacheMisses] >= 0.) {
+    printf(", %.3f LLC misses/Kpixel",
+           counts[kPerfCacheMisses] * 1000. / pixels);
+  }
+  printf(" (%.0f pixels)\n", pixels);
+}
+#endif  // HAS_PERF_EVENTS
+
+PerfScope::PerfScope(int width, int height, int iterations)
+    : pixels_(static_cast<double>(Abs(width)) * Abs(height) * iterations) {
+#ifdef HAS_PERF_EVENTS
+  StartPerfCounters();
+#endif
+}
+
+PerfScope::~PerfScope() {
+#ifdef HAS_PERF_EVENTS
+  StopPerfCounters(pixels_);
+#endif
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
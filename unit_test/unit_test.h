@@ -69,6 +69,19 @@ static inline void MemRandomize(uint8* dst, int64 len) {
   }
 }
 
+// With LIBYUV_PERF=1 on Linux, counts cycles, instructions and last level
+// cache misses while in scope and prints them per pixel when it goes out of
+// scope.  Put one around the optimized benchmark loop, passing the size that
+// loop converts and its iterations.
+class PerfScope {
+ public:
+  PerfScope(int width, int height, int iterations);
+  ~PerfScope();
+
+ private:
+  double pixels_;
+};
+
 class libyuvTest : public ::testing::Test {
  protected:
   libyuvTest();
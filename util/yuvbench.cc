@@ -0,0 +1,667 @@
+/*
+ *  Copyright 2015 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measure the throughput of libyuv functions.
+// Usage: yuvbench [-options]
+// Reports Mpix/s of source pixels, GB/s of source and destination bytes and
+// the percentage of memcpy bandwidth for each function, resolution and cpu.
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#endif
+
+#include "libyuv/compare.h"
+#include "libyuv/convert.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/convert_from.h"
+#include "libyuv/convert_from_argb.h"
+#include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/rotate.h"
+#include "libyuv/rotate_argb.h"
+#include "libyuv/scale.h"
+#include "libyuv/scale_argb.h"
+
+using namespace libyuv;  // NOLINT
+
+// options
+bool verbose = false;
+double min_time = 0.1;  // Seconds to run each function for.
+const char* filter = NULL;  // Substring of the functions to run.
+const char* json_name = NULL;  // File to write results to, or "-".
+const char* baseline_name = NULL;  // File of results to compare to.
+double tolerance = 10.;  // Percent slower than baseline that fails.
+bool any_widths = false;  // Also measure widths 1 less, for _Any_ rows.
+const int kMaxSizes = 16;
+int num_sizes = 0;
+int widths[kMaxSizes];
+int heights[kMaxSizes];
+const char* cpu_list = "c,simd";
+
+#ifdef _WIN32
+static double get_time() {
+  LARGE_INTEGER t, f;
+  QueryPerformanceCounter(&t);
+  QueryPerformanceFrequency(&f);
+  return static_cast<double>(t.QuadPart) / static_cast<double>(f.QuadPart);
+}
+#else
+static double get_time() {
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec * 1e-6;
+}
+#endif
+
+// A frame in one buffer.  Planar formats have their Y plane followed by U
+// and V planes of up to the size of the Y plane.  Packed formats use buf.
+struct Frame {
+  uint8* buf;
+  int w;
+  int h;
+};
+
+static __inline uint8* Y(const Frame& f) {
+  return f.buf;
+}
+static __inline uint8* U(const Frame& f) {
+  return f.buf + f.w * f.h;
+}
+static __inline uint8* V(const Frame& f) {
+  return f.buf + f.w * f.h * 2;
+}
+// Chroma width for horizontal subsampling "sx".
+static __inline int CW(const Frame& f, int sx) {
+  return (f.w + (1 << sx) - 1) >> sx;
+}
+
+typedef void (*BenchFunction)(const Frame& src, const Frame& dst);
+
+struct Benchmark {
+  const char* name;
+  int src_bits;  // Bits per source pixel.
+  int dst_bits;  // Bits per destination pixel, or second source pixel.
+  int dst_percent;  // Destination width and height in percent of source.
+  BenchFunction function;
+};
+
+// Bits per pixel of a planar format with chroma subsampled by sx and sy.
+#define PLANAR_BITS(SX, SY) (8 + (16 >> ((SX) + (SY))))
+
+// Planar YUV to packed formats.
+#define PLANAR_TO_PACKED_LIST(X)                                               \
+  X(I420ToARGB, 1, 1, 4) X(I420ToBGRA, 1, 1, 4) X(I420ToABGR, 1, 1, 4)         \
+  X(I420ToRGBA, 1, 1, 4) X(I420ToRGB24, 1, 1, 3) X(I420ToRAW, 1, 1, 3)         \
+  X(I420ToRGB565, 1, 1, 2) X(I420ToARGB1555, 1, 1, 2)                          \
+  X(I420ToARGB4444, 1, 1, 2) X(I420ToYUY2, 1, 1, 2) X(I420ToUYVY, 1, 1, 2)     \
+  X(J420ToARGB, 1, 1, 4) X(I422ToARGB, 1, 0, 4) X(I422ToBGRA, 1, 0, 4)         \
+  X(I422ToABGR, 1, 0, 4) X(I422ToRGBA, 1, 0, 4) X(I422ToYUY2, 1, 0, 2)         \
+  X(I422ToUYVY, 1, 0, 2) X(J422ToARGB, 1, 0, 4) X(I444ToARGB, 0, 0, 4)         \
+  X(I411ToARGB, 2, 0, 4)
+
+#define DEFINE_PLANAR_TO_PACKED(NAME, SX, SY, BPP)                             \
+  static void Bench##NAME(const Frame& s, const Frame& d) {                    \
+    NAME(Y(s), s.w, U(s), CW(s, SX), V(s), CW(s, SX),                          \
+         d.buf, d.w * BPP, d.w, d.h);                                          \
+  }
+#define ENTRY_PLANAR_TO_PACKED(NAME, SX, SY, BPP)                              \
+  { #NAME, PLANAR_BITS(SX, SY), BPP * 8, 100, Bench##NAME },
+
+// Packed formats to planar YUV.
+#define PACKED_TO_PLANAR_LIST(X)                                               \
+  X(ARGBToI420, 4, 1, 1) X(BGRAToI420, 4, 1, 1) X(ABGRToI420, 4, 1, 1)         \
+  X(RGBAToI420, 4, 1, 1) X(RGB24ToI420, 3, 1, 1) X(RAWToI420, 3, 1, 1)         \
+  X(RGB565ToI420, 2, 1, 1) X(ARGB1555ToI420, 2, 1, 1)                          \
+  X(ARGB4444ToI420, 2, 1, 1) X(YUY2ToI420, 2, 1, 1) X(UYVYToI420, 2, 1, 1)     \
+  X(ARGBToJ420, 4, 1, 1) X(ARGBToI422, 4, 1, 0) X(ARGBToJ422, 4, 1, 0)         \
+  X(ARGBToI444, 4, 0, 0) X(ARGBToI411, 4, 2, 0) X(YUY2ToI422, 2, 1, 0)         \
+  X(UYVYToI422, 2, 1, 0)
+
+#define DEFINE_PACKED_TO_PLANAR(NAME, BPP, SX, SY)                             \
+  static void Bench##NAME(const Frame& s, const Frame& d) {                    \
+    NAME(s.buf, s.w * BPP, Y(d), d.w, U(d), CW(d, SX), V(d), CW(d, SX),        \
+         d.w, d.h);                                                            \
+  }
+#define ENTRY_PACKED_TO_PLANAR(NAME, BPP, SX, SY)                              \
+  { #NAME, BPP * 8, PLANAR_BITS(SX, SY), 100, Bench##NAME },
+
+// Packed formats to packed formats.
+#define PACKED_TO_PACKED_LIST(X)                                               \
+  X(ARGBToBGRA, 4, 4) X(ARGBToABGR, 4, 4) X(ARGBToRGBA, 4, 4)                  \
+  X(ARGBToRGB24, 4, 3) X(ARGBToRAW, 4, 3) X(ARGBToRGB565, 4, 2)                \
+  X(ARGBToARGB1555, 4, 2) X(ARGBToARGB4444, 4, 2) X(ARGBToYUY2, 4, 2)          \
+  X(ARGBToUYVY, 4, 2) X(BGRAToARGB, 4, 4) X(ABGRToARGB, 4, 4)                  \
+  X(RGBAToARGB, 4, 4) X(RGB24ToARGB, 3, 4) X(RAWToARGB, 3, 4)                  \
+  X(RGB565ToARGB, 2, 4) X(ARGB1555ToARGB, 2, 4) X(ARGB4444ToARGB, 2, 4)        \
+  X(YUY2ToARGB, 2, 4) X(UYVYToARGB, 2, 4) X(ARGBCopy, 4, 4)                    \
+  X(ARGBMirror, 4, 4) X(ARGBAttenuate, 4, 4) X(ARGBUnattenuate, 4, 4)          \
+  X(ARGBGrayTo, 4, 4)
+
+#define DEFINE_PACKED_TO_PACKED(NAME, SRC_BPP, DST_BPP)                        \
+  static void Bench##NAME(const Frame& s, const Frame& d) {                    \
+    NAME(s.buf, s.w * SRC_BPP, d.buf, d.w * DST_BPP, d.w, d.h);                \
+  }
+#define ENTRY_PACKED_TO_PACKED(NAME, SRC_BPP, DST_BPP)                         \
+  { #NAME, SRC_BPP * 8, DST_BPP * 8, 100, Bench##NAME },
+
+// Planar YUV to planar YUV.
+#define PLANAR_TO_PLANAR_LIST(X)                                               \
+  X(I420Copy, 1, 1, 1, 1) X(I420Mirror, 1, 1, 1, 1) X(I422Copy, 1, 0, 1, 0)    \
+  X(I444Copy, 0, 0, 0, 0) X(I422ToI420, 1, 0, 1, 1) X(I444ToI420, 0, 0, 1, 1)  \
+  X(I411ToI420, 2, 0, 1, 1) X(I420ToI422, 1, 1, 1, 0)                          \
+  X(I420ToI444, 1, 1, 0, 0) X(I420ToI411, 1, 1, 2, 0)
+
+#define DEFINE_PLANAR_TO_PLANAR(NAME, SSX, SSY, DSX, DSY)                      \
+  static void Bench##NAME(const Frame& s, const Frame& d) {                    \
+    NAME(Y(s), s.w, U(s), CW(s, SSX), V(s), CW(s, SSX),                        \
+         Y(d), d.w, U(d), CW(d, DSX), V(d), CW(d, DSX), d.w, d.h);             \
+  }
+#define ENTRY_PLANAR_TO_PLANAR(NAME, SSX, SSY, DSX, DSY)                       \
+  { #NAME, PLANAR_BITS(SSX, SSY), PLANAR_BITS(DSX, DSY), 100, Bench##NAME },
+
+// NV12 and NV21 to packed formats.
+#define BIPLANAR_TO_PACKED_LIST(X)                                             \
+  X(NV12ToARGB, 4) X(NV21ToARGB, 4) X(NV12ToRGB565, 2) X(NV21ToRGB565, 2)
+
+#define DEFINE_BIPLANAR_TO_PACKED(NAME, BPP)                                   \
+  static void Bench##NAME(const Frame& s, const Frame& d) {                    \
+    NAME(Y(s), s.w, U(s), CW(s, 1) * 2, d.buf, d.w * BPP, d.w, d.h);           \
+  }
+#define ENTRY_BIPLANAR_TO_PACKED(NAME, BPP)                                    \
+  { #NAME, 12, BPP * 8, 100, Bench##NAME },
+
+PLANAR_TO_PACKED_LIST(DEFINE_PLANAR_TO_PACKED)
+PACKED_TO_PLANAR_LIST(DEFINE_PACKED_TO_PLANAR)
+PACKED_TO_PACKED_LIST(DEFINE_PACKED_TO_PACKED)
+PLANAR_TO_PLANAR_LIST(DEFINE_PLANAR_TO_PLANAR)
+BIPLANAR_TO_PACKED_LIST(DEFINE_BIPLANAR_TO_PACKED)
+
+static void BenchNV12ToI420(const Frame& s, const Frame& d) {
+  NV12ToI420(Y(s), s.w, U(s), CW(s, 1) * 2,
+             Y(d), d.w, U(d), CW(d, 1), V(d), CW(d, 1), d.w, d.h);
+}
+static void BenchNV21ToI420(const Frame& s, const Frame& d) {
+  NV21ToI420(Y(s), s.w, U(s), CW(s, 1) * 2,
+             Y(d), d.w, U(d), CW(d, 1), V(d), CW(d, 1), d.w, d.h);
+}
+static void BenchI420ToNV12(const Frame& s, const Frame& d) {
+  I420ToNV12(Y(s), s.w, U(s), CW(s, 1), V(s), CW(s, 1),
+             Y(d), d.w, U(d), CW(d, 1) * 2, d.w, d.h);
+}
+static void BenchI420ToNV21(const Frame& s, const Frame& d) {
+  I420ToNV21(Y(s), s.w, U(s), CW(s, 1), V(s), CW(s, 1),
+             Y(d), d.w, U(d), CW(d, 1) * 2, d.w, d.h);
+}
+static void BenchARGBToNV12(const Frame& s, const Frame& d) {
+  ARGBToNV12(s.buf, s.w * 4, Y(d), d.w, U(d), CW(d, 1) * 2, d.w, d.h);
+}
+static void BenchARGBToNV21(const Frame& s, const Frame& d) {
+  ARGBToNV21(s.buf, s.w * 4, Y(d), d.w, U(d), CW(d, 1) * 2, d.w, d.h);
+}
+
+// Rotations write a destination that is h by w.
+static void I420RotateBy(const Frame& s, const Frame& d, RotationMode mode) {
+  int dst_w = (mode == kRotate180) ? d.w : d.h;
+  I420Rotate(Y(s), s.w, U(s), CW(s, 1), V(s), CW(s, 1),
+             Y(d), dst_w, U(d), (dst_w + 1) / 2, V(d), (dst_w + 1) / 2,
+             s.w, s.h, mode);
+}
+static void BenchI420Rotate90(const Frame& s, const Frame& d) {
+  I420RotateBy(s, d, kRotate90);
+}
+static void BenchI420Rotate180(const Frame& s, const Frame& d) {
+  I420RotateBy(s, d, kRotate180);
+}
+static void BenchI420Rotate270(const Frame& s, const Frame& d) {
+  I420RotateBy(s, d, kRotate270);
+}
+static void BenchNV12ToI420Rotate90(const Frame& s, const Frame& d) {
+  NV12ToI420Rotate(Y(s), s.w, U(s), CW(s, 1) * 2,
+                   Y(d), d.h, U(d), (d.h + 1) / 2, V(d), (d.h + 1) / 2,
+                   s.w, s.h, kRotate90);
+}
+static void ARGBRotateBy(const Frame& s, const Frame& d, RotationMode mode) {
+  int dst_w = (mode == kRotate180) ? d.w : d.h;
+  ARGBRotate(s.buf, s.w * 4, d.buf, dst_w * 4, s.w, s.h, mode);
+}
+static void BenchARGBRotate90(const Frame& s, const Frame& d) {
+  ARGBRotateBy(s, d, kRotate90);
+}
+static void BenchARGBRotate180(const Frame& s, const Frame& d) {
+  ARGBRotateBy(s, d, kRotate180);
+}
+static void BenchARGBRotate270(const Frame& s, const Frame& d) {
+  ARGBRotateBy(s, d, kRotate270);
+}
+
+static void I420ScaleBy(const Frame& s, const Frame& d, FilterMode filter) {
+  I420Scale(Y(s), s.w, U(s), CW(s, 1), V(s), CW(s, 1), s.w, s.h,
+            Y(d), d.w, U(d), CW(d, 1), V(d), CW(d, 1), d.w, d.h, filter);
+}
+static void BenchI420ScaleNone(const Frame& s, const Frame& d) {
+  I420ScaleBy(s, d, kFilterNone);
+}
+static void BenchI420ScaleBox(const Frame& s, const Frame& d) {
+  I420ScaleBy(s, d, kFilterBox);
+}
+static void BenchI420ScaleBilinear(const Frame& s, const Frame& d) {
+  I420ScaleBy(s, d, kFilterBilinear);
+}
+static void ARGBScaleBy(const Frame& s, const Frame& d, FilterMode filter) {
+  ARGBScale(s.buf, s.w * 4, s.w, s.h, d.buf, d.w * 4, d.w, d.h, filter);
+}
+static void BenchARGBScaleNone(const Frame& s, const Frame& d) {
+  ARGBScaleBy(s, d, kFilterNone);
+}
+static void BenchARGBScaleBox(const Frame& s, const Frame& d) {
+  ARGBScaleBy(s, d, kFilterBox);
+}
+static void BenchARGBScaleBilinear(const Frame& s, const Frame& d) {
+  ARGBScaleBy(s, d, kFilterBilinear);
+}
+
+// Compare functions read the destination as a second source.
+static void BenchComputeSumSquareErrorPlane(const Frame& s, const Frame& d) {
+  ComputeSumSquareErrorPlane(Y(s), s.w, Y(d), d.w, s.w, s.h);
+}
+static void BenchI420Psnr(const Frame& s, const Frame& d) {
+  I420Psnr(Y(s), s.w, U(s), CW(s, 1), V(s), CW(s, 1),
+           Y(d), d.w, U(d), CW(d, 1), V(d), CW(d, 1), s.w, s.h);
+}
+static void BenchI420Ssim(const Frame& s, const Frame& d) {
+  I420Ssim(Y(s), s.w, U(s), CW(s, 1), V(s), CW(s, 1),
+           Y(d), d.w, U(d), CW(d, 1), V(d), CW(d, 1), s.w, s.h);
+}
+static void BenchHashDjb2(const Frame& s, const Frame&) {
+  HashDjb2(s.buf, static_cast<uint64>(s.w) * s.h, 5381);
+}
+static void BenchARGBDetect(const Frame& s, const Frame&) {
+  ARGBDetect(s.buf, s.w * 4, s.w, s.h);
+}
+
+static const Benchmark kBenchmarks[] = {
+  PLANAR_TO_PACKED_LIST(ENTRY_PLANAR_TO_PACKED)
+  PACKED_TO_PLANAR_LIST(ENTRY_PACKED_TO_PLANAR)
+  PACKED_TO_PACKED_LIST(ENTRY_PACKED_TO_PACKED)
+  PLANAR_TO_PLANAR_LIST(ENTRY_PLANAR_TO_PLANAR)
+  BIPLANAR_TO_PACKED_LIST(ENTRY_BIPLANAR_TO_PACKED)
+  { "NV12ToI420", 12, 12, 100, BenchNV12ToI420 },
+  { "NV21ToI420", 12, 12, 100, BenchNV21ToI420 },
+  { "I420ToNV12", 12, 12, 100, BenchI420ToNV12 },
+  { "I420ToNV21", 12, 12, 100, BenchI420ToNV21 },
+  { "ARGBToNV12", 32, 12, 100, BenchARGBToNV12 },
+  { "ARGBToNV21", 32, 12, 100, BenchARGBToNV21 },
+  { "I420Rotate90", 12, 12, 100, BenchI420Rotate90 },
+  { "I420Rotate180", 12, 12, 100, BenchI420Rotate180 },
+  { "I420Rotate270", 12, 12, 100, BenchI420Rotate270 },
+  { "NV12ToI420Rotate90", 12, 12, 100, BenchNV12ToI420Rotate90 },
+  { "ARGBRotate90", 32, 32, 100, BenchARGBRotate90 },
+  { "ARGBRotate180", 32, 32, 100, BenchARGBRotate180 },
+  { "ARGBRotate270", 32, 32, 100, BenchARGBRotate270 },
+  { "I420ScaleDown2None", 12, 12, 50, BenchI420ScaleNone },
+  { "I420ScaleDown2Box", 12, 12, 50, BenchI420ScaleBox },
+  { "I420ScaleDown2Bilinear", 12, 12, 50, BenchI420ScaleBilinear },
+  { "I420ScaleDown34Box", 12, 12, 75, BenchI420ScaleBox },
+  { "I420ScaleDown34Bilinear", 12, 12, 75, BenchI420ScaleBilinear },
+  { "I420ScaleUp2Bilinear", 12, 12, 200, BenchI420ScaleBilinear },
+  { "ARGBScaleDown2None", 32, 32, 50, BenchARGBScaleNone },
+  { "ARGBScaleDown2Box", 32, 32, 50, BenchARGBScaleBox },
+  { "ARGBScaleDown2Bilinear", 32, 32, 50, BenchARGBScaleBilinear },
+  { "ARGBScaleUp2Bilinear", 32, 32, 200, BenchARGBScaleBilinear },
+  { "ComputeSumSquareErrorPlane", 8, 8, 100,
+    BenchComputeSumSquareErrorPlane },
+  { "I420Psnr", 12, 12, 100, BenchI420Psnr },
+  { "I420Ssim", 12, 12, 100, BenchI420Ssim },
+  { "HashDjb2", 8, 0, 100, BenchHashDjb2 },
+  { "ARGBDetect", 32, 0, 100, BenchARGBDetect },
+};
+
+struct CpuMask {
+  const char* name;
+  int flags;  // Passed to MaskCpuFlags.
+  int required;  // Skipped unless the cpu has this flag.
+};
+
+static const CpuMask kCpuMasks[] = {
+  { "c", 0, 0 },
+  { "sse2", kCpuHasX86 | kCpuHasSSE2, kCpuHasSSE2 },
+  { "ssse3", kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3, kCpuHasSSSE3 },
+  { "sse41", kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3 | kCpuHasSSE41,
+    kCpuHasSSE41 },
+  { "avx", kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3 | kCpuHasSSE41 |
+    kCpuHasSSE42 | kCpuHasAVX, kCpuHasAVX },
+  { "avx2", kCpuHasX86 | kCpuHasSSE2 | kCpuHasSSSE3 | kCpuHasSSE41 |
+    kCpuHasSSE42 | kCpuHasAVX | kCpuHasAVX2 | kCpuHasERMS | kCpuHasFMA3,
+    kCpuHasAVX2 },
+  { "neon", kCpuHasARM | kCpuHasNEON, kCpuHasNEON },
+  { "mips_dspr2", kCpuHasMIPS | kCpuHasMIPS_DSP | kCpuHasMIPS_DSPR2,
+    kCpuHasMIPS_DSPR2 },
+  { "simd", -1, 0 },
+};
+
+struct Result {
+  char name[64];
+  int width;
+  int height;
+  char cpu[16];
+  double mpix_per_s;
+  double gb_per_s;
+  double memcpy_percent;
+};
+
+static Result* results = NULL;
+static int num_results = 0;
+static int max_results = 0;
+
+static void AddResult(const char* name, int width, int height,
+                      const char* cpu, double mpix_per_s, double gb_per_s,
+                      double memcpy_percent) {
+  if (num_results == max_results) {
+    max_results = max_results ? max_results * 2 : 256;
+    results = static_cast<Result*>(realloc(results,
+                                           max_results * sizeof(Result)));
+  }
+  Result* r = &results[num_results++];
+  strncpy(r->name, name, sizeof(r->name) - 1);
+  r->name[sizeof(r->name) - 1] = 0;
+  r->width = width;
+  r->height = height;
+  strncpy(r->cpu, cpu, sizeof(r->cpu) - 1);
+  r->cpu[sizeof(r->cpu) - 1] = 0;
+  r->mpix_per_s = mpix_per_s;
+  r->gb_per_s = gb_per_s;
+  r->memcpy_percent = memcpy_percent;
+}
+
+void PrintHelp(const char* program) {
+  printf("%s [-options]\n", program);
+  printf(" -s <width>x<height> .... resolution to measure.  May be repeated.\n"
+         "                          Default 640x360 1280x720 1920x1080 "
+         "3840x2160.\n");
+  printf(" -cpu <list> ............ comma separated cpu masks: c, sse2, "
+         "ssse3,\n"
+         "                          sse41, avx, avx2, neon, mips_dspr2, "
+         "simd.\n"
+         "                          Default c,simd.\n");
+  printf(" -f <name> .............. only functions containing name.\n");
+  printf(" -t <seconds> ........... time to run each function.  "
+         "Default 0.1.\n");
+  printf(" -json <file> ........... write results as JSON, - for stdout.\n");
+  printf(" -baseline <file> ....... compare to JSON results of an earlier "
+         "run\n"
+         "                          and fail if any function is slower.\n");
+  printf(" -tolerance <percent> ... slowdown allowed by -baseline.  "
+         "Default 10.\n");
+  printf(" -any ................... also measure each width minus 1 and "
+         "print how\n"
+         "                          much slower _Any_ row functions are per "
+         "pixel.\n");
+  printf(" -v ..................... verbose\n");
+  printf(" -h ..................... this help\n");
+  exit(0);
+}
+
+void ParseOptions(int argc, const char* argv[]) {
+  for (int c = 1; c < argc; ++c) {
+    if (!strcmp(argv[c], "-v")) {
+      verbose = true;
+    } else if (!strcmp(argv[c], "-h") || !strcmp(argv[c], "-help")) {
+      PrintHelp(argv[0]);
+    } else if (!strcmp(argv[c], "-s") && c + 1 < argc) {
+      if (num_sizes < kMaxSizes &&
+          sscanf(argv[++c], "%dx%d",  // NOLINT
+                 &widths[num_sizes], &heights[num_sizes]) == 2 &&
+          widths[num_sizes] > 0 && heights[num_sizes] > 0) {
+        ++num_sizes;
+      } else {
+        fprintf(stderr, "Bad size %s\n", argv[c]);
+        exit(1);
+      }
+    } else if (!strcmp(argv[c], "-cpu") && c + 1 < argc) {
+      cpu_list = argv[++c];
+    } else if (!strcmp(argv[c], "-f") && c + 1 < argc) {
+      filter = argv[++c];
+    } else if (!strcmp(argv[c], "-t") && c + 1 < argc) {
+      min_time = atof(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-json") && c + 1 < argc) {
+      json_name = argv[++c];
+    } else if (!strcmp(argv[c], "-baseline") && c + 1 < argc) {
+      baseline_name = argv[++c];
+    } else if (!strcmp(argv[c], "-tolerance") && c + 1 < argc) {
+      tolerance = atof(argv[++c]);  // NOLINT
+    } else if (!strcmp(argv[c], "-any")) {
+      any_widths = true;
+    } else {
+      fprintf(stderr, "Unknown option %s\n", argv[c]);
+      exit(1);
+    }
+  }
+  if (num_sizes == 0) {
+    static const int kDefaultSizes[4][2] = {
+      { 640, 360 }, { 1280, 720 }, { 1920, 1080 }, { 3840, 2160 }
+    };
+    for (int i = 0; i < 4; ++i) {
+      widths[i] = kDefaultSizes[i][0];
+      heights[i] = kDefaultSizes[i][1];
+    }
+    num_sizes = 4;
+  }
+}
+
+// Returns the seconds per call of function, run for at least min_time.
+static double TimeFunction(BenchFunction function,
+                           const Frame& src, const Frame& dst) {
+  function(src, dst);  // Warm up caches and one time initialization.
+  int iterations = 0;
+  double start = get_time();
+  double elapsed = 0.;
+  do {
+    function(src, dst);
+    ++iterations;
+    elapsed = get_time() - start;
+  } while (elapsed < min_time);
+  return elapsed / iterations;
+}
+
+// Copies an ARGB frame, as the reference for the bandwidth of the others.
+static void BenchMemcpy(const Frame& s, const Frame& d) {
+  memcpy(d.buf, s.buf, static_cast<size_t>(s.w) * s.h * 4);
+}
+
+static bool CpuMaskSupported(const CpuMask& mask) {
+  if (!mask.required) {
+    return true;
+  }
+  MaskCpuFlags(-1);
+  return TestCpuFlag(mask.required) != 0;
+}
+
+static void WriteJson(FILE* f) {
+  fprintf(f, "{\n  \"results\": [\n");
+  for (int i = 0; i < num_results; ++i) {
+    const Result& r = results[i];
+    fprintf(f, "    {\"name\": \"%s\", \"width\": %d, \"height\": %d, "
+            "\"cpu\": \"%s\", \"mpix_per_s\": %.2f, \"gb_per_s\": %.3f, "
+            "\"memcpy_percent\": %.1f}%s\n",
+            r.name, r.width, r.height, r.cpu, r.mpix_per_s, r.gb_per_s,
+            r.memcpy_percent, i + 1 < num_results ? "," : "");
+  }
+  fprintf(f, "  ]\n}\n");
+}
+
+// Reads results written by WriteJson and reports functions that are more
+// than tolerance percent slower.  Returns the number of regressions.
+static int CompareBaseline(const char* name) {
+  FILE* f = fopen(name, "r");
+  if (!f) {
+    fprintf(stderr, "Unable to open baseline %s\n", name);
+    return 1;
+  }
+  int num_regressions = 0;
+  int num_compared = 0;
+  char line[512];
+  while (fgets(line, sizeof(line), f)) {
+    Result b;
+    if (sscanf(line, " {\"name\": \"%63[^\"]\", \"width\": %d, "  // NOLINT
+               "\"height\": %d, \"cpu\": \"%15[^\"]\", \"mpix_per_s\": %lf",
+               b.name, &b.width, &b.height, b.cpu, &b.mpix_per_s) != 5) {
+      continue;
+    }
+    for (int i = 0; i < num_results; ++i) {
+      const Result& r = results[i];
+      if (r.width != b.width || r.height != b.height ||
+          strcmp(r.name, b.name) || strcmp(r.cpu, b.cpu)) {
+        continue;
+      }
+      double change = (r.mpix_per_s - b.mpix_per_s) * 100. / b.mpix_per_s;
+      ++num_compared;
+      if (change < -tolerance) {
+        printf("REGRESSION %-28s %5dx%-5d %-6s %10.2f Mpix/s, "
+               "baseline %10.2f (%+.1f%%)\n",
+               r.name, r.width, r.height, r.cpu, r.mpix_per_s,
+               b.mpix_per_s, change);
+        ++num_regressions;
+      } else if (verbose) {
+        printf("           %-28s %5dx%-5d %-6s %+.1f%%\n", r.name, r.width,
+               r.height, r.cpu, change);
+      }
+      break;
+    }
+  }
+  fclose(f);
+  printf("Compared %d results to %s: %d regressions.\n",
+         num_compared, name, num_regressions);
+  return num_regressions;
+}
+
+int main(int argc, const char* argv[]) {
+  ParseOptions(argc, argv);
+  FILE* out = (json_name && !strcmp(json_name, "-")) ? stderr : stdout;
+
+  int max_pixels = 0;
+  for (int i = 0; i < num_sizes; ++i) {
+    if (widths[i] * heights[i] > max_pixels) {
+      max_pixels = widths[i] * heights[i];
+    }
+  }
+  // Room for ARGB scaled up by 2, plus rotation of odd sizes.
+  size_t buffer_size = static_cast<size_t>(max_pixels) * 16 + 4096;
+  uint8* src_buf = static_cast<uint8*>(malloc(buffer_size));
+  uint8* dst_buf = static_cast<uint8*>(malloc(buffer_size));
+  if (!src_buf || !dst_buf) {
+    fprintf(stderr, "Unable to allocate %d bytes\n",
+            static_cast<int>(buffer_size * 2));
+    return 1;
+  }
+  srand(1234);
+  for (size_t i = 0; i < buffer_size; ++i) {
+    src_buf[i] = static_cast<uint8>(rand());  // NOLINT
+  }
+  memcpy(dst_buf, src_buf, buffer_size);
+
+  fprintf(out, "%-28s %-11s %-6s %10s %8s %8s\n",
+          "function", "size", "cpu", "Mpix/s", "GB/s", "memcpy%");
+  for (int s = 0; s < num_sizes; ++s) {
+    Frame src = { src_buf, widths[s], heights[s] };
+    Frame memcpy_dst = { dst_buf, widths[s], heights[s] };
+    double seconds = TimeFunction(BenchMemcpy, src, memcpy_dst);
+    double memcpy_mpix_per_s = src.w * src.h / seconds * 1e-6;
+    double memcpy_gb_per_s = src.w * src.h * 8. / seconds * 1e-9;
+    AddResult("memcpy", src.w, src.h, "c", memcpy_mpix_per_s,
+              memcpy_gb_per_s, 100.);
+    fprintf(out, "%-28s %5dx%-5d %-6s %10.2f %8.2f %8.1f\n", "memcpy",
+            src.w, src.h, "c", memcpy_mpix_per_s, memcpy_gb_per_s, 100.);
+
+    for (int m = 0; m < static_cast<int>(sizeof(kCpuMasks) /
+                                         sizeof(kCpuMasks[0])); ++m) {
+      const CpuMask& mask = kCpuMasks[m];
+      const char* found = strstr(cpu_list, mask.name);
+      size_t len = strlen(mask.name);
+      if (!found || (found != cpu_list && found[-1] != ',') ||
+          (found[len] != 0 && found[len] != ',')) {
+        continue;
+      }
+      if (!CpuMaskSupported(mask)) {
+        if (verbose) {
+          printf("Skipping cpu %s\n", mask.name);
+        }
+        continue;
+      }
+      MaskCpuFlags(mask.flags);
+      for (int b = 0; b < static_cast<int>(sizeof(kBenchmarks) /
+                                           sizeof(kBenchmarks[0])); ++b) {
+        const Benchmark& bench = kBenchmarks[b];
+        if (filter && !strstr(bench.name, filter)) {
+          continue;
+        }
+        // With -any, the width minus 1 leaves a remainder for every _Any_
+        // row function.  Its speed per pixel is compared to the full width.
+        double full_mpix_per_s = 0.;
+        for (int narrow = 0; narrow <= (any_widths && src.w > 1); ++narrow) {
+          Frame bench_src = { src.buf, src.w - narrow, src.h };
+          Frame dst = { dst_buf, bench_src.w * bench.dst_percent / 100,
+                        bench_src.h * bench.dst_percent / 100 };
+          double seconds = TimeFunction(bench.function, bench_src, dst);
+          double src_pixels = static_cast<double>(bench_src.w) * bench_src.h;
+          double dst_pixels = static_cast<double>(dst.w) * dst.h;
+          double bytes = (src_pixels * bench.src_bits +
+                          dst_pixels * bench.dst_bits) / 8.;
+          double mpix_per_s = src_pixels / seconds * 1e-6;
+          double gb_per_s = bytes / seconds * 1e-9;
+          double memcpy_percent = gb_per_s * 100. / memcpy_gb_per_s;
+          AddResult(bench.name, bench_src.w, bench_src.h, mask.name,
+                    mpix_per_s, gb_per_s, memcpy_percent);
+          fprintf(out, "%-28s %5dx%-5d %-6s %10.2f %8.2f %8.1f",
+                  bench.name, bench_src.w, bench_src.h, mask.name,
+                  mpix_per_s, gb_per_s, memcpy_percent);
+          if (narrow) {
+            fprintf(out, "  any %+.1f%%",
+                    (full_mpix_per_s / mpix_per_s - 1.) * 100.);
+          }
+          fprintf(out, "\n");
+          fflush(out);
+          full_mpix_per_s = mpix_per_s;
+        }
+      }
+    }
+  }
+  MaskCpuFlags(-1);
+
+  if (json_name) {
+    FILE* f = strcmp(json_name, "-") ? fopen(json_name, "w") : stdout;
+    if (!f) {
+      fprintf(stderr, "Unable to create %s\n", json_name);
+      return 1;
+    }
+    WriteJson(f);
+    if (f != stdout) {
+      fclose(f);
+    }
+  }
+  int num_regressions = 0;
+  if (baseline_name) {
+    num_regressions = CompareBaseline(baseline_name);
+  }
+  free(results);
+  free(src_buf);
+  free(dst_buf);
+  return num_regressions ? 1 : 0;
+}
@@ -10,23 +10,31 @@ ARFLAGS=/MACHINE:ARM /NOLOGO /SUBSYSTEM:NATIVE
 RM=cmd /c del
 
 LOCAL_OBJ_FILES = \
+	source/autotune.o\
+	source/batch.o\
 	source/compare.o\
 	source/compare_common.o\
 	source/convert.o\
 	source/convert_argb.o\
 	source/convert_from.o\
 	source/convert_from_argb.o\
+	source/convert_frame.o\
 	source/convert_to_argb.o\
 	source/convert_to_i420.o\
 	source/cpu_id.o\
+	source/dispatch.o\
+	source/frame_buffer_pool.o\
 	source/planar_functions.o\
+	source/profile.o\
 	source/rotate.o\
 	source/rotate_argb.o\
 	source/row_any.o\
 	source/row_common.o\
+	source/row_functions.o\
 	source/scale.o\
 	source/scale_argb.o\
 	source/scale_common.o\
+	source/scratch.o\
 	source/video_common.o
 
 .cc.o: